@@ -8,6 +8,8 @@
 
 #import "HLAction.h"
 
+#import "HLActionCommandQueue.h"
+#import "HLActionDescriptor.h"
 #import "HLLog.h"
 
 #if TARGET_OS_IPHONE
@@ -15,15 +17,90 @@
 #endif
 
 #include <math.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
-CGFloat
-HLActionApplyTiming(HLActionTimingMode timingMode, CGFloat normalTime)
+// note: Lookup tables for timing functions, sampled at regular intervals of normal time
+// and linearly interpolated.  Built lazily on first use.
+enum {
+  HLActionTimingTableSegmentCount = 1024,
+  HLActionTimingModeCount = HLActionTimingEaseInEaseOutBezier + 1,
+};
+
+static CGFloat HLActionTimingTables[HLActionTimingModeCount][HLActionTimingTableSegmentCount + 1];
+
+static BOOL HLActionUsesTimingTablesFlag = NO;
+
+static CGFloat
+HLActionEvaluateBezier(HLActionTimingMode timingMode, CGFloat s)
 {
-  // SKAction easing functions use cubic Bezier curves with implicit first and last
+  // note: SKAction easing functions use cubic Bezier curves with implicit first and last
   // control points (0, 0) and (1, 1).  Trial and error with ease-out proves it is using
-  // (1/3, 1/3) and (2/3, 1) for middle control points; the others are likely symmetric.
-  // These Beziers are gentler than our sine curves, but the sine math is much simpler.
+  // (1/3, 1/3) and (2/3, 1) for middle control points; the others are assumed symmetric:
+  // (1/3, 0) and (2/3, 2/3) for ease-in, and (1/3, 0) and (2/3, 1) for ease-in-ease-out.
+  // In all three cases the x control values are evenly spaced, so x(s) = s, and the curve
+  // is simply a cubic polynomial in normal time.
+  switch (timingMode) {
+    case HLActionTimingEaseInBezier:
+      return s * s * (2.0f - s);
+    case HLActionTimingEaseOutBezier:
+      return s * (1.0f + s - s * s);
+    case HLActionTimingEaseInEaseOutBezier:
+      return s * s * (3.0f - 2.0f * s);
+    default:
+      return s;
+  }
+}
+
+static CGFloat
+HLActionEvaluateBezierDerivative(HLActionTimingMode timingMode, CGFloat s)
+{
+  switch (timingMode) {
+    case HLActionTimingEaseInBezier:
+      return s * (4.0f - 3.0f * s);
+    case HLActionTimingEaseOutBezier:
+      return (1.0f - s) * (1.0f + 3.0f * s);
+    case HLActionTimingEaseInEaseOutBezier:
+      return 6.0f * s * (1.0f - s);
+    default:
+      return 1.0f;
+  }
+}
+
+static CGFloat
+HLActionInvertBezier(HLActionTimingMode timingMode, CGFloat normalTime)
+{
+  // note: The Bezier polynomials are monotonically increasing on [0, 1], so solve using
+  // Newton's method, falling back on bisection whenever a Newton step would leave the
+  // bracketing interval (as it might near the flat ends of the curves).
+  CGFloat low = 0.0f;
+  CGFloat high = 1.0f;
+  CGFloat s = normalTime;
+  for (int i = 0; i < 32; ++i) {
+    CGFloat error = HLActionEvaluateBezier(timingMode, s) - normalTime;
+    if (fabs(error) < 1.0e-12) {
+      break;
+    }
+    if (error > 0.0f) {
+      high = s;
+    } else {
+      low = s;
+    }
+    CGFloat derivative = HLActionEvaluateBezierDerivative(timingMode, s);
+    CGFloat next = (derivative > 0.0f ? s - error / derivative : low);
+    if (next <= low || next >= high) {
+      next = (low + high) / 2.0f;
+    }
+    s = next;
+  }
+  return s;
+}
 
+static CGFloat
+HLActionApplyTimingExact(HLActionTimingMode timingMode, CGFloat normalTime)
+{
   // Precondition: 0.0 <= normalTime <= 1.0
   switch (timingMode) {
     case HLActionTimingLinear:
@@ -34,11 +111,15 @@ HLActionApplyTiming(HLActionTimingMode timingMode, CGFloat normalTime)
       return (CGFloat)sin(normalTime * M_PI_2);
     case HLActionTimingEaseInEaseOut:
       return (CGFloat)((1.0 - cos(normalTime * M_PI)) / 2.0);
+    case HLActionTimingEaseInBezier:
+    case HLActionTimingEaseOutBezier:
+    case HLActionTimingEaseInEaseOutBezier:
+      return HLActionEvaluateBezier(timingMode, normalTime);
   }
 }
 
-CGFloat
-HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
+static CGFloat
+HLActionApplyTimingInverseExact(HLActionTimingMode timingMode, CGFloat normalTime)
 {
   // Precondition: 0.0 <= normalTime <= 1.0
   switch (timingMode) {
@@ -51,7 +132,160 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
     }
     case HLActionTimingEaseInEaseOut:
       return (CGFloat)(acos(1.0 - normalTime * 2.0) / M_PI);
+    case HLActionTimingEaseInBezier:
+    case HLActionTimingEaseOutBezier:
+    case HLActionTimingEaseInEaseOutBezier:
+      return HLActionInvertBezier(timingMode, normalTime);
+  }
+}
+
+static void
+HLActionTimingTablesBuild(void)
+{
+  static dispatch_once_t onceToken;
+  dispatch_once(&onceToken, ^{
+    for (NSInteger m = 0; m < HLActionTimingModeCount; ++m) {
+      CGFloat *table = HLActionTimingTables[m];
+      for (NSUInteger i = 0; i <= HLActionTimingTableSegmentCount; ++i) {
+        table[i] = HLActionApplyTimingExact((HLActionTimingMode)m, (CGFloat)i / HLActionTimingTableSegmentCount);
+      }
+      // note: Guarantee exact endpoints, so that table lookups agree with exact functions
+      // at the beginning and end of every action.
+      table[0] = 0.0f;
+      table[HLActionTimingTableSegmentCount] = 1.0f;
+    }
+  });
+}
+
+static inline CGFloat
+HLActionTimingTableLookup(const CGFloat *table, CGFloat normalTime)
+{
+  if (normalTime <= 0.0f) {
+    return 0.0f;
+  }
+  CGFloat x = normalTime * HLActionTimingTableSegmentCount;
+  NSUInteger i = (NSUInteger)x;
+  if (i >= HLActionTimingTableSegmentCount) {
+    return 1.0f;
+  }
+  CGFloat fraction = x - i;
+  return table[i] + (table[i + 1] - table[i]) * fraction;
+}
+
+static inline CGFloat
+HLActionTimingTableInverseLookup(const CGFloat *table, CGFloat normalTime)
+{
+  if (normalTime <= 0.0f) {
+    return 0.0f;
+  }
+  if (normalTime >= 1.0f) {
+    return 1.0f;
+  }
+  // note: The table is monotonically increasing, so binary search for the segment
+  // containing the value, and then invert the linear interpolation within the segment.
+  // This makes the table inverse an exact inverse of the table lookup (up to rounding).
+  NSUInteger low = 0;
+  NSUInteger high = HLActionTimingTableSegmentCount;
+  while (high - low > 1) {
+    NSUInteger middle = (low + high) / 2;
+    if (table[middle] <= normalTime) {
+      low = middle;
+    } else {
+      high = middle;
+    }
+  }
+  CGFloat segmentHeight = table[high] - table[low];
+  CGFloat fraction = (segmentHeight > 0.0f ? (normalTime - table[low]) / segmentHeight : 0.0f);
+  return ((CGFloat)low + fraction) / HLActionTimingTableSegmentCount;
+}
+
+CGFloat
+HLActionApplyTiming(HLActionTimingMode timingMode, CGFloat normalTime)
+{
+  // Precondition: 0.0 <= normalTime <= 1.0
+  // note: When using tables, all modes use them in both directions (even though the
+  // Bezier polynomials are cheap to evaluate exactly), so that the forward and inverse
+  // functions remain exact inverses of each other.  Actions convert back and forth between
+  // time frames, and rely on round trips to calculate extra time.
+  if (HLActionUsesTimingTablesFlag && timingMode != HLActionTimingLinear) {
+    return HLActionApplyTimingTable(timingMode, normalTime);
+  }
+  return HLActionApplyTimingExact(timingMode, normalTime);
+}
+
+CGFloat
+HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
+{
+  // Precondition: 0.0 <= normalTime <= 1.0
+  // note: See HLActionApplyTiming(); the table must be used in both directions or neither.
+  if (HLActionUsesTimingTablesFlag && timingMode != HLActionTimingLinear) {
+    return HLActionApplyTimingInverseTable(timingMode, normalTime);
+  }
+  return HLActionApplyTimingInverseExact(timingMode, normalTime);
+}
+
+CGFloat
+HLActionApplyTimingTable(HLActionTimingMode timingMode, CGFloat normalTime)
+{
+  if (timingMode == HLActionTimingLinear) {
+    return normalTime;
+  }
+  HLActionTimingTablesBuild();
+  return HLActionTimingTableLookup(HLActionTimingTables[timingMode], normalTime);
+}
+
+CGFloat
+HLActionApplyTimingInverseTable(HLActionTimingMode timingMode, CGFloat normalTime)
+{
+  if (timingMode == HLActionTimingLinear) {
+    return normalTime;
+  }
+  HLActionTimingTablesBuild();
+  return HLActionTimingTableInverseLookup(HLActionTimingTables[timingMode], normalTime);
+}
+
+void
+HLActionApplyTimingBatch(HLActionTimingMode timingMode, const CGFloat *normalTimes, CGFloat *results, NSUInteger count)
+{
+  switch (timingMode) {
+    case HLActionTimingLinear:
+      if (results != normalTimes) {
+        memmove(results, normalTimes, count * sizeof(CGFloat));
+      }
+      break;
+    case HLActionTimingEaseInBezier:
+    case HLActionTimingEaseOutBezier:
+    case HLActionTimingEaseInEaseOutBezier:
+      for (NSUInteger i = 0; i < count; ++i) {
+        results[i] = HLActionEvaluateBezier(timingMode, normalTimes[i]);
+      }
+      break;
+    case HLActionTimingEaseIn:
+    case HLActionTimingEaseOut:
+    case HLActionTimingEaseInEaseOut: {
+      HLActionTimingTablesBuild();
+      const CGFloat *table = HLActionTimingTables[timingMode];
+      for (NSUInteger i = 0; i < count; ++i) {
+        results[i] = HLActionTimingTableLookup(table, normalTimes[i]);
+      }
+      break;
+    }
+  }
+}
+
+void
+HLActionSetUsesTimingTables(BOOL usesTimingTables)
+{
+  if (usesTimingTables) {
+    HLActionTimingTablesBuild();
   }
+  HLActionUsesTimingTablesFlag = usesTimingTables;
+}
+
+BOOL
+HLActionUsesTimingTables(void)
+{
+  return HLActionUsesTimingTablesFlag;
 }
 
 @interface HLAction ()
@@ -68,54 +302,421 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
 
 - (NSTimeInterval)HL_elapsedTimeLinearForElapsedTime:(NSTimeInterval)elapsedTime;
 
+- (BOOL)HL_seek:(NSTimeInterval)time node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime;
+
+- (BOOL)HL_canSeekToTime:(NSTimeInterval)time;
+
+- (BOOL)HL_canSeekBackward;
+
+- (void)HL_resetElapsedTimeWithNode:(SKNode *)node;
+
+- (NSTimeInterval)HL_completionTime;
+
+- (NSTimeInterval)HL_completionTimeForElapsedTime:(NSTimeInterval)elapsedTime;
+
+- (NSTimeInterval)HL_idleTime;
+
+- (NSTimeInterval)HL_idleTimeForIdleTimeMyFrame:(NSTimeInterval)idleTimeMyFrame;
+
 #if DEBUG
 @property (nonatomic, assign) BOOL completed;
 #endif
 
 @end
 
+// note: Checked on every action update; see HLActionUpdate().
+static BOOL HLActionInstrumentationEnabledFlag = NO;
+
+static BOOL HLActionInstrumentedUpdate(HLAction *action, NSTimeInterval incrementalTime, SKNode *node, NSTimeInterval *extraTime, NSString *key);
+
+static void HLActionInstrumentationRecordAllocation(Class actionClass, NSString *key);
+
+// note: All updates of one action by another (or by a runner) go through here, so that they
+// can be instrumented.  Pass the runner key, if any.
+static inline BOOL
+HLActionUpdate(HLAction *action, NSTimeInterval incrementalTime, SKNode *node, NSTimeInterval *extraTime, NSString *key)
+{
+  if (HLActionInstrumentationEnabledFlag) {
+    return HLActionInstrumentedUpdate(action, incrementalTime, node, extraTime, key);
+  }
+  return [action HL_update:incrementalTime node:node extraTime:extraTime];
+}
+
+// note: Action runner storage is a small array of key/action pairs, stored inline in the
+// runner for the common case of a few actions per runner, and moved to the heap only when
+// it outgrows the inline storage.  Keys and actions are retained manually (with
+// CFBridgingRetain) so that the array can be a plain C array.
+enum {
+  HLActionRunnerInlineCapacity = 4,
+};
+
+// note: An entry runs either an action or an action descriptor (see
+// runActionDescriptor:withKey:); the other is NULL.
+typedef struct {
+  void *key;
+  // note: Both NULL for an entry removed during update; see HL_removeEntryAtIndex:.
+  void *action;
+  HLActionDescriptor *descriptor;
+} HLActionRunnerEntry;
+
+static inline BOOL
+HLActionRunnerEntryIsRunning(const HLActionRunnerEntry *entry)
+{
+  return (entry->action != NULL || entry->descriptor != NULL);
+}
+
+// note: Defined in HLActionDescriptor.m; not part of the public interface.
+void HLActionDescriptorBeginRunning(HLActionDescriptor *descriptor);
+void HLActionDescriptorEndRunning(HLActionDescriptor *descriptor);
+
+static const NSTimeInterval HLActionRunnerIdleTimeTolerance = 1.0e-9;
+
+// note: The registry's timer wheel has three levels of 64 lists each, plus an overflow
+// list: Level 0 lists hold runners due in each of the next 64 ticks; level 1 lists hold
+// runners due in each of the next 64 blocks of 64 ticks; level 2 lists hold runners due in
+// each of the next 64 blocks of 4096 ticks.  Lists from higher levels are redistributed to
+// lower levels ("cascaded") as their blocks begin.
+enum {
+  HLActionRunnerRegistryWheelBits = 6,
+  HLActionRunnerRegistryWheelMask = (1 << HLActionRunnerRegistryWheelBits) - 1,
+  HLActionRunnerRegistryWheelLevelSize = 1 << HLActionRunnerRegistryWheelBits,
+  HLActionRunnerRegistryWheelOverflowList = 3 * HLActionRunnerRegistryWheelLevelSize,
+  HLActionRunnerRegistryWheelListCount = HLActionRunnerRegistryWheelOverflowList + 1,
+};
+
+static const NSTimeInterval HLActionRunnerRegistryWheelTick = 1.0 / 64.0;
+
+// note: The node properties interpolated between fixed time steps; see
+// [HLActionRunner interpolatesNode].
+typedef struct {
+  CGPoint position;
+  CGFloat zRotation;
+  CGFloat xScale;
+  CGFloat yScale;
+  CGFloat alpha;
+} HLActionRunnerNodeState;
+
+static HLActionRunnerNodeState
+HLActionRunnerNodeStateGet(SKNode *node)
+{
+  HLActionRunnerNodeState state;
+  state.position = node.position;
+  state.zRotation = node.zRotation;
+  state.xScale = node.xScale;
+  state.yScale = node.yScale;
+  state.alpha = node.alpha;
+  return state;
+}
+
+static void
+HLActionRunnerNodeStateSet(SKNode *node, HLActionRunnerNodeState state)
+{
+  node.position = state.position;
+  node.zRotation = state.zRotation;
+  node.xScale = state.xScale;
+  node.yScale = state.yScale;
+  node.alpha = state.alpha;
+}
+
+static inline CGFloat
+HLActionRunnerInterpolateValue(CGFloat previousValue, CGFloat value, CGFloat alpha)
+{
+  return previousValue + (value - previousValue) * alpha;
+}
+
+static inline CGFloat
+HLActionRunnerRestoreValue(CGFloat nodeValue, CGFloat renderedValue, CGFloat simulatedValue)
+{
+  // note: If nobody else has changed the value since it was rendered, restore the simulated
+  // value exactly (so that the simulation is unaffected by floating point error in the
+  // interpolation).  Otherwise, preserve the change.
+  if (nodeValue == renderedValue) {
+    return simulatedValue;
+  }
+  return simulatedValue + (nodeValue - renderedValue);
+}
+
+// note: A callback from a perform-selector or custom action.  Object pointers are
+// unretained, except while the callback is deferred; see HLActionDispatchCallback().  For
+// custom actions, the first argument is the node and the second is the user data.
+typedef NS_ENUM(NSInteger, HLActionCallbackType) {
+  HLActionCallbackNoArguments,
+  HLActionCallbackOneArgument,
+  HLActionCallbackTwoArguments,
+  HLActionCallbackCustom,
+};
+
+typedef struct {
+  HLActionCallbackType type;
+  void *target;
+  SEL selector;
+  void *argument1;
+  void *argument2;
+  CGFloat elapsedTime;
+  NSTimeInterval duration;
+} HLActionCallback;
+
+static void
+HLActionInvokeCallback(const HLActionCallback *callback)
+{
+  id target = (__bridge id)callback->target;
+  SEL selector = callback->selector;
+  IMP imp = [target methodForSelector:selector];
+  switch (callback->type) {
+    case HLActionCallbackNoArguments: {
+      void (*func)(id, SEL) = (void (*)(id, SEL))imp;
+      func(target, selector);
+      break;
+    }
+    case HLActionCallbackOneArgument: {
+      void (*func)(id, SEL, id) = (void (*)(id, SEL, id))imp;
+      func(target, selector, (__bridge id)callback->argument1);
+      break;
+    }
+    case HLActionCallbackTwoArguments: {
+      void (*func)(id, SEL, id, id) = (void (*)(id, SEL, id, id))imp;
+      func(target, selector, (__bridge id)callback->argument1, (__bridge id)callback->argument2);
+      break;
+    }
+    case HLActionCallbackCustom: {
+      void (*func)(id, SEL, SKNode *, CGFloat, NSTimeInterval, id) = (void (*)(id, SEL, SKNode *, CGFloat, NSTimeInterval, id))imp;
+      func(target, selector, (__bridge SKNode *)callback->argument1, callback->elapsedTime, callback->duration, (__bridge id)callback->argument2);
+      break;
+    }
+  }
+}
+
+// note: The registry deferring callbacks during its current update on this thread, if
+// any; see [HLActionRunnerRegistry defersCallbacks].  Thread-local so that a runner updated
+// on another thread (outside any registry) never has its callbacks captured by a registry
+// updating on this one.
+static __thread __unsafe_unretained HLActionRunnerRegistry *HLActionCallbackDeferringRegistry = nil;
+
+static void
+HLActionReleaseCallback(HLActionCallback *callback)
+{
+  CFRelease(callback->target);
+  if (callback->argument1) {
+    CFRelease(callback->argument1);
+  }
+  if (callback->argument2) {
+    CFRelease(callback->argument2);
+  }
+}
+
+@interface HLActionRunnerRegistry ()
+
+- (void)HL_deferCallback:(const HLActionCallback *)callback;
+
+- (void)HL_addRunner:(HLActionRunner *)runner;
+
+- (void)HL_removeRunner:(HLActionRunner *)runner;
+
+- (void)HL_dropRunner:(HLActionRunner *)runner;
+
+- (void)HL_unparkRunner:(HLActionRunner *)runner;
+
+@end
+
+// note: Perform-selector and custom actions make their callbacks through here, so that
+// they can be deferred.
+static inline void
+HLActionDispatchCallback(HLActionCallback callback)
+{
+  HLActionRunnerRegistry *registry = HLActionCallbackDeferringRegistry;
+  if (registry) {
+    [registry HL_deferCallback:&callback];
+  } else {
+    HLActionInvokeCallback(&callback);
+  }
+}
+
+@interface HLActionRunner ()
+{
+  // note: Registry state is declared here (rather than in the implementation) so that the
+  // registry can access it directly during updateAllRunners:.
+@package
+  __weak HLActionRunnerRegistry *_registry;
+  __weak SKNode *_registryNode;
+  BOOL _registryHasNode;
+  // note: Set if the node was in a scene when the runner was associated with the registry;
+  // the runner is then dropped from the registry when the node leaves the scene.
+  BOOL _registryRequiresScene;
+  // note: The index of this runner in the registry's runner array, or NSNotFound if not
+  // currently a member.  Maintained by the registry.
+  NSUInteger _registryIndex;
+  // note: Parked runners are members of the registry, but are kept in its timer wheel
+  // rather than its runner array (and so _registryIndex is NSNotFound).  See
+  // [HLActionRunnerRegistry HL_parkRunner:deadlineTick:speed:].  Wheel lists are linked
+  // through unretained pointers; the registry retains parked runners.
+  BOOL _registryParked;
+  NSUInteger _registryWheelList;
+  void *_registryWheelPrevious;
+  void *_registryWheelNext;
+  uint64_t _registryWheelDeadline;
+  NSTimeInterval _registryParkedTime;
+  CGFloat _registryParkedSpeed;
+  // note: The time, in the runner's frame, for which updates can be deferred, reduced by
+  // time already deferred; see HL_idleTime.
+  NSTimeInterval _idleTime;
+  NSTimeInterval _pendingTime;
+}
+
+- (void)HL_updateEntries:(NSTimeInterval)incrementalTime node:(SKNode *)node;
+
+@end
+
 @implementation HLActionRunner
 {
-  NSMutableDictionary *_actions;
-  NSArray *_keys;
+  HLActionRunnerEntry _inlineEntries[HLActionRunnerInlineCapacity];
+  HLActionRunnerEntry *_entries;
+  NSUInteger _entryCount;
+  NSUInteger _entryCapacity;
+  NSUInteger _actionCount;
+  NSUInteger _updateDepth;
+  BOOL _hasRemovedEntries;
+  // note: Interpolation state for fixed time steps.  The simulated state is the node state
+  // after the latest step; the previous state is the node state before it.  The rendered
+  // state is what was set on the node by interpolation, and is only valid if
+  // _hasRenderedNodeState.
+  HLActionRunnerNodeState _previousNodeState;
+  HLActionRunnerNodeState _simulatedNodeState;
+  HLActionRunnerNodeState _renderedNodeState;
+  BOOL _hasPreviousNodeState;
+  BOOL _hasRenderedNodeState;
+  __weak SKNode *_renderedNode;
 }
 
 - (instancetype)init
 {
   self = [super init];
   if (self) {
-    _actions = [NSMutableDictionary dictionary];
-    _keys = nil;
+    _entries = _inlineEntries;
+    _entryCount = 0;
+    _entryCapacity = HLActionRunnerInlineCapacity;
+    _actionCount = 0;
+    _updateDepth = 0;
+    _hasRemovedEntries = NO;
+    _fixedTimeStep = 0.0;
+    _maximumStepCount = 5;
+    _accumulatedTime = 0.0;
+    _interpolatesNode = NO;
+    _hasPreviousNodeState = NO;
+    _hasRenderedNodeState = NO;
+    _defersIdleUpdates = NO;
+    _idleTime = 0.0;
+    _pendingTime = 0.0;
+    _offscreen = NO;
+    _offscreenUpdateInterval = 0.0;
+    _offscreenTime = 0.0;
+    _registryHasNode = NO;
+    _registryRequiresScene = NO;
+    _registryIndex = NSNotFound;
+    _registryParked = NO;
+    _registryWheelList = NSNotFound;
   }
   return self;
 }
 
 - (instancetype)initWithCoder:(NSCoder *)aDecoder
 {
-  self = [super init];
+  self = [self init];
   if (self) {
-    _actions = [aDecoder decodeObjectForKey:@"actions"];
-    _keys = [_actions allKeys];
+    // note: Encoded as a dictionary for compatibility with archives written before the
+    // runner used its own storage.
+    NSDictionary *actions = [aDecoder decodeObjectForKey:@"actions"];
+    [actions enumerateKeysAndObjectsUsingBlock:^(NSString *key, HLAction *action, BOOL *stop){
+      [self HL_appendEntryWithKey:key action:action descriptor:NULL];
+    }];
+    _fixedTimeStep = [aDecoder decodeDoubleForKey:@"fixedTimeStep"];
+    if ([aDecoder containsValueForKey:@"maximumStepCount"]) {
+      _maximumStepCount = (NSUInteger)[aDecoder decodeIntegerForKey:@"maximumStepCount"];
+    }
+    _accumulatedTime = [aDecoder decodeDoubleForKey:@"accumulatedTime"];
+    _interpolatesNode = [aDecoder decodeBoolForKey:@"interpolatesNode"];
+    _defersIdleUpdates = [aDecoder decodeBoolForKey:@"defersIdleUpdates"];
+    _offscreen = [aDecoder decodeBoolForKey:@"offscreen"];
+    _offscreenUpdateInterval = [aDecoder decodeDoubleForKey:@"offscreenUpdateInterval"];
+    _offscreenTime = [aDecoder decodeDoubleForKey:@"offscreenTime"];
   }
   return self;
 }
 
 - (void)encodeWithCoder:(NSCoder *)aCoder
 {
-  [aCoder encodeObject:_actions forKey:@"actions"];
+  [self HL_catchUp];
+  // note: Descriptors are encoded as equivalent actions, but are left running as
+  // descriptors in the receiver.
+  NSMutableDictionary *actions = [NSMutableDictionary dictionaryWithCapacity:_actionCount];
+  for (NSUInteger e = 0; e < _entryCount; ++e) {
+    if (_entries[e].action) {
+      actions[(__bridge NSString *)_entries[e].key] = (__bridge HLAction *)_entries[e].action;
+    } else if (_entries[e].descriptor) {
+      actions[(__bridge NSString *)_entries[e].key] = HLActionDescriptorCreateAction(_entries[e].descriptor);
+    }
+  }
+  [aCoder encodeObject:actions forKey:@"actions"];
+  if (_fixedTimeStep > 0.0) {
+    [aCoder encodeDouble:_fixedTimeStep forKey:@"fixedTimeStep"];
+    [aCoder encodeInteger:(NSInteger)_maximumStepCount forKey:@"maximumStepCount"];
+    [aCoder encodeDouble:_accumulatedTime forKey:@"accumulatedTime"];
+    [aCoder encodeBool:_interpolatesNode forKey:@"interpolatesNode"];
+  }
+  if (_defersIdleUpdates) {
+    [aCoder encodeBool:_defersIdleUpdates forKey:@"defersIdleUpdates"];
+  }
+  if (_offscreen || _offscreenTime > 0.0) {
+    [aCoder encodeBool:_offscreen forKey:@"offscreen"];
+    [aCoder encodeDouble:_offscreenUpdateInterval forKey:@"offscreenUpdateInterval"];
+    [aCoder encodeDouble:_offscreenTime forKey:@"offscreenTime"];
+  }
 }
 
 - (instancetype)copyWithZone:(NSZone *)zone
 {
+  [self HL_catchUp];
   HLActionRunner *copy = [[[self class] allocWithZone:zone] init];
   if (copy) {
-    copy->_actions = [[NSMutableDictionary alloc] initWithDictionary:_actions copyItems:YES];
-    // note: Array is not mutable, so should be okay to share.
-    copy->_keys = _keys;
+    // note: Descriptors are copied as equivalent actions, but are left running as
+    // descriptors in the receiver.
+    for (NSUInteger e = 0; e < _entryCount; ++e) {
+      if (_entries[e].action) {
+        [copy HL_appendEntryWithKey:(__bridge NSString *)_entries[e].key
+                             action:[(__bridge HLAction *)_entries[e].action copy]
+                         descriptor:NULL];
+      } else if (_entries[e].descriptor) {
+        [copy HL_appendEntryWithKey:(__bridge NSString *)_entries[e].key
+                             action:HLActionDescriptorCreateAction(_entries[e].descriptor)
+                         descriptor:NULL];
+      }
+    }
+    copy->_fixedTimeStep = _fixedTimeStep;
+    copy->_maximumStepCount = _maximumStepCount;
+    copy->_accumulatedTime = _accumulatedTime;
+    copy->_interpolatesNode = _interpolatesNode;
+    copy->_defersIdleUpdates = _defersIdleUpdates;
+    copy->_offscreen = _offscreen;
+    copy->_offscreenUpdateInterval = _offscreenUpdateInterval;
+    copy->_offscreenTime = _offscreenTime;
   }
   return copy;
 }
 
+- (void)dealloc
+{
+  for (NSUInteger e = 0; e < _entryCount; ++e) {
+    CFRelease(_entries[e].key);
+    if (_entries[e].action) {
+      CFRelease(_entries[e].action);
+    } else if (_entries[e].descriptor) {
+      HLActionDescriptorEndRunning(_entries[e].descriptor);
+    }
+  }
+  if (_entries != _inlineEntries) {
+    free(_entries);
+  }
+}
+
 - (void)update:(NSTimeInterval)incrementalTime node:(SKNode *)node speed:(CGFloat)speed
 {
   // note: If we returned extraTime, like HL_update does, we would have to divide by
@@ -129,31 +730,187 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
 }
 
 - (void)update:(NSTimeInterval)incrementalTime node:(SKNode *)node
+{
+  if (incrementalTime < 0.0) {
+    incrementalTime = 0.0;
+  }
+  if (_registryParked) {
+    [_registry HL_unparkRunner:self];
+  }
+  // note: Offscreen time is delivered in one update, which (thanks to extra time) is
+  // equivalent to many small updates for most actions; see offscreen.
+  if (_offscreen) {
+    NSTimeInterval offscreenTime = _offscreenTime + incrementalTime;
+    if (_offscreenUpdateInterval <= 0.0 || offscreenTime < _offscreenUpdateInterval) {
+      _offscreenTime = offscreenTime;
+      return;
+    }
+    incrementalTime = offscreenTime;
+    _offscreenTime = 0.0;
+  } else if (_offscreenTime > 0.0) {
+    incrementalTime += _offscreenTime;
+    _offscreenTime = 0.0;
+  }
+  if (_fixedTimeStep > 0.0) {
+    [self HL_updateFixed:incrementalTime node:node];
+  } else {
+    [self HL_step:incrementalTime node:node];
+  }
+}
+
+- (void)setFixedTimeStep:(NSTimeInterval)fixedTimeStep
+{
+  _fixedTimeStep = (fixedTimeStep > 0.0 ? fixedTimeStep : 0.0);
+}
+
+- (void)setOffscreenUpdateInterval:(NSTimeInterval)offscreenUpdateInterval
+{
+  _offscreenUpdateInterval = (offscreenUpdateInterval > 0.0 ? offscreenUpdateInterval : 0.0);
+}
+
+- (void)setOffscreenTime:(NSTimeInterval)offscreenTime
+{
+  _offscreenTime = (offscreenTime > 0.0 ? offscreenTime : 0.0);
+}
+
+- (void)setInterpolatesNode:(BOOL)interpolatesNode
+{
+  // note: The rendered state (if any) is left on the node; the simulated state is forgotten.
+  _interpolatesNode = interpolatesNode;
+  _hasPreviousNodeState = NO;
+  _hasRenderedNodeState = NO;
+}
+
+- (void)HL_updateFixed:(NSTimeInterval)incrementalTime node:(SKNode *)node
+{
+  BOOL interpolates = (_interpolatesNode && node);
+
+  // note: Restore the simulated node state before stepping, so that actions see only the
+  // results of previous steps (plus any outside changes), and never the interpolation.
+  if (_hasRenderedNodeState) {
+    SKNode *renderedNode = _renderedNode;
+    if (renderedNode) {
+      HLActionRunnerNodeState nodeState = HLActionRunnerNodeStateGet(renderedNode);
+      HLActionRunnerNodeState restoredState;
+      restoredState.position.x = HLActionRunnerRestoreValue(nodeState.position.x, _renderedNodeState.position.x, _simulatedNodeState.position.x);
+      restoredState.position.y = HLActionRunnerRestoreValue(nodeState.position.y, _renderedNodeState.position.y, _simulatedNodeState.position.y);
+      restoredState.zRotation = HLActionRunnerRestoreValue(nodeState.zRotation, _renderedNodeState.zRotation, _simulatedNodeState.zRotation);
+      restoredState.xScale = HLActionRunnerRestoreValue(nodeState.xScale, _renderedNodeState.xScale, _simulatedNodeState.xScale);
+      restoredState.yScale = HLActionRunnerRestoreValue(nodeState.yScale, _renderedNodeState.yScale, _simulatedNodeState.yScale);
+      restoredState.alpha = HLActionRunnerRestoreValue(nodeState.alpha, _renderedNodeState.alpha, _simulatedNodeState.alpha);
+      HLActionRunnerNodeStateSet(renderedNode, restoredState);
+    }
+    _hasRenderedNodeState = NO;
+    _renderedNode = nil;
+  }
+
+  _accumulatedTime += incrementalTime;
+
+  // note: Compare against the step, rather than subtracting until less than zero, so that the
+  // number of steps depends only on the accumulated time (and not on floating point error
+  // in some other calculation).
+  NSUInteger stepCount = 0;
+  while (_accumulatedTime >= _fixedTimeStep) {
+    if (_maximumStepCount > 0 && stepCount == _maximumStepCount) {
+      _accumulatedTime = fmod(_accumulatedTime, _fixedTimeStep);
+      break;
+    }
+    if (interpolates) {
+      _previousNodeState = HLActionRunnerNodeStateGet(node);
+      _hasPreviousNodeState = YES;
+    }
+    [self HL_step:_fixedTimeStep node:node];
+    _accumulatedTime -= _fixedTimeStep;
+    ++stepCount;
+  }
+
+  // note: With no steps yet run, there is nothing to interpolate from.  And with no actions
+  // remaining, there might not be another update to restore the simulated state, so leave
+  // the node as simulated.
+  if (!interpolates || !_hasPreviousNodeState) {
+    return;
+  }
+  if (_actionCount == 0) {
+    _hasPreviousNodeState = NO;
+    return;
+  }
+  _simulatedNodeState = HLActionRunnerNodeStateGet(node);
+  CGFloat alpha = (CGFloat)(_accumulatedTime / _fixedTimeStep);
+  HLActionRunnerNodeState renderedState;
+  renderedState.position.x = HLActionRunnerInterpolateValue(_previousNodeState.position.x, _simulatedNodeState.position.x, alpha);
+  renderedState.position.y = HLActionRunnerInterpolateValue(_previousNodeState.position.y, _simulatedNodeState.position.y, alpha);
+  renderedState.zRotation = HLActionRunnerInterpolateValue(_previousNodeState.zRotation, _simulatedNodeState.zRotation, alpha);
+  renderedState.xScale = HLActionRunnerInterpolateValue(_previousNodeState.xScale, _simulatedNodeState.xScale, alpha);
+  renderedState.yScale = HLActionRunnerInterpolateValue(_previousNodeState.yScale, _simulatedNodeState.yScale, alpha);
+  renderedState.alpha = HLActionRunnerInterpolateValue(_previousNodeState.alpha, _simulatedNodeState.alpha, alpha);
+  HLActionRunnerNodeStateSet(node, renderedState);
+  // note: Read back what the node actually stored, so that the comparison on restore is
+  // exact even if the node's setters adjust values.
+  _renderedNodeState = HLActionRunnerNodeStateGet(node);
+  _hasRenderedNodeState = YES;
+  _renderedNode = node;
+}
+
+- (void)setDefersIdleUpdates:(BOOL)defersIdleUpdates
+{
+  if (!defersIdleUpdates) {
+    [self HL_catchUp];
+  }
+  _defersIdleUpdates = defersIdleUpdates;
+}
+
+- (void)HL_step:(NSTimeInterval)incrementalTime node:(SKNode *)node
+{
+  // note: While all actions are idle, the incremental time is accumulated rather than
+  // passed to the actions.  When the idle time is reached, the actions get all of it at
+  // once, and so extra time carries into the following actions exactly as if they had
+  // been updated every time.
+  NSTimeInterval pendingTime = _pendingTime + incrementalTime;
+  if (pendingTime < _idleTime) {
+    _pendingTime = pendingTime;
+    return;
+  }
+  _pendingTime = 0.0;
+  [self HL_updateEntries:pendingTime node:node];
+}
+
+- (void)HL_catchUp
+{
+  // note: Brings deferred time up to date, so that the actions are as they would be if
+  // they had been updated every time.  Since deferred time never reaches the idle time of
+  // the actions, the actions don't need a node.
+  if (_registryParked) {
+    [_registry HL_unparkRunner:self];
+  }
+  if (_pendingTime > 0.0) {
+    NSTimeInterval pendingTime = _pendingTime;
+    _pendingTime = 0.0;
+    [self HL_updateEntries:pendingTime node:nil];
+  }
+  _idleTime = 0.0;
+}
+
+- (void)HL_updateEntries:(NSTimeInterval)incrementalTime node:(SKNode *)node
 {
   // note: See note in [HLAction update] for handling action completion and removal.  In
   // short, an action must be allowed a final update call regardless of its elapsed time
   // and duration; it's only completed when its update returns NO.
 
   // note: It might be possible to support reverse time, but the current implementation
-  // does not.  It still makes sense to perform the update, though, since any update
-  // can trigger a zero-duration action.
-  if (incrementalTime < 0.0) {
-    incrementalTime = 0.0;
-  }
+  // does not (and incremental time is clamped by the caller).  It still makes sense to
+  // perform the update, though, since any update can trigger a zero-duration action.
 
   // note: Actions can execute arbitrary code, which, among other things, can add or
-  // remove actions to _actions.  Considerations:
+  // remove actions to this runner.  Considerations:
   //
-  // - One general approach would be to queue up mutations to _actions while update
+  // - One general approach would be to queue up mutations to the actions while update
   //   is looping, and then apply those mutations after the loop.  I think there's
   //   usability argument against this: It would be possible for an action to be
   //   updated after it was removed or replaced.  So instead the general approach
-  //   must be to allow mutations to _actions even while looping over them in update.
+  //   must be to allow mutations to the actions even while looping over them in update.
   //   The remainder of the considerations assume this.
   //
-  // - Fast enumeration of _actions is disallowed when it might mutate.  Fine.
-  //
-  // - In a loop through _actions in update, the current action might add or replace
+  // - In a loop through the actions in update, the current action might add or replace
   //   an action.  It seems best to try to be consistent about whether a new action
   //   is updated in this tick or not, although there are a number of cases:
   //
@@ -174,7 +931,7 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   //   just follow the natural course in each case.  (Someday maybe figure out what
   //   SKAction does, and immitate it.)
   //
-  // - In a loop through _actions in update, the current action might remove an
+  // - In a loop through the actions in update, the current action might remove an
   //   action.  It seems important that the removed action is not updated again,
   //   even in this tick, or else the user might (for instance) get a callback from
   //   an action that is supposed to not exist.
@@ -182,51 +939,79 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   // - If the currently-updating action removes or replaces itself, make sure to
   //   retain the currently running action in the loop so it can finish updating.
   //
-  // - When an action completes, it must be removed from _actions, but keep in mind
-  //   that other actions updating in this tick might add a new action with the same
-  //   key.  For that reason, delaying the removal to the end of the update loop
-  //   causes troubles.
+  // - When an action completes, it must be removed, but keep in mind that other actions
+  //   updating in this tick might add a new action with the same key.  For that reason,
+  //   delaying the removal to the end of the update loop causes troubles.
   //
   // - Combining those last two into a corner case: The currently-updating action
   //   might complete on this tick, and, as part of its final update, replace itself.
   //   Don't remove the replacement!
   //
-  // - An easy solution is to copy [_actions allKeys] to a local NSArray variable on every
-  //   update, iterating through the array and accessing into the dictionary.  This works
-  //   great, but shows up unpleasantly on CPU usage graphs when there are lots of action
-  //   runners (usually, lots of nodes, each of which has an action runner via
-  //   SKNode+HLAction).  Can maintain an indepedent NSArray or NSMutableArray which only
-  //   changes when actions are added or removed.  This also suggests the possiblity of
-  //   keeping actions in a parallel array rather than a dictionary -- the number of
-  //   actions per runner will typically be low, so linear operations on arrays might
-  //   prove faster than NSDictionaries.
-
-  // note: Deliberately copy the reference to a local variable, in case _keys is updated
-  // during the update -- the local keys will not be updated.
-  NSArray *keys = _keys;
-
-  for (NSString *key in keys) {
-    HLAction *action = _actions[key];
-    // note: The key might have been removed by a previously-updated action.
-    if (!action) {
+  // - Originally actions were kept in an NSMutableDictionary, and the update looped over
+  //   a copy of [_actions allKeys].  This works great, but shows up unpleasantly on CPU
+  //   usage graphs when there are lots of action runners (usually, lots of nodes, each of
+  //   which has an action runner via SKNode+HLAction).  Now the actions are kept in a
+  //   small array (typically inline in the runner), and the update loops by index over
+  //   the entries present at the start of the update.  New keys are appended (and so not
+  //   updated, case 1); replacements are made in place (and so updated only if not yet
+  //   reached, cases 2 through 4); removals leave an empty entry in place (and so are not
+  //   updated) which is compacted away after the loop.  The steady-state update makes no
+  //   allocations.
+
+  ++_updateDepth;
+
+  NSUInteger entryCount = _entryCount;
+  for (NSUInteger e = 0; e < entryCount; ++e) {
+    // note: Always index into _entries freshly: The array might be reallocated by actions
+    // added during an update.
+    void *actionPointer = _entries[e].action;
+    // note: The entry might have been removed by a previously-updated action.
+    if (!actionPointer) {
+      HLActionDescriptor *descriptor = _entries[e].descriptor;
+      if (descriptor) {
+        // note: Strong local reference keeps the descriptor's memory valid in case it is
+        // removed (by a node subclass, say, from removeFromParent).
+        NS_VALID_UNTIL_END_OF_SCOPE HLActionArena *arena = HLActionDescriptorArena(descriptor);
+        if (!HLActionDescriptorUpdate(descriptor, incrementalTime, node) && _entries[e].descriptor == descriptor) {
+          [self HL_removeEntryAtIndex:e];
+        }
+      }
       continue;
     }
-    // note: As mentioned above, the action fetched by the key might not be the
-    // exact action we had in mind at the beginning of this update; it might
-    // instead be a replacement set by some action earlier in the loop.  But for
-    // now we choose not to care (even though that seems like inconsistent treatment
-    // of newly-added actions).
+    // note: Strong local reference retains the action in case it removes itself.
+    HLAction *action = (__bridge HLAction *)actionPointer;
     NSTimeInterval extraTime;
-    if (![action HL_update:incrementalTime node:node extraTime:&extraTime]) {
+    if (!HLActionUpdate(action, incrementalTime, node, &extraTime, (__bridge NSString *)_entries[e].key)) {
       // note: The action might have replaced itself before completing.
-      if (action == _actions[key]) {
-        [_actions removeObjectForKey:key];
-        // note: Update the entire keys array on every change to _actions.  It's possible
-        // that a smarter update of an NSMutableArray would be faster, but I'm willing to
-        // bet the dumb way does quite well.
-        _keys = [_actions allKeys];
+      if (_entries[e].action == actionPointer) {
+        [self HL_removeEntryAtIndex:e];
+      }
+    }
+  }
+
+  --_updateDepth;
+  if (_updateDepth == 0 && _hasRemovedEntries) {
+    [self HL_compactEntries];
+  }
+
+  // note: Idle time is only measured after a complete update (and not during a nested
+  // one); actions added since are accounted for, since they are in the entries.
+  _idleTime = 0.0;
+  if (_defersIdleUpdates && _updateDepth == 0 && _actionCount > 0) {
+    NSTimeInterval idleTime = INFINITY;
+    for (NSUInteger e = 0; e < _entryCount && idleTime > 0.0; ++e) {
+      // note: Descriptors (with a NULL action) are never idle.
+      NSTimeInterval actionIdleTime = [(__bridge HLAction *)_entries[e].action HL_idleTime];
+      if (actionIdleTime < idleTime) {
+        idleTime = actionIdleTime;
       }
     }
+    // note: Idle times are computed with floating point error, and waking a little early
+    // is harmless (the actions just advance time), while waking late is not.
+    if (isfinite(idleTime)) {
+      idleTime -= idleTime * HLActionRunnerIdleTimeTolerance;
+    }
+    _idleTime = idleTime;
   }
 }
 
@@ -254,21 +1039,71 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   if (!key) {
     [NSException raise:@"HLActionMissingKey" format:@"Action cannot be run without a key."];
   }
-  _actions[key] = action;
-  // note: Update the entire keys array on every change to _actions.  It's possible that a
-  // smarter update of an NSMutableArray would be faster, but I'm willing to bet the dumb
-  // way does quite well.
-  _keys = [_actions allKeys];
+  [self HL_catchUp];
+  if (!action) {
+    [self removeActionForKey:key];
+    return;
+  }
+  [self HL_setEntryWithKey:key action:action descriptor:NULL];
+}
+
+- (void)runActionDescriptor:(HLActionDescriptor *)descriptor withKey:(NSString *)key
+{
+  if (!key) {
+    [NSException raise:@"HLActionMissingKey" format:@"Action cannot be run without a key."];
+  }
+  [self HL_catchUp];
+  if (!descriptor) {
+    [self removeActionForKey:key];
+    return;
+  }
+  HLActionDescriptorBeginRunning(descriptor);
+  [self HL_setEntryWithKey:key action:nil descriptor:descriptor];
+}
+
+- (void)HL_setEntryWithKey:(NSString *)key action:(HLAction *)action descriptor:(HLActionDescriptor *)descriptor
+{
+  NSUInteger e = [self HL_indexOfEntryWithKey:key];
+  if (e == NSNotFound) {
+    [self HL_appendEntryWithKey:key action:action descriptor:descriptor];
+    return;
+  }
+  // note: Replace in place, even if the entry was removed earlier in this update; see
+  // notes in update:node:.
+  void *oldActionPointer = _entries[e].action;
+  HLActionDescriptor *oldDescriptor = _entries[e].descriptor;
+  _entries[e].action = (action ? (void *)CFBridgingRetain(action) : NULL);
+  _entries[e].descriptor = descriptor;
+  if (oldActionPointer) {
+    CFRelease(oldActionPointer);
+  } else if (oldDescriptor) {
+    HLActionDescriptorEndRunning(oldDescriptor);
+  } else {
+    ++_actionCount;
+    if (_actionCount == 1) {
+      [self HL_didGainActions];
+    }
+  }
 }
 
 - (BOOL)hasActions
 {
-  return [_actions count] > 0;
+  return _actionCount > 0;
 }
 
 - (HLAction *)actionForKey:(NSString *)key
 {
-  return _actions[key];
+  if (!key) {
+    return nil;
+  }
+  // note: The caller might inspect the action's elapsed time, or change its speed.
+  [self HL_catchUp];
+  NSUInteger e = [self HL_indexOfEntryWithKey:key];
+  if (e == NSNotFound) {
+    return nil;
+  }
+  [self HL_convertDescriptorAtIndex:e];
+  return (__bridge HLAction *)_entries[e].action;
 }
 
 - (void)removeActionForKey:(NSString *)key
@@ -276,17 +1111,827 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   if (!key) {
     return;
   }
-  [_actions removeObjectForKey:key];
-  _keys = [_actions allKeys];
+  [self HL_catchUp];
+  NSUInteger e = [self HL_indexOfEntryWithKey:key];
+  if (e == NSNotFound || !HLActionRunnerEntryIsRunning(&_entries[e])) {
+    return;
+  }
+  [self HL_removeEntryAtIndex:e];
 }
 
 - (void)removeAllActions
 {
-  [_actions removeAllObjects];
-  _keys = nil;
+  [self HL_catchUp];
+  for (NSUInteger e = 0; e < _entryCount; ++e) {
+    if (_entries[e].action) {
+      CFRelease(_entries[e].action);
+      _entries[e].action = NULL;
+    } else if (_entries[e].descriptor) {
+      HLActionDescriptorEndRunning(_entries[e].descriptor);
+      _entries[e].descriptor = NULL;
+    }
+  }
+  if (_actionCount > 0) {
+    _actionCount = 0;
+    [self HL_didLoseActions];
+  }
+  _hasRemovedEntries = YES;
+  if (_updateDepth == 0) {
+    [self HL_compactEntries];
+  }
 }
 
-@end
+- (HLActionRunnerRegistry *)registry
+{
+  return _registry;
+}
+
+- (void)setRegistry:(HLActionRunnerRegistry *)registry node:(SKNode *)node
+{
+  [self HL_catchUp];
+  HLActionRunnerRegistry *oldRegistry = _registry;
+  if (oldRegistry && _registryIndex != NSNotFound) {
+    [oldRegistry HL_removeRunner:self];
+  }
+  _registry = registry;
+  _registryNode = node;
+  _registryHasNode = (node != nil);
+  _registryRequiresScene = (node.scene != nil);
+  if (registry && _actionCount > 0) {
+    [registry HL_addRunner:self];
+  }
+}
+
+- (void)HL_didGainActions
+{
+  if (_registryIndex == NSNotFound) {
+    HLActionRunnerRegistry *registry = _registry;
+    if (registry) {
+      [registry HL_addRunner:self];
+    }
+  }
+}
+
+- (void)HL_didLoseActions
+{
+  if (_registryIndex != NSNotFound) {
+    HLActionRunnerRegistry *registry = _registry;
+    if (registry) {
+      [registry HL_removeRunner:self];
+    }
+  }
+}
+
+- (NSUInteger)HL_indexOfEntryWithKey:(NSString *)key
+{
+  // note: Keys are usually string constants, so look for pointer equality first.
+  void *keyPointer = (__bridge void *)key;
+  for (NSUInteger e = 0; e < _entryCount; ++e) {
+    if (_entries[e].key == keyPointer) {
+      return e;
+    }
+  }
+  for (NSUInteger e = 0; e < _entryCount; ++e) {
+    if ([(__bridge NSString *)_entries[e].key isEqualToString:key]) {
+      return e;
+    }
+  }
+  return NSNotFound;
+}
+
+- (void)HL_appendEntryWithKey:(NSString *)key action:(HLAction *)action descriptor:(HLActionDescriptor *)descriptor
+{
+  if (_entryCount == _entryCapacity) {
+    NSUInteger entryCapacity = _entryCapacity * 2;
+    HLActionRunnerEntry *entries;
+    if (_entries == _inlineEntries) {
+      entries = malloc(entryCapacity * sizeof(HLActionRunnerEntry));
+      if (entries) {
+        memcpy(entries, _inlineEntries, _entryCount * sizeof(HLActionRunnerEntry));
+      }
+    } else {
+      entries = realloc(_entries, entryCapacity * sizeof(HLActionRunnerEntry));
+    }
+    if (!entries) {
+      [NSException raise:NSMallocException format:@"HLActionRunner could not allocate storage for %lu actions.", (unsigned long)entryCapacity];
+    }
+    _entries = entries;
+    _entryCapacity = entryCapacity;
+    if (HLActionInstrumentationEnabledFlag) {
+      HLActionInstrumentationRecordAllocation(Nil, key);
+    }
+  }
+  _entries[_entryCount].key = (void *)CFBridgingRetain([key copy]);
+  _entries[_entryCount].action = (action ? (void *)CFBridgingRetain(action) : NULL);
+  _entries[_entryCount].descriptor = descriptor;
+  ++_entryCount;
+  ++_actionCount;
+  if (_actionCount == 1) {
+    [self HL_didGainActions];
+  }
+}
+
+- (void)HL_removeEntryAtIndex:(NSUInteger)e
+{
+  void *actionPointer = _entries[e].action;
+  HLActionDescriptor *descriptor = _entries[e].descriptor;
+  _entries[e].action = NULL;
+  _entries[e].descriptor = NULL;
+  --_actionCount;
+  if (_actionCount == 0) {
+    [self HL_didLoseActions];
+  }
+  if (_updateDepth > 0) {
+    // note: Leave the entry (with its key) in place while updating, so that indexes of
+    // entries not yet updated don't change.
+    _hasRemovedEntries = YES;
+  } else {
+    CFRelease(_entries[e].key);
+    memmove(&_entries[e], &_entries[e + 1], (_entryCount - e - 1) * sizeof(HLActionRunnerEntry));
+    --_entryCount;
+  }
+  if (actionPointer) {
+    CFRelease(actionPointer);
+  } else {
+    HLActionDescriptorEndRunning(descriptor);
+  }
+}
+
+- (void)HL_convertDescriptorAtIndex:(NSUInteger)e
+{
+  // note: Replaces a descriptor with an equivalent action (in the same state), for callers
+  // who need the object API.
+  HLActionDescriptor *descriptor = _entries[e].descriptor;
+  if (!descriptor) {
+    return;
+  }
+  HLAction *action = HLActionDescriptorCreateAction(descriptor);
+  _entries[e].action = (void *)CFBridgingRetain(action);
+  _entries[e].descriptor = NULL;
+  HLActionDescriptorEndRunning(descriptor);
+}
+
+- (void)HL_compactEntries
+{
+  NSUInteger entryCount = 0;
+  for (NSUInteger e = 0; e < _entryCount; ++e) {
+    if (HLActionRunnerEntryIsRunning(&_entries[e])) {
+      _entries[entryCount] = _entries[e];
+      ++entryCount;
+    } else {
+      CFRelease(_entries[e].key);
+    }
+  }
+  _entryCount = entryCount;
+  _hasRemovedEntries = NO;
+}
+
+@end
+
+@implementation HLActionRunnerRegistry
+{
+  // note: Runners are retained manually (with CFBridgingRetain) so that the array can be a
+  // plain C array; a removed runner leaves a NULL entry while updating, compacted after.
+  void **_runners;
+  NSUInteger _runnerSlotCount;
+  NSUInteger _runnerCapacity;
+  NSUInteger _runnerCount;
+  NSUInteger _updateDepth;
+  BOOL _hasRemovedRunners;
+  // note: Parked runners; see HL_parkRunner:deadlineTick:speed:.  The time is the sum of
+  // all incremental times passed to updateAllRunners:, and the tick is the last tick of
+  // the timer wheel processed.
+  NSTimeInterval _time;
+  uint64_t _wheelTick;
+  void *_wheelLists[HLActionRunnerRegistryWheelListCount];
+  NSUInteger _parkedCount;
+  void **_wakingRunners;
+  NSUInteger _wakingCapacity;
+  // note: Callbacks deferred during the current update; see defersCallbacks.  The buffer
+  // is kept between updates, so that steady-state updates make no allocations.
+  HLActionCallback *_deferredCallbacks;
+  NSUInteger _deferredCallbackCount;
+  NSUInteger _deferredCallbackCapacity;
+  BOOL _isFlushingCallbacks;
+}
+
+- (instancetype)init
+{
+  self = [super init];
+  if (self) {
+    _runners = NULL;
+    _runnerSlotCount = 0;
+    _runnerCapacity = 0;
+    _runnerCount = 0;
+    _updateDepth = 0;
+    _hasRemovedRunners = NO;
+    _time = 0.0;
+    _wheelTick = 0;
+    memset(_wheelLists, 0, sizeof(_wheelLists));
+    _parkedCount = 0;
+    _wakingRunners = NULL;
+    _wakingCapacity = 0;
+    _enrollsRunnersAutomatically = NO;
+    _defersCallbacks = NO;
+    _deferredCallbacks = NULL;
+    _deferredCallbackCount = 0;
+    _deferredCallbackCapacity = 0;
+    _isFlushingCallbacks = NO;
+    _commandQueue = [[HLActionCommandQueue alloc] init];
+  }
+  return self;
+}
+
+- (void)dealloc
+{
+  for (NSUInteger r = 0; r < _runnerSlotCount; ++r) {
+    if (_runners[r]) {
+      HLActionRunner *runner = (__bridge HLActionRunner *)_runners[r];
+      runner->_registryIndex = NSNotFound;
+      CFRelease(_runners[r]);
+    }
+  }
+  free(_runners);
+  // note: Parked runners keep their deferred time; their next update or catch-up delivers
+  // it.
+  for (NSUInteger l = 0; l < HLActionRunnerRegistryWheelListCount; ++l) {
+    void *runnerPointer = _wheelLists[l];
+    while (runnerPointer) {
+      HLActionRunner *runner = (__bridge HLActionRunner *)runnerPointer;
+      void *nextRunnerPointer = runner->_registryWheelNext;
+      runner->_registryParked = NO;
+      runner->_registryWheelList = NSNotFound;
+      runner->_pendingTime += (_time - runner->_registryParkedTime) * runner->_registryParkedSpeed;
+      CFRelease(runnerPointer);
+      runnerPointer = nextRunnerPointer;
+    }
+  }
+  free(_wakingRunners);
+  // note: Callbacks are only left over if an update was interrupted by an exception.
+  for (NSUInteger c = 0; c < _deferredCallbackCount; ++c) {
+    HLActionReleaseCallback(&_deferredCallbacks[c]);
+  }
+  free(_deferredCallbacks);
+}
+
+- (NSUInteger)runnerCount
+{
+  return _runnerCount + _parkedCount;
+}
+
+- (void)updateAllRunners:(NSTimeInterval)incrementalTime
+{
+  if (incrementalTime < 0.0) {
+    incrementalTime = 0.0;
+  }
+
+  // note: Commands are applied before the update begins, so that runners joining the
+  // registry because of them are updated this time.
+  [_commandQueue drain];
+
+  ++_updateDepth;
+  HLActionRunnerRegistry *deferringRegistry = HLActionCallbackDeferringRegistry;
+  HLActionCallbackDeferringRegistry = (_defersCallbacks ? self : nil);
+
+  // note: If a runner raises an exception, the registry is still restored, so that later
+  // callbacks are not deferred into it and later updates still compact and flush.
+  // Callbacks deferred before the exception are kept, and made after the next update.
+  @try {
+    // note: Runners added during the update are appended, and so not updated until next
+    // time; runners removed during the update leave a NULL entry, and so are not updated.
+    // Runners woken from the timer wheel are appended, too, but they are brought up to
+    // date (including this update) when they wake.
+    NSUInteger runnerSlotCount = _runnerSlotCount;
+    _time += incrementalTime;
+    [self HL_advanceWheel];
+
+    for (NSUInteger r = 0; r < runnerSlotCount; ++r) {
+      void *runnerPointer = _runners[r];
+      if (!runnerPointer) {
+        continue;
+      }
+      // note: Strong local reference retains the runner in case it leaves the registry.
+      HLActionRunner *runner = (__bridge HLActionRunner *)runnerPointer;
+      CGFloat speed = 1.0f;
+      if (runner->_registryHasNode) {
+        SKNode *node = runner->_registryNode;
+        if (!node) {
+          [self HL_removeRunner:runner];
+          continue;
+        }
+        if (runner->_registryRequiresScene && !node.scene) {
+          [self HL_dropRunner:runner];
+          continue;
+        }
+        speed = node.speed;
+        [runner update:incrementalTime node:node speed:speed];
+      } else {
+        [runner update:incrementalTime node:nil];
+      }
+      // note: Park runners which will be idle for at least a couple of ticks.  Time
+      // accumulated toward a fixed time step or while offscreen counts toward the idle
+      // time, too.
+      if (runner->_registryIndex == r && speed > 0.0f && runner.defersIdleUpdates) {
+        NSTimeInterval idleTime = (runner->_idleTime - runner->_pendingTime - runner.accumulatedTime - runner.offscreenTime) / speed;
+        if (idleTime >= 2.0 * HLActionRunnerRegistryWheelTick && isfinite(idleTime)) {
+          [self HL_parkRunner:runner deadlineTick:(uint64_t)((_time + idleTime) / HLActionRunnerRegistryWheelTick) speed:speed];
+        }
+      }
+    }
+  } @finally {
+    HLActionCallbackDeferringRegistry = deferringRegistry;
+    --_updateDepth;
+    if (_updateDepth == 0 && _hasRemovedRunners) {
+      [self HL_compactRunners];
+    }
+  }
+
+  if (_updateDepth == 0 && _deferredCallbackCount > 0) {
+    [self HL_flushCallbacks];
+  }
+}
+
+- (void)HL_deferCallback:(const HLActionCallback *)callback
+{
+  if (_deferredCallbackCount == _deferredCallbackCapacity) {
+    NSUInteger deferredCallbackCapacity = (_deferredCallbackCapacity > 0 ? _deferredCallbackCapacity * 2 : 16);
+    HLActionCallback *deferredCallbacks = realloc(_deferredCallbacks, deferredCallbackCapacity * sizeof(HLActionCallback));
+    if (!deferredCallbacks) {
+      [NSException raise:NSMallocException format:@"HLActionRunnerRegistry could not allocate storage for %lu callbacks.", (unsigned long)deferredCallbackCapacity];
+    }
+    _deferredCallbacks = deferredCallbacks;
+    _deferredCallbackCapacity = deferredCallbackCapacity;
+  }
+  HLActionCallback *deferredCallback = &_deferredCallbacks[_deferredCallbackCount];
+  *deferredCallback = *callback;
+  CFRetain(deferredCallback->target);
+  if (deferredCallback->argument1) {
+    CFRetain(deferredCallback->argument1);
+  }
+  if (deferredCallback->argument2) {
+    CFRetain(deferredCallback->argument2);
+  }
+  ++_deferredCallbackCount;
+}
+
+- (void)HL_flushCallbacks
+{
+  // note: Callbacks may do anything, including updating this registry again.  Callbacks
+  // deferred by such an update are appended, and made by this loop in turn.
+  if (_isFlushingCallbacks) {
+    return;
+  }
+  _isFlushingCallbacks = YES;
+  NSUInteger c = 0;
+  @try {
+    while (c < _deferredCallbackCount) {
+      // note: Copy, since the buffer might be reallocated by the callback.
+      HLActionCallback callback = _deferredCallbacks[c];
+      HLActionInvokeCallback(&callback);
+      HLActionReleaseCallback(&callback);
+      ++c;
+    }
+  } @finally {
+    // note: If a callback throws, the remaining callbacks (including the one that threw)
+    // are dropped rather than made later, out of order with later updates.
+    for (NSUInteger r = c; r < _deferredCallbackCount; ++r) {
+      HLActionReleaseCallback(&_deferredCallbacks[r]);
+    }
+    _deferredCallbackCount = 0;
+    _isFlushingCallbacks = NO;
+  }
+}
+
+- (void)HL_parkRunner:(HLActionRunner *)runner deadlineTick:(uint64_t)deadlineTick speed:(CGFloat)speed
+{
+  // note: A parked runner is not updated at all until the timer wheel reaches its deadline
+  // tick (rounded down, so that it wakes no later than its idle time), or until something
+  // else needs it up to date (see [HLActionRunner HL_catchUp]).  When it wakes, it is
+  // updated with all the time since it was parked, at the speed it was parked with.
+  if (deadlineTick <= _wheelTick) {
+    return;
+  }
+  void *runnerPointer = (void *)CFBridgingRetain(runner);
+  [self HL_removeRunner:runner];
+  runner->_registryParked = YES;
+  runner->_registryParkedTime = _time;
+  runner->_registryParkedSpeed = speed;
+  runner->_registryWheelDeadline = deadlineTick;
+  [self HL_linkParkedRunner:runnerPointer];
+  ++_parkedCount;
+}
+
+- (void)HL_unparkRunner:(HLActionRunner *)runner
+{
+  if (!runner->_registryParked) {
+    return;
+  }
+  [self HL_unlinkParkedRunner:runner];
+  runner->_registryParked = NO;
+  --_parkedCount;
+  NSTimeInterval parkedTime = (_time - runner->_registryParkedTime) * runner->_registryParkedSpeed;
+  // note: Rejoin the runner array (which retains the runner), and then release the
+  // wheel's reference; the caller holds a strong reference.
+  [self HL_addRunner:runner];
+  CFRelease((__bridge void *)runner);
+  SKNode *node = nil;
+  if (runner->_registryHasNode) {
+    node = runner->_registryNode;
+    if (!node) {
+      [self HL_removeRunner:runner];
+      return;
+    }
+    if (runner->_registryRequiresScene && !node.scene) {
+      [self HL_dropRunner:runner];
+      return;
+    }
+  }
+  [runner update:parkedTime node:node];
+}
+
+- (void)HL_linkParkedRunner:(void *)runnerPointer
+{
+  HLActionRunner *runner = (__bridge HLActionRunner *)runnerPointer;
+  uint64_t deadlineTick = runner->_registryWheelDeadline;
+  uint64_t tick = _wheelTick;
+  NSUInteger list;
+  if (deadlineTick - tick < HLActionRunnerRegistryWheelLevelSize) {
+    list = (NSUInteger)(deadlineTick & HLActionRunnerRegistryWheelMask);
+  } else if ((deadlineTick >> HLActionRunnerRegistryWheelBits) - (tick >> HLActionRunnerRegistryWheelBits) < HLActionRunnerRegistryWheelLevelSize) {
+    list = HLActionRunnerRegistryWheelLevelSize + (NSUInteger)((deadlineTick >> HLActionRunnerRegistryWheelBits) & HLActionRunnerRegistryWheelMask);
+  } else if ((deadlineTick >> (2 * HLActionRunnerRegistryWheelBits)) - (tick >> (2 * HLActionRunnerRegistryWheelBits)) < HLActionRunnerRegistryWheelLevelSize) {
+    list = 2 * HLActionRunnerRegistryWheelLevelSize + (NSUInteger)((deadlineTick >> (2 * HLActionRunnerRegistryWheelBits)) & HLActionRunnerRegistryWheelMask);
+  } else {
+    list = HLActionRunnerRegistryWheelOverflowList;
+  }
+  runner->_registryWheelList = list;
+  runner->_registryWheelPrevious = NULL;
+  runner->_registryWheelNext = _wheelLists[list];
+  if (_wheelLists[list]) {
+    ((__bridge HLActionRunner *)_wheelLists[list])->_registryWheelPrevious = runnerPointer;
+  }
+  _wheelLists[list] = runnerPointer;
+}
+
+- (void)HL_unlinkParkedRunner:(HLActionRunner *)runner
+{
+  // note: Runners detached from their list (while waking) have no list.
+  NSUInteger list = runner->_registryWheelList;
+  if (list == NSNotFound) {
+    return;
+  }
+  void *previousPointer = runner->_registryWheelPrevious;
+  void *nextPointer = runner->_registryWheelNext;
+  if (previousPointer) {
+    ((__bridge HLActionRunner *)previousPointer)->_registryWheelNext = nextPointer;
+  } else {
+    _wheelLists[list] = nextPointer;
+  }
+  if (nextPointer) {
+    ((__bridge HLActionRunner *)nextPointer)->_registryWheelPrevious = previousPointer;
+  }
+  runner->_registryWheelList = NSNotFound;
+  runner->_registryWheelPrevious = NULL;
+  runner->_registryWheelNext = NULL;
+}
+
+- (void)HL_advanceWheel
+{
+  uint64_t targetTick = (uint64_t)(_time / HLActionRunnerRegistryWheelTick);
+  if (_parkedCount == 0) {
+    _wheelTick = targetTick;
+    return;
+  }
+  while (_wheelTick < targetTick) {
+    ++_wheelTick;
+    uint64_t tick = _wheelTick;
+    if ((tick & HLActionRunnerRegistryWheelMask) == 0) {
+      uint64_t block = tick >> HLActionRunnerRegistryWheelBits;
+      if ((block & HLActionRunnerRegistryWheelMask) == 0) {
+        uint64_t superblock = block >> HLActionRunnerRegistryWheelBits;
+        if ((superblock & HLActionRunnerRegistryWheelMask) == 0) {
+          [self HL_cascadeList:HLActionRunnerRegistryWheelOverflowList];
+        }
+        [self HL_cascadeList:(2 * HLActionRunnerRegistryWheelLevelSize + (NSUInteger)(superblock & HLActionRunnerRegistryWheelMask))];
+      }
+      [self HL_cascadeList:(HLActionRunnerRegistryWheelLevelSize + (NSUInteger)(block & HLActionRunnerRegistryWheelMask))];
+    }
+    [self HL_wakeList:(NSUInteger)(tick & HLActionRunnerRegistryWheelMask)];
+    if (_parkedCount == 0) {
+      _wheelTick = targetTick;
+    }
+  }
+}
+
+- (void)HL_cascadeList:(NSUInteger)list
+{
+  void *runnerPointer = _wheelLists[list];
+  _wheelLists[list] = NULL;
+  while (runnerPointer) {
+    HLActionRunner *runner = (__bridge HLActionRunner *)runnerPointer;
+    void *nextRunnerPointer = runner->_registryWheelNext;
+    [self HL_linkParkedRunner:runnerPointer];
+    runnerPointer = nextRunnerPointer;
+  }
+}
+
+- (void)HL_wakeList:(NSUInteger)list
+{
+  // note: Waking a runner updates it, which runs arbitrary code, which might park or
+  // unpark other runners.  So first detach the whole list, and then wake each runner
+  // (unless it was unparked in the meantime by somebody else).
+  NSUInteger wakingCount = 0;
+  void *runnerPointer = _wheelLists[list];
+  _wheelLists[list] = NULL;
+  while (runnerPointer) {
+    HLActionRunner *runner = (__bridge HLActionRunner *)runnerPointer;
+    if (wakingCount == _wakingCapacity) {
+      NSUInteger wakingCapacity = (_wakingCapacity > 0 ? _wakingCapacity * 2 : 64);
+      void **wakingRunners = realloc(_wakingRunners, wakingCapacity * sizeof(void *));
+      if (!wakingRunners) {
+        [NSException raise:NSMallocException format:@"HLActionRunnerRegistry could not allocate storage for %lu runners.", (unsigned long)wakingCapacity];
+      }
+      _wakingRunners = wakingRunners;
+      _wakingCapacity = wakingCapacity;
+    }
+    _wakingRunners[wakingCount] = runnerPointer;
+    ++wakingCount;
+    runnerPointer = runner->_registryWheelNext;
+    runner->_registryWheelList = NSNotFound;
+    runner->_registryWheelPrevious = NULL;
+    runner->_registryWheelNext = NULL;
+  }
+  for (NSUInteger w = 0; w < wakingCount; ++w) {
+    // note: Strong local reference retains the runner through unparking.
+    HLActionRunner *runner = (__bridge HLActionRunner *)_wakingRunners[w];
+    [self HL_unparkRunner:runner];
+  }
+}
+
+- (void)HL_addRunner:(HLActionRunner *)runner
+{
+  if (runner->_registryIndex != NSNotFound) {
+    return;
+  }
+  if (_runnerSlotCount == _runnerCapacity) {
+    NSUInteger runnerCapacity = (_runnerCapacity > 0 ? _runnerCapacity * 2 : 64);
+    void **runners = realloc(_runners, runnerCapacity * sizeof(void *));
+    if (!runners) {
+      [NSException raise:NSMallocException format:@"HLActionRunnerRegistry could not allocate storage for %lu runners.", (unsigned long)runnerCapacity];
+    }
+    _runners = runners;
+    _runnerCapacity = runnerCapacity;
+  }
+  _runners[_runnerSlotCount] = (void *)CFBridgingRetain(runner);
+  runner->_registryIndex = _runnerSlotCount;
+  ++_runnerSlotCount;
+  ++_runnerCount;
+}
+
+- (void)HL_removeRunner:(HLActionRunner *)runner
+{
+  NSUInteger r = runner->_registryIndex;
+  if (r == NSNotFound) {
+    return;
+  }
+  runner->_registryIndex = NSNotFound;
+  void *runnerPointer = _runners[r];
+  --_runnerCount;
+  if (_updateDepth > 0) {
+    _runners[r] = NULL;
+    _hasRemovedRunners = YES;
+  } else {
+    // note: Order doesn't matter outside of update, so fill the hole with the last runner.
+    --_runnerSlotCount;
+    if (r != _runnerSlotCount) {
+      _runners[r] = _runners[_runnerSlotCount];
+      ((__bridge HLActionRunner *)_runners[r])->_registryIndex = r;
+    }
+  }
+  CFRelease(runnerPointer);
+}
+
+- (void)HL_dropRunner:(HLActionRunner *)runner
+{
+  // note: Unlike HL_removeRunner:, also disassociates the runner from the registry, so that
+  // it does not rejoin when it next gains actions, and so that it rejoins (through
+  // hlRunAction:withKey:) if its node is returned to a scene.
+  [self HL_removeRunner:runner];
+  runner->_registry = nil;
+  runner->_registryNode = nil;
+  runner->_registryHasNode = NO;
+  runner->_registryRequiresScene = NO;
+}
+
+- (void)HL_compactRunners
+{
+  NSUInteger runnerSlotCount = 0;
+  for (NSUInteger r = 0; r < _runnerSlotCount; ++r) {
+    if (_runners[r]) {
+      _runners[runnerSlotCount] = _runners[r];
+      ((__bridge HLActionRunner *)_runners[r])->_registryIndex = runnerSlotCount;
+      ++runnerSlotCount;
+    }
+  }
+  _runnerSlotCount = runnerSlotCount;
+  _hasRemovedRunners = NO;
+}
+
+@end
+
+@interface HLActionStatistics ()
+{
+@package
+  NSUInteger _updateCount;
+  NSUInteger _completionCount;
+  NSUInteger _allocationCount;
+  NSTimeInterval _updateTime;
+}
+
+- (HLActionStatistics *)HL_snapshot;
+
+- (NSDictionary *)HL_JSONObject;
+
+@end
+
+@implementation HLActionStatistics
+
+- (HLActionStatistics *)HL_snapshot
+{
+  HLActionStatistics *snapshot = [[HLActionStatistics alloc] init];
+  snapshot->_updateCount = _updateCount;
+  snapshot->_completionCount = _completionCount;
+  snapshot->_allocationCount = _allocationCount;
+  snapshot->_updateTime = _updateTime;
+  return snapshot;
+}
+
+- (NSDictionary *)HL_JSONObject
+{
+  return @{ @"updateCount" : @(_updateCount),
+            @"completionCount" : @(_completionCount),
+            @"allocationCount" : @(_allocationCount),
+            @"updateTime" : @(_updateTime) };
+}
+
+- (NSString *)description
+{
+  return [NSString stringWithFormat:@"<%@ updates=%lu completions=%lu allocations=%lu time=%.6f>",
+          NSStringFromClass([self class]),
+          (unsigned long)_updateCount,
+          (unsigned long)_completionCount,
+          (unsigned long)_allocationCount,
+          _updateTime];
+}
+
+@end
+
+// note: Keyed by Class and by runner key, respectively.  Created on first use.
+static NSMutableDictionary *HLActionInstrumentationStatisticsByClass = nil;
+static NSMutableDictionary *HLActionInstrumentationStatisticsByKey = nil;
+
+static HLActionStatistics *
+HLActionInstrumentationStatistics(NSMutableDictionary * __strong *statisticsByKey, id<NSCopying> key)
+{
+  if (!*statisticsByKey) {
+    *statisticsByKey = [NSMutableDictionary dictionary];
+  }
+  HLActionStatistics *statistics = (*statisticsByKey)[key];
+  if (!statistics) {
+    statistics = [[HLActionStatistics alloc] init];
+    (*statisticsByKey)[key] = statistics;
+  }
+  return statistics;
+}
+
+static BOOL
+HLActionInstrumentedUpdate(HLAction *action, NSTimeInterval incrementalTime, SKNode *node, NSTimeInterval *extraTime, NSString *key)
+{
+  uint64_t startTime = clock_gettime_nsec_np(CLOCK_UPTIME_RAW);
+  BOOL notYetCompleted = [action HL_update:incrementalTime node:node extraTime:extraTime];
+  NSTimeInterval updateTime = (clock_gettime_nsec_np(CLOCK_UPTIME_RAW) - startTime) / 1.0e9;
+
+  // note: Nested updates are recorded before their container's, so the container's time is
+  // inclusive; the bookkeeping here is not included in anybody's time.
+  HLActionStatistics *classStatistics = HLActionInstrumentationStatistics(&HLActionInstrumentationStatisticsByClass, [action class]);
+  ++classStatistics->_updateCount;
+  classStatistics->_updateTime += updateTime;
+  if (!notYetCompleted) {
+    ++classStatistics->_completionCount;
+  }
+  if (key) {
+    HLActionStatistics *keyStatistics = HLActionInstrumentationStatistics(&HLActionInstrumentationStatisticsByKey, key);
+    ++keyStatistics->_updateCount;
+    keyStatistics->_updateTime += updateTime;
+    if (!notYetCompleted) {
+      ++keyStatistics->_completionCount;
+    }
+  }
+  return notYetCompleted;
+}
+
+static void
+HLActionInstrumentationRecordAllocation(Class actionClass, NSString *key)
+{
+  if (actionClass) {
+    ++HLActionInstrumentationStatistics(&HLActionInstrumentationStatisticsByClass, actionClass)->_allocationCount;
+  }
+  if (key) {
+    ++HLActionInstrumentationStatistics(&HLActionInstrumentationStatisticsByKey, [key copy])->_allocationCount;
+  }
+}
+
+@implementation HLActionInstrumentation
+
++ (void)setEnabled:(BOOL)enabled
+{
+  HLActionInstrumentationEnabledFlag = enabled;
+}
+
++ (BOOL)isEnabled
+{
+  return HLActionInstrumentationEnabledFlag;
+}
+
++ (void)reset
+{
+  HLActionInstrumentationStatisticsByClass = nil;
+  HLActionInstrumentationStatisticsByKey = nil;
+}
+
++ (NSDictionary *)statisticsByActionClass
+{
+  NSMutableDictionary *statisticsByActionClass = [NSMutableDictionary dictionaryWithCapacity:[HLActionInstrumentationStatisticsByClass count]];
+  [HLActionInstrumentationStatisticsByClass enumerateKeysAndObjectsUsingBlock:^(Class actionClass, HLActionStatistics *statistics, BOOL *stop){
+    statisticsByActionClass[NSStringFromClass(actionClass)] = [statistics HL_snapshot];
+  }];
+  return statisticsByActionClass;
+}
+
++ (NSDictionary *)statisticsByKey
+{
+  NSMutableDictionary *statisticsByKey = [NSMutableDictionary dictionaryWithCapacity:[HLActionInstrumentationStatisticsByKey count]];
+  [HLActionInstrumentationStatisticsByKey enumerateKeysAndObjectsUsingBlock:^(NSString *key, HLActionStatistics *statistics, BOOL *stop){
+    statisticsByKey[key] = [statistics HL_snapshot];
+  }];
+  return statisticsByKey;
+}
+
++ (NSString *)tableDescription
+{
+  NSMutableString *table = [NSMutableString string];
+  [table appendFormat:@"%-40s %10s %10s %10s %12s\n", "name", "updates", "completed", "allocated", "time (ms)"];
+  void (^appendSection)(NSString *, NSDictionary *) = ^(NSString *title, NSDictionary *statisticsByName){
+    [table appendFormat:@"%@:\n", title];
+    NSArray *names = [statisticsByName keysSortedByValueUsingComparator:^NSComparisonResult(HLActionStatistics *a, HLActionStatistics *b){
+      if (a->_updateTime > b->_updateTime) {
+        return NSOrderedAscending;
+      } else if (a->_updateTime < b->_updateTime) {
+        return NSOrderedDescending;
+      }
+      return NSOrderedSame;
+    }];
+    for (NSString *name in names) {
+      HLActionStatistics *statistics = statisticsByName[name];
+      [table appendFormat:@"  %-38s %10lu %10lu %10lu %12.3f\n",
+       [name UTF8String],
+       (unsigned long)statistics->_updateCount,
+       (unsigned long)statistics->_completionCount,
+       (unsigned long)statistics->_allocationCount,
+       statistics->_updateTime * 1000.0];
+    }
+  };
+  appendSection(@"action classes", [self statisticsByActionClass]);
+  appendSection(@"keys", [self statisticsByKey]);
+  return table;
+}
+
++ (NSData *)JSONData
+{
+  NSMutableDictionary *actionClasses = [NSMutableDictionary dictionary];
+  [[self statisticsByActionClass] enumerateKeysAndObjectsUsingBlock:^(NSString *name, HLActionStatistics *statistics, BOOL *stop){
+    actionClasses[name] = [statistics HL_JSONObject];
+  }];
+  NSMutableDictionary *keys = [NSMutableDictionary dictionary];
+  [[self statisticsByKey] enumerateKeysAndObjectsUsingBlock:^(NSString *name, HLActionStatistics *statistics, BOOL *stop){
+    keys[name] = [statistics HL_JSONObject];
+  }];
+  NSError *error = nil;
+  NSData *data = [NSJSONSerialization dataWithJSONObject:@{ @"actionClasses" : actionClasses, @"keys" : keys }
+                                                 options:NSJSONWritingPrettyPrinted
+                                                   error:&error];
+  if (!data) {
+    HLLog(HLLogError, @"HLActionInstrumentation could not encode statistics as JSON: %@", error);
+  }
+  return data;
+}
+
+@end
+
+// note: Incremented whenever the speed or timing mode of any action changes, since that
+// might change the completion times of collections containing it; see [HLSequenceAction
+// HL_startTimes].  Atomic only because actions may be built on any thread.
+static _Atomic(uint64_t) HLActionTimingGeneration = 0;
 
 @implementation HLAction
 
@@ -383,6 +2028,21 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   return copy;
 }
 
+- (void)rewind
+{
+  _elapsedTimeLinear = 0.0;
+#if DEBUG
+  _completed = NO;
+#endif
+}
+
+- (BOOL)canRewind
+{
+  // note: Only the subclass knows what state it accumulates while running, so each
+  // rewindable subclass declares its support explicitly.
+  return NO;
+}
+
 - (void)setSpeed:(CGFloat)speed
 {
   // note: It might be possible to support a negative speed, but the current implementation
@@ -392,6 +2052,13 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   } else {
     _speed = speed;
   }
+  atomic_fetch_add_explicit(&HLActionTimingGeneration, 1, memory_order_relaxed);
+}
+
+- (void)setTimingMode:(HLActionTimingMode)timingMode
+{
+  _timingMode = timingMode;
+  atomic_fetch_add_explicit(&HLActionTimingGeneration, 1, memory_order_relaxed);
 }
 
 - (NSTimeInterval)elapsedTime
@@ -401,10 +2068,10 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
 
 - (NSTimeInterval)HL_elapsedTimeForElapsedTimeLinear:(NSTimeInterval)elapsedTimeLinear
 {
-  if (_elapsedTimeLinear <= 0.0 || _elapsedTimeLinear >= _duration || _timingMode == HLActionTimingLinear) {
-    return _elapsedTimeLinear;
+  if (elapsedTimeLinear <= 0.0 || elapsedTimeLinear >= _duration || _timingMode == HLActionTimingLinear) {
+    return elapsedTimeLinear;
   } else {
-    return HLActionApplyTiming(_timingMode, _elapsedTimeLinear / _duration) * _duration;
+    return HLActionApplyTiming(_timingMode, elapsedTimeLinear / _duration) * _duration;
   }
 }
 
@@ -429,6 +2096,20 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   return [self HL_update:incrementalTime node:node extraTime:&extraTime];
 }
 
+- (BOOL)seekToElapsedTime:(NSTimeInterval)elapsedTime node:(SKNode *)node
+{
+  if (elapsedTime < 0.0) {
+    elapsedTime = 0.0;
+  }
+  // note: Checked for the whole tree before seeking, so that an action which can't seek
+  // doesn't leave the others half-sought.
+  if (![self HL_canSeekToTime:elapsedTime]) {
+    [NSException raise:@"HLActionInvalid" format:@"%@ cannot seek backward to elapsed time %g.", NSStringFromClass([self class]), elapsedTime];
+  }
+  NSTimeInterval extraTime;
+  return [self HL_seek:elapsedTime node:node extraTime:&extraTime];
+}
+
 - (BOOL)HL_update:(NSTimeInterval)incrementalTime node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
 {
   // Preconditions: incrementalTime and speed must both be non-negative.  This method may
@@ -527,6 +2208,97 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   }
 }
 
+- (BOOL)HL_seek:(NSTimeInterval)time node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
+{
+  // note: The time is measured in the caller's frame from the start of the action, and is
+  // non-negative.  Like HL_update, returns NO if the action is completed at that time, with
+  // extraTime set to the time past completion.
+
+  // note: For most simple actions, node state is a function of elapsed time alone, and so
+  // a single update evaluates the action in closed form at the new time.  Updates only
+  // run forward, though, so to seek backward those actions are first reset to their start
+  // (see HL_resetElapsedTimeWithNode:) and then updated forward.  Other actions (including
+  // unknown subclasses) might accumulate state over time, and so can only be updated
+  // forward; see HL_canSeekToTime:.  Collections override this to find and seek their
+  // actions directly.
+  NSTimeInterval currentTime = (_speed > 0.0f ? _elapsedTimeLinear / _speed : 0.0);
+  if (time < currentTime) {
+    assert([self HL_canSeekBackward]);
+    [self HL_resetElapsedTimeWithNode:node];
+    currentTime = 0.0;
+  }
+#if DEBUG
+  _completed = NO;
+#endif
+  return [self HL_update:(time - currentTime) node:node extraTime:extraTime];
+}
+
+- (BOOL)HL_canSeekToTime:(NSTimeInterval)time
+{
+  // note: Whether HL_seek can seek to the time (in the same frame) without throwing.
+  // Collections override this to check the actions they would seek.
+  NSTimeInterval currentTime = (_speed > 0.0f ? _elapsedTimeLinear / _speed : 0.0);
+  return (time >= currentTime || [self HL_canSeekBackward]);
+}
+
+- (BOOL)HL_canSeekBackward
+{
+  return NO;
+}
+
+- (void)HL_resetElapsedTimeWithNode:(SKNode *)node
+{
+  // note: Returns the action to its start for seeking backward, without forgetting state
+  // captured from the node (unlike rewind).  For actions whose node state is a function of
+  // elapsed time alone, the next update sets the node state absolutely, and so nothing
+  // else is needed; "by" actions override this to undo the delta they have applied.
+  _elapsedTimeLinear = 0.0;
+#if DEBUG
+  _completed = NO;
+#endif
+}
+
+- (NSTimeInterval)HL_completionTime
+{
+  return [self HL_completionTimeForElapsedTime:_duration];
+}
+
+- (NSTimeInterval)HL_completionTimeForElapsedTime:(NSTimeInterval)elapsedTime
+{
+  // note: Converts an elapsed time in this action's frame (adjusted for speed and timing
+  // mode) to the time in the caller's frame, from the start of the action, assuming speed
+  // does not change.  Returns infinity for a zero speed.
+  if (elapsedTime <= 0.0) {
+    return 0.0;
+  }
+  return [self HL_elapsedTimeLinearForElapsedTime:elapsedTime] / _speed;
+}
+
+- (NSTimeInterval)HL_idleTime
+{
+  // note: The time, in the caller's frame, for which updates of this action will do
+  // nothing but advance time: no changes to the node, no callbacks, no completion.  While
+  // an action is idle, any number of updates can be replaced by a single update with the
+  // sum of their incremental times.  Zero (the default) if unknown.  See [HLActionRunner
+  // defersIdleUpdates].
+  return 0.0;
+}
+
+- (NSTimeInterval)HL_idleTimeForIdleTimeMyFrame:(NSTimeInterval)idleTimeMyFrame
+{
+  // note: For collections: Converts an idle time measured in this action's frame (adjusted
+  // for speed and timing mode), starting now, to the caller's frame.
+  if (idleTimeMyFrame <= 0.0) {
+    return 0.0;
+  }
+  if (_speed == 0.0f || isinf(idleTimeMyFrame)) {
+    return INFINITY;
+  }
+  NSTimeInterval elapsedTime = [self HL_elapsedTimeForElapsedTimeLinear:_elapsedTimeLinear];
+  NSTimeInterval idleElapsedTimeLinear = [self HL_elapsedTimeLinearForElapsedTime:(elapsedTime + idleTimeMyFrame)];
+  return MAX(0.0, (idleElapsedTimeLinear - _elapsedTimeLinear) / _speed);
+}
+
 @end
 
 @implementation HLAction (HLActions)
@@ -551,6 +2323,14 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   return [[HLRepeatAction alloc] initWithAction:action];
 }
 
++ (HLAction *)flattenedAction:(HLAction *)action
+{
+  if ([HLTimelineAction canFlattenAction:action]) {
+    return [[HLTimelineAction alloc] initWithAction:action];
+  }
+  return action;
+}
+
 + (HLWaitAction *)waitForDuration:(NSTimeInterval)duration
 {
   return [[HLWaitAction alloc] initWithDuration:duration];
@@ -596,6 +2376,11 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   return [[HLChaseWeakTargetAction alloc] initWithOrigin:origin weakTarget:destinationWeakTarget selector:destinationSelector duration:duration];
 }
 
++ (HLFollowPathAction *)followPath:(HLCubicBezierPath *)path duration:(NSTimeInterval)duration
+{
+  return [[HLFollowPathAction alloc] initWithPath:path duration:duration];
+}
+
 + (HLChangeZPositionByAction *)changeZPositionBy:(CGFloat)zPositionDelta duration:(NSTimeInterval)duration
 {
   return [[HLChangeZPositionByAction alloc] initWithZPosition:zPositionDelta duration:duration];
@@ -705,6 +2490,11 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   return [[HLFadeAlphaToAction alloc] initWithAlphaFrom:alphaFrom to:alphaTo duration:duration];
 }
 
++ (HLKeyframeAction *)keyframes:(const HLKeyframe *)keyframes count:(NSUInteger)keyframeCount channels:(HLKeyframeActionChannels)channels
+{
+  return [[HLKeyframeAction alloc] initWithKeyframes:keyframes count:keyframeCount channels:channels];
+}
+
 + (HLColorizeAction *)colorizeWithColor:(SKColor *)colorTo colorBlendFactor:(CGFloat)colorBlendFactorTo duration:(NSTimeInterval)duration
 {
   return [[HLColorizeAction alloc] initWithColor:colorTo colorBlendFactor:colorBlendFactorTo duration:duration];
@@ -802,7 +2592,11 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
 
 @implementation HLGroupAction
 {
-  NSMutableArray *_mutableActions;
+  // note: Completed actions are flagged rather than removed, so that the group can be
+  // rewound without allocating.  One byte per action, in the same order as _actions.
+  NSArray *_actions;
+  NSMutableData *_completedFlags;
+  NSUInteger _remainingCount;
 }
 
 - (instancetype)initWithActions:(NSArray *)actions
@@ -821,7 +2615,9 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   }
   self = [super initWithDuration:durationMax];
   if (self) {
-    _mutableActions = [NSMutableArray arrayWithArray:actions];
+    _actions = [NSArray arrayWithArray:actions];
+    _completedFlags = [NSMutableData dataWithLength:[actions count]];
+    _remainingCount = [actions count];
   }
   return self;
 }
@@ -830,7 +2626,23 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
 {
   self = [super initWithCoder:aDecoder];
   if (self) {
-    _mutableActions = [aDecoder decodeObjectForKey:@"actions"];
+    _actions = [aDecoder decodeObjectForKey:@"actions"];
+    NSUInteger actionsCount = [_actions count];
+    NSData *completedFlags = [aDecoder decodeObjectForKey:@"completedFlags"];
+    // note: Older archives removed completed actions from the encoded array, and so have
+    // no completed flags.
+    if (completedFlags && [completedFlags length] == actionsCount) {
+      _completedFlags = [completedFlags mutableCopy];
+    } else {
+      _completedFlags = [NSMutableData dataWithLength:actionsCount];
+    }
+    const uint8_t *flags = (const uint8_t *)_completedFlags.bytes;
+    _remainingCount = 0;
+    for (NSUInteger a = 0; a < actionsCount; ++a) {
+      if (!flags[a]) {
+        ++_remainingCount;
+      }
+    }
   }
   return self;
 }
@@ -838,21 +2650,157 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
 - (void)encodeWithCoder:(NSCoder *)aCoder
 {
   [super encodeWithCoder:aCoder];
-  [aCoder encodeObject:_mutableActions forKey:@"actions"];
+  [aCoder encodeObject:_actions forKey:@"actions"];
+  if (_remainingCount < [_actions count]) {
+    [aCoder encodeObject:_completedFlags forKey:@"completedFlags"];
+  }
 }
 
 - (instancetype)copyWithZone:(NSZone *)zone
 {
   HLGroupAction *copy = [super copyWithZone:zone];
   if (copy) {
-    copy->_mutableActions = [[NSMutableArray alloc] initWithArray:_mutableActions copyItems:YES];
+    copy->_actions = [[NSArray alloc] initWithArray:_actions copyItems:YES];
+    copy->_completedFlags = [_completedFlags mutableCopy];
+    copy->_remainingCount = _remainingCount;
   }
   return copy;
 }
 
+- (void)rewind
+{
+  [super rewind];
+  for (HLAction *action in _actions) {
+    [action rewind];
+  }
+  memset(_completedFlags.mutableBytes, 0, [_completedFlags length]);
+  _remainingCount = [_actions count];
+}
+
+- (BOOL)canRewind
+{
+  for (HLAction *action in _actions) {
+    if (![action canRewind]) {
+      return NO;
+    }
+  }
+  return YES;
+}
+
 - (NSArray *)actions
 {
-  return _mutableActions;
+  NSUInteger actionsCount = [_actions count];
+  if (_remainingCount == actionsCount) {
+    return _actions;
+  }
+  NSMutableArray *remainingActions = [NSMutableArray arrayWithCapacity:_remainingCount];
+  const uint8_t *flags = (const uint8_t *)_completedFlags.bytes;
+  for (NSUInteger a = 0; a < actionsCount; ++a) {
+    if (!flags[a]) {
+      [remainingActions addObject:_actions[a]];
+    }
+  }
+  return remainingActions;
+}
+
+- (NSTimeInterval)HL_idleTime
+{
+  if (_remainingCount == 0) {
+    return 0.0;
+  }
+  const uint8_t *flags = (const uint8_t *)_completedFlags.bytes;
+  NSUInteger actionsCount = [_actions count];
+  NSTimeInterval idleTimeMyFrame = INFINITY;
+  for (NSUInteger a = 0; a < actionsCount; ++a) {
+    if (flags[a]) {
+      continue;
+    }
+    NSTimeInterval actionIdleTime = [(HLAction *)_actions[a] HL_idleTime];
+    if (actionIdleTime < idleTimeMyFrame) {
+      idleTimeMyFrame = actionIdleTime;
+      if (idleTimeMyFrame <= 0.0) {
+        return 0.0;
+      }
+    }
+  }
+  return [self HL_idleTimeForIdleTimeMyFrame:idleTimeMyFrame];
+}
+
+- (NSTimeInterval)HL_completionTime
+{
+  NSTimeInterval completionTimeMyFrame = 0.0;
+  for (HLAction *action in _actions) {
+    NSTimeInterval actionCompletionTime = [action HL_completionTime];
+    if (actionCompletionTime > completionTimeMyFrame) {
+      completionTimeMyFrame = actionCompletionTime;
+    }
+  }
+  return [self HL_completionTimeForElapsedTime:completionTimeMyFrame];
+}
+
+- (BOOL)HL_seek:(NSTimeInterval)time node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
+{
+  self.elapsedTimeLinear = time * self.speed;
+  NSTimeInterval elapsedTime = self.elapsedTime;
+
+  // note: Every action in a group starts at the same time, so each is sought directly to
+  // the group's elapsed time.  Actions already completed before that time are left alone
+  // (so that, for instance, perform-selector actions are not performed again); completed
+  // actions which are still running at that time are sought backward.  See
+  // HL_canSeekToTime:.
+  uint8_t *flags = (uint8_t *)_completedFlags.mutableBytes;
+  NSUInteger actionsCount = [_actions count];
+  NSTimeInterval completionTimeMyFrame = 0.0;
+  for (NSUInteger a = 0; a < actionsCount; ++a) {
+    HLAction *action = _actions[a];
+    NSTimeInterval actionCompletionTime = [action HL_completionTime];
+    if (actionCompletionTime > completionTimeMyFrame) {
+      completionTimeMyFrame = actionCompletionTime;
+    }
+    if (flags[a]) {
+      if (elapsedTime >= actionCompletionTime) {
+        continue;
+      }
+      flags[a] = 0;
+      ++_remainingCount;
+    }
+    NSTimeInterval actionExtraTime;
+    if (![action HL_seek:elapsedTime node:node extraTime:&actionExtraTime]) {
+      flags[a] = 1;
+      --_remainingCount;
+    }
+  }
+
+#if DEBUG
+  self.completed = (_remainingCount == 0);
+#endif
+  if (_remainingCount > 0) {
+    return YES;
+  }
+  if (self.speed == 0.0f) {
+    *extraTime = time;
+  } else {
+    NSTimeInterval completionTimeLinear = [self HL_elapsedTimeLinearForElapsedTime:completionTimeMyFrame];
+    *extraTime = MAX(0.0, (self.elapsedTimeLinear - completionTimeLinear) / self.speed);
+  }
+  return NO;
+}
+
+- (BOOL)HL_canSeekToTime:(NSTimeInterval)time
+{
+  NSTimeInterval elapsedTime = [self HL_elapsedTimeForElapsedTimeLinear:(time * self.speed)];
+  const uint8_t *flags = (const uint8_t *)_completedFlags.bytes;
+  NSUInteger actionsCount = [_actions count];
+  for (NSUInteger a = 0; a < actionsCount; ++a) {
+    HLAction *action = _actions[a];
+    if (flags[a] && elapsedTime >= [action HL_completionTime]) {
+      continue;
+    }
+    if (![action HL_canSeekToTime:elapsedTime]) {
+      return NO;
+    }
+  }
+  return YES;
 }
 
 - (BOOL)HL_update:(NSTimeInterval)incrementalTime node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
@@ -866,9 +2814,9 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
           " but HLActions are stateful and can only be used once.)");
   }
   // note: Since groups must be created non-empty, the only way we have no actions is if
-  // we've removed them on a previous update and returned NO.  This gives us an alternate
+  // we've completed them on a previous update and returned NO.  This gives us an alternate
   // way to assert the precondition (if the self.completed is ever removed).
-  //assert([_mutableActions count] > 0);
+  //assert(_remainingCount > 0);
 #endif
 
   NSTimeInterval elapsedTimeOld = self.elapsedTime;
@@ -884,12 +2832,17 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   // update (because of code executed by one of our actions).
 
   NSTimeInterval leastExtraTimeMyFrame = incrementalTimeMyFrame;
-  NSUInteger i = 0;
-  while (i < [_mutableActions count]) {
-    HLAction *action = _mutableActions[i];
+  uint8_t *flags = (uint8_t *)_completedFlags.mutableBytes;
+  NSUInteger actionsCount = [_actions count];
+  for (NSUInteger a = 0; a < actionsCount; ++a) {
+    if (flags[a]) {
+      continue;
+    }
+    HLAction *action = _actions[a];
     NSTimeInterval extraTimeMyFrame;
-    if (![action HL_update:incrementalTimeMyFrame node:node extraTime:&extraTimeMyFrame]) {
-      [_mutableActions removeObjectAtIndex:i];
+    if (!HLActionUpdate(action, incrementalTimeMyFrame, node, &extraTimeMyFrame, nil)) {
+      flags[a] = 1;
+      --_remainingCount;
       // note: This is a logic test in place for development that can be removed if it
       // proves stable.  In the meantime, this extra-time translation is tricky, so the
       // assert helps to make sure all actions claim to have a reasonable extra time
@@ -898,12 +2851,10 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
       if (extraTimeMyFrame < leastExtraTimeMyFrame) {
         leastExtraTimeMyFrame = extraTimeMyFrame;
       }
-    } else {
-      ++i;
     }
   }
 
-  if ([_mutableActions count] > 0) {
+  if (_remainingCount > 0) {
     return YES;
   } else {
     // note: We need to translate the extra time back into the caller's frame, which means
@@ -936,9 +2887,35 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
 
 @end
 
+static NSUInteger
+HLSequenceActionTargetIndex(const NSTimeInterval *startTimes, NSUInteger actionsCount, NSTimeInterval elapsedTime)
+{
+  // note: Binary search for the target action: the first action which completes after
+  // the elapsed time.  (Actions completing exactly at the elapsed time are considered
+  // completed, as in an update.)
+  NSUInteger low = 0;
+  NSUInteger high = actionsCount;
+  while (low < high) {
+    NSUInteger middle = low + (high - low) / 2;
+    if (startTimes[middle + 1] > elapsedTime) {
+      high = middle;
+    } else {
+      low = middle + 1;
+    }
+  }
+  return low;
+}
+
 @implementation HLSequenceAction
 {
-  NSMutableArray *_mutableActions;
+  // note: Completed actions are skipped by index rather than removed, so that the
+  // sequence can be rewound without allocating.
+  NSArray *_actions;
+  NSUInteger _actionIndex;
+  // note: Start times of the actions (in the frame of the sequence), plus the completion
+  // time of the last, computed on the first seek; see HL_startTimes.
+  NSTimeInterval *_startTimes;
+  uint64_t _startTimesGeneration;
 }
 
 - (instancetype)initWithActions:(NSArray *)actions
@@ -954,38 +2931,208 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   }
   self = [super initWithDuration:durationTotal];
   if (self) {
-    _mutableActions = [NSMutableArray arrayWithArray:actions];
+    _actions = [NSArray arrayWithArray:actions];
+    _actionIndex = 0;
+  }
+  return self;
+}
+
+- (instancetype)initWithCoder:(NSCoder *)aDecoder
+{
+  self = [super initWithCoder:aDecoder];
+  if (self) {
+    _actions = [aDecoder decodeObjectForKey:@"actions"];
+    // note: Older archives removed completed actions from the encoded array, and so have
+    // no action index.
+    _actionIndex = (NSUInteger)[aDecoder decodeIntegerForKey:@"actionIndex"];
   }
   return self;
 }
 
-- (instancetype)initWithCoder:(NSCoder *)aDecoder
+- (void)dealloc
+{
+  free(_startTimes);
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{
+  [super encodeWithCoder:aCoder];
+  [aCoder encodeObject:_actions forKey:@"actions"];
+  if (_actionIndex != 0) {
+    [aCoder encodeInteger:(NSInteger)_actionIndex forKey:@"actionIndex"];
+  }
+}
+
+- (instancetype)copyWithZone:(NSZone *)zone
+{
+  HLSequenceAction *copy = [super copyWithZone:zone];
+  if (copy) {
+    copy->_actions = [[NSArray alloc] initWithArray:_actions copyItems:YES];
+    copy->_actionIndex = _actionIndex;
+  }
+  return copy;
+}
+
+- (void)rewind
+{
+  [super rewind];
+  for (HLAction *action in _actions) {
+    [action rewind];
+  }
+  _actionIndex = 0;
+}
+
+- (BOOL)canRewind
+{
+  for (HLAction *action in _actions) {
+    if (![action canRewind]) {
+      return NO;
+    }
+  }
+  return YES;
+}
+
+- (NSArray *)actions
+{
+  if (_actionIndex == 0) {
+    return _actions;
+  }
+  return [_actions subarrayWithRange:NSMakeRange(_actionIndex, [_actions count] - _actionIndex)];
+}
+
+- (NSTimeInterval)HL_idleTime
+{
+  // note: Only the current action is updated, so the sequence is idle as long as it is.
+  if (_actionIndex >= [_actions count]) {
+    return 0.0;
+  }
+  return [self HL_idleTimeForIdleTimeMyFrame:[(HLAction *)_actions[_actionIndex] HL_idleTime]];
+}
+
+- (NSTimeInterval)HL_completionTime
 {
-  self = [super initWithCoder:aDecoder];
-  if (self) {
-    _mutableActions = [aDecoder decodeObjectForKey:@"actions"];
+  NSTimeInterval completionTimeMyFrame = 0.0;
+  for (HLAction *action in _actions) {
+    completionTimeMyFrame += [action HL_completionTime];
   }
-  return self;
+  return [self HL_completionTimeForElapsedTime:completionTimeMyFrame];
 }
 
-- (void)encodeWithCoder:(NSCoder *)aCoder
+- (const NSTimeInterval *)HL_startTimes
 {
-  [super encodeWithCoder:aCoder];
-  [aCoder encodeObject:_mutableActions forKey:@"actions"];
+  // note: The start times depend on the speeds and timing modes of the sequenced actions
+  // (and of their actions, and so on), which may change at any time, and so they are
+  // recomputed if any action's speed or timing mode has changed since.
+  uint64_t timingGeneration = atomic_load_explicit(&HLActionTimingGeneration, memory_order_relaxed);
+  if (_startTimes && _startTimesGeneration == timingGeneration) {
+    return _startTimes;
+  }
+  NSUInteger actionsCount = [_actions count];
+  if (!_startTimes) {
+    _startTimes = (NSTimeInterval *)malloc(sizeof(NSTimeInterval) * (actionsCount + 1));
+    if (!_startTimes) {
+      [NSException raise:NSMallocException format:@"HLSequenceAction could not allocate storage for %lu start times.", (unsigned long)actionsCount];
+    }
+  }
+  NSTimeInterval startTime = 0.0;
+  for (NSUInteger a = 0; a < actionsCount; ++a) {
+    _startTimes[a] = startTime;
+    startTime += [(HLAction *)_actions[a] HL_completionTime];
+  }
+  _startTimes[actionsCount] = startTime;
+  _startTimesGeneration = timingGeneration;
+  return _startTimes;
 }
 
-- (instancetype)copyWithZone:(NSZone *)zone
+- (BOOL)HL_canSeekToTime:(NSTimeInterval)time
 {
-  HLSequenceAction *copy = [super copyWithZone:zone];
-  if (copy) {
-    copy->_mutableActions = [[NSMutableArray alloc] initWithArray:_mutableActions copyItems:YES];
+  NSUInteger actionsCount = [_actions count];
+  const NSTimeInterval *startTimes = [self HL_startTimes];
+  NSTimeInterval elapsedTime = [self HL_elapsedTimeForElapsedTimeLinear:(time * self.speed)];
+  NSUInteger targetIndex = HLSequenceActionTargetIndex(startTimes, actionsCount, elapsedTime);
+
+  // note: Mirrors HL_seek: Started actions after the target are sought to their start and
+  // rewound, and then the first action not completed is sought to its own elapsed time.
+  // Actions after that have not started, and so can always be sought forward.
+  NSUInteger actionIndex = _actionIndex;
+  if (targetIndex < actionIndex) {
+    for (NSUInteger a = MIN(actionIndex, actionsCount - 1); a > targetIndex; --a) {
+      HLAction *action = _actions[a];
+      if (![action canRewind]) {
+        return NO;
+      }
+      if (startTimes[a + 1] > startTimes[a] && ![action HL_canSeekToTime:0.0]) {
+        return NO;
+      }
+    }
+    actionIndex = targetIndex;
   }
-  return copy;
+  if (actionIndex < actionsCount) {
+    NSTimeInterval actionTime = MAX(0.0, elapsedTime - startTimes[actionIndex]);
+    if (![(HLAction *)_actions[actionIndex] HL_canSeekToTime:actionTime]) {
+      return NO;
+    }
+  }
+  return YES;
 }
 
-- (NSArray *)actions
+- (BOOL)HL_seek:(NSTimeInterval)time node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
 {
-  return _mutableActions;
+  NSUInteger actionsCount = [_actions count];
+  const NSTimeInterval *startTimes = [self HL_startTimes];
+
+  self.elapsedTimeLinear = time * self.speed;
+  NSTimeInterval elapsedTime = self.elapsedTime;
+  NSUInteger targetIndex = HLSequenceActionTargetIndex(startTimes, actionsCount, elapsedTime);
+
+  // note: Seeking backward: Undo the effects of started actions after the target (by
+  // seeking them to their start), and rewind them so they can run again.  Zero-duration
+  // actions can't be undone; they are only rewound, and so (for instance) perform-selector
+  // actions will be performed again when the sequence passes them again.  The target
+  // action itself, if already completed, is sought backward below.
+  if (targetIndex < _actionIndex) {
+    NSUInteger a = MIN(_actionIndex, actionsCount - 1);
+    while (a > targetIndex) {
+      HLAction *action = _actions[a];
+      if (startTimes[a + 1] > startTimes[a]) {
+        NSTimeInterval actionExtraTime;
+        [action HL_seek:0.0 node:node extraTime:&actionExtraTime];
+      }
+      [action rewind];
+      --a;
+    }
+    _actionIndex = targetIndex;
+  }
+
+  // note: Seeking forward: Actions between the current action and the target must still
+  // be sought to completion so that their effects on the node are applied, just as in
+  // an update; the target action is then sought to its own elapsed time.  Proceeds like
+  // an update, rather than trusting the target index, so that floating point error at
+  // action boundaries is resolved by the actions themselves.  Actions before the current
+  // action have completed, and are not sought again.
+  while (_actionIndex < actionsCount) {
+    HLAction *action = _actions[_actionIndex];
+    NSTimeInterval actionTime = MAX(0.0, elapsedTime - startTimes[_actionIndex]);
+    NSTimeInterval actionExtraTime;
+    if ([action HL_seek:actionTime node:node extraTime:&actionExtraTime]) {
+      break;
+    }
+    ++_actionIndex;
+  }
+
+#if DEBUG
+  self.completed = (_actionIndex == actionsCount);
+#endif
+  if (_actionIndex < actionsCount) {
+    return YES;
+  }
+  if (self.speed == 0.0f) {
+    *extraTime = time;
+  } else {
+    NSTimeInterval completionTimeLinear = [self HL_elapsedTimeLinearForElapsedTime:startTimes[actionsCount]];
+    *extraTime = MAX(0.0, (self.elapsedTimeLinear - completionTimeLinear) / self.speed);
+  }
+  return NO;
 }
 
 - (BOOL)HL_update:(NSTimeInterval)incrementalTime node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
@@ -1005,9 +3152,9 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
           " but HLActions are stateful and can only be used once.)");
   }
   // note: Since sequences must be created non-empty, the only way we have no actions is
-  // if we've removed them on a previous update and returned NO.  This gives us an
+  // if we've completed them on a previous update and returned NO.  This gives us an
   // alternate way to assert the precondition (if the self.completed is ever removed).
-  //assert([_mutableActions count] > 0);
+  //assert(_actionIndex < [_actions count]);
 #endif
 
   // note: Sequences have another expectation: One action in a sequence won't get its
@@ -1107,11 +3254,12 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   NSTimeInterval elapsedTime = self.elapsedTime;
   NSTimeInterval incrementalTimeMyFrame = elapsedTime - elapsedTimeOld;
 
-  HLAction *currentAction = _mutableActions.firstObject;
+  NSUInteger actionsCount = [_actions count];
+  HLAction *currentAction = (_actionIndex < actionsCount ? _actions[_actionIndex] : nil);
   NSTimeInterval remainingIncrementalTimeMyFrame = incrementalTimeMyFrame;
   NSTimeInterval extraTimeMyFrame = incrementalTimeMyFrame;
   while (currentAction) {
-    if ([currentAction HL_update:remainingIncrementalTimeMyFrame node:node extraTime:&extraTimeMyFrame]) {
+    if (HLActionUpdate(currentAction, remainingIncrementalTimeMyFrame, node, &extraTimeMyFrame, nil)) {
       break;
     }
     // note: This is a logic test in place for development that can be removed if it
@@ -1120,8 +3268,8 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
     // remaining when completed.
     assert(extraTimeMyFrame >= 0.0 && extraTimeMyFrame <= remainingIncrementalTimeMyFrame);
     remainingIncrementalTimeMyFrame = extraTimeMyFrame;
-    [_mutableActions removeObjectAtIndex:0];
-    currentAction = _mutableActions.firstObject;
+    ++_actionIndex;
+    currentAction = (_actionIndex < actionsCount ? _actions[_actionIndex] : nil);
   }
 
   // note: As a sequence, we are only completed when our last action is completed, and because of the way
@@ -1161,34 +3309,454 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
 @end
 
 @implementation HLRepeatAction
+{
+  // note: When the prototype can be rewound, iterations alternate between two instances
+  // of it.  At the start of an iteration, the instance that ran the iteration before last
+  // (the spare) is rewound in place rather than copying the prototype again, so that
+  // after the first two iterations the repeat allocates nothing.  Alternating, rather than
+  // rewinding the just-completed instance, means a completed instance keeps its final
+  // state until the following iteration completes, as it did when every iteration was a
+  // fresh copy.  The instances survive completion of the repeat, so that a repeat nested
+  // in a rewound parent also allocates nothing.
+  BOOL _prototypeCanRewind;
+  HLAction *_spareAction;
+  HLAction *_completedAction;
+}
+
+- (instancetype)initWithAction:(HLAction *)prototypeAction count:(NSUInteger)count
+{
+  if (!prototypeAction) {
+    [NSException raise:@"HLActionInvalid" format:@"A repeat action must be created with an action to repeat."];
+  }
+  if (count == 0 && prototypeAction.duration == 0.0) {
+    [NSException raise:@"HLActionInvalid" format:@"An action to repeated forever must have a non-zero duration."];
+  }
+  self = [super initWithDuration:(prototypeAction.duration * count)];
+  if (self) {
+    _count = count;
+    _prototypeAction = prototypeAction;
+    _prototypeCanRewind = [prototypeAction canRewind];
+  }
+  return self;
+}
+
+- (instancetype)initWithAction:(HLAction *)prototypeAction
+{
+  if (!prototypeAction) {
+    [NSException raise:@"HLActionInvalid" format:@"A repeat action must be created with an action to repeat."];
+  }
+  if (prototypeAction.duration == 0.0) {
+    [NSException raise:@"HLActionInvalid" format:@"An action to be repeated forever must have a non-zero duration."];
+  }
+  self = [super initWithDuration:0.0];
+  if (self) {
+    _prototypeAction = prototypeAction;
+    _prototypeCanRewind = [prototypeAction canRewind];
+  }
+  return self;
+}
+
+- (instancetype)initWithCoder:(NSCoder *)aDecoder
+{
+  self = [super initWithCoder:aDecoder];
+  if (self) {
+    _count = (NSUInteger)[aDecoder decodeIntegerForKey:@"count"];
+    _index = (NSUInteger)[aDecoder decodeIntegerForKey:@"index"];
+    _prototypeAction = [aDecoder decodeObjectForKey:@"prototypeAction"];
+    _copiedAction = [aDecoder decodeObjectForKey:@"copiedAction"];
+    _prototypeCanRewind = [_prototypeAction canRewind];
+  }
+  return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{
+  [super encodeWithCoder:aCoder];
+  [aCoder encodeInteger:(NSInteger)_count forKey:@"count"];
+  [aCoder encodeInteger:(NSInteger)_index forKey:@"index"];
+  [aCoder encodeObject:_prototypeAction forKey:@"prototypeAction"];
+  [aCoder encodeObject:_copiedAction forKey:@"copiedAction"];
+}
+
+- (instancetype)copyWithZone:(NSZone *)zone
+{
+  HLRepeatAction *copy = [super copyWithZone:zone];
+  if (copy) {
+    copy->_count = _count;
+    copy->_index = _index;
+    copy->_prototypeAction = [_prototypeAction copy];
+    copy->_copiedAction = [_copiedAction copy];
+    copy->_prototypeCanRewind = _prototypeCanRewind;
+  }
+  return copy;
+}
+
+- (void)rewind
+{
+  [super rewind];
+  _index = 0;
+  if (_copiedAction) {
+    if (_prototypeCanRewind) {
+      _completedAction = _copiedAction;
+    }
+    _copiedAction = nil;
+  }
+}
+
+- (BOOL)canRewind
+{
+  return YES;
+}
+
+- (void)HL_startIteration
+{
+  if (_spareAction) {
+    _copiedAction = _spareAction;
+    [_copiedAction rewind];
+  } else {
+    _copiedAction = [_prototypeAction copy];
+    if (HLActionInstrumentationEnabledFlag) {
+      HLActionInstrumentationRecordAllocation([_prototypeAction class], nil);
+    }
+  }
+  _spareAction = _completedAction;
+  _completedAction = nil;
+}
+
+- (void)HL_finishIteration
+{
+  ++_index;
+  if (_prototypeCanRewind) {
+    _completedAction = _copiedAction;
+  }
+  _copiedAction = nil;
+}
+
+- (NSTimeInterval)HL_idleTime
+{
+  // note: Starting the next iteration is not idle (it copies or rewinds an action), so the
+  // repeat is idle only until the current iteration completes.
+  if (!_copiedAction) {
+    return 0.0;
+  }
+  return [self HL_idleTimeForIdleTimeMyFrame:[_copiedAction HL_idleTime]];
+}
+
+- (NSTimeInterval)HL_completionTime
+{
+  if (_count == 0) {
+    return INFINITY;
+  }
+  return [self HL_completionTimeForElapsedTime:([_prototypeAction HL_completionTime] * _count)];
+}
+
+- (NSUInteger)HL_iterationIndexForElapsedTime:(NSTimeInterval)elapsedTime iterationTime:(NSTimeInterval)iterationTime
+{
+  // note: Iterations are equally long, so the iteration is found by division.
+  if (iterationTime <= 0.0) {
+    return _count;
+  }
+  NSTimeInterval iterations = floor(elapsedTime / iterationTime);
+  if (_count != 0 && iterations >= (NSTimeInterval)_count) {
+    return _count;
+  }
+  return (NSUInteger)iterations;
+}
+
+- (BOOL)HL_canSeekToTime:(NSTimeInterval)time
+{
+  // note: Seeking backward is only possible within the current iteration: The effects of
+  // earlier iterations can't be undone.
+  NSTimeInterval elapsedTime = [self HL_elapsedTimeForElapsedTimeLinear:(time * self.speed)];
+  NSTimeInterval iterationTime = [_prototypeAction HL_completionTime];
+  NSUInteger targetIndex = [self HL_iterationIndexForElapsedTime:elapsedTime iterationTime:iterationTime];
+  if (targetIndex < _index) {
+    return NO;
+  }
+  if (targetIndex == _index && _copiedAction) {
+    return [_copiedAction HL_canSeekToTime:MAX(0.0, elapsedTime - iterationTime * _index)];
+  }
+  return YES;
+}
+
+- (BOOL)HL_seek:(NSTimeInterval)time node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
+{
+  self.elapsedTimeLinear = time * self.speed;
+  NSTimeInterval elapsedTime = self.elapsedTime;
+
+  // note: The effects of iterations between the current and the target must still be
+  // applied to the node, so each is sought in turn.  See HL_canSeekToTime: for seeking
+  // backward.
+  NSTimeInterval iterationTime = [_prototypeAction HL_completionTime];
+  assert([self HL_iterationIndexForElapsedTime:elapsedTime iterationTime:iterationTime] >= _index);
+
+  while (_count == 0 || _index < _count) {
+    if (!_copiedAction) {
+      [self HL_startIteration];
+    }
+    NSTimeInterval actionTime = MAX(0.0, elapsedTime - iterationTime * _index);
+    NSTimeInterval actionExtraTime;
+    if ([_copiedAction HL_seek:actionTime node:node extraTime:&actionExtraTime]) {
+      break;
+    }
+    [self HL_finishIteration];
+  }
+
+#if DEBUG
+  self.completed = (_copiedAction == nil);
+#endif
+  if (_copiedAction) {
+    return YES;
+  }
+  if (self.speed == 0.0f) {
+    *extraTime = time;
+  } else {
+    NSTimeInterval completionTimeLinear = [self HL_elapsedTimeLinearForElapsedTime:(iterationTime * _count)];
+    *extraTime = MAX(0.0, (self.elapsedTimeLinear - completionTimeLinear) / self.speed);
+  }
+  return NO;
+}
+
+- (BOOL)HL_update:(NSTimeInterval)incrementalTime node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
+{
+#if DEBUG
+  if (self.completed) {
+    // note: Some actions rely on this precondition (that update is not called after
+    // returning NO) more than others.  Probably things will break, but maybe not.
+    HLLog(HLLogError, @"HLActions should not be updated after they have completed."
+          " (Note that SKActions are immutable and can be reused multiple times,"
+          " but HLActions are stateful and can only be used once.)");
+  }
+#endif
+
+  NSTimeInterval elapsedTimeOld = self.elapsedTime;
+  [self HL_advanceTime:incrementalTime];
+  NSTimeInterval elapsedTime = self.elapsedTime;
+  // note: "My frame" means adjusted for speed and timingMode.
+  NSTimeInterval incrementalTimeMyFrame = elapsedTime - elapsedTimeOld;
+
+  NSTimeInterval remainingIncrementalTimeMyFrame = incrementalTimeMyFrame;
+  NSTimeInterval extraTimeMyFrame = incrementalTimeMyFrame;
+  while (_count == 0 || _index < _count) {
+    if (!_copiedAction) {
+      [self HL_startIteration];
+    }
+    if (HLActionUpdate(_copiedAction, remainingIncrementalTimeMyFrame, node, &extraTimeMyFrame, nil)) {
+      break;
+    }
+    // note: This is a logic test in place for development that can be removed if it
+    // proves stable.  In the meantime, this extra-time translation is tricky, so the
+    // assert helps to make sure all actions claim to have a reasonable extra time
+    // remaining when completed.
+    assert(extraTimeMyFrame >= 0.0 && extraTimeMyFrame <= remainingIncrementalTimeMyFrame);
+    remainingIncrementalTimeMyFrame = extraTimeMyFrame;
+    [self HL_finishIteration];
+  }
+
+  // note: We are completed when our action has been repeated enough times, regardless of our
+  // elapsed time and duration (which don't account for the speed of our repeated action).
+  if (_copiedAction) {
+    return YES;
+  } else {
+    // note: We need to translate the extra time back into the caller's frame, which means
+    // accounting for our .speed and .timingMode, just as we did when converting
+    // incrementalTime into incrementalTimeMyFrame.
+    // completionTimeMyFrame: The completion time of this sequence, as an elapsed-time value
+    // measured in my frame (that is, translated by speed and timing mode).
+    NSTimeInterval completionTimeMyFrame = elapsedTime - extraTimeMyFrame;
+    // completionTimeLinear: The completion time of this group, as an elapsed-time value
+    // measured with a linear timing mode and according to my current speed.
+    NSTimeInterval completionTimeLinear = [self HL_elapsedTimeLinearForElapsedTime:completionTimeMyFrame];
+    CGFloat speed = self.speed;
+    // note: It should not be possible to complete the action with zero speed, but a little
+    // defensive programming seems appropriate here.
+    if (speed == 0.0f) {
+      assert(NO);
+      *extraTime = incrementalTime;
+    } else {
+      *extraTime = (self.elapsedTimeLinear - completionTimeLinear) / speed;
+      // note: Same assert as extraTimeMyFrame, above, but this time asserting our ability
+      // to successfully convert to the caller's time frame.
+      assert(*extraTime >= 0.0 && *extraTime <= incrementalTime);
+    }
+#if DEBUG
+    self.completed = YES;
+#endif
+    return NO;
+  }
+}
+
+@end
+
+static BOOL
+HLTimelineActionIsCollection(HLAction *action)
+{
+  return ([action isKindOfClass:[HLGroupAction class]]
+          || [action isKindOfClass:[HLSequenceAction class]]
+          || [action isKindOfClass:[HLRepeatAction class]]);
+}
+
+// note: Unrolling repeats multiplies leaves, so a modest tree can flatten into millions of
+// them.  Past this many, a repeat is kept whole as a single leaf instead.
+static const NSUInteger HLTimelineActionMaximumLeafCount = 4096;
+
+static NSUInteger
+HLTimelineActionLeafCount(HLAction *action)
+{
+  // note: Precondition: HLTimelineActionCanFlatten(action).  Returns the number of leaves
+  // the action would flatten into if all repeats were unrolled, saturating at NSUIntegerMax.
+  if ([action isKindOfClass:[HLGroupAction class]] || [action isKindOfClass:[HLSequenceAction class]]) {
+    NSArray *actions = ([action isKindOfClass:[HLGroupAction class]] ? ((HLGroupAction *)action).actions : ((HLSequenceAction *)action).actions);
+    NSUInteger leafCount = 0;
+    for (HLAction *member in actions) {
+      NSUInteger memberLeafCount = HLTimelineActionLeafCount(member);
+      if (memberLeafCount > NSUIntegerMax - leafCount) {
+        return NSUIntegerMax;
+      }
+      leafCount += memberLeafCount;
+    }
+    return leafCount;
+  }
+  if ([action isKindOfClass:[HLRepeatAction class]]) {
+    HLRepeatAction *repeatAction = (HLRepeatAction *)action;
+    NSUInteger prototypeLeafCount = HLTimelineActionLeafCount(repeatAction.prototypeAction);
+    if (prototypeLeafCount != 0 && repeatAction.count > NSUIntegerMax / prototypeLeafCount) {
+      return NSUIntegerMax;
+    }
+    return prototypeLeafCount * repeatAction.count;
+  }
+  return 1;
+}
+
+static NSTimeInterval
+HLTimelineActionFlatten(HLAction *action, NSTimeInterval startTime, NSMutableArray *leaves, NSMutableData *startTimes)
+{
+  // note: Precondition: HLTimelineActionCanFlatten(action).  Appends leaves in tree order,
+  // and returns the completion time of the action.
+  if ([action isKindOfClass:[HLGroupAction class]]) {
+    NSTimeInterval completionTime = startTime;
+    for (HLAction *member in ((HLGroupAction *)action).actions) {
+      NSTimeInterval memberCompletionTime = HLTimelineActionFlatten(member, startTime, leaves, startTimes);
+      if (memberCompletionTime > completionTime) {
+        completionTime = memberCompletionTime;
+      }
+    }
+    return completionTime;
+  }
+  if ([action isKindOfClass:[HLSequenceAction class]]) {
+    NSTimeInterval time = startTime;
+    for (HLAction *member in ((HLSequenceAction *)action).actions) {
+      time = HLTimelineActionFlatten(member, time, leaves, startTimes);
+    }
+    return time;
+  }
+  if ([action isKindOfClass:[HLRepeatAction class]]) {
+    HLRepeatAction *repeatAction = (HLRepeatAction *)action;
+    NSUInteger leafCount = [leaves count];
+    NSUInteger repeatLeafCount = HLTimelineActionLeafCount(repeatAction);
+    if (leafCount > HLTimelineActionMaximumLeafCount || repeatLeafCount > HLTimelineActionMaximumLeafCount - leafCount) {
+      // note: The repeat runs (and seeks) itself as a leaf, reusing its copies of the
+      // prototype across iterations.
+      [leaves addObject:action];
+      [startTimes appendBytes:&startTime length:sizeof(NSTimeInterval)];
+      return startTime + [action HL_completionTime];
+    }
+    NSTimeInterval time = startTime;
+    for (NSUInteger i = 0; i < repeatAction.count; ++i) {
+      time = HLTimelineActionFlatten([repeatAction.prototypeAction copy], time, leaves, startTimes);
+    }
+    return time;
+  }
+  [leaves addObject:action];
+  [startTimes appendBytes:&startTime length:sizeof(NSTimeInterval)];
+  return startTime + [action HL_completionTime];
+}
+
+@implementation HLTimelineAction
+{
+  // note: Leaves are sorted by start time.  Leaves before _cursor have started; those in
+  // [_firstActive, _cursor) not flagged in _completedFlags are running.  Start times are in
+  // the frame of the timeline, and the duration of the timeline is its completion time.
+  NSArray *_actions;
+  NSData *_startTimes;
+  NSMutableData *_completedFlags;
+  NSUInteger _cursor;
+  NSUInteger _firstActive;
+}
 
-- (instancetype)initWithAction:(HLAction *)prototypeAction count:(NSUInteger)count
++ (BOOL)canFlattenAction:(HLAction *)action
 {
-  if (!prototypeAction) {
-    [NSException raise:@"HLActionInvalid" format:@"A repeat action must be created with an action to repeat."];
+  if (!action || action.elapsedTime != 0.0) {
+    return NO;
   }
-  if (count == 0 && prototypeAction.duration == 0.0) {
-    [NSException raise:@"HLActionInvalid" format:@"An action to repeated forever must have a non-zero duration."];
+  if (!HLTimelineActionIsCollection(action)) {
+    return isfinite([action HL_completionTime]);
   }
-  self = [super initWithDuration:(prototypeAction.duration * count)];
-  if (self) {
-    _count = count;
-    _prototypeAction = prototypeAction;
+  if (action.speed != 1.0f || action.timingMode != HLActionTimingLinear) {
+    return NO;
   }
-  return self;
+  if ([action isKindOfClass:[HLRepeatAction class]]) {
+    HLRepeatAction *repeatAction = (HLRepeatAction *)action;
+    if (repeatAction.count == 0 || repeatAction.index != 0 || repeatAction.copiedAction) {
+      return NO;
+    }
+    return [self canFlattenAction:repeatAction.prototypeAction];
+  }
+  // note: For groups and sequences that have not yet been run, the non-completed actions
+  // are all the actions.
+  NSArray *actions = ([action isKindOfClass:[HLGroupAction class]] ? ((HLGroupAction *)action).actions : ((HLSequenceAction *)action).actions);
+  for (HLAction *member in actions) {
+    if (![self canFlattenAction:member]) {
+      return NO;
+    }
+  }
+  return YES;
 }
 
-- (instancetype)initWithAction:(HLAction *)prototypeAction
+- (instancetype)initWithAction:(HLAction *)action
 {
-  if (!prototypeAction) {
-    [NSException raise:@"HLActionInvalid" format:@"A repeat action must be created with an action to repeat."];
+  if (![HLTimelineAction canFlattenAction:action]) {
+    [NSException raise:@"HLActionInvalid" format:@"A timeline action must be created with an action that can be flattened."];
   }
-  if (prototypeAction.duration == 0.0) {
-    [NSException raise:@"HLActionInvalid" format:@"An action to be repeated forever must have a non-zero duration."];
+
+  NSMutableArray *leaves = [NSMutableArray array];
+  NSMutableData *leafStartTimes = [NSMutableData data];
+  NSTimeInterval completionTime = HLTimelineActionFlatten([action copy], 0.0, leaves, leafStartTimes);
+
+  // note: Stable sort by start time, so that leaves with the same start time stay in tree
+  // order.
+  NSUInteger leafCount = [leaves count];
+  const NSTimeInterval *leafStartTimesBytes = (const NSTimeInterval *)leafStartTimes.bytes;
+  NSMutableArray *leafIndexes = [NSMutableArray arrayWithCapacity:leafCount];
+  for (NSUInteger l = 0; l < leafCount; ++l) {
+    [leafIndexes addObject:@(l)];
   }
-  self = [super initWithDuration:0.0];
+  [leafIndexes sortWithOptions:NSSortStable usingComparator:^NSComparisonResult(NSNumber *a, NSNumber *b){
+    NSTimeInterval startTimeA = leafStartTimesBytes[[a unsignedIntegerValue]];
+    NSTimeInterval startTimeB = leafStartTimesBytes[[b unsignedIntegerValue]];
+    if (startTimeA < startTimeB) {
+      return NSOrderedAscending;
+    } else if (startTimeA > startTimeB) {
+      return NSOrderedDescending;
+    }
+    return NSOrderedSame;
+  }];
+  NSMutableArray *sortedLeaves = [NSMutableArray arrayWithCapacity:leafCount];
+  NSMutableData *sortedStartTimes = [NSMutableData dataWithLength:(leafCount * sizeof(NSTimeInterval))];
+  NSTimeInterval *sortedStartTimesBytes = (NSTimeInterval *)sortedStartTimes.mutableBytes;
+  for (NSUInteger l = 0; l < leafCount; ++l) {
+    NSUInteger leafIndex = [leafIndexes[l] unsignedIntegerValue];
+    [sortedLeaves addObject:leaves[leafIndex]];
+    sortedStartTimesBytes[l] = leafStartTimesBytes[leafIndex];
+  }
+
+  self = [super initWithDuration:completionTime];
   if (self) {
-    _prototypeAction = prototypeAction;
+    _actions = sortedLeaves;
+    _startTimes = sortedStartTimes;
+    _completedFlags = [NSMutableData dataWithLength:leafCount];
+    _cursor = 0;
+    _firstActive = 0;
   }
   return self;
 }
@@ -1197,10 +3765,11 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
 {
   self = [super initWithCoder:aDecoder];
   if (self) {
-    _count = (NSUInteger)[aDecoder decodeIntegerForKey:@"count"];
-    _index = (NSUInteger)[aDecoder decodeIntegerForKey:@"index"];
-    _prototypeAction = [aDecoder decodeObjectForKey:@"prototypeAction"];
-    _copiedAction = [aDecoder decodeObjectForKey:@"copiedAction"];
+    _actions = [aDecoder decodeObjectForKey:@"actions"];
+    _startTimes = [aDecoder decodeObjectForKey:@"startTimes"];
+    _completedFlags = [[aDecoder decodeObjectForKey:@"completedFlags"] mutableCopy];
+    _cursor = (NSUInteger)[aDecoder decodeIntegerForKey:@"cursor"];
+    _firstActive = (NSUInteger)[aDecoder decodeIntegerForKey:@"firstActive"];
   }
   return self;
 }
@@ -1208,30 +3777,53 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
 - (void)encodeWithCoder:(NSCoder *)aCoder
 {
   [super encodeWithCoder:aCoder];
-  [aCoder encodeInteger:(NSInteger)_count forKey:@"count"];
-  [aCoder encodeInteger:(NSInteger)_index forKey:@"index"];
-  [aCoder encodeObject:_prototypeAction forKey:@"prototypeAction"];
-  [aCoder encodeObject:_copiedAction forKey:@"copiedAction"];
+  [aCoder encodeObject:_actions forKey:@"actions"];
+  // note: The start times are encoded as raw doubles, which assumes the archive is decoded
+  // on a platform with the same byte order.
+  [aCoder encodeObject:_startTimes forKey:@"startTimes"];
+  [aCoder encodeObject:_completedFlags forKey:@"completedFlags"];
+  [aCoder encodeInteger:(NSInteger)_cursor forKey:@"cursor"];
+  [aCoder encodeInteger:(NSInteger)_firstActive forKey:@"firstActive"];
 }
 
 - (instancetype)copyWithZone:(NSZone *)zone
 {
-  HLRepeatAction *copy = [super copyWithZone:zone];
+  HLTimelineAction *copy = [super copyWithZone:zone];
   if (copy) {
-    copy->_count = _count;
-    copy->_index = _index;
-    copy->_prototypeAction = [_prototypeAction copy];
-    copy->_copiedAction = [_copiedAction copy];
+    copy->_actions = [[NSArray alloc] initWithArray:_actions copyItems:YES];
+    copy->_startTimes = _startTimes;
+    copy->_completedFlags = [_completedFlags mutableCopy];
+    copy->_cursor = _cursor;
+    copy->_firstActive = _firstActive;
   }
   return copy;
 }
 
+- (void)rewind
+{
+  [super rewind];
+  for (HLAction *action in _actions) {
+    [action rewind];
+  }
+  memset(_completedFlags.mutableBytes, 0, [_completedFlags length]);
+  _cursor = 0;
+  _firstActive = 0;
+}
+
+- (BOOL)canRewind
+{
+  for (HLAction *action in _actions) {
+    if (![action canRewind]) {
+      return NO;
+    }
+  }
+  return YES;
+}
+
 - (BOOL)HL_update:(NSTimeInterval)incrementalTime node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
 {
 #if DEBUG
   if (self.completed) {
-    // note: Some actions rely on this precondition (that update is not called after
-    // returning NO) more than others.  Probably things will break, but maybe not.
     HLLog(HLLogError, @"HLActions should not be updated after they have completed."
           " (Note that SKActions are immutable and can be reused multiple times,"
           " but HLActions are stateful and can only be used once.)");
@@ -1244,62 +3836,83 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   // note: "My frame" means adjusted for speed and timingMode.
   NSTimeInterval incrementalTimeMyFrame = elapsedTime - elapsedTimeOld;
 
-  NSTimeInterval remainingIncrementalTimeMyFrame = incrementalTimeMyFrame;
-  NSTimeInterval extraTimeMyFrame = incrementalTimeMyFrame;
-  while (_count == 0 || _index < _count) {
-    if (!_copiedAction) {
-      _copiedAction = [_prototypeAction copy];
+  uint8_t *flags = (uint8_t *)_completedFlags.mutableBytes;
+  const NSTimeInterval *startTimes = (const NSTimeInterval *)_startTimes.bytes;
+  NSUInteger actionsCount = [_actions count];
+  NSTimeInterval extraTimeMyFrame;
+
+  // note: Update running leaves, which all started before this update.
+  for (NSUInteger a = _firstActive; a < _cursor; ++a) {
+    if (flags[a]) {
+      continue;
     }
-    if ([_copiedAction HL_update:remainingIncrementalTimeMyFrame node:node extraTime:&extraTimeMyFrame]) {
-      break;
+    if (!HLActionUpdate(_actions[a], incrementalTimeMyFrame, node, &extraTimeMyFrame, nil)) {
+      flags[a] = 1;
     }
-    // note: This is a logic test in place for development that can be removed if it
-    // proves stable.  In the meantime, this extra-time translation is tricky, so the
-    // assert helps to make sure all actions claim to have a reasonable extra time
-    // remaining when completed.
-    assert(extraTimeMyFrame >= 0.0 && extraTimeMyFrame <= remainingIncrementalTimeMyFrame);
-    remainingIncrementalTimeMyFrame = extraTimeMyFrame;
-    ++_index;
-    _copiedAction = nil;
   }
 
-  // note: We are completed when our action has been repeated enough times, regardless of our
-  // elapsed time and duration (which don't account for the speed of our repeated action).
-  if (_copiedAction) {
+  // note: Start leaves whose start time has been reached, giving them only the part of the
+  // incremental time after their start (as a sequence would give the extra time of the
+  // previous action).  A leaf starting exactly now is still updated, with zero time, like
+  // the next action in a sequence.
+  while (_cursor < actionsCount && startTimes[_cursor] <= elapsedTime) {
+    NSUInteger a = _cursor;
+    ++_cursor;
+    if (!HLActionUpdate(_actions[a], elapsedTime - startTimes[a], node, &extraTimeMyFrame, nil)) {
+      flags[a] = 1;
+    }
+  }
+
+  while (_firstActive < _cursor && flags[_firstActive]) {
+    ++_firstActive;
+  }
+
+  if (_firstActive < actionsCount) {
     return YES;
+  }
+
+  // note: See HLGroupAction for translating extra time back into the caller's frame.
+  NSTimeInterval completionTimeMyFrame = MIN(self.duration, elapsedTime);
+  NSTimeInterval completionTimeLinear = [self HL_elapsedTimeLinearForElapsedTime:completionTimeMyFrame];
+  CGFloat speed = self.speed;
+  if (speed == 0.0f) {
+    *extraTime = incrementalTime;
   } else {
-    // note: We need to translate the extra time back into the caller's frame, which means
-    // accounting for our .speed and .timingMode, just as we did when converting
-    // incrementalTime into incrementalTimeMyFrame.
-    // completionTimeMyFrame: The completion time of this sequence, as an elapsed-time value
-    // measured in my frame (that is, translated by speed and timing mode).
-    NSTimeInterval completionTimeMyFrame = elapsedTime - extraTimeMyFrame;
-    // completionTimeLinear: The completion time of this group, as an elapsed-time value
-    // measured with a linear timing mode and according to my current speed.
-    NSTimeInterval completionTimeLinear = [self HL_elapsedTimeLinearForElapsedTime:completionTimeMyFrame];
-    CGFloat speed = self.speed;
-    // note: It should not be possible to complete the action with zero speed, but a little
-    // defensive programming seems appropriate here.
-    if (speed == 0.0f) {
-      assert(NO);
-      *extraTime = incrementalTime;
-    } else {
-      *extraTime = (self.elapsedTimeLinear - completionTimeLinear) / speed;
-      // note: Same assert as extraTimeMyFrame, above, but this time asserting our ability
-      // to successfully convert to the caller's time frame.
-      assert(*extraTime >= 0.0 && *extraTime <= incrementalTime);
-    }
+    *extraTime = MIN(incrementalTime, MAX(0.0, (self.elapsedTimeLinear - completionTimeLinear) / speed));
+  }
 #if DEBUG
-    self.completed = YES;
+  self.completed = YES;
 #endif
-    return NO;
-  }
+  return NO;
 }
 
 @end
 
 @implementation HLWaitAction
 
+- (BOOL)canRewind
+{
+  return YES;
+}
+
+- (BOOL)HL_canSeekBackward
+{
+  return YES;
+}
+
+- (NSTimeInterval)HL_idleTime
+{
+  NSTimeInterval remainingTimeLinear = self.duration - self.elapsedTimeLinear;
+  if (remainingTimeLinear <= 0.0) {
+    return 0.0;
+  }
+  CGFloat speed = self.speed;
+  if (speed == 0.0f) {
+    return INFINITY;
+  }
+  return remainingTimeLinear / speed;
+}
+
 - (BOOL)HL_update:(NSTimeInterval)incrementalTime node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
 {
 #if DEBUG
@@ -1374,6 +3987,38 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   return copy;
 }
 
+- (void)rewind
+{
+  [super rewind];
+  _lastCumulativeDeltaX = 0.0f;
+  _lastCumulativeDeltaY = 0.0f;
+}
+
+- (BOOL)canRewind
+{
+  return YES;
+}
+
+- (BOOL)HL_canSeekBackward
+{
+  return YES;
+}
+
+- (void)HL_resetElapsedTimeWithNode:(SKNode *)node
+{
+  // note: Undo the delta applied so far, so that the next update applies it from the start.
+  CGPoint instantaneousDelta = [self HL_instantaneousDelta];
+  if (node) {
+    CGPoint position = node.position;
+    position.x -= _lastCumulativeDeltaX + instantaneousDelta.x;
+    position.y -= _lastCumulativeDeltaY + instantaneousDelta.y;
+    node.position = position;
+  }
+  _lastCumulativeDeltaX = 0.0f;
+  _lastCumulativeDeltaY = 0.0f;
+  [super HL_resetElapsedTimeWithNode:node];
+}
+
 - (BOOL)HL_update:(NSTimeInterval)incrementalTime node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
 {
 #if DEBUG
@@ -1443,6 +4088,7 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
 @implementation HLMoveToAction
 {
   BOOL _isOriginSet;
+  BOOL _isOriginFromNode;
   CGPoint _origin;
   CGPoint _destination;
 }
@@ -1473,6 +4119,7 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   self = [super initWithCoder:aDecoder];
   if (self) {
     _isOriginSet = [aDecoder decodeBoolForKey:@"isOriginSet"];
+    _isOriginFromNode = [aDecoder decodeBoolForKey:@"isOriginFromNode"];
 #if TARGET_OS_IPHONE
     _origin = [aDecoder decodeCGPointForKey:@"origin"];
     _destination = [aDecoder decodeCGPointForKey:@"destination"];
@@ -1488,6 +4135,7 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
 {
   [super encodeWithCoder:aCoder];
   [aCoder encodeBool:_isOriginSet forKey:@"isOriginSet"];
+  [aCoder encodeBool:_isOriginFromNode forKey:@"isOriginFromNode"];
 #if TARGET_OS_IPHONE
   [aCoder encodeCGPoint:_origin forKey:@"origin"];
   [aCoder encodeCGPoint:_destination forKey:@"destination"];
@@ -1502,12 +4150,32 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   HLMoveToAction *copy = [super copyWithZone:zone];
   if (copy) {
     copy->_isOriginSet = _isOriginSet;
+    copy->_isOriginFromNode = _isOriginFromNode;
     copy->_origin = _origin;
     copy->_destination = _destination;
   }
   return copy;
 }
 
+- (void)rewind
+{
+  [super rewind];
+  if (_isOriginFromNode) {
+    _isOriginSet = NO;
+    _isOriginFromNode = NO;
+  }
+}
+
+- (BOOL)canRewind
+{
+  return YES;
+}
+
+- (BOOL)HL_canSeekBackward
+{
+  return YES;
+}
+
 - (BOOL)HL_update:(NSTimeInterval)incrementalTime node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
 {
 #if DEBUG
@@ -1529,6 +4197,7 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
     if (node) {
       _origin = node.position;
       _isOriginSet = YES;
+      _isOriginFromNode = YES;
     } else {
       [NSException raise:@"HLActionUninitialized" format:@"HLMoveToAction requires an origin:"
        " either pass a node to the first update,"
@@ -1903,6 +4572,121 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
 
 @end
 
+@implementation HLFollowPathAction
+
+- (instancetype)initWithPath:(HLCubicBezierPath *)path duration:(NSTimeInterval)duration
+{
+  if (!path) {
+    [NSException raise:@"HLActionInvalid" format:@"HLFollowPathAction requires a path."];
+  }
+  self = [super initWithDuration:duration];
+  if (self) {
+    _path = path;
+    _orientsToTangent = NO;
+  }
+  return self;
+}
+
+- (instancetype)initWithCoder:(NSCoder *)aDecoder
+{
+  self = [super initWithCoder:aDecoder];
+  if (self) {
+    _path = [aDecoder decodeObjectForKey:@"path"];
+    _orientsToTangent = [aDecoder decodeBoolForKey:@"orientsToTangent"];
+  }
+  return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{
+  [super encodeWithCoder:aCoder];
+  [aCoder encodeObject:_path forKey:@"path"];
+  [aCoder encodeBool:_orientsToTangent forKey:@"orientsToTangent"];
+}
+
+- (instancetype)copyWithZone:(NSZone *)zone
+{
+  HLFollowPathAction *copy = [super copyWithZone:zone];
+  if (copy) {
+    // note: The path is immutable, and shared (along with its arc length tables).
+    copy->_path = _path;
+    copy->_orientsToTangent = _orientsToTangent;
+  }
+  return copy;
+}
+
+- (BOOL)canRewind
+{
+  return YES;
+}
+
+- (BOOL)HL_canSeekBackward
+{
+  return YES;
+}
+
+- (BOOL)HL_update:(NSTimeInterval)incrementalTime node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
+{
+#if DEBUG
+  if (self.completed) {
+    // note: Some actions rely on this precondition (that update is not called after
+    // returning NO) more than others.  Probably things will break, but maybe not.
+    HLLog(HLLogError, @"HLActions should not be updated after they have completed."
+          " (Note that SKActions are immutable and can be reused multiple times,"
+          " but HLActions are stateful and can only be used once.)");
+  }
+#endif
+
+  BOOL notYetCompleted;
+  [self HL_advanceTime:incrementalTime extraTime:extraTime notYetCompleted:&notYetCompleted];
+
+  if (node) {
+    CGPoint position;
+    CGPoint tangent;
+    [_path getPoint:&position tangent:&tangent forArcLength:[self HL_arcLength]];
+    node.position = position;
+    if (_orientsToTangent && (tangent.x != 0.0f || tangent.y != 0.0f)) {
+      node.zRotation = (CGFloat)atan2(tangent.y, tangent.x);
+    }
+  }
+
+#if DEBUG
+  if (!notYetCompleted) {
+    self.completed = YES;
+  }
+#endif
+  return notYetCompleted;
+}
+
+- (CGPoint)position
+{
+  return [_path pointForArcLength:[self HL_arcLength]];
+}
+
+- (CGFloat)zRotation
+{
+  CGPoint tangent;
+  [_path getPoint:NULL tangent:&tangent forArcLength:[self HL_arcLength]];
+  if (tangent.x == 0.0f && tangent.y == 0.0f) {
+    return 0.0f;
+  }
+  return (CGFloat)atan2(tangent.y, tangent.x);
+}
+
+- (CGFloat)HL_arcLength
+{
+  NSTimeInterval elapsedTime = self.elapsedTime;
+  NSTimeInterval duration = self.duration;
+
+  if (elapsedTime >= duration) {
+    return _path.arcLength;
+  }
+
+  return (CGFloat)(elapsedTime / duration) * _path.arcLength;
+}
+
+@end
+
 @implementation HLChangeZPositionByAction
 {
   CGFloat _delta;
@@ -1928,21 +4712,48 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   return self;
 }
 
-- (void)encodeWithCoder:(NSCoder *)aCoder
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{
+  [super encodeWithCoder:aCoder];
+  [aCoder encodeDouble:_delta forKey:@"delta"];
+  [aCoder encodeDouble:_lastCumulativeDelta forKey:@"lastCumulativeDelta"];
+}
+
+- (instancetype)copyWithZone:(NSZone *)zone
+{
+  HLChangeZPositionByAction *copy = [super copyWithZone:zone];
+  if (copy) {
+    copy->_delta = _delta;
+    copy->_lastCumulativeDelta = _lastCumulativeDelta;
+  }
+  return copy;
+}
+
+- (void)rewind
+{
+  [super rewind];
+  _lastCumulativeDelta = 0.0f;
+}
+
+- (BOOL)canRewind
+{
+  return YES;
+}
+
+- (BOOL)HL_canSeekBackward
 {
-  [super encodeWithCoder:aCoder];
-  [aCoder encodeDouble:_delta forKey:@"delta"];
-  [aCoder encodeDouble:_lastCumulativeDelta forKey:@"lastCumulativeDelta"];
+  return YES;
 }
 
-- (instancetype)copyWithZone:(NSZone *)zone
+- (void)HL_resetElapsedTimeWithNode:(SKNode *)node
 {
-  HLChangeZPositionByAction *copy = [super copyWithZone:zone];
-  if (copy) {
-    copy->_delta = _delta;
-    copy->_lastCumulativeDelta = _lastCumulativeDelta;
+  // note: See [HLMoveByAction HL_resetElapsedTimeWithNode:].
+  CGFloat instantaneousDelta = [self HL_instantaneousDelta];
+  if (node) {
+    node.zPosition -= _lastCumulativeDelta + instantaneousDelta;
   }
-  return copy;
+  _lastCumulativeDelta = 0.0f;
+  [super HL_resetElapsedTimeWithNode:node];
 }
 
 - (BOOL)HL_update:(NSTimeInterval)incrementalTime node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
@@ -2008,6 +4819,7 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
 @implementation HLChangeZPositionToAction
 {
   BOOL _isZPositionFromSet;
+  BOOL _isZPositionFromNode;
   CGFloat _zPositionFrom;
   CGFloat _zPositionTo;
 }
@@ -2038,6 +4850,7 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   self = [super initWithCoder:aDecoder];
   if (self) {
     _isZPositionFromSet = [aDecoder decodeBoolForKey:@"isZPositionFromSet"];
+    _isZPositionFromNode = [aDecoder decodeBoolForKey:@"isZPositionFromNode"];
     _zPositionFrom = (CGFloat)[aDecoder decodeDoubleForKey:@"zPositionFrom"];
     _zPositionTo = (CGFloat)[aDecoder decodeDoubleForKey:@"zPositionTo"];
   }
@@ -2048,6 +4861,7 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
 {
   [super encodeWithCoder:aCoder];
   [aCoder encodeBool:_isZPositionFromSet forKey:@"isZPositionFromSet"];
+  [aCoder encodeBool:_isZPositionFromNode forKey:@"isZPositionFromNode"];
   [aCoder encodeDouble:_zPositionFrom forKey:@"zPositionFrom"];
   [aCoder encodeDouble:_zPositionTo forKey:@"zPositionTo"];
 }
@@ -2057,12 +4871,32 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   HLChangeZPositionToAction *copy = [super copyWithZone:zone];
   if (copy) {
     copy->_isZPositionFromSet = _isZPositionFromSet;
+    copy->_isZPositionFromNode = _isZPositionFromNode;
     copy->_zPositionFrom = _zPositionFrom;
     copy->_zPositionTo = _zPositionTo;
   }
   return copy;
 }
 
+- (void)rewind
+{
+  [super rewind];
+  if (_isZPositionFromNode) {
+    _isZPositionFromSet = NO;
+    _isZPositionFromNode = NO;
+  }
+}
+
+- (BOOL)canRewind
+{
+  return YES;
+}
+
+- (BOOL)HL_canSeekBackward
+{
+  return YES;
+}
+
 - (BOOL)HL_update:(NSTimeInterval)incrementalTime node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
 {
 #if DEBUG
@@ -2079,6 +4913,7 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
     if (node) {
       _zPositionFrom = node.zPosition;
       _isZPositionFromSet = YES;
+      _isZPositionFromNode = YES;
     } else {
       [NSException raise:@"HLActionUninitialized" format:@"HLChangeZPositionToAction requires a z-position-from:"
        " either pass a node to the first update,"
@@ -2169,6 +5004,33 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   return copy;
 }
 
+- (void)rewind
+{
+  [super rewind];
+  _lastCumulativeDelta = 0.0f;
+}
+
+- (BOOL)canRewind
+{
+  return YES;
+}
+
+- (BOOL)HL_canSeekBackward
+{
+  return YES;
+}
+
+- (void)HL_resetElapsedTimeWithNode:(SKNode *)node
+{
+  // note: See [HLMoveByAction HL_resetElapsedTimeWithNode:].
+  CGFloat instantaneousDelta = [self HL_instantaneousDelta];
+  if (node) {
+    node.zRotation -= _lastCumulativeDelta + instantaneousDelta;
+  }
+  _lastCumulativeDelta = 0.0f;
+  [super HL_resetElapsedTimeWithNode:node];
+}
+
 - (BOOL)HL_update:(NSTimeInterval)incrementalTime node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
 {
 #if DEBUG
@@ -2233,6 +5095,7 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
 @implementation HLRotateToAction
 {
   BOOL _isAngleFromSet;
+  BOOL _isAngleFromNode;
   CGFloat _angleFrom;
   CGFloat _angleTo;
   BOOL _shortestUnitArc;
@@ -2270,6 +5133,7 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   self = [super initWithCoder:aDecoder];
   if (self) {
     _isAngleFromSet = [aDecoder decodeBoolForKey:@"isAngleFromSet"];
+    _isAngleFromNode = [aDecoder decodeBoolForKey:@"isAngleFromNode"];
     _angleFrom = (CGFloat)[aDecoder decodeDoubleForKey:@"angleFrom"];
     _angleTo = (CGFloat)[aDecoder decodeDoubleForKey:@"angleTo"];
     _shortestUnitArc = [aDecoder decodeBoolForKey:@"shortestUnitArc"];
@@ -2281,6 +5145,7 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
 {
   [super encodeWithCoder:aCoder];
   [aCoder encodeBool:_isAngleFromSet forKey:@"isAngleFromSet"];
+  [aCoder encodeBool:_isAngleFromNode forKey:@"isAngleFromNode"];
   [aCoder encodeDouble:_angleFrom forKey:@"angleFrom"];
   [aCoder encodeDouble:_angleTo forKey:@"angleTo"];
   [aCoder encodeBool:_shortestUnitArc forKey:@"shortestUnitArc"];
@@ -2291,6 +5156,7 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   HLRotateToAction *copy = [super copyWithZone:zone];
   if (copy) {
     copy->_isAngleFromSet = _isAngleFromSet;
+    copy->_isAngleFromNode = _isAngleFromNode;
     copy->_angleFrom = _angleFrom;
     copy->_angleTo = _angleTo;
     copy->_shortestUnitArc = _shortestUnitArc;
@@ -2298,6 +5164,25 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   return copy;
 }
 
+- (void)rewind
+{
+  [super rewind];
+  if (_isAngleFromNode) {
+    _isAngleFromSet = NO;
+    _isAngleFromNode = NO;
+  }
+}
+
+- (BOOL)canRewind
+{
+  return YES;
+}
+
+- (BOOL)HL_canSeekBackward
+{
+  return YES;
+}
+
 - (BOOL)HL_update:(NSTimeInterval)incrementalTime node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
 {
 #if DEBUG
@@ -2318,6 +5203,7 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
         _angleFrom = node.zRotation;
       }
       _isAngleFromSet = YES;
+      _isAngleFromNode = YES;
     } else {
       [NSException raise:@"HLActionUninitialized" format:@"HLRotateToAction requires an angle-from:"
        " either pass a node to the first update,"
@@ -2426,6 +5312,34 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   return copy;
 }
 
+- (void)rewind
+{
+  [super rewind];
+  _lastCumulativeDelta = 0.0f;
+}
+
+- (BOOL)canRewind
+{
+  return YES;
+}
+
+- (BOOL)HL_canSeekBackward
+{
+  return YES;
+}
+
+- (void)HL_resetElapsedTimeWithNode:(SKNode *)node
+{
+  // note: See [HLMoveByAction HL_resetElapsedTimeWithNode:].
+  CGFloat instantaneousDelta = [self HL_instantaneousDelta];
+  if (node) {
+    node.xScale -= _lastCumulativeDelta + instantaneousDelta;
+    node.yScale -= _lastCumulativeDelta + instantaneousDelta;
+  }
+  _lastCumulativeDelta = 0.0f;
+  [super HL_resetElapsedTimeWithNode:node];
+}
+
 - (BOOL)HL_update:(NSTimeInterval)incrementalTime node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
 {
 #if DEBUG
@@ -2539,6 +5453,38 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   return copy;
 }
 
+- (void)rewind
+{
+  [super rewind];
+  _lastCumulativeDeltaX = 0.0f;
+  _lastCumulativeDeltaY = 0.0f;
+}
+
+- (BOOL)canRewind
+{
+  return YES;
+}
+
+- (BOOL)HL_canSeekBackward
+{
+  return YES;
+}
+
+- (void)HL_resetElapsedTimeWithNode:(SKNode *)node
+{
+  // note: See [HLMoveByAction HL_resetElapsedTimeWithNode:].
+  CGFloat instantaneousDeltaX;
+  CGFloat instantaneousDeltaY;
+  [self HL_instantaneousDeltaX:&instantaneousDeltaX instantaneousDeltaY:&instantaneousDeltaY];
+  if (node) {
+    node.xScale -= _lastCumulativeDeltaX + instantaneousDeltaX;
+    node.yScale -= _lastCumulativeDeltaY + instantaneousDeltaY;
+  }
+  _lastCumulativeDeltaX = 0.0f;
+  _lastCumulativeDeltaY = 0.0f;
+  [super HL_resetElapsedTimeWithNode:node];
+}
+
 - (BOOL)HL_update:(NSTimeInterval)incrementalTime node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
 {
 #if DEBUG
@@ -2624,6 +5570,7 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
 @implementation HLScaleToAction
 {
   BOOL _isFromSet;
+  BOOL _isFromNode;
   CGFloat _xFrom;
   CGFloat _yFrom;
   CGFloat _xTo;
@@ -2659,6 +5606,7 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   self = [super initWithCoder:aDecoder];
   if (self) {
     _isFromSet = [aDecoder decodeBoolForKey:@"isFromSet"];
+    _isFromNode = [aDecoder decodeBoolForKey:@"isFromNode"];
     _xFrom = (CGFloat)[aDecoder decodeDoubleForKey:@"xFrom"];
     _yFrom = (CGFloat)[aDecoder decodeDoubleForKey:@"yFrom"];
     _xTo = (CGFloat)[aDecoder decodeDoubleForKey:@"xTo"];
@@ -2671,6 +5619,7 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
 {
   [super encodeWithCoder:aCoder];
   [aCoder encodeBool:_isFromSet forKey:@"isFromSet"];
+  [aCoder encodeBool:_isFromNode forKey:@"isFromNode"];
   [aCoder encodeDouble:_xFrom forKey:@"xFrom"];
   [aCoder encodeDouble:_yFrom forKey:@"yFrom"];
   [aCoder encodeDouble:_xTo forKey:@"xTo"];
@@ -2682,6 +5631,7 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   HLScaleToAction *copy = [super copyWithZone:zone];
   if (copy) {
     copy->_isFromSet = _isFromSet;
+    copy->_isFromNode = _isFromNode;
     copy->_xFrom = _xFrom;
     copy->_yFrom = _yFrom;
     copy->_xTo = _xTo;
@@ -2690,6 +5640,25 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   return copy;
 }
 
+- (void)rewind
+{
+  [super rewind];
+  if (_isFromNode) {
+    _isFromSet = NO;
+    _isFromNode = NO;
+  }
+}
+
+- (BOOL)canRewind
+{
+  return YES;
+}
+
+- (BOOL)HL_canSeekBackward
+{
+  return YES;
+}
+
 - (BOOL)HL_update:(NSTimeInterval)incrementalTime node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
 {
 #if DEBUG
@@ -2707,6 +5676,7 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
       _xFrom = node.xScale;
       _yFrom = node.yScale;
       _isFromSet = YES;
+      _isFromNode = YES;
     } else {
       [NSException raise:@"HLActionUninitialized" format:@"HLScaleToAction requires original scale values:"
        " either pass a node to the first update,"
@@ -2828,6 +5798,33 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   return copy;
 }
 
+- (void)rewind
+{
+  [super rewind];
+  _lastCumulativeDelta = 0.0f;
+}
+
+- (BOOL)canRewind
+{
+  return YES;
+}
+
+- (BOOL)HL_canSeekBackward
+{
+  return YES;
+}
+
+- (void)HL_resetElapsedTimeWithNode:(SKNode *)node
+{
+  // note: See [HLMoveByAction HL_resetElapsedTimeWithNode:].
+  CGFloat instantaneousDelta = [self HL_instantaneousDelta];
+  if (node) {
+    node.alpha -= _lastCumulativeDelta + instantaneousDelta;
+  }
+  _lastCumulativeDelta = 0.0f;
+  [super HL_resetElapsedTimeWithNode:node];
+}
+
 - (BOOL)HL_update:(NSTimeInterval)incrementalTime node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
 {
 #if DEBUG
@@ -2854,8 +5851,151 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   [self HL_advanceTime:incrementalTime extraTime:extraTime notYetCompleted:&notYetCompleted];
 
   if (node) {
-    CGFloat instantaneousDelta = [self HL_instantaneousDelta];
-    node.alpha += instantaneousDelta;
+    CGFloat instantaneousDelta = [self HL_instantaneousDelta];
+    node.alpha += instantaneousDelta;
+  }
+
+#if DEBUG
+  if (!notYetCompleted) {
+    self.completed = YES;
+  }
+#endif
+  return notYetCompleted;
+}
+
+- (CGFloat)instantaneousDelta
+{
+  CGFloat instantaneousDelta = [self HL_instantaneousDelta];
+  return instantaneousDelta;
+}
+
+- (CGFloat)HL_instantaneousDelta
+{
+  NSTimeInterval elapsedTime = self.elapsedTime;
+  NSTimeInterval duration = self.duration;
+
+  CGFloat instantaneousDelta;
+  if (elapsedTime >= duration) {
+    instantaneousDelta = _delta - _lastCumulativeDelta;
+  } else {
+    CGFloat normalTime = elapsedTime / duration;
+    instantaneousDelta = _delta * normalTime - _lastCumulativeDelta;
+  }
+  return instantaneousDelta;
+}
+
+@end
+
+@implementation HLFadeAlphaToAction
+{
+  BOOL _isAlphaFromSet;
+  BOOL _isAlphaFromNode;
+  CGFloat _alphaFrom;
+  CGFloat _alphaTo;
+}
+
+- (instancetype)initWithAlphaTo:(CGFloat)alphaTo duration:(NSTimeInterval)duration
+{
+  self = [super initWithDuration:duration];
+  if (self) {
+    _isAlphaFromSet = NO;
+    _alphaTo = alphaTo;
+  }
+  return self;
+}
+
+- (instancetype)initWithAlphaFrom:(CGFloat)alphaFrom to:(CGFloat)alphaTo duration:(NSTimeInterval)duration
+{
+  self = [super initWithDuration:duration];
+  if (self) {
+    _isAlphaFromSet = YES;
+    _alphaFrom = alphaFrom;
+    _alphaTo = alphaTo;
+  }
+  return self;
+}
+
+- (instancetype)initWithCoder:(NSCoder *)aDecoder
+{
+  self = [super initWithCoder:aDecoder];
+  if (self) {
+    _isAlphaFromSet = [aDecoder decodeBoolForKey:@"isAlphaFromSet"];
+    _isAlphaFromNode = [aDecoder decodeBoolForKey:@"isAlphaFromNode"];
+    _alphaFrom = (CGFloat)[aDecoder decodeDoubleForKey:@"alphaFrom"];
+    _alphaTo = (CGFloat)[aDecoder decodeDoubleForKey:@"alphaTo"];
+  }
+  return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{
+  [super encodeWithCoder:aCoder];
+  [aCoder encodeBool:_isAlphaFromSet forKey:@"isAlphaFromSet"];
+  [aCoder encodeBool:_isAlphaFromNode forKey:@"isAlphaFromNode"];
+  [aCoder encodeDouble:_alphaFrom forKey:@"alphaFrom"];
+  [aCoder encodeDouble:_alphaTo forKey:@"alphaTo"];
+}
+
+- (instancetype)copyWithZone:(NSZone *)zone
+{
+  HLFadeAlphaToAction *copy = [super copyWithZone:zone];
+  if (copy) {
+    copy->_isAlphaFromSet = _isAlphaFromSet;
+    copy->_isAlphaFromNode = _isAlphaFromNode;
+    copy->_alphaFrom = _alphaFrom;
+    copy->_alphaTo = _alphaTo;
+  }
+  return copy;
+}
+
+- (void)rewind
+{
+  [super rewind];
+  if (_isAlphaFromNode) {
+    _isAlphaFromSet = NO;
+    _isAlphaFromNode = NO;
+  }
+}
+
+- (BOOL)canRewind
+{
+  return YES;
+}
+
+- (BOOL)HL_canSeekBackward
+{
+  return YES;
+}
+
+- (BOOL)HL_update:(NSTimeInterval)incrementalTime node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
+{
+#if DEBUG
+  if (self.completed) {
+    // note: Some actions rely on this precondition (that update is not called after
+    // returning NO) more than others.  Probably things will break, but maybe not.
+    HLLog(HLLogError, @"HLActions should not be updated after they have completed."
+          " (Note that SKActions are immutable and can be reused multiple times,"
+          " but HLActions are stateful and can only be used once.)");
+  }
+#endif
+
+  if (!_isAlphaFromSet) {
+    if (node) {
+      _alphaFrom = node.alpha;
+      _isAlphaFromSet = YES;
+      _isAlphaFromNode = YES;
+    } else {
+      [NSException raise:@"HLActionUninitialized" format:@"HLFadeAlphaToAction requires an alpha-from:"
+       " either pass a node to the first update,"
+       " or initialize with initWithAlphaFrom:to:duration:."];
+    }
+  }
+
+  BOOL notYetCompleted;
+  [self HL_advanceTime:incrementalTime extraTime:extraTime notYetCompleted:&notYetCompleted];
+
+  if (node) {
+    node.alpha = [self HL_alpha];
   }
 
 #if DEBUG
@@ -2866,53 +6006,155 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   return notYetCompleted;
 }
 
-- (CGFloat)instantaneousDelta
+- (CGFloat)alpha
 {
-  CGFloat instantaneousDelta = [self HL_instantaneousDelta];
-  return instantaneousDelta;
+  if (!_isAlphaFromSet) {
+    [NSException raise:@"HLActionUninitialized" format:@"HLFadeAlphaToAction requires an alpha-from:"
+     " either pass a node to the first update,"
+     " or initialize with initWithAlphaFrom:to:duration:."];
+  }
+  return [self HL_alpha];
 }
 
-- (CGFloat)HL_instantaneousDelta
+- (CGFloat)HL_alpha
 {
   NSTimeInterval elapsedTime = self.elapsedTime;
   NSTimeInterval duration = self.duration;
 
-  CGFloat instantaneousDelta;
   if (elapsedTime >= duration) {
-    instantaneousDelta = _delta - _lastCumulativeDelta;
-  } else {
-    CGFloat normalTime = elapsedTime / duration;
-    instantaneousDelta = _delta * normalTime - _lastCumulativeDelta;
+    return _alphaTo;
   }
-  return instantaneousDelta;
+
+  CGFloat normalTime = elapsedTime / duration;
+
+  return _alphaFrom * (1.0f - normalTime) + _alphaTo * normalTime;
 }
 
 @end
 
-@implementation HLFadeAlphaToAction
+// note: Keyframe values are stored as a flat array of components: for each keyframe, the
+// components of each animated channel, in the order of the channel flags.
+enum {
+  HLKeyframeActionComponentCountMax = 6,
+};
+
+static NSUInteger
+HLKeyframeActionComponentCount(HLKeyframeActionChannels channels)
 {
-  BOOL _isAlphaFromSet;
-  CGFloat _alphaFrom;
-  CGFloat _alphaTo;
+  NSUInteger componentCount = 0;
+  if (channels & HLKeyframeActionChannelPosition) {
+    componentCount += 2;
+  }
+  if (channels & HLKeyframeActionChannelScale) {
+    componentCount += 2;
+  }
+  if (channels & HLKeyframeActionChannelAlpha) {
+    componentCount += 1;
+  }
+  if (channels & HLKeyframeActionChannelRotation) {
+    componentCount += 1;
+  }
+  return componentCount;
 }
 
-- (instancetype)initWithAlphaTo:(CGFloat)alphaTo duration:(NSTimeInterval)duration
+static void
+HLKeyframeActionGetComponents(const HLKeyframe *keyframe, HLKeyframeActionChannels channels, CGFloat *components)
 {
-  self = [super initWithDuration:duration];
-  if (self) {
-    _isAlphaFromSet = NO;
-    _alphaTo = alphaTo;
+  if (channels & HLKeyframeActionChannelPosition) {
+    *components++ = keyframe->position.x;
+    *components++ = keyframe->position.y;
+  }
+  if (channels & HLKeyframeActionChannelScale) {
+    *components++ = keyframe->xScale;
+    *components++ = keyframe->yScale;
+  }
+  if (channels & HLKeyframeActionChannelAlpha) {
+    *components++ = keyframe->alpha;
+  }
+  if (channels & HLKeyframeActionChannelRotation) {
+    *components++ = keyframe->zRotation;
   }
-  return self;
 }
 
-- (instancetype)initWithAlphaFrom:(CGFloat)alphaFrom to:(CGFloat)alphaTo duration:(NSTimeInterval)duration
+static void
+HLKeyframeActionSetComponents(HLKeyframe *keyframe, HLKeyframeActionChannels channels, const CGFloat *components)
 {
-  self = [super initWithDuration:duration];
+  if (channels & HLKeyframeActionChannelPosition) {
+    keyframe->position.x = *components++;
+    keyframe->position.y = *components++;
+  }
+  if (channels & HLKeyframeActionChannelScale) {
+    keyframe->xScale = *components++;
+    keyframe->yScale = *components++;
+  }
+  if (channels & HLKeyframeActionChannelAlpha) {
+    keyframe->alpha = *components++;
+  }
+  if (channels & HLKeyframeActionChannelRotation) {
+    keyframe->zRotation = *components++;
+  }
+}
+
+static void
+HLKeyframeActionSetNodeComponents(SKNode *node, HLKeyframeActionChannels channels, const CGFloat *components)
+{
+  if (channels & HLKeyframeActionChannelPosition) {
+    node.position = CGPointMake(components[0], components[1]);
+    components += 2;
+  }
+  if (channels & HLKeyframeActionChannelScale) {
+    node.xScale = components[0];
+    node.yScale = components[1];
+    components += 2;
+  }
+  if (channels & HLKeyframeActionChannelAlpha) {
+    node.alpha = *components++;
+  }
+  if (channels & HLKeyframeActionChannelRotation) {
+    node.zRotation = *components++;
+  }
+}
+
+@implementation HLKeyframeAction
+{
+  HLKeyframeActionChannels _channels;
+  NSUInteger _keyframeCount;
+  NSUInteger _componentCount;
+  // note: The keyframe arrays are immutable once created, and so copies of the action share
+  // them.  The data objects own the arrays; the pointers are cached for update.
+  NSData *_timesData;
+  NSData *_componentsData;
+  NSData *_timingModesData;
+  const CGFloat *_times;
+  const CGFloat *_components;
+  const HLActionTimingMode *_timingModes;
+  // note: The segment found by the last update; see HLPiecewiseLinearSegmentIndex().
+  NSUInteger _segmentIndexHint;
+}
+
+- (instancetype)initWithKeyframes:(const HLKeyframe *)keyframes count:(NSUInteger)keyframeCount channels:(HLKeyframeActionChannels)channels
+{
+  if (!keyframes || keyframeCount == 0) {
+    [NSException raise:@"HLActionInvalid" format:@"HLKeyframeAction must have at least one keyframe."];
+  }
+  self = [super initWithDuration:keyframes[keyframeCount - 1].time];
   if (self) {
-    _isAlphaFromSet = YES;
-    _alphaFrom = alphaFrom;
-    _alphaTo = alphaTo;
+    NSUInteger componentCount = HLKeyframeActionComponentCount(channels);
+    NSMutableData *timesData = [NSMutableData dataWithLength:(sizeof(CGFloat) * keyframeCount)];
+    NSMutableData *componentsData = [NSMutableData dataWithLength:(sizeof(CGFloat) * keyframeCount * componentCount)];
+    NSMutableData *timingModesData = [NSMutableData dataWithLength:(sizeof(HLActionTimingMode) * keyframeCount)];
+    CGFloat *times = (CGFloat *)[timesData mutableBytes];
+    CGFloat *components = (CGFloat *)[componentsData mutableBytes];
+    HLActionTimingMode *timingModes = (HLActionTimingMode *)[timingModesData mutableBytes];
+    for (NSUInteger k = 0; k < keyframeCount; ++k) {
+      if (keyframes[k].time < 0.0 || (k > 0 && keyframes[k].time <= keyframes[k - 1].time)) {
+        [NSException raise:@"HLActionInvalid" format:@"HLKeyframeAction must have non-negative, strictly-increasing keyframe times."];
+      }
+      times[k] = (CGFloat)keyframes[k].time;
+      HLKeyframeActionGetComponents(&keyframes[k], channels, components + k * componentCount);
+      timingModes[k] = keyframes[k].timingMode;
+    }
+    [self HL_setChannels:channels keyframeCount:keyframeCount timesData:timesData componentsData:componentsData timingModesData:timingModesData];
   }
   return self;
 }
@@ -2921,9 +6163,31 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
 {
   self = [super initWithCoder:aDecoder];
   if (self) {
-    _isAlphaFromSet = [aDecoder decodeBoolForKey:@"isAlphaFromSet"];
-    _alphaFrom = (CGFloat)[aDecoder decodeDoubleForKey:@"alphaFrom"];
-    _alphaTo = (CGFloat)[aDecoder decodeDoubleForKey:@"alphaTo"];
+    HLKeyframeActionChannels channels = (HLKeyframeActionChannels)[aDecoder decodeIntegerForKey:@"channels"];
+    NSArray *times = [aDecoder decodeObjectForKey:@"keyframeTimes"];
+    NSArray *components = [aDecoder decodeObjectForKey:@"keyframeComponents"];
+    NSArray *timingModes = [aDecoder decodeObjectForKey:@"keyframeTimingModes"];
+    NSUInteger keyframeCount = [times count];
+    NSUInteger componentCount = HLKeyframeActionComponentCount(channels);
+    if (keyframeCount == 0
+        || [components count] != keyframeCount * componentCount
+        || [timingModes count] != keyframeCount) {
+      [NSException raise:NSInvalidUnarchiveOperationException format:@"HLKeyframeAction has inconsistent keyframe arrays."];
+    }
+    NSMutableData *timesData = [NSMutableData dataWithLength:(sizeof(CGFloat) * keyframeCount)];
+    NSMutableData *componentsData = [NSMutableData dataWithLength:(sizeof(CGFloat) * keyframeCount * componentCount)];
+    NSMutableData *timingModesData = [NSMutableData dataWithLength:(sizeof(HLActionTimingMode) * keyframeCount)];
+    CGFloat *timesBytes = (CGFloat *)[timesData mutableBytes];
+    CGFloat *componentsBytes = (CGFloat *)[componentsData mutableBytes];
+    HLActionTimingMode *timingModesBytes = (HLActionTimingMode *)[timingModesData mutableBytes];
+    for (NSUInteger k = 0; k < keyframeCount; ++k) {
+      timesBytes[k] = (CGFloat)[times[k] doubleValue];
+      timingModesBytes[k] = (HLActionTimingMode)[timingModes[k] integerValue];
+    }
+    for (NSUInteger c = 0; c < keyframeCount * componentCount; ++c) {
+      componentsBytes[c] = (CGFloat)[components[c] doubleValue];
+    }
+    [self HL_setChannels:channels keyframeCount:keyframeCount timesData:timesData componentsData:componentsData timingModesData:timingModesData];
   }
   return self;
 }
@@ -2931,22 +6195,48 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
 - (void)encodeWithCoder:(NSCoder *)aCoder
 {
   [super encodeWithCoder:aCoder];
-  [aCoder encodeBool:_isAlphaFromSet forKey:@"isAlphaFromSet"];
-  [aCoder encodeDouble:_alphaFrom forKey:@"alphaFrom"];
-  [aCoder encodeDouble:_alphaTo forKey:@"alphaTo"];
+  [aCoder encodeInteger:(NSInteger)_channels forKey:@"channels"];
+  NSMutableArray *times = [NSMutableArray arrayWithCapacity:_keyframeCount];
+  NSMutableArray *timingModes = [NSMutableArray arrayWithCapacity:_keyframeCount];
+  for (NSUInteger k = 0; k < _keyframeCount; ++k) {
+    [times addObject:@(_times[k])];
+    [timingModes addObject:@(_timingModes[k])];
+  }
+  NSMutableArray *components = [NSMutableArray arrayWithCapacity:(_keyframeCount * _componentCount)];
+  for (NSUInteger c = 0; c < _keyframeCount * _componentCount; ++c) {
+    [components addObject:@(_components[c])];
+  }
+  [aCoder encodeObject:times forKey:@"keyframeTimes"];
+  [aCoder encodeObject:components forKey:@"keyframeComponents"];
+  [aCoder encodeObject:timingModes forKey:@"keyframeTimingModes"];
 }
 
 - (instancetype)copyWithZone:(NSZone *)zone
 {
-  HLFadeAlphaToAction *copy = [super copyWithZone:zone];
+  HLKeyframeAction *copy = [super copyWithZone:zone];
   if (copy) {
-    copy->_isAlphaFromSet = _isAlphaFromSet;
-    copy->_alphaFrom = _alphaFrom;
-    copy->_alphaTo = _alphaTo;
+    [copy HL_setChannels:_channels keyframeCount:_keyframeCount timesData:_timesData componentsData:_componentsData timingModesData:_timingModesData];
+    copy->_segmentIndexHint = _segmentIndexHint;
   }
   return copy;
 }
 
+- (void)rewind
+{
+  [super rewind];
+  _segmentIndexHint = 0;
+}
+
+- (BOOL)canRewind
+{
+  return YES;
+}
+
+- (BOOL)HL_canSeekBackward
+{
+  return YES;
+}
+
 - (BOOL)HL_update:(NSTimeInterval)incrementalTime node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
 {
 #if DEBUG
@@ -2959,22 +6249,14 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   }
 #endif
 
-  if (!_isAlphaFromSet) {
-    if (node) {
-      _alphaFrom = node.alpha;
-      _isAlphaFromSet = YES;
-    } else {
-      [NSException raise:@"HLActionUninitialized" format:@"HLFadeAlphaToAction requires an alpha-from:"
-       " either pass a node to the first update,"
-       " or initialize with initWithAlphaFrom:to:duration:."];
-    }
-  }
-
   BOOL notYetCompleted;
   [self HL_advanceTime:incrementalTime extraTime:extraTime notYetCompleted:&notYetCompleted];
 
   if (node) {
-    node.alpha = [self HL_alpha];
+    CGFloat components[HLKeyframeActionComponentCountMax];
+    HLActionTimingMode timingMode;
+    [self HL_getComponents:components timingMode:&timingMode forTime:(CGFloat)self.elapsedTime segmentIndexHint:&_segmentIndexHint];
+    HLKeyframeActionSetNodeComponents(node, _channels, components);
   }
 
 #if DEBUG
@@ -2985,40 +6267,125 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   return notYetCompleted;
 }
 
-- (CGFloat)alpha
+- (HLKeyframeActionChannels)channels
 {
-  if (!_isAlphaFromSet) {
-    [NSException raise:@"HLActionUninitialized" format:@"HLFadeAlphaToAction requires an alpha-from:"
-     " either pass a node to the first update,"
-     " or initialize with initWithAlphaFrom:to:duration:."];
+  return _channels;
+}
+
+- (NSUInteger)keyframeCount
+{
+  return _keyframeCount;
+}
+
+- (HLKeyframe)keyframeAtIndex:(NSUInteger)index
+{
+  if (index >= _keyframeCount) {
+    [NSException raise:NSRangeException format:@"Keyframe index %lu out of range.", (unsigned long)index];
   }
-  return [self HL_alpha];
+  HLKeyframe keyframe = { 0 };
+  keyframe.time = _times[index];
+  keyframe.timingMode = _timingModes[index];
+  HLKeyframeActionSetComponents(&keyframe, _channels, _components + index * _componentCount);
+  return keyframe;
 }
 
-- (CGFloat)HL_alpha
+- (HLKeyframe)currentKeyframe
 {
-  NSTimeInterval elapsedTime = self.elapsedTime;
-  NSTimeInterval duration = self.duration;
+  return [self keyframeForTime:self.elapsedTime];
+}
 
-  if (elapsedTime >= duration) {
-    return _alphaTo;
+- (HLKeyframe)keyframeForTime:(NSTimeInterval)time
+{
+  HLKeyframe keyframe;
+  [self getKeyframes:&keyframe forTimes:&time count:1];
+  return keyframe;
+}
+
+- (void)getKeyframes:(HLKeyframe *)keyframes forTimes:(const NSTimeInterval *)times count:(NSUInteger)count
+{
+  // note: Sampling uses its own hint, so as not to disturb the state of the action.
+  NSUInteger segmentIndexHint = _segmentIndexHint;
+  for (NSUInteger s = 0; s < count; ++s) {
+    CGFloat components[HLKeyframeActionComponentCountMax];
+    HLKeyframe *keyframe = &keyframes[s];
+    *keyframe = (HLKeyframe){ 0 };
+    keyframe->time = times[s];
+    [self HL_getComponents:components timingMode:&keyframe->timingMode forTime:(CGFloat)times[s] segmentIndexHint:&segmentIndexHint];
+    HLKeyframeActionSetComponents(keyframe, _channels, components);
   }
+}
 
-  CGFloat normalTime = elapsedTime / duration;
+- (void)HL_setChannels:(HLKeyframeActionChannels)channels
+         keyframeCount:(NSUInteger)keyframeCount
+             timesData:(NSData *)timesData
+        componentsData:(NSData *)componentsData
+       timingModesData:(NSData *)timingModesData
+{
+  _channels = channels;
+  _keyframeCount = keyframeCount;
+  _componentCount = HLKeyframeActionComponentCount(channels);
+  _timesData = timesData;
+  _componentsData = componentsData;
+  _timingModesData = timingModesData;
+  _times = (const CGFloat *)[timesData bytes];
+  _components = (const CGFloat *)[componentsData bytes];
+  _timingModes = (const HLActionTimingMode *)[timingModesData bytes];
+}
 
-  return _alphaFrom * (1.0f - normalTime) + _alphaTo * normalTime;
+- (void)HL_getComponents:(CGFloat *)components
+              timingMode:(HLActionTimingMode *)timingMode
+                 forTime:(CGFloat)time
+        segmentIndexHint:(NSUInteger *)segmentIndexHint
+{
+  if (_keyframeCount == 1 || time <= _times[0]) {
+    memcpy(components, _components, sizeof(CGFloat) * _componentCount);
+    *timingMode = _timingModes[0];
+    return;
+  }
+
+  NSUInteger k = HLPiecewiseLinearSegmentIndex(_times, _keyframeCount, time, *segmentIndexHint);
+  *segmentIndexHint = k;
+  *timingMode = _timingModes[k];
+  const CGFloat *componentsFrom = _components + k * _componentCount;
+  const CGFloat *componentsTo = componentsFrom + _componentCount;
+  if (time >= _times[k + 1]) {
+    memcpy(components, componentsTo, sizeof(CGFloat) * _componentCount);
+    return;
+  }
+
+  // note: All channels of the segment are interpolated together, in one pass over the
+  // components.
+  CGFloat normalTime = HLActionApplyTiming(_timingModes[k], (time - _times[k]) / (_times[k + 1] - _times[k]));
+  for (NSUInteger c = 0; c < _componentCount; ++c) {
+    components[c] = componentsFrom[c] + (componentsTo[c] - componentsFrom[c]) * normalTime;
+  }
 }
 
 @end
 
+// note: Half of an 8-bit color channel step; smaller changes can't be seen.
+static const CGFloat HLColorizeActionComponentTolerance = 1.0f / 512.0f;
+
 @implementation HLColorizeAction
 {
   BOOL _isColorAnimated;
+  BOOL _isColorFromNode;
   SKColor *_colorFrom;
   SKColor *_colorTo;
   BOOL _isColorBlendFactorFromSet;
+  BOOL _isColorBlendFactorFromNode;
   CGFloat _colorBlendFactorFrom;
   CGFloat _colorBlendFactorTo;
+  // note: Components of the from and to colors, read at first use so that updates don't
+  // have to query the color objects.
+  BOOL _hasColorComponents;
+  CGFloat _colorComponentsFrom[4];
+  CGFloat _colorComponentsTo[4];
+  // note: The last color object produced by an update, and its components.  A new color
+  // object is only allocated when the components have changed visibly.  The getters reuse
+  // it when they can, but never replace it.
+  SKColor *_lastColor;
+  CGFloat _lastColorComponents[4];
 }
 
 - (instancetype)initWithColor:(SKColor *)colorTo
@@ -3094,7 +6461,9 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
       _colorFrom = [aDecoder decodeObjectForKey:@"colorFrom"];
       _colorTo = [aDecoder decodeObjectForKey:@"colorTo"];
     }
+    _isColorFromNode = [aDecoder decodeBoolForKey:@"isColorFromNode"];
     _isColorBlendFactorFromSet = [aDecoder decodeBoolForKey:@"isColorBlendFactorFromSet"];
+    _isColorBlendFactorFromNode = [aDecoder decodeBoolForKey:@"isColorBlendFactorFromNode"];
     _colorBlendFactorFrom = (CGFloat)[aDecoder decodeDoubleForKey:@"colorBlendFactorFrom"];
     _colorBlendFactorTo = (CGFloat)[aDecoder decodeDoubleForKey:@"colorBlendFactorTo"];
   }
@@ -3109,7 +6478,9 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
     [aCoder encodeObject:_colorFrom forKey:@"colorFrom"];
     [aCoder encodeObject:_colorTo forKey:@"colorTo"];
   }
+  [aCoder encodeBool:_isColorFromNode forKey:@"isColorFromNode"];
   [aCoder encodeBool:_isColorBlendFactorFromSet forKey:@"isColorBlendFactorFromSet"];
+  [aCoder encodeBool:_isColorBlendFactorFromNode forKey:@"isColorBlendFactorFromNode"];
   [aCoder encodeDouble:_colorBlendFactorFrom forKey:@"colorBlendFactorFrom"];
   [aCoder encodeDouble:_colorBlendFactorTo forKey:@"colorBlendFactorTo"];
 }
@@ -3121,13 +6492,40 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
     copy->_isColorAnimated = _isColorAnimated;
     copy->_colorFrom = _colorFrom;
     copy->_colorTo = _colorTo;
+    copy->_isColorFromNode = _isColorFromNode;
     copy->_isColorBlendFactorFromSet = _isColorBlendFactorFromSet;
+    copy->_isColorBlendFactorFromNode = _isColorBlendFactorFromNode;
     copy->_colorBlendFactorFrom = _colorBlendFactorFrom;
     copy->_colorBlendFactorTo = _colorBlendFactorTo;
   }
   return copy;
 }
 
+- (void)rewind
+{
+  [super rewind];
+  if (_isColorFromNode) {
+    _colorFrom = nil;
+    _isColorFromNode = NO;
+    _hasColorComponents = NO;
+  }
+  _lastColor = nil;
+  if (_isColorBlendFactorFromNode) {
+    _isColorBlendFactorFromSet = NO;
+    _isColorBlendFactorFromNode = NO;
+  }
+}
+
+- (BOOL)canRewind
+{
+  return YES;
+}
+
+- (BOOL)HL_canSeekBackward
+{
+  return YES;
+}
+
 - (BOOL)HL_update:(NSTimeInterval)incrementalTime node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
 {
 #if DEBUG
@@ -3146,6 +6544,8 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   if (_isColorAnimated && !_colorFrom) {
     if (haveSpriteNode) {
       _colorFrom = ((SKSpriteNode *)node).color;
+      _isColorFromNode = YES;
+      _hasColorComponents = NO;
     } else {
       [NSException raise:@"HLActionUninitialized" format:@"HLColorizeAction requires an initial color:"
        " either pass a sprite node to the first update,"
@@ -3156,6 +6556,7 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
     if (haveSpriteNode) {
       _colorBlendFactorFrom = ((SKSpriteNode *)node).colorBlendFactor;
       _isColorBlendFactorFromSet = YES;
+      _isColorBlendFactorFromNode = YES;
     } else {
       [NSException raise:@"HLActionUninitialized" format:@"HLColorizeAction requires an initial color blend factor:"
        " either pass a sprite node to the first update,"
@@ -3167,11 +6568,18 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   [self HL_advanceTime:incrementalTime extraTime:extraTime notYetCompleted:&notYetCompleted];
 
   if (haveSpriteNode) {
-    SKColor *color;
+    CGFloat colorComponents[4];
     CGFloat colorBlendFactor;
-    [self HL_colorizeWithColor:&color colorBlendFactor:&colorBlendFactor];
+    [self HL_getColorComponents:colorComponents colorBlendFactor:&colorBlendFactor];
     if (_isColorAnimated) {
-      ((SKSpriteNode *)node).color = color;
+      // note: Only set the color when it changes visibly, which (since only then is a new
+      // color object produced) is when the color object changes.  Compare against the
+      // node's current color, rather than the last color produced, so that a color set on
+      // the node by someone else is reasserted.
+      SKColor *color = [self HL_colorWithComponents:colorComponents remember:YES];
+      if (((SKSpriteNode *)node).color != color) {
+        ((SKSpriteNode *)node).color = color;
+      }
     }
     ((SKSpriteNode *)node).colorBlendFactor = colorBlendFactor;
   }
@@ -3194,10 +6602,10 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
      " either pass a sprite node to the first update,"
      " or initialize with initWithColorFrom:to:colorBlendFactorFrom:to:duration."];
   }
-  SKColor *color;
+  CGFloat colorComponents[4];
   CGFloat colorBlendFactor;
-  [self HL_colorizeWithColor:&color colorBlendFactor:&colorBlendFactor];
-  return color;
+  [self HL_getColorComponents:colorComponents colorBlendFactor:&colorBlendFactor];
+  return [self HL_colorWithComponents:colorComponents remember:NO];
 }
 
 - (CGFloat)colorBlendFactor
@@ -3207,15 +6615,32 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
      " either pass a sprite node to the first update,"
      " or initialize with initWithColorBlendFactorFrom:to:duration."];
   }
-  SKColor *color;
+  CGFloat colorComponents[4];
   CGFloat colorBlendFactor;
-  [self HL_colorizeWithColor:&color colorBlendFactor:&colorBlendFactor];
+  [self HL_getColorComponents:colorComponents colorBlendFactor:&colorBlendFactor];
   return colorBlendFactor;
 }
 
 - (void)getColor:(SKColor * __autoreleasing *)color colorBlendFactor:(CGFloat *)colorBlendFactor
 {
-  if (!_isColorAnimated && !_colorFrom) {
+  if (_isColorAnimated && !_colorFrom) {
+    [NSException raise:@"HLActionUninitialized" format:@"HLColorizeAction requires an initial color:"
+     " either pass a sprite node to the first update,"
+     " or initialize with initWithColorFrom:to:colorBlendFactorFrom:to:duration."];
+  }
+  if (!_isColorBlendFactorFromSet) {
+    [NSException raise:@"HLActionUninitialized" format:@"HLColorizeAction requires an initial color blend factor:"
+     " either pass a sprite node to the first update,"
+     " or initialize with initWithColorBlendFactorFrom:to:duration."];
+  }
+  CGFloat colorComponents[4];
+  [self HL_getColorComponents:colorComponents colorBlendFactor:colorBlendFactor];
+  *color = (_isColorAnimated ? [self HL_colorWithComponents:colorComponents remember:NO] : nil);
+}
+
+- (void)getColorRed:(CGFloat *)red green:(CGFloat *)green blue:(CGFloat *)blue alpha:(CGFloat *)alpha colorBlendFactor:(CGFloat *)colorBlendFactor
+{
+  if (_isColorAnimated && !_colorFrom) {
     [NSException raise:@"HLActionUninitialized" format:@"HLColorizeAction requires an initial color:"
      " either pass a sprite node to the first update,"
      " or initialize with initWithColorFrom:to:colorBlendFactorFrom:to:duration."];
@@ -3225,17 +6650,32 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
      " either pass a sprite node to the first update,"
      " or initialize with initWithColorBlendFactorFrom:to:duration."];
   }
-  [self HL_colorizeWithColor:color colorBlendFactor:colorBlendFactor];
+  CGFloat colorComponents[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+  [self HL_getColorComponents:colorComponents colorBlendFactor:colorBlendFactor];
+  *red = colorComponents[0];
+  *green = colorComponents[1];
+  *blue = colorComponents[2];
+  *alpha = colorComponents[3];
 }
 
-- (void)HL_colorizeWithColor:(SKColor * __autoreleasing *)color colorBlendFactor:(CGFloat *)colorBlendFactor
+- (void)HL_getColorComponents:(CGFloat *)colorComponents colorBlendFactor:(CGFloat *)colorBlendFactor
 {
   NSTimeInterval elapsedTime = self.elapsedTime;
   NSTimeInterval duration = self.duration;
 
+  if (_isColorAnimated && !_hasColorComponents) {
+    assert(_colorFrom);
+    assert(_colorTo);
+    [_colorFrom getRed:&_colorComponentsFrom[0] green:&_colorComponentsFrom[1] blue:&_colorComponentsFrom[2] alpha:&_colorComponentsFrom[3]];
+    [_colorTo getRed:&_colorComponentsTo[0] green:&_colorComponentsTo[1] blue:&_colorComponentsTo[2] alpha:&_colorComponentsTo[3]];
+    _hasColorComponents = YES;
+  }
+
   if (elapsedTime >= duration) {
     *colorBlendFactor = _colorBlendFactorTo;
-    *color = _colorTo;
+    if (_isColorAnimated) {
+      memcpy(colorComponents, _colorComponentsTo, sizeof(_colorComponentsTo));
+    }
     return;
   }
 
@@ -3243,23 +6683,43 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
 
   *colorBlendFactor = _colorBlendFactorFrom * (1.0f - normalTime) + _colorBlendFactorTo * normalTime;
   if (_isColorAnimated) {
-    assert(_colorTo);
-    CGFloat colorToRed;
-    CGFloat colorToGreen;
-    CGFloat colorToBlue;
-    CGFloat colorToAlpha;
-    [_colorTo getRed:&colorToRed green:&colorToGreen blue:&colorToBlue alpha:&colorToAlpha];
-    assert(_colorFrom);
-    CGFloat colorFromRed;
-    CGFloat colorFromGreen;
-    CGFloat colorFromBlue;
-    CGFloat colorFromAlpha;
-    [_colorFrom getRed:&colorFromRed green:&colorFromGreen blue:&colorFromBlue alpha:&colorFromAlpha];
-    *color = [SKColor colorWithRed:(colorFromRed * (1.0f - normalTime) + colorToRed * normalTime)
-                             green:(colorFromGreen * (1.0f - normalTime) + colorToGreen * normalTime)
-                              blue:(colorFromBlue * (1.0f - normalTime) + colorToBlue * normalTime)
-                             alpha:(colorFromAlpha * (1.0f - normalTime) + colorToAlpha * normalTime)];
+    for (int c = 0; c < 4; ++c) {
+      colorComponents[c] = _colorComponentsFrom[c] * (1.0f - normalTime) + _colorComponentsTo[c] * normalTime;
+    }
+  }
+}
+
+- (SKColor *)HL_colorWithComponents:(const CGFloat *)colorComponents remember:(BOOL)remember
+{
+  // note: The final color is always exactly the "to" color.
+  if (self.elapsedTime >= self.duration) {
+    if (remember && _lastColor != _colorTo) {
+      _lastColor = _colorTo;
+      memcpy(_lastColorComponents, _colorComponentsTo, sizeof(_colorComponentsTo));
+    }
+    return _colorTo;
+  }
+  if (_lastColor) {
+    BOOL changed = NO;
+    for (int c = 0; c < 4; ++c) {
+      if (fabs(colorComponents[c] - _lastColorComponents[c]) >= HLColorizeActionComponentTolerance) {
+        changed = YES;
+        break;
+      }
+    }
+    if (!changed) {
+      return _lastColor;
+    }
+  }
+  SKColor *color = [SKColor colorWithRed:colorComponents[0]
+                                   green:colorComponents[1]
+                                    blue:colorComponents[2]
+                                   alpha:colorComponents[3]];
+  if (remember) {
+    _lastColor = color;
+    memcpy(_lastColorComponents, colorComponents, sizeof(_lastColorComponents));
   }
+  return color;
 }
 
 @end
@@ -3280,6 +6740,11 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   return self;
 }
 
+- (BOOL)canRewind
+{
+  return YES;
+}
+
 - (BOOL)HL_update:(NSTimeInterval)incrementalTime node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
 {
 #if DEBUG
@@ -3316,6 +6781,7 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   NSTimeInterval _timePerFrame;
   BOOL _resize;
   BOOL _isRestoreTextureSpecified;
+  BOOL _isRestoreTextureFromNode;
 }
 
 - (instancetype)initWithTextures:(NSArray *)textures timePerFrame:(CGFloat)timePerFrame resize:(BOOL)resize restore:(BOOL)restore
@@ -3376,6 +6842,7 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
       _restore = [aDecoder decodeBoolForKey:@"restore"];
       _restoreTexture = [aDecoder decodeObjectForKey:@"restoreTexture"];
       _isRestoreTextureSpecified = [aDecoder decodeBoolForKey:@"isRestoreTextureSpecified"];
+      _isRestoreTextureFromNode = [aDecoder decodeBoolForKey:@"isRestoreTextureFromNode"];
     } else {
       _restore = NO;
       _restoreTexture = nil;
@@ -3396,6 +6863,7 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
     [aCoder encodeBool:_restore forKey:@"restore"];
     [aCoder encodeObject:_restoreTexture forKey:@"restoreTexture"];
     [aCoder encodeBool:_isRestoreTextureSpecified forKey:@"isRestoreTextureSpecified"];
+    [aCoder encodeBool:_isRestoreTextureFromNode forKey:@"isRestoreTextureFromNode"];
   }
 }
 
@@ -3411,10 +6879,31 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
     copy->_restore = _restore;
     copy->_restoreTexture = _restoreTexture;
     copy->_isRestoreTextureSpecified = _isRestoreTextureSpecified;
+    copy->_isRestoreTextureFromNode = _isRestoreTextureFromNode;
   }
   return copy;
 }
 
+- (void)rewind
+{
+  [super rewind];
+  if (_isRestoreTextureFromNode) {
+    _restoreTexture = nil;
+    _isRestoreTextureSpecified = NO;
+    _isRestoreTextureFromNode = NO;
+  }
+}
+
+- (BOOL)canRewind
+{
+  return YES;
+}
+
+- (BOOL)HL_canSeekBackward
+{
+  return YES;
+}
+
 - (BOOL)HL_update:(NSTimeInterval)incrementalTime node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
 {
 #if DEBUG
@@ -3436,6 +6925,7 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
     if (haveSpriteNode) {
       _restoreTexture = ((SKSpriteNode *)node).texture;
       _isRestoreTextureSpecified = YES;
+      _isRestoreTextureFromNode = YES;
     } else {
       [NSException raise:@"HLActionUninitialized" format:@"The restore feature of HLAnimateTexturesAction requires an original texture:"
        " either pass a sprite node to the first update,"
@@ -3605,6 +7095,22 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   return copy;
 }
 
+- (BOOL)canRewind
+{
+  return YES;
+}
+
+- (BOOL)HL_canSeekBackward
+{
+  return YES;
+}
+
+- (NSTimeInterval)HL_completionTime
+{
+  // note: Never completes, despite a zero duration.
+  return INFINITY;
+}
+
 - (BOOL)HL_update:(NSTimeInterval)incrementalTime node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
 {
   // note: This action never completes, so the typical DEBUG check for completion
@@ -3666,6 +7172,11 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   return self;
 }
 
+- (BOOL)canRewind
+{
+  return YES;
+}
+
 - (BOOL)HL_update:(NSTimeInterval)incrementalTime node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
 {
 #if DEBUG
@@ -3735,6 +7246,11 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   return copy;
 }
 
+- (BOOL)canRewind
+{
+  return YES;
+}
+
 - (BOOL)HL_update:(NSTimeInterval)incrementalTime node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
 {
 #if DEBUG
@@ -3759,9 +7275,11 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
 
   id target = _weakTarget;
   if (target) {
-    IMP imp = [target methodForSelector:_selector];
-    void (*func)(id, SEL) = (void (*)(id, SEL))imp;
-    func(target, _selector);
+    HLActionDispatchCallback((HLActionCallback){
+      .type = HLActionCallbackNoArguments,
+      .target = (__bridge void *)target,
+      .selector = _selector,
+    });
   }
 
   *extraTime = incrementalTime;
@@ -3821,6 +7339,11 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   return copy;
 }
 
+- (BOOL)canRewind
+{
+  return YES;
+}
+
 - (BOOL)HL_update:(NSTimeInterval)incrementalTime node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
 {
 #if DEBUG
@@ -3845,9 +7368,12 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
 
   id target = _weakTarget;
   if (target) {
-    IMP imp = [target methodForSelector:_selector];
-    void (*func)(id, SEL, id) = (void (*)(id, SEL, id))imp;
-    func(target, _selector, _argument);
+    HLActionDispatchCallback((HLActionCallback){
+      .type = HLActionCallbackOneArgument,
+      .target = (__bridge void *)target,
+      .selector = _selector,
+      .argument1 = (__bridge void *)_argument,
+    });
   }
 
   *extraTime = incrementalTime;
@@ -3912,6 +7438,11 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   return copy;
 }
 
+- (BOOL)canRewind
+{
+  return YES;
+}
+
 - (BOOL)HL_update:(NSTimeInterval)incrementalTime node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
 {
 #if DEBUG
@@ -3936,9 +7467,13 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
 
   id target = _weakTarget;
   if (target) {
-    IMP imp = [target methodForSelector:_selector];
-    void (*func)(id, SEL, id, id) = (void (*)(id, SEL, id, id))imp;
-    func(target, _selector, _argument1, _argument2);
+    HLActionDispatchCallback((HLActionCallback){
+      .type = HLActionCallbackTwoArguments,
+      .target = (__bridge void *)target,
+      .selector = _selector,
+      .argument1 = (__bridge void *)_argument1,
+      .argument2 = (__bridge void *)_argument2,
+    });
   }
 
   *extraTime = incrementalTime;
@@ -3993,6 +7528,11 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   return copy;
 }
 
+- (BOOL)canRewind
+{
+  return YES;
+}
+
 - (BOOL)HL_update:(NSTimeInterval)incrementalTime node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
 {
 #if DEBUG
@@ -4017,9 +7557,11 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
 
   id target = _strongTarget;
   if (target) {
-    IMP imp = [target methodForSelector:_selector];
-    void (*func)(id, SEL) = (void (*)(id, SEL))imp;
-    func(target, _selector);
+    HLActionDispatchCallback((HLActionCallback){
+      .type = HLActionCallbackNoArguments,
+      .target = (__bridge void *)target,
+      .selector = _selector,
+    });
   }
 
   *extraTime = incrementalTime;
@@ -4079,6 +7621,11 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   return copy;
 }
 
+- (BOOL)canRewind
+{
+  return YES;
+}
+
 - (BOOL)HL_update:(NSTimeInterval)incrementalTime node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
 {
 #if DEBUG
@@ -4103,9 +7650,12 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
 
   id target = _strongTarget;
   if (target) {
-    IMP imp = [target methodForSelector:_selector];
-    void (*func)(id, SEL, id) = (void (*)(id, SEL, id))imp;
-    func(target, _selector, _argument);
+    HLActionDispatchCallback((HLActionCallback){
+      .type = HLActionCallbackOneArgument,
+      .target = (__bridge void *)target,
+      .selector = _selector,
+      .argument1 = (__bridge void *)_argument,
+    });
   }
 
   *extraTime = incrementalTime;
@@ -4170,6 +7720,11 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   return copy;
 }
 
+- (BOOL)canRewind
+{
+  return YES;
+}
+
 - (BOOL)HL_update:(NSTimeInterval)incrementalTime node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
 {
 #if DEBUG
@@ -4194,9 +7749,13 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
 
   id target = _strongTarget;
   if (target) {
-    IMP imp = [target methodForSelector:_selector];
-    void (*func)(id, SEL, id, id) = (void (*)(id, SEL, id, id))imp;
-    func(target, _selector, _argument1, _argument2);
+    HLActionDispatchCallback((HLActionCallback){
+      .type = HLActionCallbackTwoArguments,
+      .target = (__bridge void *)target,
+      .selector = _selector,
+      .argument1 = (__bridge void *)_argument1,
+      .argument2 = (__bridge void *)_argument2,
+    });
   }
 
   *extraTime = incrementalTime;
@@ -4258,6 +7817,11 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   return copy;
 }
 
+- (BOOL)HL_canSeekBackward
+{
+  return YES;
+}
+
 - (BOOL)HL_update:(NSTimeInterval)incrementalTime node:(SKNode *)node extraTime:(NSTimeInterval *)extraTime
 {
 #if DEBUG
@@ -4289,13 +7853,15 @@ HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime)
   id target = _weakTarget;
   if (target) {
     NSTimeInterval duration = self.duration;
-    IMP imp = [target methodForSelector:_selector];
-    void (*func)(id, SEL, SKNode *, CGFloat, NSTimeInterval, id) = (void (*)(id, SEL, SKNode *, CGFloat, NSTimeInterval, id))imp;
-    if (notYetCompleted) {
-      func(target, _selector, node, (CGFloat)self.elapsedTime, duration, _userData);
-    } else {
-      func(target, _selector, node, (CGFloat)duration, duration, _userData);
-    }
+    HLActionDispatchCallback((HLActionCallback){
+      .type = HLActionCallbackCustom,
+      .target = (__bridge void *)target,
+      .selector = _selector,
+      .argument1 = (__bridge void *)node,
+      .argument2 = (__bridge void *)_userData,
+      .elapsedTime = (notYetCompleted ? (CGFloat)self.elapsedTime : (CGFloat)duration),
+      .duration = duration,
+    });
   }
 
 #if DEBUG
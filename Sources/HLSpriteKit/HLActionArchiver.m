@@ -0,0 +1,1278 @@
+//
+//  HLActionArchiver.m
+//  HLSpriteKit
+//
+//  Created by Karl Voskuil on 10/16/26.
+//  Copyright © 2026 Hilo Games. All rights reserved.
+//
+
+#import "HLActionArchiver.h"
+
+#import <CoreGraphics/CoreGraphics.h>
+#include <libkern/OSByteOrder.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if TARGET_OS_IPHONE
+#import <UIKit/UIKit.h>
+#endif
+
+NSString * const HLActionArchiverErrorDomain = @"HLActionArchiverErrorDomain";
+
+const NSUInteger HLActionArchiverFormatVersion = 1;
+
+// note: The archive format:
+//
+//   archive := magic version root*
+//   magic := 'H' 'L' 'A' 'B'
+//   version := varint
+//   root := value
+//
+//   value := tag payload
+//
+// Strings (for keys, class names, and string values) are written as a string reference:
+// a varint which is either 1, followed by a definition (varint length and UTF-8 bytes)
+// which is assigned the next index in the shared string table; or an existing index plus
+// 2.  The reference 0 ends the field list of an object.
+//
+// Objects (other than strings, numbers, data, arrays, and dictionaries) are assigned
+// indexes in the order they are first written; later occurrences are written as
+// references to the index.
+enum {
+  HLActionArchiverTagNil = 0,
+  HLActionArchiverTagFalse,
+  HLActionArchiverTagTrue,
+  // note: Zigzag-encoded varint.
+  HLActionArchiverTagInteger,
+  // note: 4-byte little-endian IEEE float.
+  HLActionArchiverTagFloat,
+  // note: 8-byte little-endian IEEE double.
+  HLActionArchiverTagDouble,
+  // note: Two doubles.
+  HLActionArchiverTagPoint,
+  // note: Varint length and bytes, from encodeBytes:length:forKey:.
+  HLActionArchiverTagBytes,
+  // note: String reference.
+  HLActionArchiverTagString,
+  HLActionArchiverTagNumberBool,
+  HLActionArchiverTagNumberInteger,
+  HLActionArchiverTagNumberDouble,
+  // note: Varint length and bytes.
+  HLActionArchiverTagData,
+  HLActionArchiverTagMutableData,
+  // note: Varint count and values.
+  HLActionArchiverTagArray,
+  HLActionArchiverTagMutableArray,
+  // note: Varint count and key-value pairs of values.
+  HLActionArchiverTagDictionary,
+  HLActionArchiverTagMutableDictionary,
+  // note: Class string reference, then fields (key string reference and value), then 0.
+  HLActionArchiverTagObject,
+  // note: Varint object index.
+  HLActionArchiverTagReference,
+};
+
+static const uint8_t HLActionArchiverMagic[4] = { 'H', 'L', 'A', 'B' };
+
+enum {
+  HLActionArchiverStringReferenceEnd = 0,
+  HLActionArchiverStringReferenceDefinition = 1,
+  HLActionArchiverStringReferenceIndexBase = 2,
+};
+
+#pragma mark -
+#pragma mark HLActionArchiver
+
+static void
+HLActionArchiverWriteVarint(NSMutableData *data, uint64_t value)
+{
+  uint8_t buffer[10];
+  size_t length = 0;
+  while (value >= 0x80) {
+    buffer[length++] = (uint8_t)(value | 0x80);
+    value >>= 7;
+  }
+  buffer[length++] = (uint8_t)value;
+  [data appendBytes:buffer length:length];
+}
+
+static inline void
+HLActionArchiverWriteTag(NSMutableData *data, uint8_t tag)
+{
+  [data appendBytes:&tag length:1];
+}
+
+static inline void
+HLActionArchiverWriteZigzag(NSMutableData *data, int64_t value)
+{
+  HLActionArchiverWriteVarint(data, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+static inline void
+HLActionArchiverWriteDouble(NSMutableData *data, double value)
+{
+  uint64_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  bits = OSSwapHostToLittleInt64(bits);
+  [data appendBytes:&bits length:sizeof(bits)];
+}
+
+static inline void
+HLActionArchiverWriteFloat(NSMutableData *data, float value)
+{
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  bits = OSSwapHostToLittleInt32(bits);
+  [data appendBytes:&bits length:sizeof(bits)];
+}
+
+@implementation HLActionArchiver
+{
+  NSMutableData *_data;
+  NSMutableDictionary *_stringIndexes;
+  NSMapTable *_objectIndexes;
+  NSUInteger _objectCount;
+  NSUInteger _objectDepth;
+}
+
+- (instancetype)init
+{
+  self = [super init];
+  if (self) {
+    _data = [NSMutableData data];
+    [_data appendBytes:HLActionArchiverMagic length:sizeof(HLActionArchiverMagic)];
+    HLActionArchiverWriteVarint(_data, HLActionArchiverFormatVersion);
+    _stringIndexes = [NSMutableDictionary dictionary];
+    // note: Objects are retained so that their addresses can't be reused by other objects
+    // during archiving.
+    _objectIndexes = [NSMapTable mapTableWithKeyOptions:(NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality)
+                                           valueOptions:NSPointerFunctionsStrongMemory];
+    _objectCount = 0;
+    _objectDepth = 0;
+  }
+  return self;
+}
+
++ (NSData *)archivedDataWithRootObject:(id)rootObject
+{
+  HLActionArchiver *archiver = [[HLActionArchiver alloc] init];
+  [archiver encodeRootObject:rootObject];
+  return archiver.encodedData;
+}
+
+- (void)encodeRootObject:(id)rootObject
+{
+  [self HL_encodeValue:rootObject];
+}
+
+- (NSData *)encodedData
+{
+  return [_data copy];
+}
+
+- (BOOL)allowsKeyedCoding
+{
+  return YES;
+}
+
+- (void)encodeObject:(id)object forKey:(NSString *)key
+{
+  [self HL_encodeKey:key];
+  [self HL_encodeValue:object];
+}
+
+- (void)encodeConditionalObject:(id)object forKey:(NSString *)key
+{
+  [self HL_encodeKey:key];
+  NSNumber *objectIndex = (object ? [_objectIndexes objectForKey:object] : nil);
+  if (objectIndex) {
+    HLActionArchiverWriteTag(_data, HLActionArchiverTagReference);
+    HLActionArchiverWriteVarint(_data, [objectIndex unsignedIntegerValue]);
+  } else {
+    HLActionArchiverWriteTag(_data, HLActionArchiverTagNil);
+  }
+}
+
+- (void)encodeBool:(BOOL)value forKey:(NSString *)key
+{
+  [self HL_encodeKey:key];
+  HLActionArchiverWriteTag(_data, (value ? HLActionArchiverTagTrue : HLActionArchiverTagFalse));
+}
+
+- (void)encodeInt:(int)value forKey:(NSString *)key
+{
+  [self encodeInt64:value forKey:key];
+}
+
+- (void)encodeInt32:(int32_t)value forKey:(NSString *)key
+{
+  [self encodeInt64:value forKey:key];
+}
+
+- (void)encodeInteger:(NSInteger)value forKey:(NSString *)key
+{
+  [self encodeInt64:value forKey:key];
+}
+
+- (void)encodeInt64:(int64_t)value forKey:(NSString *)key
+{
+  [self HL_encodeKey:key];
+  HLActionArchiverWriteTag(_data, HLActionArchiverTagInteger);
+  HLActionArchiverWriteZigzag(_data, value);
+}
+
+- (void)encodeFloat:(float)value forKey:(NSString *)key
+{
+  [self HL_encodeKey:key];
+  HLActionArchiverWriteTag(_data, HLActionArchiverTagFloat);
+  HLActionArchiverWriteFloat(_data, value);
+}
+
+- (void)encodeDouble:(double)value forKey:(NSString *)key
+{
+  [self HL_encodeKey:key];
+  HLActionArchiverWriteTag(_data, HLActionArchiverTagDouble);
+  HLActionArchiverWriteDouble(_data, value);
+}
+
+- (void)encodeBytes:(const uint8_t *)bytes length:(NSUInteger)length forKey:(NSString *)key
+{
+  [self HL_encodeKey:key];
+  HLActionArchiverWriteTag(_data, HLActionArchiverTagBytes);
+  HLActionArchiverWriteVarint(_data, length);
+  if (length > 0) {
+    [_data appendBytes:bytes length:length];
+  }
+}
+
+#if TARGET_OS_IPHONE
+- (void)encodeCGPoint:(CGPoint)point forKey:(NSString *)key
+#else
+- (void)encodePoint:(NSPoint)point forKey:(NSString *)key
+#endif
+{
+  [self HL_encodeKey:key];
+  HLActionArchiverWriteTag(_data, HLActionArchiverTagPoint);
+  HLActionArchiverWriteDouble(_data, point.x);
+  HLActionArchiverWriteDouble(_data, point.y);
+}
+
+- (void)encodeValueOfObjCType:(const char *)type at:(const void *)addr
+{
+  [NSException raise:NSInvalidArchiveOperationException format:@"HLActionArchiver only supports keyed coding."];
+}
+
+- (void)encodeDataObject:(NSData *)data
+{
+  [NSException raise:NSInvalidArchiveOperationException format:@"HLActionArchiver only supports keyed coding."];
+}
+
+- (void)HL_encodeKey:(NSString *)key
+{
+  // note: Keyed values outside of an object would be read as root objects.
+  if (_objectDepth == 0) {
+    [NSException raise:NSInvalidArchiveOperationException format:@"HLActionArchiver can only encode keyed values from within encodeWithCoder:; use encodeRootObject: for root objects."];
+  }
+  [self HL_encodeString:key];
+}
+
+- (void)HL_encodeString:(NSString *)string
+{
+  NSNumber *stringIndex = _stringIndexes[string];
+  if (stringIndex) {
+    HLActionArchiverWriteVarint(_data, [stringIndex unsignedIntegerValue] + HLActionArchiverStringReferenceIndexBase);
+    return;
+  }
+  // note: Copy, in case it's mutable.
+  _stringIndexes[[string copy]] = @([_stringIndexes count]);
+  HLActionArchiverWriteVarint(_data, HLActionArchiverStringReferenceDefinition);
+  const char *utf8 = [string UTF8String];
+  size_t length = strlen(utf8);
+  HLActionArchiverWriteVarint(_data, length);
+  [_data appendBytes:utf8 length:length];
+}
+
+- (void)HL_encodeValue:(id)object
+{
+  if (!object) {
+    HLActionArchiverWriteTag(_data, HLActionArchiverTagNil);
+    return;
+  }
+
+  if ([object isKindOfClass:[NSString class]]) {
+    HLActionArchiverWriteTag(_data, HLActionArchiverTagString);
+    [self HL_encodeString:object];
+    return;
+  }
+
+  if ([object isKindOfClass:[NSNumber class]]) {
+    CFNumberRef number = (__bridge CFNumberRef)object;
+    if (CFGetTypeID(number) == CFBooleanGetTypeID()) {
+      HLActionArchiverWriteTag(_data, HLActionArchiverTagNumberBool);
+      uint8_t value = ([object boolValue] ? 1 : 0);
+      [_data appendBytes:&value length:1];
+    } else if (CFNumberIsFloatType(number)) {
+      HLActionArchiverWriteTag(_data, HLActionArchiverTagNumberDouble);
+      HLActionArchiverWriteDouble(_data, [object doubleValue]);
+    } else {
+      HLActionArchiverWriteTag(_data, HLActionArchiverTagNumberInteger);
+      HLActionArchiverWriteZigzag(_data, [object longLongValue]);
+    }
+    return;
+  }
+
+  // note: Mutability is preserved using classForKeyedArchiver, as with NSKeyedArchiver;
+  // bridged Core Foundation instances claim to be kinds of the mutable classes.
+  if ([object isKindOfClass:[NSData class]]) {
+    BOOL isMutable = ([object classForKeyedArchiver] == [NSMutableData class]);
+    HLActionArchiverWriteTag(_data, (isMutable ? HLActionArchiverTagMutableData : HLActionArchiverTagData));
+    NSData *data = object;
+    HLActionArchiverWriteVarint(_data, [data length]);
+    [_data appendData:data];
+    return;
+  }
+
+  if ([object isKindOfClass:[NSArray class]]) {
+    BOOL isMutable = ([object classForKeyedArchiver] == [NSMutableArray class]);
+    HLActionArchiverWriteTag(_data, (isMutable ? HLActionArchiverTagMutableArray : HLActionArchiverTagArray));
+    NSArray *array = object;
+    HLActionArchiverWriteVarint(_data, [array count]);
+    for (id element in array) {
+      [self HL_encodeValue:element];
+    }
+    return;
+  }
+
+  if ([object isKindOfClass:[NSDictionary class]]) {
+    BOOL isMutable = ([object classForKeyedArchiver] == [NSMutableDictionary class]);
+    HLActionArchiverWriteTag(_data, (isMutable ? HLActionArchiverTagMutableDictionary : HLActionArchiverTagDictionary));
+    NSDictionary *dictionary = object;
+    HLActionArchiverWriteVarint(_data, [dictionary count]);
+    [dictionary enumerateKeysAndObjectsUsingBlock:^(id key, id value, BOOL *stop){
+      [self HL_encodeValue:key];
+      [self HL_encodeValue:value];
+    }];
+    return;
+  }
+
+  object = [object replacementObjectForCoder:self];
+  if (!object) {
+    HLActionArchiverWriteTag(_data, HLActionArchiverTagNil);
+    return;
+  }
+  NSNumber *objectIndex = [_objectIndexes objectForKey:object];
+  if (objectIndex) {
+    HLActionArchiverWriteTag(_data, HLActionArchiverTagReference);
+    HLActionArchiverWriteVarint(_data, [objectIndex unsignedIntegerValue]);
+    return;
+  }
+  if (![object conformsToProtocol:@protocol(NSCoding)]) {
+    [NSException raise:NSInvalidArchiveOperationException format:@"HLActionArchiver cannot encode object of class %@, which does not conform to NSCoding.", NSStringFromClass([object class])];
+  }
+  [_objectIndexes setObject:@(_objectCount) forKey:object];
+  ++_objectCount;
+  HLActionArchiverWriteTag(_data, HLActionArchiverTagObject);
+  [self HL_encodeString:NSStringFromClass([object classForCoder])];
+  ++_objectDepth;
+  [object encodeWithCoder:self];
+  --_objectDepth;
+  HLActionArchiverWriteVarint(_data, HLActionArchiverStringReferenceEnd);
+}
+
+@end
+
+#pragma mark -
+#pragma mark HLActionUnarchiver
+
+typedef struct {
+  NSUInteger keyIndex;
+  NSUInteger valueOffset;
+} HLActionUnarchiverField;
+
+typedef struct {
+  NSUInteger offset;
+  NSUInteger classIndex;
+  NSUInteger fieldStart;
+  NSUInteger fieldCount;
+} HLActionUnarchiverObject;
+
+enum {
+  HLActionUnarchiverObjectStateScanned = 0,
+  HLActionUnarchiverObjectStateDecoding,
+  HLActionUnarchiverObjectStateDecoded,
+};
+
+static void *
+HLActionUnarchiverReallocArray(void *array, NSUInteger count, size_t elementSize)
+{
+  void *reallocated = realloc(array, count * elementSize);
+  if (!reallocated) {
+    [NSException raise:NSMallocException format:@"HLActionUnarchiver could not allocate storage for %lu elements.", (unsigned long)count];
+  }
+  return reallocated;
+}
+
+static void
+HLActionUnarchiverRaiseMalformed(void)
+{
+  [NSException raise:NSInvalidUnarchiveOperationException format:@"HLActionUnarchiver found malformed archive data."];
+}
+
+// note: The maximum nesting of values (while scanning) and of objects (while decoding,
+// where references can chain objects together more deeply than they are nested).  Deeper
+// archives fail rather than overflowing the stack; action trees are nowhere near as deep.
+static const NSUInteger HLActionUnarchiverMaximumDepth = 256;
+
+@implementation HLActionUnarchiver
+{
+  NSData *_data;
+  const uint8_t *_bytes;
+  NSUInteger _length;
+  NSUInteger _rootOffset;
+
+  NSMutableArray *_strings;
+  NSMutableDictionary *_stringIndexes;
+  // note: The offset of each string's definition, in order of index (which is also order of
+  // offset).  Definitions before the scanned offset have already been added to the table;
+  // values are scanned (and so their definitions added) in order before they are decoded.
+  NSUInteger *_stringOffsets;
+  NSUInteger _stringCapacity;
+  NSUInteger _stringsScannedOffset;
+
+  // note: All objects scanned so far, in order of index (which is also order of offset).
+  HLActionUnarchiverObject *_objects;
+  NSUInteger _objectCount;
+  NSUInteger _objectCapacity;
+  NSMutableArray *_decodedObjects;
+  uint8_t *_objectStates;
+
+  // note: The fields of each object are contiguous in the field array.  While scanning,
+  // fields are pushed on a stack, and then moved to the field array when their object is
+  // complete.
+  HLActionUnarchiverField *_fields;
+  NSUInteger _fieldCount;
+  NSUInteger _fieldCapacity;
+  HLActionUnarchiverField *_scanStack;
+  NSUInteger _scanStackCount;
+  NSUInteger _scanStackCapacity;
+
+  // note: The object currently being decoded with initWithCoder:, or NSNotFound.
+  NSUInteger _currentObject;
+
+  // note: The classes allowed for the value currently being decoded by
+  // decodeObjectOfClasses:forKey:, or nil for any class.
+  NSSet *_allowedClasses;
+
+  NSUInteger _scanDepth;
+  NSUInteger _decodeDepth;
+}
+
+- (instancetype)initForReadingFromData:(NSData *)data error:(NSError * __autoreleasing *)error
+{
+  self = [super init];
+  if (self) {
+    _data = [data copy];
+    _bytes = [_data bytes];
+    _length = [_data length];
+    if (_length < sizeof(HLActionArchiverMagic) || memcmp(_bytes, HLActionArchiverMagic, sizeof(HLActionArchiverMagic)) != 0) {
+      if (error) {
+        *error = [NSError errorWithDomain:HLActionArchiverErrorDomain
+                                     code:1
+                                 userInfo:@{ NSLocalizedDescriptionKey : @"The data is not an HLActionArchiver archive." }];
+      }
+      return nil;
+    }
+    NSUInteger offset = sizeof(HLActionArchiverMagic);
+    uint64_t version = 0;
+    if (![self HL_readVarint:&version offset:&offset] || version > HLActionArchiverFormatVersion) {
+      if (error) {
+        *error = [NSError errorWithDomain:HLActionArchiverErrorDomain
+                                     code:2
+                                 userInfo:@{ NSLocalizedDescriptionKey : @"The archive was written by an unsupported version of HLActionArchiver." }];
+      }
+      return nil;
+    }
+    _rootOffset = offset;
+    _strings = [NSMutableArray array];
+    _stringIndexes = [NSMutableDictionary dictionary];
+    _stringsScannedOffset = offset;
+    _decodedObjects = [NSMutableArray array];
+    _currentObject = NSNotFound;
+  }
+  return self;
+}
+
+- (void)dealloc
+{
+  free(_stringOffsets);
+  free(_objects);
+  free(_objectStates);
+  free(_fields);
+  free(_scanStack);
+}
+
++ (id)unarchivedObjectFromData:(NSData *)data error:(NSError * __autoreleasing *)error
+{
+  HLActionUnarchiver *unarchiver = [[HLActionUnarchiver alloc] initForReadingFromData:data error:error];
+  if (!unarchiver) {
+    return nil;
+  }
+  if (!unarchiver.hasMoreRootObjects) {
+    if (error) {
+      *error = [NSError errorWithDomain:HLActionArchiverErrorDomain
+                                   code:3
+                               userInfo:@{ NSLocalizedDescriptionKey : @"The archive contains no root objects." }];
+    }
+    return nil;
+  }
+  @try {
+    return [unarchiver decodeRootObject];
+  } @catch (NSException *exception) {
+    if (![exception.name isEqualToString:NSInvalidUnarchiveOperationException]) {
+      @throw;
+    }
+    if (error) {
+      *error = [NSError errorWithDomain:HLActionArchiverErrorDomain
+                                   code:4
+                               userInfo:@{ NSLocalizedDescriptionKey : @"The archive could not be decoded.",
+                                           NSLocalizedFailureReasonErrorKey : (exception.reason ?: @"") }];
+    }
+    return nil;
+  }
+}
+
+- (BOOL)hasMoreRootObjects
+{
+  return _rootOffset < _length;
+}
+
+- (id)decodeRootObject
+{
+  if (_rootOffset >= _length) {
+    [NSException raise:NSInvalidUnarchiveOperationException format:@"HLActionUnarchiver has no more root objects."];
+  }
+  // note: Decoding state is reset in case a previous root object raised partway through.
+  _currentObject = NSNotFound;
+  _allowedClasses = nil;
+  _scanDepth = 0;
+  _decodeDepth = 0;
+  NSUInteger offset = _rootOffset;
+  NSUInteger endOffset = offset;
+  [self HL_scanValueAtOffset:&endOffset];
+  _rootOffset = endOffset;
+  return [self HL_decodeValueAtOffset:offset];
+}
+
+- (BOOL)allowsKeyedCoding
+{
+  return YES;
+}
+
+- (BOOL)containsValueForKey:(NSString *)key
+{
+  return ([self HL_valueOffsetForKey:key] != NSNotFound);
+}
+
+- (id)decodeObjectForKey:(NSString *)key
+{
+  NSUInteger valueOffset = [self HL_valueOffsetForKey:key];
+  if (valueOffset == NSNotFound) {
+    return nil;
+  }
+  return [self HL_decodeValueAtOffset:valueOffset];
+}
+
+- (id)decodeObjectOfClass:(Class)aClass forKey:(NSString *)key
+{
+  return [self decodeObjectOfClasses:(aClass ? [NSSet setWithObject:aClass] : nil) forKey:key];
+}
+
+- (id)decodeObjectOfClasses:(NSSet *)classes forKey:(NSString *)key
+{
+  // note: As with NSSecureCoding, the value must be an instance of one of the classes (or
+  // of a subclass), which is checked before any object is instantiated; so must the
+  // elements of collections.  Objects decoded by the value's own initWithCoder: are
+  // checked only against the classes it passes in turn.
+  NSUInteger valueOffset = [self HL_valueOffsetForKey:key];
+  if (valueOffset == NSNotFound) {
+    return nil;
+  }
+  NSSet *allowedClasses = _allowedClasses;
+  _allowedClasses = classes;
+  id object = [self HL_decodeValueAtOffset:valueOffset];
+  _allowedClasses = allowedClasses;
+  return object;
+}
+
+- (BOOL)decodeBoolForKey:(NSString *)key
+{
+  int64_t integerValue = 0;
+  [self HL_decodeScalarForKey:key integerValue:&integerValue doubleValue:NULL];
+  return (integerValue != 0);
+}
+
+- (int)decodeIntForKey:(NSString *)key
+{
+  return (int)[self decodeInt64ForKey:key];
+}
+
+- (int32_t)decodeInt32ForKey:(NSString *)key
+{
+  return (int32_t)[self decodeInt64ForKey:key];
+}
+
+- (NSInteger)decodeIntegerForKey:(NSString *)key
+{
+  return (NSInteger)[self decodeInt64ForKey:key];
+}
+
+- (int64_t)decodeInt64ForKey:(NSString *)key
+{
+  int64_t integerValue = 0;
+  [self HL_decodeScalarForKey:key integerValue:&integerValue doubleValue:NULL];
+  return integerValue;
+}
+
+- (float)decodeFloatForKey:(NSString *)key
+{
+  return (float)[self decodeDoubleForKey:key];
+}
+
+- (double)decodeDoubleForKey:(NSString *)key
+{
+  double doubleValue = 0.0;
+  [self HL_decodeScalarForKey:key integerValue:NULL doubleValue:&doubleValue];
+  return doubleValue;
+}
+
+- (const uint8_t *)decodeBytesForKey:(NSString *)key returnedLength:(NSUInteger *)length
+{
+  NSUInteger offset = [self HL_valueOffsetForKey:key];
+  if (offset == NSNotFound) {
+    if (length) {
+      *length = 0;
+    }
+    return NULL;
+  }
+  uint8_t tag = [self HL_readTagAtOffset:&offset];
+  if (tag != HLActionArchiverTagBytes) {
+    [self HL_raiseTypeMismatchForKey:key];
+  }
+  uint64_t bytesLength;
+  const uint8_t *bytes = [self HL_readBytes:&bytesLength offset:&offset];
+  if (length) {
+    *length = (NSUInteger)bytesLength;
+  }
+  return bytes;
+}
+
+#if TARGET_OS_IPHONE
+- (CGPoint)decodeCGPointForKey:(NSString *)key
+#else
+- (NSPoint)decodePointForKey:(NSString *)key
+#endif
+{
+  NSUInteger offset = [self HL_valueOffsetForKey:key];
+  if (offset == NSNotFound) {
+    return CGPointZero;
+  }
+  uint8_t tag = [self HL_readTagAtOffset:&offset];
+  if (tag != HLActionArchiverTagPoint) {
+    [self HL_raiseTypeMismatchForKey:key];
+  }
+  double x = [self HL_readDoubleAtOffset:&offset];
+  double y = [self HL_readDoubleAtOffset:&offset];
+  return CGPointMake((CGFloat)x, (CGFloat)y);
+}
+
+- (void)decodeValueOfObjCType:(const char *)type at:(void *)data
+{
+  [NSException raise:NSInvalidUnarchiveOperationException format:@"HLActionUnarchiver only supports keyed coding."];
+}
+
+- (void)decodeValueOfObjCType:(const char *)type at:(void *)data size:(NSUInteger)size
+{
+  [NSException raise:NSInvalidUnarchiveOperationException format:@"HLActionUnarchiver only supports keyed coding."];
+}
+
+- (NSData *)decodeDataObject
+{
+  [NSException raise:NSInvalidUnarchiveOperationException format:@"HLActionUnarchiver only supports keyed coding."];
+  return nil;
+}
+
+#pragma mark Reading Primitives
+
+- (BOOL)HL_readVarint:(uint64_t *)value offset:(NSUInteger *)offset
+{
+  uint64_t result = 0;
+  unsigned int shift = 0;
+  NSUInteger o = *offset;
+  while (o < _length && shift < 64) {
+    uint8_t byte = _bytes[o];
+    ++o;
+    result |= (uint64_t)(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      *value = result;
+      *offset = o;
+      return YES;
+    }
+    shift += 7;
+  }
+  return NO;
+}
+
+- (uint64_t)HL_readVarintAtOffset:(NSUInteger *)offset
+{
+  uint64_t value;
+  if (![self HL_readVarint:&value offset:offset]) {
+    HLActionUnarchiverRaiseMalformed();
+  }
+  return value;
+}
+
+- (uint8_t)HL_readTagAtOffset:(NSUInteger *)offset
+{
+  if (*offset >= _length) {
+    HLActionUnarchiverRaiseMalformed();
+  }
+  uint8_t tag = _bytes[*offset];
+  ++(*offset);
+  return tag;
+}
+
+- (void)HL_skipLength:(uint64_t)length offset:(NSUInteger *)offset
+{
+  if (length > _length - *offset) {
+    HLActionUnarchiverRaiseMalformed();
+  }
+  *offset += (NSUInteger)length;
+}
+
+- (const uint8_t *)HL_readBytes:(uint64_t *)length offset:(NSUInteger *)offset
+{
+  *length = [self HL_readVarintAtOffset:offset];
+  const uint8_t *bytes = _bytes + *offset;
+  [self HL_skipLength:*length offset:offset];
+  return bytes;
+}
+
+- (double)HL_readDoubleAtOffset:(NSUInteger *)offset
+{
+  NSUInteger o = *offset;
+  [self HL_skipLength:sizeof(uint64_t) offset:offset];
+  uint64_t bits;
+  memcpy(&bits, _bytes + o, sizeof(bits));
+  bits = OSSwapLittleToHostInt64(bits);
+  double value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+- (float)HL_readFloatAtOffset:(NSUInteger *)offset
+{
+  NSUInteger o = *offset;
+  [self HL_skipLength:sizeof(uint32_t) offset:offset];
+  uint32_t bits;
+  memcpy(&bits, _bytes + o, sizeof(bits));
+  bits = OSSwapLittleToHostInt32(bits);
+  float value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+- (int64_t)HL_readZigzagAtOffset:(NSUInteger *)offset
+{
+  uint64_t value = [self HL_readVarintAtOffset:offset];
+  return (int64_t)(value >> 1) ^ -(int64_t)(value & 1);
+}
+
+/**
+ Reads a string reference, returning the string's index, or `NSNotFound` for the end
+ marker.
+*/
+- (NSUInteger)HL_readStringReferenceAtOffset:(NSUInteger *)offset
+{
+  NSUInteger referenceOffset = *offset;
+  uint64_t reference = [self HL_readVarintAtOffset:offset];
+  if (reference == HLActionArchiverStringReferenceEnd) {
+    return NSNotFound;
+  }
+  if (reference >= HLActionArchiverStringReferenceIndexBase) {
+    uint64_t stringIndex = reference - HLActionArchiverStringReferenceIndexBase;
+    if (stringIndex >= [_strings count]) {
+      HLActionUnarchiverRaiseMalformed();
+    }
+    return (NSUInteger)stringIndex;
+  }
+  uint64_t length;
+  const uint8_t *bytes = [self HL_readBytes:&length offset:offset];
+  NSUInteger stringCount = [_strings count];
+  if (referenceOffset < _stringsScannedOffset) {
+    // note: Already defined; find it by offset.
+    NSUInteger low = 0;
+    NSUInteger high = stringCount;
+    while (low < high) {
+      NSUInteger middle = low + (high - low) / 2;
+      if (_stringOffsets[middle] < referenceOffset) {
+        low = middle + 1;
+      } else {
+        high = middle;
+      }
+    }
+    if (low >= stringCount || _stringOffsets[low] != referenceOffset) {
+      HLActionUnarchiverRaiseMalformed();
+    }
+    return low;
+  }
+  NSString *string = [[NSString alloc] initWithBytes:bytes length:(NSUInteger)length encoding:NSUTF8StringEncoding];
+  if (!string) {
+    HLActionUnarchiverRaiseMalformed();
+  }
+  if (stringCount == _stringCapacity) {
+    _stringCapacity = (_stringCapacity > 0 ? _stringCapacity * 2 : 64);
+    _stringOffsets = HLActionUnarchiverReallocArray(_stringOffsets, _stringCapacity, sizeof(NSUInteger));
+  }
+  _stringOffsets[stringCount] = referenceOffset;
+  [_strings addObject:string];
+  _stringIndexes[string] = @(stringCount);
+  _stringsScannedOffset = *offset;
+  return stringCount;
+}
+
+#pragma mark Scanning
+
+- (void)HL_scanValueAtOffset:(NSUInteger *)offset
+{
+  [self HL_walkValueAtOffset:offset scanning:YES];
+}
+
+- (void)HL_skipValueAtOffset:(NSUInteger *)offset
+{
+  [self HL_walkValueAtOffset:offset scanning:NO];
+}
+
+/**
+ Moves the offset past a value.  When scanning, registers the strings and objects
+ encountered; otherwise, the value must already have been scanned.
+*/
+- (void)HL_walkValueAtOffset:(NSUInteger *)offset scanning:(BOOL)scanning
+{
+  if (_scanDepth >= HLActionUnarchiverMaximumDepth) {
+    [NSException raise:NSInvalidUnarchiveOperationException format:@"HLActionUnarchiver found values nested more than %lu deep.", (unsigned long)HLActionUnarchiverMaximumDepth];
+  }
+  ++_scanDepth;
+  uint8_t tag = [self HL_readTagAtOffset:offset];
+  switch (tag) {
+    case HLActionArchiverTagNil:
+    case HLActionArchiverTagFalse:
+    case HLActionArchiverTagTrue:
+      break;
+    case HLActionArchiverTagInteger:
+    case HLActionArchiverTagNumberInteger:
+    case HLActionArchiverTagReference:
+      [self HL_readVarintAtOffset:offset];
+      break;
+    case HLActionArchiverTagFloat:
+      [self HL_skipLength:sizeof(uint32_t) offset:offset];
+      break;
+    case HLActionArchiverTagDouble:
+    case HLActionArchiverTagNumberDouble:
+      [self HL_skipLength:sizeof(uint64_t) offset:offset];
+      break;
+    case HLActionArchiverTagPoint:
+      [self HL_skipLength:(2 * sizeof(uint64_t)) offset:offset];
+      break;
+    case HLActionArchiverTagNumberBool:
+      [self HL_skipLength:1 offset:offset];
+      break;
+    case HLActionArchiverTagBytes:
+    case HLActionArchiverTagData:
+    case HLActionArchiverTagMutableData: {
+      uint64_t length;
+      [self HL_readBytes:&length offset:offset];
+      break;
+    }
+    case HLActionArchiverTagString:
+      if ([self HL_readStringReferenceAtOffset:offset] == NSNotFound) {
+        HLActionUnarchiverRaiseMalformed();
+      }
+      break;
+    case HLActionArchiverTagArray:
+    case HLActionArchiverTagMutableArray: {
+      uint64_t count = [self HL_readVarintAtOffset:offset];
+      for (uint64_t i = 0; i < count; ++i) {
+        [self HL_walkValueAtOffset:offset scanning:scanning];
+      }
+      break;
+    }
+    case HLActionArchiverTagDictionary:
+    case HLActionArchiverTagMutableDictionary: {
+      uint64_t count = [self HL_readVarintAtOffset:offset];
+      for (uint64_t i = 0; i < count; ++i) {
+        [self HL_walkValueAtOffset:offset scanning:scanning];
+        [self HL_walkValueAtOffset:offset scanning:scanning];
+      }
+      break;
+    }
+    case HLActionArchiverTagObject:
+      if (scanning) {
+        [self HL_scanObjectAtOffset:offset];
+      } else {
+        [self HL_skipObjectAtOffset:offset];
+      }
+      break;
+    default:
+      HLActionUnarchiverRaiseMalformed();
+  }
+  --_scanDepth;
+}
+
+- (void)HL_scanObjectAtOffset:(NSUInteger *)offset
+{
+  // note: The offset of an object is the offset of its tag.
+  NSUInteger objectOffset = *offset - 1;
+  if (_objectCount > 0 && _objects[_objectCount - 1].offset >= objectOffset) {
+    // note: Already scanned.  (Not expected, since values are scanned only once.)
+    HLActionUnarchiverRaiseMalformed();
+  }
+  if (_objectCount == _objectCapacity) {
+    _objectCapacity = (_objectCapacity > 0 ? _objectCapacity * 2 : 64);
+    _objects = HLActionUnarchiverReallocArray(_objects, _objectCapacity, sizeof(HLActionUnarchiverObject));
+    _objectStates = HLActionUnarchiverReallocArray(_objectStates, _objectCapacity, sizeof(uint8_t));
+  }
+  NSUInteger objectIndex = _objectCount;
+  ++_objectCount;
+  _objectStates[objectIndex] = HLActionUnarchiverObjectStateScanned;
+  [_decodedObjects addObject:[NSNull null]];
+
+  NSUInteger classIndex = [self HL_readStringReferenceAtOffset:offset];
+  if (classIndex == NSNotFound) {
+    HLActionUnarchiverRaiseMalformed();
+  }
+
+  NSUInteger stackBase = _scanStackCount;
+  while (YES) {
+    NSUInteger keyIndex = [self HL_readStringReferenceAtOffset:offset];
+    if (keyIndex == NSNotFound) {
+      break;
+    }
+    if (_scanStackCount == _scanStackCapacity) {
+      _scanStackCapacity = (_scanStackCapacity > 0 ? _scanStackCapacity * 2 : 64);
+      _scanStack = HLActionUnarchiverReallocArray(_scanStack, _scanStackCapacity, sizeof(HLActionUnarchiverField));
+    }
+    _scanStack[_scanStackCount].keyIndex = keyIndex;
+    _scanStack[_scanStackCount].valueOffset = *offset;
+    ++_scanStackCount;
+    [self HL_scanValueAtOffset:offset];
+  }
+
+  NSUInteger fieldCount = _scanStackCount - stackBase;
+  if (_fieldCount + fieldCount > _fieldCapacity) {
+    NSUInteger fieldCapacity = (_fieldCapacity > 0 ? _fieldCapacity : 256);
+    while (fieldCapacity < _fieldCount + fieldCount) {
+      fieldCapacity *= 2;
+    }
+    _fields = HLActionUnarchiverReallocArray(_fields, fieldCapacity, sizeof(HLActionUnarchiverField));
+    _fieldCapacity = fieldCapacity;
+  }
+  if (fieldCount > 0) {
+    memcpy(_fields + _fieldCount, _scanStack + stackBase, fieldCount * sizeof(HLActionUnarchiverField));
+  }
+  _objects[objectIndex].offset = objectOffset;
+  _objects[objectIndex].classIndex = classIndex;
+  _objects[objectIndex].fieldStart = _fieldCount;
+  _objects[objectIndex].fieldCount = fieldCount;
+  _fieldCount += fieldCount;
+  _scanStackCount = stackBase;
+}
+
+#pragma mark Decoding
+
+- (NSUInteger)HL_valueOffsetForKey:(NSString *)key
+{
+  if (_currentObject == NSNotFound) {
+    [NSException raise:NSInvalidUnarchiveOperationException format:@"HLActionUnarchiver can only decode keyed values from within initWithCoder:; use decodeRootObject for root objects."];
+  }
+  NSNumber *keyIndexNumber = _stringIndexes[key];
+  if (!keyIndexNumber) {
+    return NSNotFound;
+  }
+  NSUInteger keyIndex = [keyIndexNumber unsignedIntegerValue];
+  HLActionUnarchiverObject *object = &_objects[_currentObject];
+  HLActionUnarchiverField *fields = _fields + object->fieldStart;
+  for (NSUInteger f = 0; f < object->fieldCount; ++f) {
+    if (fields[f].keyIndex == keyIndex) {
+      return fields[f].valueOffset;
+    }
+  }
+  return NSNotFound;
+}
+
+- (void)HL_decodeScalarForKey:(NSString *)key integerValue:(int64_t *)integerValue doubleValue:(double *)doubleValue
+{
+  NSUInteger offset = [self HL_valueOffsetForKey:key];
+  if (offset == NSNotFound) {
+    return;
+  }
+  // note: As with NSKeyedUnarchiver, numeric values may be decoded as other numeric types.
+  uint8_t tag = [self HL_readTagAtOffset:&offset];
+  int64_t i = 0;
+  double d = 0.0;
+  switch (tag) {
+    case HLActionArchiverTagFalse:
+      break;
+    case HLActionArchiverTagTrue:
+      i = 1;
+      d = 1.0;
+      break;
+    case HLActionArchiverTagInteger:
+    case HLActionArchiverTagNumberInteger:
+      i = [self HL_readZigzagAtOffset:&offset];
+      d = (double)i;
+      break;
+    case HLActionArchiverTagFloat:
+      d = [self HL_readFloatAtOffset:&offset];
+      i = (int64_t)d;
+      break;
+    case HLActionArchiverTagDouble:
+    case HLActionArchiverTagNumberDouble:
+      d = [self HL_readDoubleAtOffset:&offset];
+      i = (int64_t)d;
+      break;
+    case HLActionArchiverTagNumberBool:
+      [self HL_skipLength:1 offset:&offset];
+      i = _bytes[offset - 1];
+      d = (double)i;
+      break;
+    default:
+      [self HL_raiseTypeMismatchForKey:key];
+  }
+  if (integerValue) {
+    *integerValue = i;
+  }
+  if (doubleValue) {
+    *doubleValue = d;
+  }
+}
+
+- (void)HL_raiseTypeMismatchForKey:(NSString *)key
+{
+  [NSException raise:NSInvalidUnarchiveOperationException format:@"HLActionUnarchiver found a value of unexpected type for key \"%@\".", key];
+}
+
+- (void)HL_checkAllowedClass:(Class)valueClass
+{
+  if (!_allowedClasses) {
+    return;
+  }
+  for (Class allowedClass in _allowedClasses) {
+    if ([valueClass isSubclassOfClass:allowedClass]) {
+      return;
+    }
+  }
+  [NSException raise:NSInvalidUnarchiveOperationException format:@"HLActionUnarchiver found a value of class %@, which is not among the allowed classes %@.",
+   NSStringFromClass(valueClass), [_allowedClasses allObjects]];
+}
+
+- (Class)HL_classForTag:(uint8_t)tag
+{
+  switch (tag) {
+    case HLActionArchiverTagFalse:
+    case HLActionArchiverTagTrue:
+    case HLActionArchiverTagInteger:
+    case HLActionArchiverTagNumberInteger:
+    case HLActionArchiverTagFloat:
+    case HLActionArchiverTagDouble:
+    case HLActionArchiverTagNumberDouble:
+    case HLActionArchiverTagNumberBool:
+      return [NSNumber class];
+    case HLActionArchiverTagBytes:
+    case HLActionArchiverTagData:
+      return [NSData class];
+    case HLActionArchiverTagMutableData:
+      return [NSMutableData class];
+    case HLActionArchiverTagString:
+      return [NSString class];
+    case HLActionArchiverTagArray:
+      return [NSArray class];
+    case HLActionArchiverTagMutableArray:
+      return [NSMutableArray class];
+    case HLActionArchiverTagDictionary:
+      return [NSDictionary class];
+    case HLActionArchiverTagMutableDictionary:
+      return [NSMutableDictionary class];
+    default:
+      // note: Nil and points are decoded as nil; objects are checked when decoded.
+      return Nil;
+  }
+}
+
+- (id)HL_decodeValueAtOffset:(NSUInteger)valueOffset
+{
+  NSUInteger offset = valueOffset;
+  uint8_t tag = [self HL_readTagAtOffset:&offset];
+  if (_allowedClasses) {
+    Class valueClass = [self HL_classForTag:tag];
+    if (valueClass) {
+      [self HL_checkAllowedClass:valueClass];
+    }
+  }
+  switch (tag) {
+    case HLActionArchiverTagNil:
+      return nil;
+    case HLActionArchiverTagFalse:
+      return @NO;
+    case HLActionArchiverTagTrue:
+      return @YES;
+    case HLActionArchiverTagInteger:
+    case HLActionArchiverTagNumberInteger:
+      return @([self HL_readZigzagAtOffset:&offset]);
+    case HLActionArchiverTagFloat:
+      return @([self HL_readFloatAtOffset:&offset]);
+    case HLActionArchiverTagDouble:
+    case HLActionArchiverTagNumberDouble:
+      return @([self HL_readDoubleAtOffset:&offset]);
+    case HLActionArchiverTagNumberBool:
+      [self HL_skipLength:1 offset:&offset];
+      return (_bytes[offset - 1] ? @YES : @NO);
+    case HLActionArchiverTagPoint:
+      return nil;
+    case HLActionArchiverTagBytes:
+    case HLActionArchiverTagData:
+    case HLActionArchiverTagMutableData: {
+      uint64_t length;
+      const uint8_t *bytes = [self HL_readBytes:&length offset:&offset];
+      if (tag == HLActionArchiverTagMutableData) {
+        return [NSMutableData dataWithBytes:bytes length:(NSUInteger)length];
+      }
+      return [NSData dataWithBytes:bytes length:(NSUInteger)length];
+    }
+    case HLActionArchiverTagString:
+      return _strings[[self HL_readStringReferenceAtOffset:&offset]];
+    case HLActionArchiverTagArray:
+    case HLActionArchiverTagMutableArray: {
+      uint64_t count = [self HL_readVarintAtOffset:&offset];
+      NSMutableArray *array = [NSMutableArray arrayWithCapacity:(NSUInteger)MIN(count, (uint64_t)_length)];
+      for (uint64_t i = 0; i < count; ++i) {
+        NSUInteger elementOffset = offset;
+        [self HL_skipValueAtOffset:&offset];
+        id element = [self HL_decodeValueAtOffset:elementOffset];
+        if (!element) {
+          HLActionUnarchiverRaiseMalformed();
+        }
+        [array addObject:element];
+      }
+      return (tag == HLActionArchiverTagMutableArray ? array : [array copy]);
+    }
+    case HLActionArchiverTagDictionary:
+    case HLActionArchiverTagMutableDictionary: {
+      uint64_t count = [self HL_readVarintAtOffset:&offset];
+      NSMutableDictionary *dictionary = [NSMutableDictionary dictionaryWithCapacity:(NSUInteger)MIN(count, (uint64_t)_length)];
+      for (uint64_t i = 0; i < count; ++i) {
+        NSUInteger keyOffset = offset;
+        [self HL_skipValueAtOffset:&offset];
+        NSUInteger valueOffset = offset;
+        [self HL_skipValueAtOffset:&offset];
+        id key = [self HL_decodeValueAtOffset:keyOffset];
+        id value = [self HL_decodeValueAtOffset:valueOffset];
+        if (!key || !value) {
+          HLActionUnarchiverRaiseMalformed();
+        }
+        dictionary[key] = value;
+      }
+      return (tag == HLActionArchiverTagMutableDictionary ? dictionary : [dictionary copy]);
+    }
+    case HLActionArchiverTagObject:
+      return [self HL_decodeObjectAtIndex:[self HL_objectIndexForOffset:valueOffset]];
+    case HLActionArchiverTagReference: {
+      uint64_t objectIndex = [self HL_readVarintAtOffset:&offset];
+      if (objectIndex >= _objectCount) {
+        HLActionUnarchiverRaiseMalformed();
+      }
+      return [self HL_decodeObjectAtIndex:(NSUInteger)objectIndex];
+    }
+    default:
+      HLActionUnarchiverRaiseMalformed();
+      return nil;
+  }
+}
+
+- (void)HL_skipObjectAtOffset:(NSUInteger *)offset
+{
+  // note: Objects being skipped have already been scanned, so jump directly to the value
+  // of the last field, and then skip past it and the end marker.
+  NSUInteger objectIndex = [self HL_objectIndexForOffset:(*offset - 1)];
+  [self HL_readStringReferenceAtOffset:offset];
+  HLActionUnarchiverObject *object = &_objects[objectIndex];
+  if (object->fieldCount == 0) {
+    [self HL_readStringReferenceAtOffset:offset];
+    return;
+  }
+  *offset = _fields[object->fieldStart + object->fieldCount - 1].valueOffset;
+  [self HL_skipValueAtOffset:offset];
+  [self HL_readStringReferenceAtOffset:offset];
+}
+
+- (NSUInteger)HL_objectIndexForOffset:(NSUInteger)objectOffset
+{
+  // note: Objects are scanned in order of offset, so binary search.
+  NSUInteger low = 0;
+  NSUInteger high = _objectCount;
+  while (low < high) {
+    NSUInteger middle = low + (high - low) / 2;
+    if (_objects[middle].offset < objectOffset) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  if (low >= _objectCount || _objects[low].offset != objectOffset) {
+    HLActionUnarchiverRaiseMalformed();
+  }
+  return low;
+}
+
+- (id)HL_decodeObjectAtIndex:(NSUInteger)objectIndex
+{
+  // note: As with NSKeyedUnarchiver, an object referred to during its own decoding (that
+  // is, in a cycle) is returned as allocated but not yet initialized; it is initialized in
+  // place when its initWithCoder: returns.
+  if (_objectStates[objectIndex] != HLActionUnarchiverObjectStateScanned) {
+    id object = _decodedObjects[objectIndex];
+    if (object == [NSNull null]) {
+      return nil;
+    }
+    [self HL_checkAllowedClass:[object class]];
+    return object;
+  }
+
+  NSString *className = _strings[_objects[objectIndex].classIndex];
+  Class objectClass = NSClassFromString(className);
+  if (!objectClass || ![objectClass instancesRespondToSelector:@selector(initWithCoder:)]) {
+    [NSException raise:NSInvalidUnarchiveOperationException format:@"HLActionUnarchiver cannot decode object of class %@.", className];
+  }
+  [self HL_checkAllowedClass:objectClass];
+  if (_decodeDepth >= HLActionUnarchiverMaximumDepth) {
+    [NSException raise:NSInvalidUnarchiveOperationException format:@"HLActionUnarchiver found objects nested more than %lu deep.", (unsigned long)HLActionUnarchiverMaximumDepth];
+  }
+
+  ++_decodeDepth;
+  _objectStates[objectIndex] = HLActionUnarchiverObjectStateDecoding;
+  NSUInteger parentObject = _currentObject;
+  NSSet *allowedClasses = _allowedClasses;
+  _currentObject = objectIndex;
+  _allowedClasses = nil;
+  id object = [objectClass alloc];
+  _decodedObjects[objectIndex] = object;
+  object = [object initWithCoder:self];
+  object = [object awakeAfterUsingCoder:self];
+  _currentObject = parentObject;
+  _allowedClasses = allowedClasses;
+  _objectStates[objectIndex] = HLActionUnarchiverObjectStateDecoded;
+  _decodedObjects[objectIndex] = (object ?: [NSNull null]);
+  --_decodeDepth;
+  return object;
+}
+
+@end
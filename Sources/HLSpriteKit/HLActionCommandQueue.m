@@ -0,0 +1,217 @@
+//
+//  HLActionCommandQueue.m
+//  HLSpriteKit
+//
+//  Created by Karl Voskuil on 10/16/26.
+//  Copyright © 2026 Hilo Games. All rights reserved.
+//
+
+#import "HLActionCommandQueue.h"
+
+#import "SKNode+HLAction.h"
+
+#include <stdatomic.h>
+#include <stdlib.h>
+
+typedef NS_ENUM(uint8_t, HLActionCommandType) {
+  HLActionCommandRunAction,
+  HLActionCommandRemoveAction,
+  HLActionCommandRemoveAllActions,
+};
+
+// note: Object pointers are retained (with CFBridgingRetain) by the adding thread, and
+// released by the draining thread after the command is applied.
+typedef struct HLActionCommand {
+  struct HLActionCommand *next;
+  HLActionCommandType type;
+  BOOL isTargetActionRunner;
+  void *target;
+  void *key;
+  void *action;
+} HLActionCommand;
+
+static void
+HLActionCommandApply(const HLActionCommand *command)
+{
+  NSString *key = (__bridge NSString *)command->key;
+  if (command->isTargetActionRunner) {
+    HLActionRunner *actionRunner = (__bridge HLActionRunner *)command->target;
+    switch (command->type) {
+      case HLActionCommandRunAction:
+        [actionRunner runAction:(__bridge HLAction *)command->action withKey:key];
+        break;
+      case HLActionCommandRemoveAction:
+        [actionRunner removeActionForKey:key];
+        break;
+      case HLActionCommandRemoveAllActions:
+        [actionRunner removeAllActions];
+        break;
+    }
+  } else {
+    SKNode *node = (__bridge SKNode *)command->target;
+    switch (command->type) {
+      case HLActionCommandRunAction:
+        [node hlRunAction:(__bridge HLAction *)command->action withKey:key];
+        break;
+      case HLActionCommandRemoveAction:
+        [node hlRemoveActionForKey:key];
+        break;
+      case HLActionCommandRemoveAllActions:
+        [node hlRemoveAllActions];
+        break;
+    }
+  }
+}
+
+static void
+HLActionCommandRelease(HLActionCommand *command)
+{
+  CFRelease(command->target);
+  if (command->key) {
+    CFRelease(command->key);
+  }
+  if (command->action) {
+    CFRelease(command->action);
+  }
+  free(command);
+}
+
+@implementation HLActionCommandQueue
+{
+  // note: The most recently added command; commands are linked from newest to oldest.
+  _Atomic(HLActionCommand *) _head;
+}
+
+- (instancetype)init
+{
+  self = [super init];
+  if (self) {
+    atomic_init(&_head, NULL);
+  }
+  return self;
+}
+
+- (void)dealloc
+{
+  // note: Commands never applied are discarded.
+  HLActionCommand *command = atomic_exchange_explicit(&_head, NULL, memory_order_acquire);
+  while (command) {
+    HLActionCommand *nextCommand = command->next;
+    HLActionCommandRelease(command);
+    command = nextCommand;
+  }
+}
+
+- (void)runAction:(HLAction *)action withKey:(NSString *)key onNode:(SKNode *)node
+{
+  [self HL_addCommandWithType:(action ? HLActionCommandRunAction : HLActionCommandRemoveAction)
+                       target:node
+         isTargetActionRunner:NO
+                          key:key
+                       action:action];
+}
+
+- (void)removeActionForKey:(NSString *)key onNode:(SKNode *)node
+{
+  [self HL_addCommandWithType:HLActionCommandRemoveAction target:node isTargetActionRunner:NO key:key action:nil];
+}
+
+- (void)removeAllActionsOnNode:(SKNode *)node
+{
+  [self HL_addCommandWithType:HLActionCommandRemoveAllActions target:node isTargetActionRunner:NO key:nil action:nil];
+}
+
+- (void)runAction:(HLAction *)action withKey:(NSString *)key onActionRunner:(HLActionRunner *)actionRunner
+{
+  [self HL_addCommandWithType:(action ? HLActionCommandRunAction : HLActionCommandRemoveAction)
+                       target:actionRunner
+         isTargetActionRunner:YES
+                          key:key
+                       action:action];
+}
+
+- (void)removeActionForKey:(NSString *)key onActionRunner:(HLActionRunner *)actionRunner
+{
+  [self HL_addCommandWithType:HLActionCommandRemoveAction target:actionRunner isTargetActionRunner:YES key:key action:nil];
+}
+
+- (void)removeAllActionsOnActionRunner:(HLActionRunner *)actionRunner
+{
+  [self HL_addCommandWithType:HLActionCommandRemoveAllActions target:actionRunner isTargetActionRunner:YES key:nil action:nil];
+}
+
+- (void)HL_addCommandWithType:(HLActionCommandType)type
+                       target:(id)target
+         isTargetActionRunner:(BOOL)isTargetActionRunner
+                          key:(NSString *)key
+                       action:(HLAction *)action
+{
+  if (!target) {
+    return;
+  }
+  if (!key && type != HLActionCommandRemoveAllActions) {
+    [NSException raise:@"HLActionMissingKey" format:@"Action cannot be run without a key."];
+  }
+  HLActionCommand *command = malloc(sizeof(HLActionCommand));
+  if (!command) {
+    [NSException raise:NSMallocException format:@"HLActionCommandQueue could not allocate a command."];
+  }
+  command->type = type;
+  command->isTargetActionRunner = isTargetActionRunner;
+  command->target = (void *)CFBridgingRetain(target);
+  command->key = (key ? (void *)CFBridgingRetain([key copy]) : NULL);
+  command->action = (action ? (void *)CFBridgingRetain(action) : NULL);
+
+  // note: Release ordering publishes the command's fields to the draining thread.
+  HLActionCommand *head = atomic_load_explicit(&_head, memory_order_relaxed);
+  do {
+    command->next = head;
+  } while (!atomic_compare_exchange_weak_explicit(&_head, &head, command, memory_order_release, memory_order_relaxed));
+}
+
+- (BOOL)hasCommands
+{
+  return atomic_load_explicit(&_head, memory_order_relaxed) != NULL;
+}
+
+- (NSUInteger)drain
+{
+  // note: Checked first (without the exchange) so that draining an empty queue, which is
+  // the usual case, is a single load.
+  if (atomic_load_explicit(&_head, memory_order_relaxed) == NULL) {
+    return 0;
+  }
+  HLActionCommand *command = atomic_exchange_explicit(&_head, NULL, memory_order_acquire);
+
+  // note: Reverse the stack so that commands are applied in the order they were added.
+  HLActionCommand *oldestCommand = NULL;
+  while (command) {
+    HLActionCommand *nextCommand = command->next;
+    command->next = oldestCommand;
+    oldestCommand = command;
+    command = nextCommand;
+  }
+
+  NSUInteger commandCount = 0;
+  command = oldestCommand;
+  @try {
+    while (command) {
+      HLActionCommandApply(command);
+      HLActionCommand *nextCommand = command->next;
+      HLActionCommandRelease(command);
+      ++commandCount;
+      command = nextCommand;
+    }
+  } @finally {
+    // note: If applying a command throws, the remaining commands (including the one that
+    // threw) are discarded, as if the queue were deallocated.
+    while (command) {
+      HLActionCommand *nextCommand = command->next;
+      HLActionCommandRelease(command);
+      command = nextCommand;
+    }
+  }
+  return commandCount;
+}
+
+@end
@@ -0,0 +1,747 @@
+//
+//  HLActionDescriptor.m
+//  HLSpriteKit
+//
+//  Created by Karl Voskuil on 10/16/26.
+//  Copyright © 2026 Hilo Games. All rights reserved.
+//
+
+#import "HLActionDescriptor.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// note: Called by HLActionRunner (in HLAction.m); not part of the public interface.
+void HLActionDescriptorBeginRunning(HLActionDescriptor *descriptor);
+void HLActionDescriptorEndRunning(HLActionDescriptor *descriptor);
+
+typedef NS_ENUM(uint8_t, HLActionDescriptorType) {
+  HLActionDescriptorTypeWait,
+  HLActionDescriptorTypeMoveBy,
+  HLActionDescriptorTypeMoveTo,
+  HLActionDescriptorTypeScaleBy,
+  HLActionDescriptorTypeScaleTo,
+  HLActionDescriptorTypeRotateBy,
+  HLActionDescriptorTypeRotateTo,
+  HLActionDescriptorTypeFadeAlphaBy,
+  HLActionDescriptorTypeFadeAlphaTo,
+  HLActionDescriptorTypeRemoveFromParent,
+  HLActionDescriptorTypeSequence,
+  HLActionDescriptorTypeGroup,
+};
+
+// note: Chunk memory follows the header directly.  Allocations are rounded up to this
+// alignment, as is the header.
+enum {
+  HLActionArenaAlignment = 16,
+};
+
+static const NSUInteger HLActionArenaDefaultChunkSize = 16384;
+
+typedef struct HLActionArenaChunk {
+  struct HLActionArenaChunk *next;
+  size_t size;
+  size_t used;
+  // note: The number of running descriptors allocated from this chunk; the chunk can only
+  // be recycled when zero.
+  NSUInteger runningCount;
+} HLActionArenaChunk;
+
+static inline size_t
+HLActionArenaAlign(size_t size)
+{
+  return (size + (HLActionArenaAlignment - 1)) & ~(size_t)(HLActionArenaAlignment - 1);
+}
+
+struct HLActionDescriptor {
+  HLActionArenaChunk *chunk;
+  __unsafe_unretained HLActionArena *arena;
+  HLActionDescriptorType type;
+  // note: A descriptor is run only once, and only as a root; members of sequences and
+  // groups are run by their parents.
+  BOOL isRunning;
+  BOOL isMember;
+  BOOL isStarted;
+  // note: For members of groups.
+  BOOL isCompleted;
+  // note: For "to" descriptors: whether the starting value has been read from the node.
+  BOOL isFromSet;
+  HLActionTimingMode timingMode;
+  CGFloat speed;
+  NSTimeInterval duration;
+  NSTimeInterval elapsedTimeLinear;
+  // note: The sum of all incremental times passed to this descriptor, in its caller's
+  // frame; see HLActionDescriptorCreateAction().
+  NSTimeInterval time;
+  union {
+    struct {
+      CGFloat valueX;
+      CGFloat valueY;
+      CGFloat fromX;
+      CGFloat fromY;
+      CGFloat lastCumulativeDeltaX;
+      CGFloat lastCumulativeDeltaY;
+    } leaf;
+    struct {
+      HLActionDescriptor **descriptors;
+      // note: The member array might not be allocated from the same chunk as the
+      // collection.
+      HLActionArenaChunk *descriptorsChunk;
+      NSUInteger count;
+      // note: The current descriptor of a sequence, or the number of uncompleted
+      // descriptors of a group.
+      NSUInteger index;
+      NSUInteger remainingCount;
+    } collection;
+  };
+};
+
+@interface HLActionArena ()
+{
+@package
+  NSUInteger _runningCount;
+}
+
+- (void *)HL_allocate:(size_t)size chunk:(HLActionArenaChunk **)chunk;
+
+@end
+
+@implementation HLActionArena
+{
+  // note: All chunks, most recently allocated first.
+  HLActionArenaChunk *_chunks;
+  HLActionArenaChunk *_currentChunk;
+  size_t _chunkSize;
+}
+
+- (instancetype)init
+{
+  return [self initWithChunkSize:HLActionArenaDefaultChunkSize];
+}
+
+- (instancetype)initWithChunkSize:(NSUInteger)chunkSize
+{
+  self = [super init];
+  if (self) {
+    _chunks = NULL;
+    _currentChunk = NULL;
+    _chunkSize = HLActionArenaAlign(MAX(chunkSize, (NSUInteger)sizeof(HLActionDescriptor)));
+    _chunkBytes = 0;
+    _runningCount = 0;
+  }
+  return self;
+}
+
+- (void)dealloc
+{
+  HLActionArenaChunk *chunk = _chunks;
+  while (chunk) {
+    HLActionArenaChunk *nextChunk = chunk->next;
+    free(chunk);
+    chunk = nextChunk;
+  }
+}
+
+- (NSUInteger)runningCount
+{
+  return _runningCount;
+}
+
+- (void)recycle
+{
+  for (HLActionArenaChunk *chunk = _chunks; chunk; chunk = chunk->next) {
+    if (chunk->runningCount == 0) {
+      chunk->used = 0;
+    }
+  }
+}
+
+- (void *)HL_allocate:(size_t)size chunk:(HLActionArenaChunk **)chunk
+{
+  size = HLActionArenaAlign(size);
+  HLActionArenaChunk *allocationChunk = _currentChunk;
+  if (!allocationChunk || allocationChunk->size - allocationChunk->used < size) {
+    // note: Prefer an empty (recycled) chunk to a new one.  The search is linear, but only
+    // happens when the current chunk is full.
+    allocationChunk = NULL;
+    for (HLActionArenaChunk *c = _chunks; c; c = c->next) {
+      if (c->used == 0 && c->size >= size) {
+        allocationChunk = c;
+        break;
+      }
+    }
+    if (!allocationChunk) {
+      size_t chunkSize = MAX(_chunkSize, size);
+      allocationChunk = malloc(HLActionArenaAlign(sizeof(HLActionArenaChunk)) + chunkSize);
+      if (!allocationChunk) {
+        [NSException raise:NSMallocException format:@"HLActionArena could not allocate a chunk of %lu bytes.", (unsigned long)chunkSize];
+      }
+      allocationChunk->next = _chunks;
+      allocationChunk->size = chunkSize;
+      allocationChunk->used = 0;
+      allocationChunk->runningCount = 0;
+      _chunks = allocationChunk;
+      _chunkBytes += chunkSize;
+    }
+    _currentChunk = allocationChunk;
+  }
+  void *memory = (char *)allocationChunk + HLActionArenaAlign(sizeof(HLActionArenaChunk)) + allocationChunk->used;
+  allocationChunk->used += size;
+  memset(memory, 0, size);
+  *chunk = allocationChunk;
+  return memory;
+}
+
+@end
+
+static HLActionDescriptor *
+HLActionDescriptorCreate(HLActionArena *arena, HLActionDescriptorType type, NSTimeInterval duration)
+{
+  if (!arena) {
+    [NSException raise:NSInvalidArgumentException format:@"An action descriptor must be created with an arena."];
+  }
+  HLActionArenaChunk *chunk;
+  HLActionDescriptor *descriptor = [arena HL_allocate:sizeof(HLActionDescriptor) chunk:&chunk];
+  descriptor->chunk = chunk;
+  descriptor->arena = arena;
+  descriptor->type = type;
+  descriptor->timingMode = HLActionTimingLinear;
+  descriptor->speed = 1.0f;
+  descriptor->duration = duration;
+  return descriptor;
+}
+
+static HLActionDescriptor *
+HLActionDescriptorCreateLeaf(HLActionArena *arena, HLActionDescriptorType type, CGFloat valueX, CGFloat valueY, NSTimeInterval duration)
+{
+  HLActionDescriptor *descriptor = HLActionDescriptorCreate(arena, type, duration);
+  descriptor->leaf.valueX = valueX;
+  descriptor->leaf.valueY = valueY;
+  return descriptor;
+}
+
+static HLActionDescriptor *
+HLActionDescriptorCreateCollection(HLActionArena *arena, HLActionDescriptorType type, HLActionDescriptor * const *descriptors, NSUInteger count)
+{
+  if (!descriptors || count == 0) {
+    [NSException raise:@"HLActionInvalid" format:@"An action descriptor sequence or group must be created with at least one descriptor."];
+  }
+  NSTimeInterval duration = 0.0;
+  for (NSUInteger d = 0; d < count; ++d) {
+    HLActionDescriptor *member = descriptors[d];
+    if (member->arena != arena || member->isMember || member->isRunning) {
+      [NSException raise:@"HLActionInvalid" format:@"Action descriptors in a sequence or group must be from the same arena, and not otherwise used."];
+    }
+    if (type == HLActionDescriptorTypeSequence) {
+      duration += member->duration;
+    } else if (member->duration > duration) {
+      duration = member->duration;
+    }
+  }
+  HLActionDescriptor *descriptor = HLActionDescriptorCreate(arena, type, duration);
+  HLActionArenaChunk *descriptorsChunk;
+  HLActionDescriptor **members = [arena HL_allocate:(count * sizeof(HLActionDescriptor *)) chunk:&descriptorsChunk];
+  memcpy(members, descriptors, count * sizeof(HLActionDescriptor *));
+  for (NSUInteger d = 0; d < count; ++d) {
+    members[d]->isMember = YES;
+  }
+  descriptor->collection.descriptors = members;
+  descriptor->collection.descriptorsChunk = descriptorsChunk;
+  descriptor->collection.count = count;
+  descriptor->collection.index = 0;
+  descriptor->collection.remainingCount = count;
+  return descriptor;
+}
+
+HLActionDescriptor *
+HLActionDescriptorWait(HLActionArena *arena, NSTimeInterval duration)
+{
+  return HLActionDescriptorCreate(arena, HLActionDescriptorTypeWait, duration);
+}
+
+HLActionDescriptor *
+HLActionDescriptorMoveBy(HLActionArena *arena, CGFloat deltaX, CGFloat deltaY, NSTimeInterval duration)
+{
+  return HLActionDescriptorCreateLeaf(arena, HLActionDescriptorTypeMoveBy, deltaX, deltaY, duration);
+}
+
+HLActionDescriptor *
+HLActionDescriptorMoveTo(HLActionArena *arena, CGPoint destination, NSTimeInterval duration)
+{
+  return HLActionDescriptorCreateLeaf(arena, HLActionDescriptorTypeMoveTo, destination.x, destination.y, duration);
+}
+
+HLActionDescriptor *
+HLActionDescriptorScaleBy(HLActionArena *arena, CGFloat scaleDeltaX, CGFloat scaleDeltaY, NSTimeInterval duration)
+{
+  return HLActionDescriptorCreateLeaf(arena, HLActionDescriptorTypeScaleBy, scaleDeltaX, scaleDeltaY, duration);
+}
+
+HLActionDescriptor *
+HLActionDescriptorScaleTo(HLActionArena *arena, CGFloat scaleXTo, CGFloat scaleYTo, NSTimeInterval duration)
+{
+  return HLActionDescriptorCreateLeaf(arena, HLActionDescriptorTypeScaleTo, scaleXTo, scaleYTo, duration);
+}
+
+HLActionDescriptor *
+HLActionDescriptorRotateBy(HLActionArena *arena, CGFloat angleDelta, NSTimeInterval duration)
+{
+  return HLActionDescriptorCreateLeaf(arena, HLActionDescriptorTypeRotateBy, angleDelta, 0.0f, duration);
+}
+
+HLActionDescriptor *
+HLActionDescriptorRotateTo(HLActionArena *arena, CGFloat angleTo, NSTimeInterval duration)
+{
+  return HLActionDescriptorCreateLeaf(arena, HLActionDescriptorTypeRotateTo, angleTo, 0.0f, duration);
+}
+
+HLActionDescriptor *
+HLActionDescriptorFadeAlphaBy(HLActionArena *arena, CGFloat alphaDelta, NSTimeInterval duration)
+{
+  return HLActionDescriptorCreateLeaf(arena, HLActionDescriptorTypeFadeAlphaBy, alphaDelta, 0.0f, duration);
+}
+
+HLActionDescriptor *
+HLActionDescriptorFadeAlphaTo(HLActionArena *arena, CGFloat alphaTo, NSTimeInterval duration)
+{
+  return HLActionDescriptorCreateLeaf(arena, HLActionDescriptorTypeFadeAlphaTo, alphaTo, 0.0f, duration);
+}
+
+HLActionDescriptor *
+HLActionDescriptorRemoveFromParent(HLActionArena *arena)
+{
+  return HLActionDescriptorCreate(arena, HLActionDescriptorTypeRemoveFromParent, 0.0);
+}
+
+HLActionDescriptor *
+HLActionDescriptorSequence(HLActionArena *arena, HLActionDescriptor * const *descriptors, NSUInteger count)
+{
+  return HLActionDescriptorCreateCollection(arena, HLActionDescriptorTypeSequence, descriptors, count);
+}
+
+HLActionDescriptor *
+HLActionDescriptorGroup(HLActionArena *arena, HLActionDescriptor * const *descriptors, NSUInteger count)
+{
+  return HLActionDescriptorCreateCollection(arena, HLActionDescriptorTypeGroup, descriptors, count);
+}
+
+void
+HLActionDescriptorSetTimingMode(HLActionDescriptor *descriptor, HLActionTimingMode timingMode)
+{
+  descriptor->timingMode = timingMode;
+}
+
+void
+HLActionDescriptorSetSpeed(HLActionDescriptor *descriptor, CGFloat speed)
+{
+  descriptor->speed = (speed > 0.0f ? speed : 0.0f);
+}
+
+NSTimeInterval
+HLActionDescriptorDuration(const HLActionDescriptor *descriptor)
+{
+  return descriptor->duration;
+}
+
+HLActionArena *
+HLActionDescriptorArena(const HLActionDescriptor *descriptor)
+{
+  return descriptor->arena;
+}
+
+#pragma mark - Running
+
+// note: The following mirror the corresponding HLAction methods exactly, so that a
+// descriptor gives the same results as the equivalent action.  See HLAction.m for
+// discussion.
+
+static inline NSTimeInterval
+HLActionDescriptorElapsedTime(const HLActionDescriptor *descriptor)
+{
+  NSTimeInterval elapsedTimeLinear = descriptor->elapsedTimeLinear;
+  NSTimeInterval duration = descriptor->duration;
+  if (elapsedTimeLinear <= 0.0 || elapsedTimeLinear >= duration || descriptor->timingMode == HLActionTimingLinear) {
+    return elapsedTimeLinear;
+  }
+  return HLActionApplyTiming(descriptor->timingMode, (CGFloat)(elapsedTimeLinear / duration)) * duration;
+}
+
+static inline NSTimeInterval
+HLActionDescriptorElapsedTimeLinearForElapsedTime(const HLActionDescriptor *descriptor, NSTimeInterval elapsedTime)
+{
+  NSTimeInterval duration = descriptor->duration;
+  if (elapsedTime <= 0.0 || elapsedTime >= duration || descriptor->timingMode == HLActionTimingLinear) {
+    return elapsedTime;
+  }
+  return HLActionApplyTimingInverse(descriptor->timingMode, (CGFloat)(elapsedTime / duration)) * duration;
+}
+
+static inline BOOL
+HLActionDescriptorAdvanceTime(HLActionDescriptor *descriptor, NSTimeInterval incrementalTime, NSTimeInterval *extraTime)
+{
+  descriptor->elapsedTimeLinear += (incrementalTime * descriptor->speed);
+  if (descriptor->elapsedTimeLinear < descriptor->duration) {
+    return YES;
+  }
+  if (descriptor->speed == 0.0f) {
+    *extraTime = incrementalTime;
+  } else {
+    *extraTime = (descriptor->elapsedTimeLinear - descriptor->duration) / descriptor->speed;
+  }
+  return NO;
+}
+
+static inline CGFloat
+HLActionDescriptorNormalTime(const HLActionDescriptor *descriptor)
+{
+  NSTimeInterval elapsedTime = HLActionDescriptorElapsedTime(descriptor);
+  if (elapsedTime >= descriptor->duration) {
+    return 1.0f;
+  }
+  return (CGFloat)(elapsedTime / descriptor->duration);
+}
+
+static inline CGFloat
+HLActionDescriptorInterpolate(CGFloat from, CGFloat to, CGFloat normalTime)
+{
+  if (normalTime >= 1.0f) {
+    return to;
+  }
+  return from * (1.0f - normalTime) + to * normalTime;
+}
+
+static inline BOOL
+HLActionDescriptorIsBy(HLActionDescriptorType type)
+{
+  return (type == HLActionDescriptorTypeMoveBy
+          || type == HLActionDescriptorTypeScaleBy
+          || type == HLActionDescriptorTypeRotateBy
+          || type == HLActionDescriptorTypeFadeAlphaBy);
+}
+
+static BOOL HLActionDescriptorStep(HLActionDescriptor *descriptor, NSTimeInterval incrementalTime, SKNode *node, NSTimeInterval *extraTime);
+
+static BOOL
+HLActionDescriptorStepLeaf(HLActionDescriptor *descriptor, NSTimeInterval incrementalTime, SKNode *node, NSTimeInterval *extraTime)
+{
+  HLActionDescriptorType type = descriptor->type;
+
+  if (!descriptor->isFromSet) {
+    switch (type) {
+      case HLActionDescriptorTypeMoveTo:
+      case HLActionDescriptorTypeScaleTo:
+      case HLActionDescriptorTypeRotateTo:
+      case HLActionDescriptorTypeFadeAlphaTo:
+        if (!node) {
+          [NSException raise:@"HLActionUninitialized" format:@"An action descriptor animating to a value requires a node on its first update."];
+        }
+        break;
+      default:
+        break;
+    }
+    switch (type) {
+      case HLActionDescriptorTypeMoveTo:
+        descriptor->leaf.fromX = node.position.x;
+        descriptor->leaf.fromY = node.position.y;
+        break;
+      case HLActionDescriptorTypeScaleTo:
+        descriptor->leaf.fromX = node.xScale;
+        descriptor->leaf.fromY = node.yScale;
+        break;
+      case HLActionDescriptorTypeRotateTo:
+        descriptor->leaf.fromX = node.zRotation;
+        break;
+      case HLActionDescriptorTypeFadeAlphaTo:
+        descriptor->leaf.fromX = node.alpha;
+        break;
+      default:
+        break;
+    }
+    descriptor->isFromSet = YES;
+  }
+
+  // note: As in HLMoveByAction, the cumulative delta is the sum of the instantaneous deltas,
+  // so that the final delta compensates for floating point drift.
+  BOOL isBy = HLActionDescriptorIsBy(type);
+  if (isBy) {
+    CGFloat normalTime = HLActionDescriptorNormalTime(descriptor);
+    descriptor->leaf.lastCumulativeDeltaX += descriptor->leaf.valueX * normalTime - descriptor->leaf.lastCumulativeDeltaX;
+    descriptor->leaf.lastCumulativeDeltaY += descriptor->leaf.valueY * normalTime - descriptor->leaf.lastCumulativeDeltaY;
+  }
+
+  BOOL notYetCompleted = HLActionDescriptorAdvanceTime(descriptor, incrementalTime, extraTime);
+
+  if (!node || type == HLActionDescriptorTypeWait) {
+    return notYetCompleted;
+  }
+
+  CGFloat normalTime = HLActionDescriptorNormalTime(descriptor);
+  CGFloat x;
+  CGFloat y;
+  if (isBy) {
+    x = descriptor->leaf.valueX * normalTime - descriptor->leaf.lastCumulativeDeltaX;
+    y = descriptor->leaf.valueY * normalTime - descriptor->leaf.lastCumulativeDeltaY;
+  } else {
+    x = HLActionDescriptorInterpolate(descriptor->leaf.fromX, descriptor->leaf.valueX, normalTime);
+    y = HLActionDescriptorInterpolate(descriptor->leaf.fromY, descriptor->leaf.valueY, normalTime);
+  }
+  switch (type) {
+    case HLActionDescriptorTypeMoveBy: {
+      CGPoint position = node.position;
+      position.x += x;
+      position.y += y;
+      node.position = position;
+      break;
+    }
+    case HLActionDescriptorTypeMoveTo:
+      node.position = CGPointMake(x, y);
+      break;
+    case HLActionDescriptorTypeScaleBy:
+      node.xScale += x;
+      node.yScale += y;
+      break;
+    case HLActionDescriptorTypeScaleTo:
+      node.xScale = x;
+      node.yScale = y;
+      break;
+    case HLActionDescriptorTypeRotateBy:
+      node.zRotation += x;
+      break;
+    case HLActionDescriptorTypeRotateTo:
+      node.zRotation = x;
+      break;
+    case HLActionDescriptorTypeFadeAlphaBy:
+      node.alpha += x;
+      break;
+    case HLActionDescriptorTypeFadeAlphaTo:
+      node.alpha = x;
+      break;
+    default:
+      break;
+  }
+  return notYetCompleted;
+}
+
+static BOOL
+HLActionDescriptorComplete(HLActionDescriptor *descriptor, NSTimeInterval incrementalTime, NSTimeInterval elapsedTime, NSTimeInterval extraTimeMyFrame, NSTimeInterval *extraTime)
+{
+  // note: Translates extra time from a completed sequence or group back into the caller's
+  // frame, as in [HLSequenceAction HL_update:node:extraTime:].
+  NSTimeInterval completionTimeLinear = HLActionDescriptorElapsedTimeLinearForElapsedTime(descriptor, elapsedTime - extraTimeMyFrame);
+  if (descriptor->speed == 0.0f) {
+    *extraTime = incrementalTime;
+  } else {
+    *extraTime = (descriptor->elapsedTimeLinear - completionTimeLinear) / descriptor->speed;
+  }
+  return NO;
+}
+
+static BOOL
+HLActionDescriptorStepSequence(HLActionDescriptor *descriptor, NSTimeInterval incrementalTime, SKNode *node, NSTimeInterval *extraTime)
+{
+  NSTimeInterval elapsedTimeOld = HLActionDescriptorElapsedTime(descriptor);
+  descriptor->elapsedTimeLinear += (incrementalTime * descriptor->speed);
+  NSTimeInterval elapsedTime = HLActionDescriptorElapsedTime(descriptor);
+  NSTimeInterval incrementalTimeMyFrame = elapsedTime - elapsedTimeOld;
+
+  NSUInteger count = descriptor->collection.count;
+  NSTimeInterval remainingIncrementalTimeMyFrame = incrementalTimeMyFrame;
+  NSTimeInterval extraTimeMyFrame = incrementalTimeMyFrame;
+  while (descriptor->collection.index < count) {
+    HLActionDescriptor *member = descriptor->collection.descriptors[descriptor->collection.index];
+    if (HLActionDescriptorStep(member, remainingIncrementalTimeMyFrame, node, &extraTimeMyFrame)) {
+      return YES;
+    }
+    remainingIncrementalTimeMyFrame = extraTimeMyFrame;
+    ++descriptor->collection.index;
+  }
+  return HLActionDescriptorComplete(descriptor, incrementalTime, elapsedTime, extraTimeMyFrame, extraTime);
+}
+
+static BOOL
+HLActionDescriptorStepGroup(HLActionDescriptor *descriptor, NSTimeInterval incrementalTime, SKNode *node, NSTimeInterval *extraTime)
+{
+  NSTimeInterval elapsedTimeOld = HLActionDescriptorElapsedTime(descriptor);
+  descriptor->elapsedTimeLinear += (incrementalTime * descriptor->speed);
+  NSTimeInterval elapsedTime = HLActionDescriptorElapsedTime(descriptor);
+  NSTimeInterval incrementalTimeMyFrame = elapsedTime - elapsedTimeOld;
+
+  NSTimeInterval leastExtraTimeMyFrame = incrementalTimeMyFrame;
+  NSUInteger count = descriptor->collection.count;
+  for (NSUInteger d = 0; d < count; ++d) {
+    HLActionDescriptor *member = descriptor->collection.descriptors[d];
+    if (member->isCompleted) {
+      continue;
+    }
+    NSTimeInterval extraTimeMyFrame;
+    if (!HLActionDescriptorStep(member, incrementalTimeMyFrame, node, &extraTimeMyFrame)) {
+      member->isCompleted = YES;
+      --descriptor->collection.remainingCount;
+      if (extraTimeMyFrame < leastExtraTimeMyFrame) {
+        leastExtraTimeMyFrame = extraTimeMyFrame;
+      }
+    }
+  }
+  if (descriptor->collection.remainingCount > 0) {
+    return YES;
+  }
+  return HLActionDescriptorComplete(descriptor, incrementalTime, elapsedTime, leastExtraTimeMyFrame, extraTime);
+}
+
+static BOOL
+HLActionDescriptorStep(HLActionDescriptor *descriptor, NSTimeInterval incrementalTime, SKNode *node, NSTimeInterval *extraTime)
+{
+  descriptor->isStarted = YES;
+  descriptor->time += incrementalTime;
+  switch (descriptor->type) {
+    case HLActionDescriptorTypeSequence:
+      return HLActionDescriptorStepSequence(descriptor, incrementalTime, node, extraTime);
+    case HLActionDescriptorTypeGroup:
+      return HLActionDescriptorStepGroup(descriptor, incrementalTime, node, extraTime);
+    case HLActionDescriptorTypeRemoveFromParent:
+      descriptor->elapsedTimeLinear += (incrementalTime * descriptor->speed);
+      if (node && node.parent) {
+        [node removeFromParent];
+      }
+      *extraTime = incrementalTime;
+      return NO;
+    default:
+      return HLActionDescriptorStepLeaf(descriptor, incrementalTime, node, extraTime);
+  }
+}
+
+BOOL
+HLActionDescriptorUpdate(HLActionDescriptor *descriptor, NSTimeInterval incrementalTime, SKNode *node)
+{
+  if (incrementalTime < 0.0) {
+    incrementalTime = 0.0;
+  }
+  NSTimeInterval extraTime;
+  return HLActionDescriptorStep(descriptor, incrementalTime, node, &extraTime);
+}
+
+static void
+HLActionDescriptorCountRunning(HLActionDescriptor *descriptor, NSInteger increment)
+{
+  descriptor->chunk->runningCount += increment;
+  descriptor->arena->_runningCount += increment;
+  if (descriptor->type == HLActionDescriptorTypeSequence || descriptor->type == HLActionDescriptorTypeGroup) {
+    descriptor->collection.descriptorsChunk->runningCount += increment;
+    for (NSUInteger d = 0; d < descriptor->collection.count; ++d) {
+      HLActionDescriptorCountRunning(descriptor->collection.descriptors[d], increment);
+    }
+  }
+}
+
+void
+HLActionDescriptorBeginRunning(HLActionDescriptor *descriptor)
+{
+  // note: The descriptor's members (and member arrays) are counted, too, so that the
+  // chunks they were allocated from are not recycled while running.
+  if (descriptor->isRunning || descriptor->isMember) {
+    [NSException raise:@"HLActionInvalid" format:@"An action descriptor may only be run once, and not if it is a member of a sequence or group."];
+  }
+  descriptor->isRunning = YES;
+  HLActionDescriptorCountRunning(descriptor, 1);
+  CFRetain((__bridge CFTypeRef)descriptor->arena);
+}
+
+void
+HLActionDescriptorEndRunning(HLActionDescriptor *descriptor)
+{
+  HLActionArena *arena = descriptor->arena;
+  HLActionDescriptorCountRunning(descriptor, -1);
+  CFRelease((__bridge CFTypeRef)arena);
+}
+
+#pragma mark - Converting
+
+static HLAction *
+HLActionDescriptorCreateActionTree(const HLActionDescriptor *descriptor)
+{
+  HLAction *action = nil;
+  CGFloat valueX = descriptor->leaf.valueX;
+  CGFloat valueY = descriptor->leaf.valueY;
+  NSTimeInterval duration = descriptor->duration;
+  BOOL isFromSet = descriptor->isFromSet;
+  switch (descriptor->type) {
+    case HLActionDescriptorTypeWait:
+      action = [[HLWaitAction alloc] initWithDuration:duration];
+      break;
+    case HLActionDescriptorTypeMoveBy:
+      action = [[HLMoveByAction alloc] initWithX:valueX y:valueY duration:duration];
+      break;
+    case HLActionDescriptorTypeMoveTo:
+      if (isFromSet) {
+        action = [[HLMoveToAction alloc] initWithOrigin:CGPointMake(descriptor->leaf.fromX, descriptor->leaf.fromY)
+                                            destination:CGPointMake(valueX, valueY)
+                                               duration:duration];
+      } else {
+        action = [[HLMoveToAction alloc] initWithDestination:CGPointMake(valueX, valueY) duration:duration];
+      }
+      break;
+    case HLActionDescriptorTypeScaleBy:
+      action = [[HLScaleXYByAction alloc] initWithX:valueX y:valueY duration:duration];
+      break;
+    case HLActionDescriptorTypeScaleTo:
+      if (isFromSet) {
+        action = [[HLScaleToAction alloc] initWithXFrom:descriptor->leaf.fromX y:descriptor->leaf.fromY xTo:valueX y:valueY duration:duration];
+      } else {
+        action = [[HLScaleToAction alloc] initWithXTo:valueX y:valueY duration:duration];
+      }
+      break;
+    case HLActionDescriptorTypeRotateBy:
+      action = [[HLRotateByAction alloc] initWithAngle:valueX duration:duration];
+      break;
+    case HLActionDescriptorTypeRotateTo:
+      if (isFromSet) {
+        action = [[HLRotateToAction alloc] initWithAngleFrom:descriptor->leaf.fromX to:valueX duration:duration shortestUnitArc:NO];
+      } else {
+        action = [[HLRotateToAction alloc] initWithAngleTo:valueX duration:duration shortestUnitArc:NO];
+      }
+      break;
+    case HLActionDescriptorTypeFadeAlphaBy:
+      action = [[HLFadeAlphaByAction alloc] initWithAlpha:valueX duration:duration];
+      break;
+    case HLActionDescriptorTypeFadeAlphaTo:
+      if (isFromSet) {
+        action = [[HLFadeAlphaToAction alloc] initWithAlphaFrom:descriptor->leaf.fromX to:valueX duration:duration];
+      } else {
+        action = [[HLFadeAlphaToAction alloc] initWithAlphaTo:valueX duration:duration];
+      }
+      break;
+    case HLActionDescriptorTypeRemoveFromParent:
+      action = [[HLRemoveFromParentAction alloc] init];
+      break;
+    case HLActionDescriptorTypeSequence:
+    case HLActionDescriptorTypeGroup: {
+      NSUInteger count = descriptor->collection.count;
+      NSMutableArray *actions = [NSMutableArray arrayWithCapacity:count];
+      for (NSUInteger d = 0; d < count; ++d) {
+        [actions addObject:HLActionDescriptorCreateActionTree(descriptor->collection.descriptors[d])];
+      }
+      if (descriptor->type == HLActionDescriptorTypeSequence) {
+        action = [[HLSequenceAction alloc] initWithActions:actions];
+      } else {
+        action = [[HLGroupAction alloc] initWithActions:actions];
+      }
+      break;
+    }
+  }
+  action.timingMode = descriptor->timingMode;
+  action.speed = descriptor->speed;
+  return action;
+}
+
+HLAction *
+HLActionDescriptorCreateAction(const HLActionDescriptor *descriptor)
+{
+  // note: The "to" actions were created with the starting values read by the descriptors
+  // (if any), and seeking without a node applies no changes, so the action ends up exactly
+  // as if it had been run on the node all along.
+  HLAction *action = HLActionDescriptorCreateActionTree(descriptor);
+  if (descriptor->isStarted) {
+    [action seekToElapsedTime:descriptor->time node:nil];
+  }
+  return action;
+}
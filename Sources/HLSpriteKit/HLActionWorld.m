@@ -0,0 +1,584 @@
+//
+//  HLActionWorld.m
+//  HLSpriteKit
+//
+//  Created by Karl Voskuil on 10/16/26.
+//  Copyright © 2026 Hilo Games. All rights reserved.
+//
+
+#import "HLActionWorld.h"
+
+#include <stdlib.h>
+
+const NSUInteger HLActionWorldTrackNotFound = NSNotFound;
+
+enum {
+  HLActionWorldTrackStateFree = 0,
+  HLActionWorldTrackStateWaiting,
+  HLActionWorldTrackStateRunning,
+};
+
+// note: Tracks are divided into chunks of this many slots for concurrent evaluation, so
+// that each worker handles a contiguous range of each array.
+enum {
+  HLActionWorldConcurrentChunkSize = 512,
+};
+
+static void HLActionWorldStepTracks(HLActionWorld *world, NSUInteger begin, NSUInteger end, NSTimeInterval incrementalTime);
+static BOOL HLActionWorldStepTrack(HLActionWorld *world, NSUInteger t, NSTimeInterval incrementalTime);
+static BOOL HLActionWorldAdvanceTrack(HLActionWorld *world, NSUInteger t, NSTimeInterval incrementalTime);
+static void HLActionWorldComputeTrack(HLActionWorld *world, NSUInteger t);
+static void HLActionWorldApplyTrack(HLActionWorld *world, NSUInteger t);
+static void HLActionWorldReadFrom(HLActionWorld *world, NSUInteger t, HLActionWorldTrackType type, SKNode *node);
+
+static void *
+HLActionWorldReallocArray(void *array, NSUInteger count, size_t elementSize)
+{
+  void *reallocated = realloc(array, count * elementSize);
+  if (!reallocated) {
+    [NSException raise:NSMallocException format:@"HLActionWorld could not allocate storage for %lu tracks.", (unsigned long)count];
+  }
+  return reallocated;
+}
+
+@implementation HLActionWorld
+{
+  NSUInteger _capacity;
+  // note: The high-water mark of used slots; slots at indexes less than this may be free.
+  NSUInteger _slotCount;
+  NSUInteger _trackCount;
+  // note: Free slots are linked through _nextTracks.
+  NSUInteger _freeTrack;
+
+  // note: Per-track fields, one array per field.  The arrays used in the time-advancement
+  // loop are kept separate from those used only when writing back to nodes.
+  uint8_t *_states;
+  uint8_t *_stepped;
+  uint8_t *_completed;
+  uint8_t *_types;
+  uint8_t *_timingModes;
+  uint8_t *_isFromSet;
+  NSTimeInterval *_durations;
+  NSTimeInterval *_elapsedTimesLinear;
+  NSTimeInterval *_extraTimes;
+  CGFloat *_speeds;
+  CGFloat *_normalTimes;
+  CGFloat *_valuesX;
+  CGFloat *_valuesY;
+  CGFloat *_fromsX;
+  CGFloat *_fromsY;
+  CGFloat *_lastCumulativeDeltasX;
+  CGFloat *_lastCumulativeDeltasY;
+  // note: The values computed for the track by the first pass: deltas for "by" tracks, and
+  // new values for "to" tracks.
+  CGFloat *_resultsX;
+  CGFloat *_resultsY;
+  NSUInteger *_nextTracks;
+  // note: Retained with CFBridgingRetain() when the track is added, and released when the
+  // track is freed.
+  void **_nodes;
+}
+
+- (instancetype)init
+{
+  return [self initWithCapacity:64];
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity
+{
+  self = [super init];
+  if (self) {
+    _slotCount = 0;
+    _trackCount = 0;
+    _freeTrack = HLActionWorldTrackNotFound;
+    _concurrentTrackThreshold = 0;
+    [self HL_growToCapacity:(capacity > 0 ? capacity : 1)];
+  }
+  return self;
+}
+
+- (void)dealloc
+{
+  for (NSUInteger t = 0; t < _slotCount; ++t) {
+    if (_states[t] != HLActionWorldTrackStateFree) {
+      CFRelease(_nodes[t]);
+    }
+  }
+  free(_states);
+  free(_stepped);
+  free(_completed);
+  free(_types);
+  free(_timingModes);
+  free(_isFromSet);
+  free(_durations);
+  free(_elapsedTimesLinear);
+  free(_extraTimes);
+  free(_speeds);
+  free(_normalTimes);
+  free(_valuesX);
+  free(_valuesY);
+  free(_fromsX);
+  free(_fromsY);
+  free(_lastCumulativeDeltasX);
+  free(_lastCumulativeDeltasY);
+  free(_resultsX);
+  free(_resultsY);
+  free(_nextTracks);
+  free(_nodes);
+}
+
+- (NSUInteger)addTrackWithType:(HLActionWorldTrackType)type
+                          node:(SKNode *)node
+                        valueX:(CGFloat)valueX
+                        valueY:(CGFloat)valueY
+                      duration:(NSTimeInterval)duration
+                    timingMode:(HLActionTimingMode)timingMode
+                         speed:(CGFloat)speed
+{
+  return [self addTrackWithType:type
+                           node:node
+                         valueX:valueX
+                         valueY:valueY
+                       duration:duration
+                     timingMode:timingMode
+                          speed:speed
+                     afterTrack:HLActionWorldTrackNotFound];
+}
+
+- (NSUInteger)addTrackWithType:(HLActionWorldTrackType)type
+                          node:(SKNode *)node
+                        valueX:(CGFloat)valueX
+                        valueY:(CGFloat)valueY
+                      duration:(NSTimeInterval)duration
+                    timingMode:(HLActionTimingMode)timingMode
+                         speed:(CGFloat)speed
+                    afterTrack:(NSUInteger)previousTrack
+{
+  if (!node) {
+    [NSException raise:@"HLActionInvalid" format:@"HLActionWorld tracks require a node."];
+  }
+
+  NSUInteger track;
+  if (_freeTrack != HLActionWorldTrackNotFound) {
+    track = _freeTrack;
+    _freeTrack = _nextTracks[track];
+  } else {
+    if (_slotCount == _capacity) {
+      [self HL_growToCapacity:(_capacity * 2)];
+    }
+    track = _slotCount;
+    ++_slotCount;
+  }
+  ++_trackCount;
+
+  _stepped[track] = 0;
+  _completed[track] = 0;
+  _types[track] = (uint8_t)type;
+  _timingModes[track] = (uint8_t)timingMode;
+  _isFromSet[track] = 0;
+  _durations[track] = duration;
+  _elapsedTimesLinear[track] = 0.0;
+  _extraTimes[track] = 0.0;
+  // note: As with [HLAction setSpeed:], negative speed is not supported.
+  _speeds[track] = (speed < 0.0f ? 0.0f : speed);
+  _normalTimes[track] = 0.0f;
+  _valuesX[track] = valueX;
+  _valuesY[track] = valueY;
+  _fromsX[track] = 0.0f;
+  _fromsY[track] = 0.0f;
+  _lastCumulativeDeltasX[track] = 0.0f;
+  _lastCumulativeDeltasY[track] = 0.0f;
+  _resultsX[track] = 0.0f;
+  _resultsY[track] = 0.0f;
+  _nextTracks[track] = HLActionWorldTrackNotFound;
+  _nodes[track] = (void *)CFBridgingRetain(node);
+
+  if ([self hasTrack:previousTrack] && previousTrack != track) {
+    NSUInteger lastTrack = previousTrack;
+    while (_nextTracks[lastTrack] != HLActionWorldTrackNotFound) {
+      lastTrack = _nextTracks[lastTrack];
+    }
+    _nextTracks[lastTrack] = track;
+    _states[track] = HLActionWorldTrackStateWaiting;
+  } else {
+    _states[track] = HLActionWorldTrackStateRunning;
+  }
+
+  return track;
+}
+
+- (BOOL)hasTrack:(NSUInteger)track
+{
+  return (track < _slotCount && _states[track] != HLActionWorldTrackStateFree);
+}
+
+- (void)removeTrack:(NSUInteger)track
+{
+  if (![self hasTrack:track]) {
+    return;
+  }
+
+  // note: Unlink from the previous track, if any.  Removal is not expected to be a hot
+  // path, so a scan is acceptable.
+  if (_states[track] == HLActionWorldTrackStateWaiting) {
+    for (NSUInteger t = 0; t < _slotCount; ++t) {
+      if (_states[t] != HLActionWorldTrackStateFree && _nextTracks[t] == track) {
+        _nextTracks[t] = HLActionWorldTrackNotFound;
+        break;
+      }
+    }
+  }
+
+  while (track != HLActionWorldTrackNotFound) {
+    NSUInteger nextTrack = _nextTracks[track];
+    [self HL_freeTrack:track];
+    track = nextTrack;
+  }
+}
+
+- (void)removeTracksForNode:(SKNode *)node
+{
+  void *nodePointer = (__bridge void *)node;
+  for (NSUInteger t = 0; t < _slotCount; ++t) {
+    // note: Removing a track also removes its followers, which might already have been
+    // visited (and might be for a different node); check state again on each iteration.
+    if (_states[t] != HLActionWorldTrackStateFree && _nodes[t] == nodePointer) {
+      [self removeTrack:t];
+    }
+  }
+}
+
+- (void)removeAllTracks
+{
+  for (NSUInteger t = 0; t < _slotCount; ++t) {
+    if (_states[t] != HLActionWorldTrackStateFree) {
+      CFRelease(_nodes[t]);
+      _nodes[t] = NULL;
+      _states[t] = HLActionWorldTrackStateFree;
+    }
+  }
+  _slotCount = 0;
+  _trackCount = 0;
+  _freeTrack = HLActionWorldTrackNotFound;
+}
+
+- (NSUInteger)trackCount
+{
+  return _trackCount;
+}
+
+- (void)update:(NSTimeInterval)incrementalTime
+{
+  [self update:incrementalTime speed:1.0f];
+}
+
+- (void)update:(NSTimeInterval)incrementalTime speed:(CGFloat)speed
+{
+  if (incrementalTime < 0.0) {
+    incrementalTime = 0.0;
+  }
+  if (speed <= 0.0f) {
+    incrementalTime = 0.0;
+  } else {
+    incrementalTime *= speed;
+  }
+
+  // note: First pass: Advance time and compute new values for all running tracks in one
+  // loop over contiguous arrays.  No nodes are touched, and each track only touches its own
+  // slots in the arrays, so the pass can be split across threads.
+  NSUInteger slotCount = _slotCount;
+  if (_concurrentTrackThreshold > 0 && _trackCount >= _concurrentTrackThreshold && slotCount > HLActionWorldConcurrentChunkSize) {
+    size_t chunkCount = (slotCount + HLActionWorldConcurrentChunkSize - 1) / HLActionWorldConcurrentChunkSize;
+    // note: Unretained, since dispatch_apply() does not return until all chunks are done.
+    __unsafe_unretained HLActionWorld *world = self;
+    dispatch_apply(chunkCount, dispatch_get_global_queue(QOS_CLASS_USER_INTERACTIVE, 0), ^(size_t chunk){
+      NSUInteger begin = chunk * HLActionWorldConcurrentChunkSize;
+      NSUInteger end = MIN(begin + HLActionWorldConcurrentChunkSize, slotCount);
+      HLActionWorldStepTracks(world, begin, end, incrementalTime);
+    });
+  } else {
+    HLActionWorldStepTracks(self, 0, slotCount, incrementalTime);
+  }
+
+  // note: Second pass (always on the calling thread): Write results back to nodes, and
+  // start following tracks for completed ones.  Following tracks started in this pass are
+  // updated immediately with the extra time of their predecessor (and so are not marked as
+  // stepped).
+  for (NSUInteger t = 0; t < slotCount; ++t) {
+    if (!_stepped[t]) {
+      continue;
+    }
+    _stepped[t] = 0;
+    HLActionWorldApplyTrack(self, t);
+    if (_completed[t]) {
+      [self HL_completeTrack:t];
+    }
+  }
+}
+
+static void
+HLActionWorldStepTracks(HLActionWorld *world, NSUInteger begin, NSUInteger end, NSTimeInterval incrementalTime)
+{
+  uint8_t *states = world->_states;
+  for (NSUInteger t = begin; t < end; ++t) {
+    if (states[t] != HLActionWorldTrackStateRunning) {
+      continue;
+    }
+    world->_stepped[t] = 1;
+    world->_completed[t] = (uint8_t)!HLActionWorldStepTrack(world, t, incrementalTime);
+  }
+}
+
+static inline BOOL
+HLActionWorldTrackTypeIsTo(HLActionWorldTrackType type)
+{
+  switch (type) {
+    case HLActionWorldTrackMoveTo:
+    case HLActionWorldTrackScaleTo:
+    case HLActionWorldTrackRotateTo:
+    case HLActionWorldTrackFadeAlphaTo:
+    case HLActionWorldTrackChangeZPositionTo:
+      return YES;
+    default:
+      return NO;
+  }
+}
+
+static BOOL
+HLActionWorldStepTrack(HLActionWorld *world, NSUInteger t, NSTimeInterval incrementalTime)
+{
+  BOOL notYetCompleted = HLActionWorldAdvanceTrack(world, t, incrementalTime);
+  // note: A "to" track doesn't know its origin until its first apply, which must read the
+  // node; the apply computes it then.
+  if (world->_isFromSet[t] || !HLActionWorldTrackTypeIsTo((HLActionWorldTrackType)world->_types[t])) {
+    HLActionWorldComputeTrack(world, t);
+  }
+  return notYetCompleted;
+}
+
+static BOOL
+HLActionWorldAdvanceTrack(HLActionWorld *world, NSUInteger t, NSTimeInterval incrementalTime)
+{
+  // note: Mirrors [HLAction HL_advanceTime:extraTime:notYetCompleted:], followed by the
+  // normal-time calculation of the corresponding action.
+  CGFloat speed = world->_speeds[t];
+  NSTimeInterval duration = world->_durations[t];
+  NSTimeInterval elapsedTimeLinear = world->_elapsedTimesLinear[t] + incrementalTime * speed;
+  world->_elapsedTimesLinear[t] = elapsedTimeLinear;
+  if (elapsedTimeLinear >= duration) {
+    if (speed == 0.0f) {
+      // note: See note in HLAction: Only possible for zero duration, and so this must be
+      // the first update.
+      world->_extraTimes[t] = incrementalTime;
+    } else {
+      world->_extraTimes[t] = (elapsedTimeLinear - duration) / speed;
+    }
+    world->_normalTimes[t] = 1.0f;
+    return NO;
+  }
+  CGFloat normalTime = (CGFloat)(elapsedTimeLinear / duration);
+  HLActionTimingMode timingMode = (HLActionTimingMode)world->_timingModes[t];
+  if (elapsedTimeLinear > 0.0 && timingMode != HLActionTimingLinear) {
+    normalTime = HLActionApplyTiming(timingMode, normalTime);
+  }
+  world->_normalTimes[t] = normalTime;
+  return YES;
+}
+
+static void
+HLActionWorldComputeTrack(HLActionWorld *world, NSUInteger t)
+{
+  CGFloat normalTime = world->_normalTimes[t];
+  BOOL finished = (normalTime >= 1.0f);
+  CGFloat valueX = world->_valuesX[t];
+  CGFloat valueY = world->_valuesY[t];
+
+  // note: "By" tracks use the same mechanism as the corresponding actions to avoid
+  // floating point drift: The instantaneous delta is the difference between the delta
+  // expected by now and the sum of the deltas already applied.
+  CGFloat deltaX = 0.0f;
+  CGFloat deltaY = 0.0f;
+  // note: "To" tracks interpolate between an origin remembered on the first update and the
+  // destination, snapping to the destination when finished.
+  CGFloat toX = valueX;
+  CGFloat toY = valueY;
+
+  HLActionWorldTrackType type = (HLActionWorldTrackType)world->_types[t];
+  switch (type) {
+    case HLActionWorldTrackMoveBy:
+    case HLActionWorldTrackScaleBy:
+    case HLActionWorldTrackRotateBy:
+    case HLActionWorldTrackFadeAlphaBy:
+    case HLActionWorldTrackChangeZPositionBy:
+      if (finished) {
+        deltaX = valueX - world->_lastCumulativeDeltasX[t];
+        deltaY = valueY - world->_lastCumulativeDeltasY[t];
+      } else {
+        deltaX = valueX * normalTime - world->_lastCumulativeDeltasX[t];
+        deltaY = valueY * normalTime - world->_lastCumulativeDeltasY[t];
+      }
+      world->_lastCumulativeDeltasX[t] += deltaX;
+      world->_lastCumulativeDeltasY[t] += deltaY;
+      world->_resultsX[t] = deltaX;
+      world->_resultsY[t] = deltaY;
+      break;
+    case HLActionWorldTrackMoveTo:
+    case HLActionWorldTrackScaleTo:
+    case HLActionWorldTrackRotateTo:
+    case HLActionWorldTrackFadeAlphaTo:
+    case HLActionWorldTrackChangeZPositionTo:
+      if (!finished) {
+        toX = world->_fromsX[t] * (1.0f - normalTime) + valueX * normalTime;
+        toY = world->_fromsY[t] * (1.0f - normalTime) + valueY * normalTime;
+      }
+      world->_resultsX[t] = toX;
+      world->_resultsY[t] = toY;
+      break;
+  }
+}
+
+static void
+HLActionWorldApplyTrack(HLActionWorld *world, NSUInteger t)
+{
+  SKNode *node = (__bridge SKNode *)world->_nodes[t];
+  HLActionWorldTrackType type = (HLActionWorldTrackType)world->_types[t];
+  if (!world->_isFromSet[t] && HLActionWorldTrackTypeIsTo(type)) {
+    HLActionWorldReadFrom(world, t, type, node);
+    HLActionWorldComputeTrack(world, t);
+  }
+  CGFloat resultX = world->_resultsX[t];
+  CGFloat resultY = world->_resultsY[t];
+
+  switch (type) {
+    case HLActionWorldTrackMoveBy: {
+      CGPoint position = node.position;
+      position.x += resultX;
+      position.y += resultY;
+      node.position = position;
+      break;
+    }
+    case HLActionWorldTrackMoveTo:
+      node.position = CGPointMake(resultX, resultY);
+      break;
+    case HLActionWorldTrackScaleBy:
+      node.xScale += resultX;
+      node.yScale += resultY;
+      break;
+    case HLActionWorldTrackScaleTo:
+      node.xScale = resultX;
+      node.yScale = resultY;
+      break;
+    case HLActionWorldTrackRotateBy:
+      node.zRotation += resultX;
+      break;
+    case HLActionWorldTrackRotateTo:
+      node.zRotation = resultX;
+      break;
+    case HLActionWorldTrackFadeAlphaBy:
+      node.alpha += resultX;
+      break;
+    case HLActionWorldTrackFadeAlphaTo:
+      node.alpha = resultX;
+      break;
+    case HLActionWorldTrackChangeZPositionBy:
+      node.zPosition += resultX;
+      break;
+    case HLActionWorldTrackChangeZPositionTo:
+      node.zPosition = resultX;
+      break;
+  }
+}
+
+static void
+HLActionWorldReadFrom(HLActionWorld *world, NSUInteger t, HLActionWorldTrackType type, SKNode *node)
+{
+  switch (type) {
+    case HLActionWorldTrackMoveTo: {
+      CGPoint position = node.position;
+      world->_fromsX[t] = position.x;
+      world->_fromsY[t] = position.y;
+      break;
+    }
+    case HLActionWorldTrackScaleTo:
+      world->_fromsX[t] = node.xScale;
+      world->_fromsY[t] = node.yScale;
+      break;
+    case HLActionWorldTrackRotateTo:
+      world->_fromsX[t] = node.zRotation;
+      break;
+    case HLActionWorldTrackFadeAlphaTo:
+      world->_fromsX[t] = node.alpha;
+      break;
+    case HLActionWorldTrackChangeZPositionTo:
+      world->_fromsX[t] = node.zPosition;
+      break;
+    default:
+      break;
+  }
+  world->_isFromSet[t] = 1;
+}
+
+- (void)HL_completeTrack:(NSUInteger)track
+{
+  // note: Like HLSequenceAction, start the next track (if any) with the extra time from
+  // the completed track, and continue down the chain as long as tracks complete.
+  while (YES) {
+    NSUInteger nextTrack = _nextTracks[track];
+    NSTimeInterval extraTime = _extraTimes[track];
+    [self HL_freeTrack:track];
+    if (nextTrack == HLActionWorldTrackNotFound) {
+      break;
+    }
+    track = nextTrack;
+    _states[track] = HLActionWorldTrackStateRunning;
+    BOOL notYetCompleted = HLActionWorldStepTrack(self, track, extraTime);
+    HLActionWorldApplyTrack(self, track);
+    if (notYetCompleted) {
+      break;
+    }
+  }
+}
+
+- (void)HL_freeTrack:(NSUInteger)track
+{
+  CFRelease(_nodes[track]);
+  _nodes[track] = NULL;
+  _states[track] = HLActionWorldTrackStateFree;
+  _stepped[track] = 0;
+  _nextTracks[track] = _freeTrack;
+  _freeTrack = track;
+  --_trackCount;
+}
+
+- (void)HL_growToCapacity:(NSUInteger)capacity
+{
+  _states = HLActionWorldReallocArray(_states, capacity, sizeof(uint8_t));
+  _stepped = HLActionWorldReallocArray(_stepped, capacity, sizeof(uint8_t));
+  _completed = HLActionWorldReallocArray(_completed, capacity, sizeof(uint8_t));
+  _types = HLActionWorldReallocArray(_types, capacity, sizeof(uint8_t));
+  _timingModes = HLActionWorldReallocArray(_timingModes, capacity, sizeof(uint8_t));
+  _isFromSet = HLActionWorldReallocArray(_isFromSet, capacity, sizeof(uint8_t));
+  _durations = HLActionWorldReallocArray(_durations, capacity, sizeof(NSTimeInterval));
+  _elapsedTimesLinear = HLActionWorldReallocArray(_elapsedTimesLinear, capacity, sizeof(NSTimeInterval));
+  _extraTimes = HLActionWorldReallocArray(_extraTimes, capacity, sizeof(NSTimeInterval));
+  _speeds = HLActionWorldReallocArray(_speeds, capacity, sizeof(CGFloat));
+  _normalTimes = HLActionWorldReallocArray(_normalTimes, capacity, sizeof(CGFloat));
+  _valuesX = HLActionWorldReallocArray(_valuesX, capacity, sizeof(CGFloat));
+  _valuesY = HLActionWorldReallocArray(_valuesY, capacity, sizeof(CGFloat));
+  _fromsX = HLActionWorldReallocArray(_fromsX, capacity, sizeof(CGFloat));
+  _fromsY = HLActionWorldReallocArray(_fromsY, capacity, sizeof(CGFloat));
+  _lastCumulativeDeltasX = HLActionWorldReallocArray(_lastCumulativeDeltasX, capacity, sizeof(CGFloat));
+  _lastCumulativeDeltasY = HLActionWorldReallocArray(_lastCumulativeDeltasY, capacity, sizeof(CGFloat));
+  _resultsX = HLActionWorldReallocArray(_resultsX, capacity, sizeof(CGFloat));
+  _resultsY = HLActionWorldReallocArray(_resultsY, capacity, sizeof(CGFloat));
+  _nextTracks = HLActionWorldReallocArray(_nextTracks, capacity, sizeof(NSUInteger));
+  _nodes = HLActionWorldReallocArray(_nodes, capacity, sizeof(void *));
+  for (NSUInteger t = _capacity; t < capacity; ++t) {
+    _states[t] = HLActionWorldTrackStateFree;
+    _stepped[t] = 0;
+    _nodes[t] = NULL;
+  }
+  _capacity = capacity;
+}
+
+@end
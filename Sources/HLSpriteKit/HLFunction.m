@@ -8,10 +8,27 @@
 
 #import "HLFunction.h"
 
+#if TARGET_OS_IPHONE
+#import <UIKit/UIKit.h>
+#endif
+
+#include <math.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+// note: The number of chords used to approximate the arc length of a cubic Bezier.
+enum {
+  HLCubicBezierArcLengthChordCount = 64,
+};
+
 @implementation HLCubicBezier
 {
   CGFloat _coefficientsX[3];
   CGFloat _coefficientsY[3];
+  // note: Cumulative arc lengths at regular t intervals, one for each chord endpoint.
+  // Calculated on initialization, so that the immutable curve can be shared by callers
+  // on any thread without synchronization.
+  CGFloat _arcLengths[HLCubicBezierArcLengthChordCount + 1];
 }
 
 - (instancetype)initWithP0:(CGPoint)p0 p1:(CGPoint)p1 p2:(CGPoint)p2 p3:(CGPoint)p3
@@ -19,16 +36,56 @@
   self = [super init];
   if (self) {
     _p0 = p0;
+    _p1 = p1;
+    _p2 = p2;
+    _p3 = p3;
     _coefficientsX[0] = p3.x - 3.0f * p2.x + 3.0f * p1.x - p0.x;
     _coefficientsY[0] = p3.y - 3.0f * p2.y + 3.0f * p1.y - p0.y;
     _coefficientsX[1] = 3.0f * p2.x - 6.0f * p1.x + 3.0f * p0.x;
     _coefficientsY[1] = 3.0f * p2.y - 6.0f * p1.y + 3.0f * p0.y;
     _coefficientsX[2] = 3.0f * p1.x - 3.0f * p0.x;
     _coefficientsY[2] = 3.0f * p1.y - 3.0f * p0.y;
+    _arcLengths[0] = 0.0f;
+    CGPoint lastPoint = p0;
+    for (NSUInteger c = 1; c <= HLCubicBezierArcLengthChordCount; ++c) {
+      CGPoint point = [self pointForT:((CGFloat)c / HLCubicBezierArcLengthChordCount)];
+      _arcLengths[c] = _arcLengths[c - 1] + (CGFloat)hypot(point.x - lastPoint.x, point.y - lastPoint.y);
+      lastPoint = point;
+    }
   }
   return self;
 }
 
+- (instancetype)initWithCoder:(NSCoder *)aDecoder
+{
+#if TARGET_OS_IPHONE
+  return [self initWithP0:[aDecoder decodeCGPointForKey:@"p0"]
+                       p1:[aDecoder decodeCGPointForKey:@"p1"]
+                       p2:[aDecoder decodeCGPointForKey:@"p2"]
+                       p3:[aDecoder decodeCGPointForKey:@"p3"]];
+#else
+  return [self initWithP0:[aDecoder decodePointForKey:@"p0"]
+                       p1:[aDecoder decodePointForKey:@"p1"]
+                       p2:[aDecoder decodePointForKey:@"p2"]
+                       p3:[aDecoder decodePointForKey:@"p3"]];
+#endif
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{
+#if TARGET_OS_IPHONE
+  [aCoder encodeCGPoint:_p0 forKey:@"p0"];
+  [aCoder encodeCGPoint:_p1 forKey:@"p1"];
+  [aCoder encodeCGPoint:_p2 forKey:@"p2"];
+  [aCoder encodeCGPoint:_p3 forKey:@"p3"];
+#else
+  [aCoder encodePoint:_p0 forKey:@"p0"];
+  [aCoder encodePoint:_p1 forKey:@"p1"];
+  [aCoder encodePoint:_p2 forKey:@"p2"];
+  [aCoder encodePoint:_p3 forKey:@"p3"];
+#endif
+}
+
 - (CGPoint)pointForT:(CGFloat)t
 {
   CGFloat tSquared = t * t;
@@ -37,6 +94,111 @@
                      _coefficientsY[0] * tCubed + _coefficientsY[1] * tSquared + _coefficientsY[2] * t + _p0.y);
 }
 
+- (CGPoint)tangentForT:(CGFloat)t
+{
+  CGFloat tSquared = t * t;
+  return CGPointMake(3.0f * _coefficientsX[0] * tSquared + 2.0f * _coefficientsX[1] * t + _coefficientsX[2],
+                     3.0f * _coefficientsY[0] * tSquared + 2.0f * _coefficientsY[1] * t + _coefficientsY[2]);
+}
+
+- (CGFloat)arcLength
+{
+  return _arcLengths[HLCubicBezierArcLengthChordCount];
+}
+
+- (CGFloat)tForArcLength:(CGFloat)arcLength
+{
+  const CGFloat *arcLengths = _arcLengths;
+  CGFloat totalArcLength = arcLengths[HLCubicBezierArcLengthChordCount];
+  if (arcLength <= 0.0f || totalArcLength <= 0.0f) {
+    return 0.0f;
+  }
+  if (arcLength >= totalArcLength) {
+    return 1.0f;
+  }
+  NSUInteger c = HLPiecewiseLinearSegmentIndex(arcLengths, HLCubicBezierArcLengthChordCount + 1, arcLength, 0);
+  CGFloat chordLength = arcLengths[c + 1] - arcLengths[c];
+  CGFloat chordFraction = (chordLength > 0.0f ? (arcLength - arcLengths[c]) / chordLength : 0.0f);
+  return (c + chordFraction) / HLCubicBezierArcLengthChordCount;
+}
+
+@end
+
+@implementation HLCubicBezierPath
+{
+  NSUInteger _bezierCount;
+  // note: The cumulative arc length at the start of each curve, and then the total.
+  CGFloat *_arcLengths;
+}
+
+- (instancetype)initWithBeziers:(NSArray *)beziers
+{
+  self = [super init];
+  if (self) {
+    _bezierCount = [beziers count];
+    if (_bezierCount < 1) {
+      [NSException raise:@"HLFunctionInvalid"
+                  format:@"HLCubicBezierPath must have at least one curve."];
+    }
+    _beziers = [beziers copy];
+    _arcLengths = (CGFloat *)malloc(sizeof(CGFloat) * (_bezierCount + 1));
+    if (!_arcLengths) {
+      [NSException raise:NSMallocException format:@"HLCubicBezierPath could not allocate storage for %lu curves.", (unsigned long)_bezierCount];
+    }
+    _arcLengths[0] = 0.0f;
+    for (NSUInteger b = 0; b < _bezierCount; ++b) {
+      HLCubicBezier *bezier = _beziers[b];
+      _arcLengths[b + 1] = _arcLengths[b] + bezier.arcLength;
+    }
+  }
+  return self;
+}
+
+- (instancetype)initWithCoder:(NSCoder *)aDecoder
+{
+  return [self initWithBeziers:[aDecoder decodeObjectForKey:@"beziers"]];
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{
+  [aCoder encodeObject:_beziers forKey:@"beziers"];
+}
+
+- (void)dealloc
+{
+  free(_arcLengths);
+}
+
+- (CGFloat)arcLength
+{
+  return _arcLengths[_bezierCount];
+}
+
+- (CGPoint)pointForArcLength:(CGFloat)arcLength
+{
+  CGPoint point;
+  [self getPoint:&point tangent:NULL forArcLength:arcLength];
+  return point;
+}
+
+- (void)getPoint:(CGPoint *)point tangent:(CGPoint *)tangent forArcLength:(CGFloat)arcLength
+{
+  if (arcLength < 0.0f) {
+    arcLength = 0.0f;
+  } else if (arcLength > _arcLengths[_bezierCount]) {
+    arcLength = _arcLengths[_bezierCount];
+  }
+  NSUInteger b = HLPiecewiseLinearSegmentIndex(_arcLengths, _bezierCount + 1, arcLength, 0);
+  HLCubicBezier *bezier = _beziers[b];
+  CGFloat t = [bezier tForArcLength:(arcLength - _arcLengths[b])];
+  if (point) {
+    *point = [bezier pointForT:t];
+  }
+  if (tangent) {
+    *tangent = [bezier tangentForT:t];
+  }
+}
+
 @end
 
 @implementation HLTrajectoryBezier
@@ -76,6 +238,11 @@
   return _bezier.p0;
 }
 
+- (HLCubicBezier *)bezier
+{
+  return _bezier;
+}
+
 - (CGPoint)pointForT:(CGFloat)t
 {
   return [_bezier pointForT:t];
@@ -83,11 +250,47 @@
 
 @end
 
+NSUInteger
+HLPiecewiseLinearSegmentIndex(const CGFloat *knotXValues, NSUInteger knotCount, CGFloat x, NSUInteger hint)
+{
+  if (knotCount < 3 || x < knotXValues[1]) {
+    return 0;
+  }
+  NSUInteger lastSegmentIndex = knotCount - 2;
+  if (x >= knotXValues[lastSegmentIndex]) {
+    return lastSegmentIndex;
+  }
+  if (hint < lastSegmentIndex && knotXValues[hint] <= x) {
+    if (x < knotXValues[hint + 1]) {
+      return hint;
+    }
+    if (x < knotXValues[hint + 2]) {
+      return hint + 1;
+    }
+  }
+  // note: Invariant: knotXValues[low] <= x < knotXValues[high].
+  NSUInteger low = 1;
+  NSUInteger high = lastSegmentIndex;
+  while (high - low > 1) {
+    NSUInteger middle = low + (high - low) / 2;
+    if (knotXValues[middle] <= x) {
+      low = middle;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
 @implementation HLPiecewiseLinearFunction
 {
   CGFloat *_knotXValues;
   CGFloat *_knotYValues;
   NSUInteger _knotCount;
+  // note: The segment found by the last evaluation; see HLPiecewiseLinearSegmentIndex().
+  // Any value is valid, so relaxed atomic access is enough to make evaluation from
+  // multiple threads safe.
+  _Atomic(NSUInteger) _segmentIndexHint;
 }
 
 - (instancetype)initWithKnotXValues:(NSArray *)knotXValues
@@ -104,6 +307,7 @@
       [NSException raise:@"HLFunctionInvalid"
                   format:@"HLPiecewiseLinearFunction must be given the same number of knot X and Y values."];
     }
+    atomic_init(&_segmentIndexHint, 0);
     _knotXValues = (CGFloat *)malloc(sizeof(CGFloat) * _knotCount);
     _knotYValues = (CGFloat *)malloc(sizeof(CGFloat) * _knotCount);
     for (NSUInteger k = 0; k < _knotCount; ++k) {
@@ -131,9 +335,10 @@
   } else if (x >= _knotXValues[_knotCount - 1]) {
     return _knotYValues[_knotCount - 1];
   } else {
-    NSUInteger k = 0;
-    while (x > _knotXValues[k + 1]) {
-      ++k;
+    NSUInteger hint = atomic_load_explicit(&_segmentIndexHint, memory_order_relaxed);
+    NSUInteger k = HLPiecewiseLinearSegmentIndex(_knotXValues, _knotCount, x, hint);
+    if (k != hint) {
+      atomic_store_explicit(&_segmentIndexHint, k, memory_order_relaxed);
     }
     return (x - _knotXValues[k]) / (_knotXValues[k + 1] - _knotXValues[k]) * (_knotYValues[k + 1] - _knotYValues[k]) + _knotYValues[k];
   }
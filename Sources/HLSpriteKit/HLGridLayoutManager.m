@@ -10,6 +10,8 @@
 
 #import <TargetConditionals.h>
 
+#import "HLLayoutState.h"
+
 @implementation HLGridLayoutManager
 
 - (instancetype)init
@@ -154,8 +156,49 @@
 }
 
 - (void)layout:(NSArray *)nodes
+{
+  [self GL_layout:nodes state:nil];
+}
+
+- (void)layout:(NSArray *)nodes getState:(HLLayoutState * __autoreleasing *)state
+{
+  [self GL_layout:nodes state:state];
+}
+
+- (void)GL_layout:(NSArray *)nodes state:(HLLayoutState * __autoreleasing *)returnState
 {
   NSUInteger nodesCount = [nodes count];
+  if (nodesCount == 0) {
+    _size = CGSizeZero;
+    if (returnState) {
+      *returnState = [self GL_stateWithPositions:NULL count:0];
+    }
+    return;
+  }
+
+  // note: The grid doesn't consider node sizes, so there is nothing to measure.
+  CGPoint *positions = (CGPoint *)malloc(nodesCount * sizeof(CGPoint));
+  [self layoutSizes:NULL count:nodesCount getPositions:positions];
+  if (returnState) {
+    *returnState = [self GL_stateWithPositions:positions count:nodesCount];
+  }
+
+  // note: If the grid has no dimensions, no positions are calculated, and the nodes are
+  // left where they are.
+  if (_columnCount > 0 || _rowCount > 0) {
+    for (NSUInteger nodeIndex = 0; nodeIndex < nodesCount; ++nodeIndex) {
+      id node = nodes[nodeIndex];
+      if ([node isKindOfClass:[SKNode class]]) {
+        [(SKNode *)node setPosition:positions[nodeIndex]];
+      }
+    }
+  }
+
+  free(positions);
+}
+
+- (void)layoutSizes:(const CGSize *)sizes count:(NSUInteger)nodesCount getPositions:(CGPoint *)positions
+{
   if (nodesCount == 0) {
     _size = CGSizeZero;
     return;
@@ -188,129 +231,113 @@
 
   switch (_fillMode) {
     case HLGridLayoutManagerFillRightThenDown: {
-      NSEnumerator *nodesEnumerator = [nodes objectEnumerator];
+      NSUInteger nodeIndex = 0;
       for (int row = (int)_rowCount - 1; row >= 0; --row) {
         for (int column = 0; column < (int)_columnCount; ++column) {
-          id node = [nodesEnumerator nextObject];
-          if (!node) {
+          if (nodeIndex >= nodesCount) {
             break;
           }
-          if ([node isKindOfClass:[SKNode class]]) {
-            [(SKNode *)node setPosition:CGPointMake(lowerLeftSquareX + column * squareOffsetX,
-                                                    lowerLeftSquareY + row * squareOffsetY)];
-          }
+          positions[nodeIndex] = CGPointMake(lowerLeftSquareX + column * squareOffsetX,
+                                             lowerLeftSquareY + row * squareOffsetY);
+          ++nodeIndex;
         }
       }
       break;
     }
     case HLGridLayoutManagerFillRightThenUp: {
-      NSEnumerator *nodesEnumerator = [nodes objectEnumerator];
+      NSUInteger nodeIndex = 0;
       for (int row = 0; row < (int)_rowCount; ++row) {
         for (int column = 0; column < (int)_columnCount; ++column) {
-          id node = [nodesEnumerator nextObject];
-          if (!node) {
+          if (nodeIndex >= nodesCount) {
             break;
           }
-          if ([node isKindOfClass:[SKNode class]]) {
-            [(SKNode *)node setPosition:CGPointMake(lowerLeftSquareX + column * squareOffsetX,
-                                                    lowerLeftSquareY + row * squareOffsetY)];
-          }
+          positions[nodeIndex] = CGPointMake(lowerLeftSquareX + column * squareOffsetX,
+                                             lowerLeftSquareY + row * squareOffsetY);
+          ++nodeIndex;
         }
       }
       break;
     }
     case HLGridLayoutManagerFillLeftThenDown: {
-      NSEnumerator *nodesEnumerator = [nodes objectEnumerator];
+      NSUInteger nodeIndex = 0;
       for (int row = (int)_rowCount - 1; row >= 0; --row) {
         for (int column = (int)_columnCount - 1; column >= 0; --column) {
-          id node = [nodesEnumerator nextObject];
-          if (!node) {
+          if (nodeIndex >= nodesCount) {
             break;
           }
-          if ([node isKindOfClass:[SKNode class]]) {
-            [(SKNode *)node setPosition:CGPointMake(lowerLeftSquareX + column * squareOffsetX,
-                                                    lowerLeftSquareY + row * squareOffsetY)];
-          }
+          positions[nodeIndex] = CGPointMake(lowerLeftSquareX + column * squareOffsetX,
+                                             lowerLeftSquareY + row * squareOffsetY);
+          ++nodeIndex;
         }
       }
       break;
     }
     case HLGridLayoutManagerFillLeftThenUp: {
-      NSEnumerator *nodesEnumerator = [nodes objectEnumerator];
+      NSUInteger nodeIndex = 0;
       for (int row = 0; row < (int)_rowCount; ++row) {
         for (int column = (int)_columnCount - 1; column >= 0; --column) {
-          id node = [nodesEnumerator nextObject];
-          if (!node) {
+          if (nodeIndex >= nodesCount) {
             break;
           }
-          if ([node isKindOfClass:[SKNode class]]) {
-            [(SKNode *)node setPosition:CGPointMake(lowerLeftSquareX + column * squareOffsetX,
-                                                    lowerLeftSquareY + row * squareOffsetY)];
-          }
+          positions[nodeIndex] = CGPointMake(lowerLeftSquareX + column * squareOffsetX,
+                                             lowerLeftSquareY + row * squareOffsetY);
+          ++nodeIndex;
         }
       }
       break;
     }
     case HLGridLayoutManagerFillDownThenRight: {
-      NSEnumerator *nodesEnumerator = [nodes objectEnumerator];
+      NSUInteger nodeIndex = 0;
       for (int column = 0; column < (int)_columnCount; ++column) {
         for (int row = (int)_rowCount - 1; row >= 0; --row) {
-          id node = [nodesEnumerator nextObject];
-          if (!node) {
+          if (nodeIndex >= nodesCount) {
             break;
           }
-          if ([node isKindOfClass:[SKNode class]]) {
-            [(SKNode *)node setPosition:CGPointMake(lowerLeftSquareX + column * squareOffsetX,
-                                                    lowerLeftSquareY + row * squareOffsetY)];
-          }
+          positions[nodeIndex] = CGPointMake(lowerLeftSquareX + column * squareOffsetX,
+                                             lowerLeftSquareY + row * squareOffsetY);
+          ++nodeIndex;
         }
       }
       break;
     }
     case HLGridLayoutManagerFillDownThenLeft: {
-      NSEnumerator *nodesEnumerator = [nodes objectEnumerator];
+      NSUInteger nodeIndex = 0;
       for (int column = (int)_columnCount - 1; column >= 0; --column) {
         for (int row = (int)_rowCount - 1; row >= 0; --row) {
-          id node = [nodesEnumerator nextObject];
-          if (!node) {
+          if (nodeIndex >= nodesCount) {
             break;
           }
-          if ([node isKindOfClass:[SKNode class]]) {
-            [(SKNode *)node setPosition:CGPointMake(lowerLeftSquareX + column * squareOffsetX,
-                                                    lowerLeftSquareY + row * squareOffsetY)];
-          }
+          positions[nodeIndex] = CGPointMake(lowerLeftSquareX + column * squareOffsetX,
+                                             lowerLeftSquareY + row * squareOffsetY);
+          ++nodeIndex;
         }
       }
       break;
     }
     case HLGridLayoutManagerFillUpThenRight: {
-      NSEnumerator *nodesEnumerator = [nodes objectEnumerator];
+      NSUInteger nodeIndex = 0;
       for (int column = 0; column < (int)_columnCount; ++column) {
         for (int row = 0; row < (int)_rowCount; ++row) {
-          id node = [nodesEnumerator nextObject];
-          if (!node) {
+          if (nodeIndex >= nodesCount) {
             break;
           }
-          if ([node isKindOfClass:[SKNode class]]) {
-            [(SKNode *)node setPosition:CGPointMake(lowerLeftSquareX + column * squareOffsetX,
-                                                    lowerLeftSquareY + row * squareOffsetY)];
-          }
+          positions[nodeIndex] = CGPointMake(lowerLeftSquareX + column * squareOffsetX,
+                                             lowerLeftSquareY + row * squareOffsetY);
+          ++nodeIndex;
         }
       }
       break;
     }
   case HLGridLayoutManagerFillUpThenLeft: {
-      NSEnumerator *nodesEnumerator = [nodes objectEnumerator];
+      NSUInteger nodeIndex = 0;
       for (int column = (int)_columnCount - 1; column >= 0; --column) {
         for (int row = 0; row < (int)_rowCount; ++row) {
-          id node = [nodesEnumerator nextObject];
-          if (!node) {
+          if (nodeIndex >= nodesCount) {
             break;
           }
-          if ([node isKindOfClass:[SKNode class]]) {
-            [(SKNode *)node setPosition:CGPointMake(lowerLeftSquareX + column * squareOffsetX,
-                                                    lowerLeftSquareY + row * squareOffsetY)];
-          }
+          positions[nodeIndex] = CGPointMake(lowerLeftSquareX + column * squareOffsetX,
+                                             lowerLeftSquareY + row * squareOffsetY);
+          ++nodeIndex;
         }
       }
       break;
@@ -318,6 +345,62 @@
   }
 }
 
+- (void)layoutSizes:(const CGSize *)sizes
+              count:(NSUInteger)count
+       getPositions:(CGPoint *)positions
+              state:(HLLayoutState * __autoreleasing *)returnState
+{
+  [self layoutSizes:sizes count:count getPositions:positions];
+  if (returnState) {
+    *returnState = [self GL_stateWithPositions:positions count:count];
+  }
+}
+
+- (HLLayoutState *)GL_stateWithPositions:(const CGPoint *)positions count:(NSUInteger)nodesCount
+{
+  // note: Lines are the rows or columns in the order they are filled, so that cells are
+  // numbered as nodes.  Each is derived from the position of the square's node.
+  BOOL linesAreRows = NO;
+  switch (_fillMode) {
+    case HLGridLayoutManagerFillRightThenDown:
+    case HLGridLayoutManagerFillRightThenUp:
+    case HLGridLayoutManagerFillLeftThenDown:
+    case HLGridLayoutManagerFillLeftThenUp:
+      linesAreRows = YES;
+      break;
+    case HLGridLayoutManagerFillDownThenRight:
+    case HLGridLayoutManagerFillDownThenLeft:
+    case HLGridLayoutManagerFillUpThenRight:
+    case HLGridLayoutManagerFillUpThenLeft:
+      linesAreRows = NO;
+      break;
+  }
+  HLLayoutState *state = [[HLLayoutState alloc] initWithLineAxis:(linesAreRows ? HLLayoutStateAxisY : HLLayoutStateAxisX)];
+  if (nodesCount == 0 || (_columnCount == 0 && _rowCount == 0)) {
+    return state;
+  }
+
+  NSUInteger lineCellCount = (linesAreRows ? _columnCount : _rowCount);
+  CGFloat squareOffsetLeft = _squareSize.width * _squareAnchorPoint.x;
+  CGFloat squareOffsetBottom = _squareSize.height * _squareAnchorPoint.y;
+  for (NSUInteger nodeIndex = 0; nodeIndex < nodesCount; ++nodeIndex) {
+    CGFloat squareLeft = positions[nodeIndex].x - squareOffsetLeft;
+    CGFloat squareBottom = positions[nodeIndex].y - squareOffsetBottom;
+    if (linesAreRows) {
+      if (nodeIndex % lineCellCount == 0) {
+        [state addLineFrom:squareBottom to:(squareBottom + _squareSize.height)];
+      }
+      [state addCellFrom:squareLeft to:(squareLeft + _squareSize.width)];
+    } else {
+      if (nodeIndex % lineCellCount == 0) {
+        [state addLineFrom:squareLeft to:(squareLeft + _squareSize.width)];
+      }
+      [state addCellFrom:squareBottom to:(squareBottom + _squareSize.height)];
+    }
+  }
+  return state;
+}
+
 - (void)layoutWith2DArray:(NSArray *)nodeArrays
 {
   NSUInteger subarraysCount = [nodeArrays count];
@@ -0,0 +1,282 @@
+//
+//  HLInstancedAction.m
+//  HLSpriteKit
+//
+//  Created by Karl Voskuil on 10/16/26.
+//  Copyright © 2026 Hilo Games. All rights reserved.
+//
+
+#import "HLInstancedAction.h"
+
+typedef struct {
+  CGPoint position;
+  CGFloat zRotation;
+  CGFloat xScale;
+  CGFloat yScale;
+  CGFloat alpha;
+  CGFloat zPosition;
+} HLInstancedActionNodeState;
+
+static HLInstancedActionNodeState
+HLInstancedActionNodeStateGet(SKNode *node)
+{
+  HLInstancedActionNodeState state;
+  state.position = node.position;
+  state.zRotation = node.zRotation;
+  state.xScale = node.xScale;
+  state.yScale = node.yScale;
+  state.alpha = node.alpha;
+  state.zPosition = node.zPosition;
+  return state;
+}
+
+static void
+HLInstancedActionNodeStateSet(SKNode *node, HLInstancedActionNodeState state)
+{
+  node.position = state.position;
+  node.zRotation = state.zRotation;
+  node.xScale = state.xScale;
+  node.yScale = state.yScale;
+  node.alpha = state.alpha;
+  node.zPosition = state.zPosition;
+}
+
+/**
+ An evaluation of the instanced action shared by all nodes subscribed with the same time
+ offset.
+*/
+@interface HLInstancedActionPhase : NSObject {
+@public
+  NSTimeInterval timeOffset;
+  HLAction *action;
+  SKNode *evaluationNode;
+  NSMutableArray *nodes;
+}
+@end
+
+@implementation HLInstancedActionPhase
+@end
+
+@implementation HLInstancedAction
+{
+  NSMutableArray *_phases;
+  // note: Maps each subscribed node (by identity) to its time offset, for finding its
+  // phase and for ignoring duplicate subscriptions.
+  NSMapTable *_nodeTimeOffsets;
+  // note: The time of the shared timeline, that is, the sum of incremental times since the
+  // first update.
+  NSTimeInterval _elapsedTime;
+}
+
+- (instancetype)initWithAction:(HLAction *)action
+{
+  return [self initWithAction:action broadcastMode:HLInstancedActionBroadcastDeltas];
+}
+
+- (instancetype)initWithAction:(HLAction *)action broadcastMode:(HLInstancedActionBroadcastMode)broadcastMode
+{
+  if (!action) {
+    [NSException raise:@"HLActionInvalid" format:@"HLInstancedAction requires an action."];
+  }
+  self = [super init];
+  if (self) {
+    _action = [action copy];
+    _broadcastMode = broadcastMode;
+    _templateNode = [SKNode node];
+    _phases = [NSMutableArray array];
+    _nodeTimeOffsets = [NSMapTable mapTableWithKeyOptions:(NSPointerFunctionsStrongMemory | NSPointerFunctionsObjectPointerPersonality)
+                                             valueOptions:NSPointerFunctionsStrongMemory];
+    _elapsedTime = 0.0;
+  }
+  return self;
+}
+
+- (void)addNode:(SKNode *)node
+{
+  [self addNode:node timeOffset:0.0];
+}
+
+- (void)addNode:(SKNode *)node timeOffset:(NSTimeInterval)timeOffset
+{
+  if (!node) {
+    [NSException raise:@"HLActionInvalid" format:@"HLInstancedAction cannot subscribe a nil node."];
+  }
+  if ([_nodeTimeOffsets objectForKey:node]) {
+    return;
+  }
+  if (timeOffset < 0.0) {
+    timeOffset = 0.0;
+  }
+
+  HLInstancedActionPhase *phase = [self HL_phaseWithTimeOffset:timeOffset];
+  if (!phase) {
+    phase = [[HLInstancedActionPhase alloc] init];
+    phase->timeOffset = timeOffset;
+    phase->action = [_action copy];
+    phase->evaluationNode = [SKNode node];
+    HLInstancedActionNodeStateSet(phase->evaluationNode, HLInstancedActionNodeStateGet(_templateNode));
+    phase->nodes = [NSMutableArray array];
+    // note: Catch up silently to the phase's place in the shared timeline.  If the action
+    // completes on the way, then the node would be unsubscribed immediately anyway.
+    if (_elapsedTime > timeOffset) {
+      if (![phase->action update:(_elapsedTime - timeOffset) node:phase->evaluationNode]) {
+        return;
+      }
+    }
+    [_phases addObject:phase];
+  }
+  [phase->nodes addObject:node];
+  [_nodeTimeOffsets setObject:@(timeOffset) forKey:node];
+}
+
+- (void)removeNode:(SKNode *)node
+{
+  NSNumber *timeOffset = [_nodeTimeOffsets objectForKey:node];
+  if (!timeOffset) {
+    return;
+  }
+  HLInstancedActionPhase *phase = [self HL_phaseWithTimeOffset:[timeOffset doubleValue]];
+  [phase->nodes removeObjectIdenticalTo:node];
+  // note: An empty phase is dropped rather than evaluated for nobody.
+  if ([phase->nodes count] == 0) {
+    [_phases removeObjectIdenticalTo:phase];
+  }
+  [_nodeTimeOffsets removeObjectForKey:node];
+}
+
+- (void)removeAllNodes
+{
+  [_phases removeAllObjects];
+  [_nodeTimeOffsets removeAllObjects];
+}
+
+- (NSUInteger)nodeCount
+{
+  return [_nodeTimeOffsets count];
+}
+
+- (NSUInteger)phaseCount
+{
+  return [_phases count];
+}
+
+- (void)update:(NSTimeInterval)incrementalTime
+{
+  [self update:incrementalTime speed:1.0f];
+}
+
+- (void)update:(NSTimeInterval)incrementalTime speed:(CGFloat)speed
+{
+  if (incrementalTime < 0.0) {
+    incrementalTime = 0.0;
+  }
+  if (speed <= 0.0f) {
+    incrementalTime = 0.0;
+  } else {
+    incrementalTime *= speed;
+  }
+  NSTimeInterval lastElapsedTime = _elapsedTime;
+  _elapsedTime += incrementalTime;
+
+  // note: Iterate over a snapshot, since the action might (through a perform-selector
+  // action, say) subscribe or unsubscribe nodes.
+  NSArray *phases = [_phases copy];
+  for (HLInstancedActionPhase *phase in phases) {
+    NSTimeInterval phaseIncrementalTime;
+    if (lastElapsedTime >= phase->timeOffset) {
+      phaseIncrementalTime = incrementalTime;
+    } else if (_elapsedTime > phase->timeOffset) {
+      phaseIncrementalTime = _elapsedTime - phase->timeOffset;
+    } else {
+      continue;
+    }
+
+    SKNode *evaluationNode = phase->evaluationNode;
+    HLInstancedActionNodeState oldState = HLInstancedActionNodeStateGet(evaluationNode);
+    BOOL notYetCompleted = [phase->action update:phaseIncrementalTime node:evaluationNode];
+    HLInstancedActionNodeState newState = HLInstancedActionNodeStateGet(evaluationNode);
+    [self HL_broadcastFromState:oldState toState:newState nodes:phase->nodes];
+
+    if (!notYetCompleted) {
+      for (SKNode *node in phase->nodes) {
+        [_nodeTimeOffsets removeObjectForKey:node];
+      }
+      [_phases removeObjectIdenticalTo:phase];
+    }
+  }
+}
+
+- (HLInstancedActionPhase *)HL_phaseWithTimeOffset:(NSTimeInterval)timeOffset
+{
+  for (HLInstancedActionPhase *phase in _phases) {
+    if (phase->timeOffset == timeOffset) {
+      return phase;
+    }
+  }
+  return nil;
+}
+
+- (void)HL_broadcastFromState:(HLInstancedActionNodeState)oldState toState:(HLInstancedActionNodeState)newState nodes:(NSArray *)nodes
+{
+  BOOL positionChanged = (newState.position.x != oldState.position.x || newState.position.y != oldState.position.y);
+  BOOL zRotationChanged = (newState.zRotation != oldState.zRotation);
+  BOOL scaleChanged = (newState.xScale != oldState.xScale || newState.yScale != oldState.yScale);
+  BOOL alphaChanged = (newState.alpha != oldState.alpha);
+  BOOL zPositionChanged = (newState.zPosition != oldState.zPosition);
+  if (!positionChanged && !zRotationChanged && !scaleChanged && !alphaChanged && !zPositionChanged) {
+    return;
+  }
+
+  // note: Only changed properties are written, so that subscribed nodes remain free to
+  // change the others.
+  if (_broadcastMode == HLInstancedActionBroadcastValues) {
+    for (SKNode *node in nodes) {
+      if (positionChanged) {
+        node.position = newState.position;
+      }
+      if (zRotationChanged) {
+        node.zRotation = newState.zRotation;
+      }
+      if (scaleChanged) {
+        node.xScale = newState.xScale;
+        node.yScale = newState.yScale;
+      }
+      if (alphaChanged) {
+        node.alpha = newState.alpha;
+      }
+      if (zPositionChanged) {
+        node.zPosition = newState.zPosition;
+      }
+    }
+    return;
+  }
+
+  CGFloat deltaX = newState.position.x - oldState.position.x;
+  CGFloat deltaY = newState.position.y - oldState.position.y;
+  CGFloat deltaZRotation = newState.zRotation - oldState.zRotation;
+  CGFloat deltaXScale = newState.xScale - oldState.xScale;
+  CGFloat deltaYScale = newState.yScale - oldState.yScale;
+  CGFloat deltaAlpha = newState.alpha - oldState.alpha;
+  CGFloat deltaZPosition = newState.zPosition - oldState.zPosition;
+  for (SKNode *node in nodes) {
+    if (positionChanged) {
+      CGPoint position = node.position;
+      node.position = CGPointMake(position.x + deltaX, position.y + deltaY);
+    }
+    if (zRotationChanged) {
+      node.zRotation += deltaZRotation;
+    }
+    if (scaleChanged) {
+      node.xScale += deltaXScale;
+      node.yScale += deltaYScale;
+    }
+    if (alphaChanged) {
+      node.alpha += deltaAlpha;
+    }
+    if (zPositionChanged) {
+      node.zPosition += deltaZPosition;
+    }
+  }
+}
+
+@end
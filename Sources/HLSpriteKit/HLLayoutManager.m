@@ -10,74 +10,187 @@
 
 #import "HLLayoutManager.h"
 
-CGSize
-HLLayoutManagerGetNodeSize(id node)
+#include <objc/runtime.h>
+#include <os/lock.h>
+#include <stdatomic.h>
+
+typedef NS_ENUM(uint8_t, HLLayoutManagerSizeKind) {
+  HLLayoutManagerSizeNone,
+  HLLayoutManagerSizeLayoutSizing,
+  HLLayoutManagerSizeLabelFrame,
+  HLLayoutManagerSizeMethod,
+};
+
+typedef CGSize (*HLLayoutManagerSizeIMP)(id, SEL);
+
+typedef struct {
+  Class nodeClass;
+  HLLayoutManagerSizeKind kind;
+  HLLayoutManagerSizeIMP sizeImplementation;
+} HLLayoutManagerSizeResolution;
+
+// note: Resolutions are cached per class in a small open-addressed table, so that
+// measuring a node costs a hash lookup and a direct function call rather than
+// methodSignatureForSelector: and an NSInvocation.  Layout managers are not otherwise tied
+// to any one thread, so the table is shared: A slot's resolution is written once, under
+// the lock, and then published by a release store of its class key; lookups load the
+// table and its keys with acquire ordering and take no lock.  Slots are never changed or
+// cleared once published; instead, `HLLayoutManagerInvalidateNodeSizeCache()` publishes a
+// new, empty table.  A replaced table is never freed, since a lookup on another thread
+// might still be reading it (invalidation is expected to be rare, and a table is only a
+// few kilobytes).  When the table fills, further classes are resolved on every call (which
+// is still correct, only slower).
+enum { HLLayoutManagerSizeCacheCapacity = 128 };
+typedef struct {
+  _Atomic(uintptr_t) classKey;
+  HLLayoutManagerSizeResolution resolution;
+} HLLayoutManagerSizeCacheEntry;
+static HLLayoutManagerSizeCacheEntry HLLayoutManagerSizeCacheInitialTable[HLLayoutManagerSizeCacheCapacity];
+static HLLayoutManagerSizeCacheEntry * _Atomic HLLayoutManagerSizeCache = HLLayoutManagerSizeCacheInitialTable;
+static NSUInteger HLLayoutManagerSizeCacheCount = 0;
+static os_unfair_lock HLLayoutManagerSizeCacheLock = OS_UNFAIR_LOCK_INIT;
+
+static HLLayoutManagerSizeResolution
+HLLayoutManagerResolveSize(Class nodeClass)
 {
+  HLLayoutManagerSizeResolution resolution = { nodeClass, HLLayoutManagerSizeNone, NULL };
+
+  if ([nodeClass conformsToProtocol:@protocol(HLLayoutSizing)]) {
+    Method layoutSizeMethod = class_getInstanceMethod(nodeClass, @selector(layoutSize));
+    if (layoutSizeMethod) {
+      resolution.kind = HLLayoutManagerSizeLayoutSizing;
+      resolution.sizeImplementation = (HLLayoutManagerSizeIMP)method_getImplementation(layoutSizeMethod);
+      return resolution;
+    }
+  }
+
   // note: As of iOS 10, SKNode exposes an undocumented `size` selector.  For SKLabelNode
   // it returns zero.
-  if ([node isKindOfClass:[SKLabelNode class]]) {
-    return [(SKLabelNode *)node frame].size;
+  if ([nodeClass isSubclassOfClass:[SKLabelNode class]]) {
+    resolution.kind = HLLayoutManagerSizeLabelFrame;
+    return resolution;
   }
 
-  SEL selector = @selector(size);
-  NSMethodSignature *sizeMethodSignature = [node methodSignatureForSelector:selector];
-  if (sizeMethodSignature
-      && strcmp(sizeMethodSignature.methodReturnType, @encode(CGSize)) == 0) {
-    NSInvocation *invocation = [NSInvocation invocationWithMethodSignature:sizeMethodSignature];
-    invocation.selector = selector;
-    [invocation invokeWithTarget:node];
-    CGSize nodeSize;
-    [invocation getReturnValue:&nodeSize];
-    return nodeSize;
+  Method sizeMethod = class_getInstanceMethod(nodeClass, @selector(size));
+  if (sizeMethod) {
+    char returnType[32];
+    method_getReturnType(sizeMethod, returnType, sizeof(returnType));
+    if (strcmp(returnType, @encode(CGSize)) == 0) {
+      resolution.kind = HLLayoutManagerSizeMethod;
+      resolution.sizeImplementation = (HLLayoutManagerSizeIMP)method_getImplementation(sizeMethod);
+    }
   }
 
-  return CGSizeZero;
+  return resolution;
 }
 
-CGFloat
-HLLayoutManagerGetNodeWidth(id node)
+// note: The table is never more than half full, so probing always finds either the class
+// or an empty slot.  Safe to call without the cache lock.
+static NSUInteger
+HLLayoutManagerSizeCacheSlot(HLLayoutManagerSizeCacheEntry *table, uintptr_t classKey)
 {
-  // note: As of iOS 10, SKNode exposes an undocumented `size` selector.  For SKLabelNode
-  // it returns zero.
-  if ([node isKindOfClass:[SKLabelNode class]]) {
-    return [(SKLabelNode *)node frame].size.width;
+  NSUInteger slot = (classKey >> 4) % HLLayoutManagerSizeCacheCapacity;
+  while (YES) {
+    uintptr_t slotClassKey = atomic_load_explicit(&table[slot].classKey, memory_order_acquire);
+    if (slotClassKey == 0 || slotClassKey == classKey) {
+      return slot;
+    }
+    slot = (slot + 1) % HLLayoutManagerSizeCacheCapacity;
   }
+}
 
-  SEL selector = @selector(size);
-  NSMethodSignature *sizeMethodSignature = [node methodSignatureForSelector:selector];
-  if (sizeMethodSignature
-      && strcmp(sizeMethodSignature.methodReturnType, @encode(CGSize)) == 0) {
-    NSInvocation *invocation = [NSInvocation invocationWithMethodSignature:sizeMethodSignature];
-    invocation.selector = selector;
-    [invocation invokeWithTarget:node];
-    CGSize nodeSize;
-    [invocation getReturnValue:&nodeSize];
-    return nodeSize.width;
+static HLLayoutManagerSizeResolution
+HLLayoutManagerGetSizeResolution(Class nodeClass)
+{
+  uintptr_t classKey = (uintptr_t)nodeClass;
+  HLLayoutManagerSizeCacheEntry *table = atomic_load_explicit(&HLLayoutManagerSizeCache, memory_order_acquire);
+  NSUInteger slot = HLLayoutManagerSizeCacheSlot(table, classKey);
+  if (atomic_load_explicit(&table[slot].classKey, memory_order_acquire) == classKey) {
+    return table[slot].resolution;
   }
 
-  return 0.0f;
+  // note: Resolved outside the lock, since resolving may message the class (for instance,
+  // triggering +initialize, which might itself lay out nodes).
+  HLLayoutManagerSizeResolution resolution = HLLayoutManagerResolveSize(nodeClass);
+
+  // note: The lock serializes writers; the table and slot are found again under it, since
+  // another thread may have filled the empty slot (with this class or another), or
+  // invalidated the cache, in the meantime.
+  os_unfair_lock_lock(&HLLayoutManagerSizeCacheLock);
+  if (HLLayoutManagerSizeCacheCount < HLLayoutManagerSizeCacheCapacity / 2) {
+    table = atomic_load_explicit(&HLLayoutManagerSizeCache, memory_order_relaxed);
+    slot = HLLayoutManagerSizeCacheSlot(table, classKey);
+    if (atomic_load_explicit(&table[slot].classKey, memory_order_relaxed) == 0) {
+      table[slot].resolution = resolution;
+      atomic_store_explicit(&table[slot].classKey, classKey, memory_order_release);
+      ++HLLayoutManagerSizeCacheCount;
+    }
+  }
+  os_unfair_lock_unlock(&HLLayoutManagerSizeCacheLock);
+
+  return resolution;
 }
 
-CGFloat
-HLLayoutManagerGetNodeHeight(id node)
+void
+HLLayoutManagerInvalidateNodeSizeCache(void)
 {
-  // note: As of iOS 10, SKNode exposes an undocumented `size` selector.  For SKLabelNode
-  // it returns zero.
-  if ([node isKindOfClass:[SKLabelNode class]]) {
-    return [(SKLabelNode *)node frame].size.height;
+  HLLayoutManagerSizeCacheEntry *table = calloc(HLLayoutManagerSizeCacheCapacity, sizeof(HLLayoutManagerSizeCacheEntry));
+  os_unfair_lock_lock(&HLLayoutManagerSizeCacheLock);
+  atomic_store_explicit(&HLLayoutManagerSizeCache, table, memory_order_release);
+  HLLayoutManagerSizeCacheCount = 0;
+  os_unfair_lock_unlock(&HLLayoutManagerSizeCacheLock);
+}
+
+static inline CGSize
+HLLayoutManagerGetNodeSizeWithResolution(id node, HLLayoutManagerSizeResolution resolution)
+{
+  switch (resolution.kind) {
+    case HLLayoutManagerSizeNone:
+      return CGSizeZero;
+    case HLLayoutManagerSizeLayoutSizing:
+      return resolution.sizeImplementation(node, @selector(layoutSize));
+    case HLLayoutManagerSizeLabelFrame:
+      return [(SKLabelNode *)node frame].size;
+    case HLLayoutManagerSizeMethod:
+      return resolution.sizeImplementation(node, @selector(size));
+  }
+  return CGSizeZero;
+}
+
+CGSize
+HLLayoutManagerGetNodeSize(id node)
+{
+  if (!node) {
+    return CGSizeZero;
   }
+  return HLLayoutManagerGetNodeSizeWithResolution(node, HLLayoutManagerGetSizeResolution(object_getClass(node)));
+}
 
-  SEL selector = @selector(size);
-  NSMethodSignature *sizeMethodSignature = [node methodSignatureForSelector:selector];
-  if (sizeMethodSignature
-      && strcmp(sizeMethodSignature.methodReturnType, @encode(CGSize)) == 0) {
-    NSInvocation *invocation = [NSInvocation invocationWithMethodSignature:sizeMethodSignature];
-    invocation.selector = selector;
-    [invocation invokeWithTarget:node];
-    CGSize nodeSize;
-    [invocation getReturnValue:&nodeSize];
-    return nodeSize.height;
+void
+HLLayoutManagerGetNodeSizes(NSArray *nodes, CGSize *sizes)
+{
+  // note: Nodes laid out together are usually of only a few classes, so the last
+  // resolution is reused without going to the cache.
+  HLLayoutManagerSizeResolution resolution = { Nil, HLLayoutManagerSizeNone, NULL };
+  NSUInteger nodeIndex = 0;
+  for (id node in nodes) {
+    Class nodeClass = object_getClass(node);
+    if (nodeClass != resolution.nodeClass) {
+      resolution = HLLayoutManagerGetSizeResolution(nodeClass);
+    }
+    sizes[nodeIndex] = HLLayoutManagerGetNodeSizeWithResolution(node, resolution);
+    ++nodeIndex;
   }
+}
 
-  return 0.0f;
+CGFloat
+HLLayoutManagerGetNodeWidth(id node)
+{
+  return HLLayoutManagerGetNodeSize(node).width;
+}
+
+CGFloat
+HLLayoutManagerGetNodeHeight(id node)
+{
+  return HLLayoutManagerGetNodeSize(node).height;
 }
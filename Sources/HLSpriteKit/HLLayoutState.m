@@ -0,0 +1,248 @@
+//
+//  HLLayoutState.m
+//  HLSpriteKit
+//
+//  Created by Karl Voskuil on 10/16/26.
+//  Copyright © 2026 Hilo Games. All rights reserved.
+//
+
+#import "HLLayoutState.h"
+
+#include <stdlib.h>
+
+// note: Returns the index in [begin, end) of the interval containing the coordinate, or
+// NSNotFound.  Intervals are sorted by their minimums, either increasing or decreasing
+// with index; the direction is inferred from the first and last intervals.
+static NSUInteger
+HLLayoutStateFindInterval(const CGFloat *mins, const CGFloat *maxes, NSUInteger begin, NSUInteger end, CGFloat coordinate)
+{
+  if (begin >= end) {
+    return NSNotFound;
+  }
+  BOOL decreasing = (mins[begin] > mins[end - 1]);
+  // note: Find the boundary between intervals starting at or before the coordinate and
+  // those starting after it.  For increasing intervals, the candidate is the last that
+  // starts at or before; for decreasing, the first.
+  NSUInteger low = begin;
+  NSUInteger high = end;
+  while (low < high) {
+    NSUInteger middle = low + (high - low) / 2;
+    BOOL startsAtOrBefore = (mins[middle] <= coordinate);
+    if (startsAtOrBefore != decreasing) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  NSUInteger candidate;
+  if (!decreasing) {
+    if (low == begin) {
+      return NSNotFound;
+    }
+    candidate = low - 1;
+  } else {
+    if (low == end) {
+      return NSNotFound;
+    }
+    candidate = low;
+  }
+  if (coordinate > maxes[candidate]) {
+    return NSNotFound;
+  }
+  return candidate;
+}
+
+// note: Returns the first index in [begin, end) whose value is beyond the threshold
+// (greater than it, or less than it), or end if there is none.  Values must be sorted so
+// that all indexes beyond the threshold come after those that are not.
+static NSUInteger
+HLLayoutStateFindFirstBeyond(const CGFloat *values, NSUInteger begin, NSUInteger end, CGFloat threshold, BOOL greater, BOOL inclusive)
+{
+  NSUInteger low = begin;
+  NSUInteger high = end;
+  while (low < high) {
+    NSUInteger middle = low + (high - low) / 2;
+    CGFloat value = values[middle];
+    BOOL isBeyond;
+    if (greater) {
+      isBeyond = (inclusive ? value >= threshold : value > threshold);
+    } else {
+      isBeyond = (inclusive ? value <= threshold : value < threshold);
+    }
+    if (isBeyond) {
+      high = middle;
+    } else {
+      low = middle + 1;
+    }
+  }
+  return low;
+}
+
+// note: Returns the range of indexes in [begin, end) of intervals intersecting [low, high].
+// Intervals must not overlap, so that their minimums and maximums are sorted in the same
+// direction.
+static NSRange
+HLLayoutStateFindIntervalRange(const CGFloat *mins, const CGFloat *maxes, NSUInteger begin, NSUInteger end, CGFloat low, CGFloat high)
+{
+  if (begin >= end || low > high) {
+    return NSMakeRange(begin, 0);
+  }
+  NSUInteger rangeBegin;
+  NSUInteger rangeEnd;
+  if (mins[begin] > mins[end - 1]) {
+    rangeBegin = HLLayoutStateFindFirstBeyond(mins, begin, end, high, NO, YES);
+    rangeEnd = HLLayoutStateFindFirstBeyond(maxes, begin, end, low, NO, NO);
+  } else {
+    rangeBegin = HLLayoutStateFindFirstBeyond(maxes, begin, end, low, YES, YES);
+    rangeEnd = HLLayoutStateFindFirstBeyond(mins, begin, end, high, YES, NO);
+  }
+  if (rangeEnd <= rangeBegin) {
+    return NSMakeRange(rangeBegin, 0);
+  }
+  return NSMakeRange(rangeBegin, rangeEnd - rangeBegin);
+}
+
+@implementation HLLayoutState
+{
+  CGFloat *_lineMins;
+  CGFloat *_lineMaxes;
+  // note: The index of the first cell of each line, plus (at lineCount) the total cell
+  // count.
+  NSUInteger *_lineCellStarts;
+  NSUInteger _lineCapacity;
+  CGFloat *_cellMins;
+  CGFloat *_cellMaxes;
+  NSUInteger _cellCapacity;
+}
+
+- (instancetype)init
+{
+  return [self initWithLineAxis:HLLayoutStateAxisY];
+}
+
+- (instancetype)initWithLineAxis:(HLLayoutStateAxis)lineAxis
+{
+  self = [super init];
+  if (self) {
+    _lineAxis = lineAxis;
+    _lineCount = 0;
+    _cellCount = 0;
+    _lineCapacity = 0;
+    _cellCapacity = 0;
+    _lineMins = NULL;
+    _lineMaxes = NULL;
+    _lineCellStarts = NULL;
+    _cellMins = NULL;
+    _cellMaxes = NULL;
+  }
+  return self;
+}
+
+- (void)dealloc
+{
+  free(_lineMins);
+  free(_lineMaxes);
+  free(_lineCellStarts);
+  free(_cellMins);
+  free(_cellMaxes);
+}
+
+- (void)addLineFrom:(CGFloat)start to:(CGFloat)end
+{
+  if (_lineCount == _lineCapacity) {
+    NSUInteger lineCapacity = (_lineCapacity > 0 ? _lineCapacity * 2 : 4);
+    CGFloat *lineMins = realloc(_lineMins, lineCapacity * sizeof(CGFloat));
+    CGFloat *lineMaxes = realloc(_lineMaxes, lineCapacity * sizeof(CGFloat));
+    NSUInteger *lineCellStarts = realloc(_lineCellStarts, (lineCapacity + 1) * sizeof(NSUInteger));
+    if (lineMins) {
+      _lineMins = lineMins;
+    }
+    if (lineMaxes) {
+      _lineMaxes = lineMaxes;
+    }
+    if (lineCellStarts) {
+      _lineCellStarts = lineCellStarts;
+    }
+    if (!lineMins || !lineMaxes || !lineCellStarts) {
+      [NSException raise:NSMallocException format:@"HLLayoutState could not allocate storage for %lu lines.", (unsigned long)lineCapacity];
+    }
+    _lineCapacity = lineCapacity;
+  }
+  _lineMins[_lineCount] = MIN(start, end);
+  _lineMaxes[_lineCount] = MAX(start, end);
+  _lineCellStarts[_lineCount] = _cellCount;
+  ++_lineCount;
+  _lineCellStarts[_lineCount] = _cellCount;
+}
+
+- (void)addCellFrom:(CGFloat)start to:(CGFloat)end
+{
+  if (_lineCount == 0) {
+    [NSException raise:@"HLLayoutStateInvalid" format:@"A line must be added before adding cells."];
+  }
+  if (_cellCount == _cellCapacity) {
+    NSUInteger cellCapacity = (_cellCapacity > 0 ? _cellCapacity * 2 : 8);
+    CGFloat *cellMins = realloc(_cellMins, cellCapacity * sizeof(CGFloat));
+    CGFloat *cellMaxes = realloc(_cellMaxes, cellCapacity * sizeof(CGFloat));
+    if (cellMins) {
+      _cellMins = cellMins;
+    }
+    if (cellMaxes) {
+      _cellMaxes = cellMaxes;
+    }
+    if (!cellMins || !cellMaxes) {
+      [NSException raise:NSMallocException format:@"HLLayoutState could not allocate storage for %lu cells.", (unsigned long)cellCapacity];
+    }
+    _cellCapacity = cellCapacity;
+  }
+  _cellMins[_cellCount] = MIN(start, end);
+  _cellMaxes[_cellCount] = MAX(start, end);
+  ++_cellCount;
+  _lineCellStarts[_lineCount] = _cellCount;
+}
+
+- (NSUInteger)lineContainingPoint:(CGPoint)point
+{
+  CGFloat lineCoordinate = (_lineAxis == HLLayoutStateAxisX ? point.x : point.y);
+  return HLLayoutStateFindInterval(_lineMins, _lineMaxes, 0, _lineCount, lineCoordinate);
+}
+
+- (NSUInteger)cellContainingPoint:(CGPoint)point
+{
+  NSUInteger lineIndex = [self lineContainingPoint:point];
+  if (lineIndex == NSNotFound) {
+    return NSNotFound;
+  }
+  CGFloat cellCoordinate = (_lineAxis == HLLayoutStateAxisX ? point.y : point.x);
+  return HLLayoutStateFindInterval(_cellMins, _cellMaxes, _lineCellStarts[lineIndex], _lineCellStarts[lineIndex + 1], cellCoordinate);
+}
+
+- (NSIndexSet *)cellIndexesIntersectingRect:(CGRect)rect
+{
+  NSMutableIndexSet *cellIndexes = [NSMutableIndexSet indexSet];
+  if (CGRectIsNull(rect)) {
+    return cellIndexes;
+  }
+  CGFloat lineLow = (_lineAxis == HLLayoutStateAxisX ? CGRectGetMinX(rect) : CGRectGetMinY(rect));
+  CGFloat lineHigh = (_lineAxis == HLLayoutStateAxisX ? CGRectGetMaxX(rect) : CGRectGetMaxY(rect));
+  CGFloat cellLow = (_lineAxis == HLLayoutStateAxisX ? CGRectGetMinY(rect) : CGRectGetMinX(rect));
+  CGFloat cellHigh = (_lineAxis == HLLayoutStateAxisX ? CGRectGetMaxY(rect) : CGRectGetMaxX(rect));
+  NSRange lineRange = HLLayoutStateFindIntervalRange(_lineMins, _lineMaxes, 0, _lineCount, lineLow, lineHigh);
+  for (NSUInteger lineIndex = lineRange.location; lineIndex < NSMaxRange(lineRange); ++lineIndex) {
+    NSRange cellRange = HLLayoutStateFindIntervalRange(_cellMins, _cellMaxes, _lineCellStarts[lineIndex], _lineCellStarts[lineIndex + 1], cellLow, cellHigh);
+    if (cellRange.length > 0) {
+      [cellIndexes addIndexesInRange:cellRange];
+    }
+  }
+  return cellIndexes;
+}
+
+- (NSRange)cellRangeOfLineAtIndex:(NSUInteger)lineIndex
+{
+  if (lineIndex >= _lineCount) {
+    [NSException raise:NSRangeException format:@"Line index %lu beyond bounds %lu.", (unsigned long)lineIndex, (unsigned long)_lineCount];
+  }
+  return NSMakeRange(_lineCellStarts[lineIndex], _lineCellStarts[lineIndex + 1] - _lineCellStarts[lineIndex]);
+}
+
+@end
@@ -10,6 +10,8 @@
 
 #import <TargetConditionals.h>
 
+#import "HLLayoutState.h"
+
 const CGFloat HLOutlineLayoutManagerEpsilon = 0.001f;
 
 @implementation HLOutlineLayoutManager
@@ -131,21 +133,111 @@ const CGFloat HLOutlineLayoutManagerEpsilon = 0.001f;
 
 - (void)layout:(NSArray *)nodes
 {
-  [self GL_layout:nodes animated:NO duration:0.0 delay:0.0];
+  [self GL_layout:nodes animated:NO duration:0.0 delay:0.0 state:nil];
 }
 
 - (void)layout:(NSArray *)nodes animatedDuration:(NSTimeInterval)duration delay:(NSTimeInterval)delay
 {
-  [self GL_layout:nodes animated:YES duration:duration delay:delay];
+  [self GL_layout:nodes animated:YES duration:duration delay:delay state:nil];
+}
+
+- (void)layout:(NSArray *)nodes getState:(HLLayoutState * __autoreleasing *)state
+{
+  [self GL_layout:nodes animated:NO duration:0.0 delay:0.0 state:state];
+}
+
+- (void)layoutSizes:(const CGSize *)sizes count:(NSUInteger)count getPositions:(CGPoint *)positions
+{
+  [self GL_layoutSizes:sizes count:count getPositions:positions state:nil];
+}
+
+- (void)layoutSizes:(const CGSize *)sizes
+              count:(NSUInteger)count
+       getPositions:(CGPoint *)positions
+              state:(HLLayoutState * __autoreleasing *)returnState
+{
+  HLLayoutState *state = (returnState ? [[HLLayoutState alloc] initWithLineAxis:HLLayoutStateAxisY] : nil);
+  [self GL_layoutSizes:sizes count:count getPositions:positions state:state];
+  if (returnState) {
+    *returnState = state;
+  }
 }
 
-- (void)GL_layout:(NSArray *)nodes animated:(BOOL)animated duration:(NSTimeInterval)duration delay:(NSTimeInterval)delay
+- (CGFloat)labelOffsetYForNodeAtIndex:(NSUInteger)nodeIndex
+{
+  NSUInteger levelLabelOffsetYsCount = (_levelLabelOffsetYs ? [_levelLabelOffsetYs count] : 0);
+  if (levelLabelOffsetYsCount == 0 || nodeIndex >= [_nodeLevels count]) {
+    return 0.0f;
+  }
+  NSUInteger nodeLevel = [_nodeLevels[nodeIndex] unsignedIntegerValue];
+  NSNumber *levelLabelOffsetYNumber = _levelLabelOffsetYs[MIN(nodeLevel, levelLabelOffsetYsCount - 1)];
+  return (CGFloat)[levelLabelOffsetYNumber doubleValue];
+}
+
+- (void)GL_layout:(NSArray *)nodes
+         animated:(BOOL)animated
+         duration:(NSTimeInterval)duration
+            delay:(NSTimeInterval)delay
+            state:(HLLayoutState * __autoreleasing *)returnState
+{
+  // note: Each node is a line, with a single unbounded cell.
+  HLLayoutState *state = (returnState ? [[HLLayoutState alloc] initWithLineAxis:HLLayoutStateAxisY] : nil);
+  if (returnState) {
+    *returnState = state;
+  }
+  NSUInteger layoutCount = MIN([_nodeLevels count], [nodes count]);
+  if (layoutCount == 0) {
+    return;
+  }
+  // note: Checked here, as in GL_layoutSizes:count:getPositions:state:, so that nodes are not
+  // moved to uncalculated positions.
+  if ([_levelIndents count] == 0) {
+    return;
+  }
+
+  // note: Only nodes with levels are measured.
+  CGSize *sizes = (CGSize *)malloc(layoutCount * sizeof(CGSize));
+  CGPoint *positions = (CGPoint *)malloc(layoutCount * sizeof(CGPoint));
+  for (NSUInteger nodeIndex = 0; nodeIndex < layoutCount; ++nodeIndex) {
+    sizes[nodeIndex] = HLLayoutManagerGetNodeSize(nodes[nodeIndex]);
+  }
+  [self GL_layoutSizes:sizes count:layoutCount getPositions:positions state:state];
+
+  for (NSUInteger nodeIndex = 0; nodeIndex < layoutCount; ++nodeIndex) {
+
+    SKNode *node = nodes[nodeIndex];
+    CGPoint position = positions[nodeIndex];
+
+    if ([node isKindOfClass:[SKLabelNode class]]) {
+      position.y += [self labelOffsetYForNodeAtIndex:nodeIndex];
+    }
+
+    if (!animated) {
+      node.position = position;
+    } else {
+      SKAction *moveAction = [SKAction moveTo:position duration:duration];
+      moveAction.timingMode = SKActionTimingEaseInEaseOut;
+      if (delay > 0.0) {
+        [node runAction:[SKAction sequence:@[ [SKAction waitForDuration:delay], moveAction ]]];
+      } else {
+        [node runAction:moveAction];
+      }
+    }
+  }
+
+  free(sizes);
+  free(positions);
+}
+
+- (void)GL_layoutSizes:(const CGSize *)sizes
+                 count:(NSUInteger)nodesCount
+          getPositions:(CGPoint *)positions
+                 state:(HLLayoutState *)state
 {
   NSUInteger nodeLevelsCount = [_nodeLevels count];
   if (nodeLevelsCount == 0) {
     return;
   }
-  NSUInteger nodesCount = [nodes count];
   if (nodesCount == 0) {
     return;
   }
@@ -156,7 +248,6 @@ const CGFloat HLOutlineLayoutManagerEpsilon = 0.001f;
   }
   NSUInteger levelLineHeightsCount = (_levelLineHeights ? [_levelLineHeights count] : 0);
   NSUInteger levelAnchorPointYsCount = (_levelAnchorPointYs ? [_levelAnchorPointYs count] : 0);
-  NSUInteger levelLabelOffsetYsCount = (_levelLabelOffsetYs ? [_levelLabelOffsetYs count] : 0);
   NSUInteger levelLineBeforeSeparatorsCount = (_levelLineBeforeSeparators ? [_levelLineBeforeSeparators count] : 0);
   NSUInteger levelLineAfterSeparatorsCount = (_levelLineAfterSeparators ? [_levelLineAfterSeparators count] : 0);
 
@@ -186,13 +277,6 @@ const CGFloat HLOutlineLayoutManagerEpsilon = 0.001f;
       levelAnchorPointYs[levelIndex] = (CGFloat)[_levelAnchorPointYs[levelIndex] doubleValue];
     }
   }
-  CGFloat *levelLabelOffsetYs = NULL;
-  if (levelLabelOffsetYsCount > 0) {
-    levelLabelOffsetYs = (CGFloat *)malloc(levelLabelOffsetYsCount * sizeof(CGFloat));
-    for (NSUInteger levelIndex = 0; levelIndex < levelLabelOffsetYsCount; ++levelIndex) {
-      levelLabelOffsetYs[levelIndex] = (CGFloat)[_levelLabelOffsetYs[levelIndex] doubleValue];
-    }
-  }
   CGFloat *levelLineBeforeSeparators = NULL;
   if (levelLineBeforeSeparatorsCount > 0) {
     levelLineBeforeSeparators = (CGFloat *)malloc(levelLineBeforeSeparatorsCount * sizeof(CGFloat));
@@ -217,11 +301,12 @@ const CGFloat HLOutlineLayoutManagerEpsilon = 0.001f;
   // First pass: Calculate the relative Y-position of each node in the outline, and sum
   // total outline height.
   CGFloat *nodeOffsetYs = (CGFloat *)malloc(layoutCount * sizeof(CGFloat));
+  CGFloat *lineTopOffsetYs = (state ? (CGFloat *)malloc(layoutCount * sizeof(CGFloat)) : NULL);
+  CGFloat *lineHeights = (state ? (CGFloat *)malloc(layoutCount * sizeof(CGFloat)) : NULL);
   CGFloat offsetY = 0.0f;
   for (NSUInteger nodeIndex = 0; nodeIndex < layoutCount; ++nodeIndex) {
 
     NSUInteger nodeLevel = [_nodeLevels[nodeIndex] unsignedIntegerValue];
-    SKNode *node = nodes[nodeIndex];
 
     if (nodeIndex > 0) {
       CGFloat lineBeforeSeparator = 0.0f;
@@ -240,7 +325,7 @@ const CGFloat HLOutlineLayoutManagerEpsilon = 0.001f;
       lineHeight = levelLineHeights[levelLineHeightsCount - 1];
     }
     if (lineHeight < HLOutlineLayoutManagerEpsilon) {
-      lineHeight = HLLayoutManagerGetNodeHeight(node);
+      lineHeight = sizes[nodeIndex].height;
     }
 
     CGFloat anchorPointY = 0.5f;
@@ -250,17 +335,12 @@ const CGFloat HLOutlineLayoutManagerEpsilon = 0.001f;
       anchorPointY = levelAnchorPointYs[levelAnchorPointYsCount - 1];
     }
 
-    CGFloat nodeOffsetY = 0.0f;
-    if ([node isKindOfClass:[SKLabelNode class]]) {
-      if (nodeLevel < levelLabelOffsetYsCount) {
-        nodeOffsetY = levelLabelOffsetYs[nodeLevel];
-      } else if (levelLabelOffsetYsCount > 0) {
-        nodeOffsetY = levelLabelOffsetYs[levelLabelOffsetYsCount - 1];
-      }
+    if (state) {
+      lineTopOffsetYs[nodeIndex] = offsetY;
+      lineHeights[nodeIndex] = lineHeight;
     }
-
     offsetY -= lineHeight;
-    nodeOffsetYs[nodeIndex] = offsetY + nodeOffsetY + lineHeight * anchorPointY;
+    nodeOffsetYs[nodeIndex] = offsetY + lineHeight * anchorPointY;
 
     if (nodeIndex + 1 < layoutCount) {
       CGFloat lineAfterSeparator = 0.0f;
@@ -276,12 +356,11 @@ const CGFloat HLOutlineLayoutManagerEpsilon = 0.001f;
 
   _height = outlineHeight;
 
-  // Second pass: Calculate starting Y and each node indent X, and position nodes.
+  // Second pass: Calculate starting Y and each node indent X.
   CGFloat outlineYTop = _outlinePosition.y + outlineHeight * (1.0f - _anchorPointY);
   for (NSUInteger nodeIndex = 0; nodeIndex < layoutCount; ++nodeIndex) {
 
     NSUInteger nodeLevel = [_nodeLevels[nodeIndex] unsignedIntegerValue];
-    SKNode *node = nodes[nodeIndex];
 
     CGFloat nodeIndent = 0.0f;
     if (nodeLevel < levelIndentsCount) {
@@ -290,28 +369,23 @@ const CGFloat HLOutlineLayoutManagerEpsilon = 0.001f;
       nodeIndent = levelIndentsAccumulated[levelIndentsCount - 1] + lastLevelIndent * (nodeLevel - levelIndentsCount + 1);
     }
 
-    CGPoint position = CGPointMake(_outlinePosition.x + nodeIndent,
-                                   outlineYTop + nodeOffsetYs[nodeIndex]);
-    if (!animated) {
-      node.position = position;
-    } else {
-      SKAction *moveAction = [SKAction moveTo:position duration:duration];
-      moveAction.timingMode = SKActionTimingEaseInEaseOut;
-      if (delay > 0.0) {
-        [node runAction:[SKAction sequence:@[ [SKAction waitForDuration:delay], moveAction ]]];
-      } else {
-        [node runAction:moveAction];
-      }
+    positions[nodeIndex] = CGPointMake(_outlinePosition.x + nodeIndent,
+                                       outlineYTop + nodeOffsetYs[nodeIndex]);
+    if (state) {
+      CGFloat lineTopY = outlineYTop + lineTopOffsetYs[nodeIndex];
+      [state addLineFrom:lineTopY to:(lineTopY - lineHeights[nodeIndex])];
+      [state addCellFrom:-CGFLOAT_MAX to:CGFLOAT_MAX];
     }
   }
 
   free(levelIndentsAccumulated);
   free(levelLineHeights);
   free(levelAnchorPointYs);
-  free(levelLabelOffsetYs);
   free(levelLineBeforeSeparators);
   free(levelLineAfterSeparators);
   free(nodeOffsetYs);
+  free(lineTopOffsetYs);
+  free(lineHeights);
 }
 
 @end
@@ -325,30 +399,25 @@ HLOutlineLayoutManagerLineContainingPointY(NSArray *nodes,
                                            NSArray *levelLabelOffsetYs)
 {
   NSUInteger layoutCount = MIN([nodes count], [nodeLevels count]);
-  SKNode *pointYNode = [SKNode node];
-  pointYNode.position = CGPointMake(0.0f, pointY);
-  NSUInteger nextNodeIndex = [nodes indexOfObject:pointYNode
-                                    inSortedRange:NSMakeRange(0, layoutCount)
-                                          options:NSBinarySearchingInsertionIndex
-                                  usingComparator:^NSComparisonResult(SKNode *node1, SKNode *node2){
-    // note: Array of nodes is sorted according to position.y, largest to smallest.  NSArray considers "ascending"
-    // direction to be from the first element of the sorted array to the last element of the sorted array, so, though
-    // it might seem strange, a descending position.y is considered to be "ascending".
-    if (node1.position.y > node2.position.y) {
-      return NSOrderedAscending;
-    } else if (node1.position.y < node2.position.y) {
-      return NSOrderedDescending;
+  // note: Array of nodes is sorted according to position.y, largest to smallest.  Find
+  // the first node with a y-position smaller than pointY.
+  NSUInteger low = 0;
+  NSUInteger high = layoutCount;
+  while (low < high) {
+    NSUInteger middle = low + (high - low) / 2;
+    if ([(SKNode *)nodes[middle] position].y < pointY) {
+      high = middle;
     } else {
-      return NSOrderedSame;
+      low = middle + 1;
     }
-  }];
+  }
+  NSUInteger nextNodeIndex = low;
 
   NSUInteger levelLineHeightsCount = (levelLineHeights ? [levelLineHeights count] : 0);
   NSUInteger levelAnchorPointYsCount = (levelAnchorPointYs ? [levelAnchorPointYs count] : 0);
   NSUInteger levelLabelOffsetYsCount = (levelLabelOffsetYs ? [levelLabelOffsetYs count] : 0);
 
-  // note: nextNodeIndex is the node with array position greater than pointYNode, which means the node
-  // with a y-position smaller than pointY.  The node that contains the pointY is either that node,
+  // note: nextNodeIndex is the node with a y-position smaller than pointY.  The node that contains the pointY is either that node,
   // or the one with next-larger y-position (that is, with the next-lower array index).  Using [begin, end)
   // range terminology.
   NSUInteger checkNodeIndexBegin = (nextNodeIndex > 0 ? nextNodeIndex - 1 : nextNodeIndex);
@@ -246,19 +246,31 @@ const CGFloat HLParallaxLayoutManagerEpsilon = 0.001f;
     return;
   }
 
+  // note: The parallax doesn't consider node sizes, so there is nothing to measure.
+  CGPoint *positions = (CGPoint *)malloc(nodeCount * sizeof(CGPoint));
+  [self layoutSizes:NULL count:nodeCount getPositions:positions];
+
+  for (NSUInteger nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex) {
+    SKNode *node = nodes[nodeIndex];
+    node.position = positions[nodeIndex];
+  }
+
+  free(positions);
+}
+
+- (void)layoutSizes:(const CGSize *)sizes count:(NSUInteger)nodeCount getPositions:(CGPoint *)positions
+{
   NSUInteger speedsCount = (_speeds ? [_speeds count] : 0);
 
   CGFloat speed = 1.0f;
   for (NSUInteger nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex) {
 
-    SKNode *node = nodes[nodeIndex];
-
     if (nodeIndex < speedsCount) {
       speed = [_speeds[nodeIndex] floatValue];
     }
 
-    node.position = CGPointMake(_parallaxPosition.x + _offset.x * speed,
-                                _parallaxPosition.y + _offset.y * speed);
+    positions[nodeIndex] = CGPointMake(_parallaxPosition.x + _offset.x * speed,
+                                       _parallaxPosition.y + _offset.y * speed);
   }
 }
 
@@ -170,16 +170,19 @@ typedef NS_ENUM(NSInteger, HLRingLayoutManagerThetasMode) {
 
 - (void)layout:(NSArray *)nodes getThetas:(NSArray * __autoreleasing *)thetas
 {
-  NSMutableArray *mutableThetas = [NSMutableArray array];
-  [self GL_layout:nodes getThetas:&mutableThetas];
-  *thetas = mutableThetas;
+  [self GL_layout:nodes getThetas:thetas];
 }
 
-- (void)GL_layout:(NSArray *)nodes getThetas:(NSMutableArray * __autoreleasing *)thetas
+- (void)layoutSizes:(const CGSize *)sizes count:(NSUInteger)count getPositions:(CGPoint *)positions
 {
-  NSUInteger radiiCount = [_radii count];
-  if (radiiCount == 0) {
-    return;
+  [self GL_layoutCount:count isNodes:NULL getPositions:positions thetas:NULL];
+}
+
+- (void)GL_layout:(NSArray *)nodes getThetas:(NSArray * __autoreleasing *)returnThetas
+{
+  NSMutableArray *mutableThetas = (returnThetas ? [NSMutableArray array] : nil);
+  if (returnThetas) {
+    *returnThetas = mutableThetas;
   }
 
   NSUInteger nodeCount = [nodes count];
@@ -187,13 +190,54 @@ typedef NS_ENUM(NSInteger, HLRingLayoutManagerThetasMode) {
     return;
   }
 
+  // note: The ring doesn't consider node sizes, so there is nothing to measure.  It does,
+  // however, skip entries which are not nodes, without advancing theta.
+  BOOL *isNodes = (BOOL *)malloc(nodeCount * sizeof(BOOL));
+  for (NSUInteger nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex) {
+    isNodes[nodeIndex] = [nodes[nodeIndex] isKindOfClass:[SKNode class]];
+  }
+  CGPoint *positions = (CGPoint *)malloc(nodeCount * sizeof(CGPoint));
+  CGFloat *thetas = (returnThetas ? (CGFloat *)malloc(nodeCount * sizeof(CGFloat)) : NULL);
+  if ([self GL_layoutCount:nodeCount isNodes:isNodes getPositions:positions thetas:thetas]) {
+    for (NSUInteger nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex) {
+      if (!isNodes[nodeIndex]) {
+        continue;
+      }
+      [(SKNode *)nodes[nodeIndex] setPosition:positions[nodeIndex]];
+      if (thetas) {
+        [mutableThetas addObject:@(thetas[nodeIndex])];
+      }
+    }
+  }
+
+  free(isNodes);
+  free(positions);
+  free(thetas);
+}
+
+- (BOOL)GL_layoutCount:(NSUInteger)nodeCount
+               isNodes:(const BOOL *)isNodes
+          getPositions:(CGPoint *)positions
+                thetas:(CGFloat *)returnThetas
+{
+  // note: Entries flagged as not nodes are skipped (with their positions and thetas left
+  // unset) and do not advance theta.  Pass NULL to treat all entries as nodes.
+  NSUInteger radiiCount = [_radii count];
+  if (radiiCount == 0) {
+    return NO;
+  }
+
+  if (nodeCount == 0) {
+    return NO;
+  }
+
   NSUInteger thetasCount = (_thetas ? [_thetas count] : 0);
   CGFloat theta = 0.0f;
   CGFloat thetaIncrement = 0.0f;
   switch (_thetasMode) {
     case HLRingLayoutManagerThetasAssigned:
       if (thetasCount == 0) {
-        return;
+        return NO;
       }
       break;
     case HLRingLayoutManagerThetasRegular:
@@ -209,17 +253,15 @@ typedef NS_ENUM(NSInteger, HLRingLayoutManagerThetasMode) {
       thetaIncrement = _thetaIncrement;
       break;
     case HLRingLayoutManagerThetasNone:
-      return;
+      return NO;
   }
 
   CGFloat radius = 0.0f;
   for (NSUInteger nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex) {
 
-    id entry = nodes[nodeIndex];
-    if (![entry isKindOfClass:[SKNode class]]) {
+    if (isNodes && !isNodes[nodeIndex]) {
       continue;
     }
-    SKNode *node = (SKNode *)entry;
 
     if (nodeIndex < radiiCount) {
       radius = [_radii[nodeIndex] floatValue];
@@ -231,16 +273,18 @@ typedef NS_ENUM(NSInteger, HLRingLayoutManagerThetasMode) {
       }
     }
 
-    node.position = CGPointMake(_ringPosition.x + radius * (CGFloat)cos(theta),
-                                _ringPosition.y + radius * (CGFloat)sin(theta));
-    if (thetas) {
-      [*thetas addObject:@(theta)];
+    positions[nodeIndex] = CGPointMake(_ringPosition.x + radius * (CGFloat)cos(theta),
+                                       _ringPosition.y + radius * (CGFloat)sin(theta));
+    if (returnThetas) {
+      returnThetas[nodeIndex] = theta;
     }
 
     if (_thetasMode != HLRingLayoutManagerThetasAssigned) {
       theta += thetaIncrement;
     }
   }
+
+  return YES;
 }
 
 @end
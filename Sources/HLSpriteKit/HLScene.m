@@ -9,6 +9,7 @@
 #import "HLScene.h"
 
 #import "HLLog.h"
+#import "SKNode+HLAction.h"
 #import "SKNode+HLGestureTarget.h"
 
 NSString * const HLSceneChildNoCoding = @"HLSceneChildNoCoding";
@@ -33,6 +34,8 @@ static BOOL _sceneAssetsLoaded = NO;
   SKNode *_modalPresentationNode;
 
   NSMutableArray *_sharedGestureRecognizers;
+
+  HLActionRunnerRegistry *_actionRunnerRegistry;
 }
 
 - (instancetype)initWithCoder:(NSCoder *)aDecoder
@@ -41,6 +44,10 @@ static BOOL _sceneAssetsLoaded = NO;
   if (self) {
 
     _gestureTargetHitTestMode = (HLSceneGestureTargetHitTestMode)[aDecoder decodeIntegerForKey:@"gestureTargetHitTestMode"];
+    BOOL enrollsRunnersAutomatically = [aDecoder decodeBoolForKey:@"actionRunnerRegistryEnrollsRunnersAutomatically"];
+    if (enrollsRunnersAutomatically) {
+      [self actionRunnerRegistry].enrollsRunnersAutomatically = YES;
+    }
 
     NSMutableArray *childrenArrayQueue = [NSMutableArray arrayWithObject:self.children];
     NSUInteger a = 0;
@@ -56,6 +63,10 @@ static BOOL _sceneAssetsLoaded = NO;
           continue;
         }
 
+        if (enrollsRunnersAutomatically && [node hlHasActions]) {
+          [node hlSetActionRunnerRegistry:[self actionRunnerRegistry]];
+        }
+
         NSNumber *optionBitsNumber = node.userData[HLSceneChildUserDataKey];
         if (optionBitsNumber == nil) {
           continue;
@@ -116,6 +127,7 @@ static BOOL _sceneAssetsLoaded = NO;
   [super encodeWithCoder:aCoder];
 
   [aCoder encodeInteger:_gestureTargetHitTestMode forKey:@"gestureTargetHitTestMode"];
+  [aCoder encodeBool:_actionRunnerRegistry.enrollsRunnersAutomatically forKey:@"actionRunnerRegistryEnrollsRunnersAutomatically"];
 
   [removedChildren enumerateKeysAndObjectsUsingBlock:^(id key, id object, BOOL *stop){
     SKNode *child = [key nonretainedObjectValue];
@@ -465,6 +477,25 @@ static BOOL _sceneAssetsLoaded = NO;
   }
 }
 
+#pragma mark -
+#pragma mark Action Runners
+
+- (HLActionRunnerRegistry *)actionRunnerRegistry
+{
+  if (!_actionRunnerRegistry) {
+    _actionRunnerRegistry = [[HLActionRunnerRegistry alloc] init];
+  }
+  return _actionRunnerRegistry;
+}
+
+- (void)updateAllRunners:(NSTimeInterval)incrementalTime
+{
+  if (!_actionRunnerRegistry) {
+    return;
+  }
+  [_actionRunnerRegistry updateAllRunners:incrementalTime];
+}
+
 #pragma mark -
 #pragma mark Modal Presentation
 
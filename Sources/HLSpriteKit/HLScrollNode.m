@@ -390,6 +390,19 @@ enum {
   _contentNode.position = [self HL_contentConstrainedPositionX:_contentNode.position.x positionY:_contentNode.position.y scale:constrainedScale];
 }
 
+- (CGRect)visibleContentRect
+{
+  CGPoint contentOffset = self.contentOffset;
+  CGFloat contentScale = self.contentScale;
+  if (contentScale <= 0.0f) {
+    return CGRectNull;
+  }
+  return CGRectMake((_size.width * -_anchorPoint.x - contentOffset.x) / contentScale,
+                    (_size.height * -_anchorPoint.y - contentOffset.y) / contentScale,
+                    _size.width / contentScale,
+                    _size.height / contentScale);
+}
+
 - (void)setContentScale:(CGFloat)contentScale animatedDuration:(NSTimeInterval)duration completion:(void (^)(void))completion
 {
   SKAction *action = [self actionForSetContentScale:contentScale animatedDuration:duration];
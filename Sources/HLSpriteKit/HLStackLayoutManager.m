@@ -10,9 +10,46 @@
 
 #import <TargetConditionals.h>
 
+#import "HLLayoutState.h"
+
 const CGFloat HLStackLayoutManagerEpsilon = 0.001f;
 
+// note: Returns the configured value for the cell at the passed index, where the final
+// configured value is used for all remaining cells.
+static inline CGFloat
+HLStackLayoutManagerCellValue(NSArray *values, NSUInteger valuesCount, NSUInteger index, CGFloat defaultValue)
+{
+  if (valuesCount == 0) {
+    return defaultValue;
+  }
+  NSNumber *valueNumber = values[MIN(index, valuesCount - 1)];
+  return (CGFloat)[valueNumber doubleValue];
+}
+
 @implementation HLStackLayoutManager
+{
+  // note: State for incremental layout (see layoutIncrementally:).  It describes the nodes
+  // last passed to layoutIncrementally:, and is neither encoded nor copied.
+  BOOL _incrementalIsValid;
+  NSUInteger _incrementalCount;
+  NSUInteger _incrementalCapacity;
+  // note: The measured length of each node in the stacking dimension, and the offset of
+  // each cell from the start of the first cell.
+  CGFloat *_incrementalFitLengths;
+  CGFloat *_incrementalCellOffsets;
+  NSMutableIndexSet *_incrementalUnmeasuredIndexes;
+  NSUInteger _incrementalDirtyIndex;
+  // note: The configuration used by the last incremental layout, and the resulting
+  // position of the start of the first cell.  The full stack position is kept, since the
+  // start only reflects its coordinate in the stacking dimension.
+  HLStackLayoutManagerStackDirection _incrementalStackDirection;
+  NSArray *_incrementalCellLengths;
+  NSArray *_incrementalCellAnchorPoints;
+  CGFloat _incrementalCellSeparator;
+  CGFloat _incrementalCellLabelOffsetY;
+  CGPoint _incrementalStackPosition;
+  CGFloat _incrementalStart;
+}
 
 - (instancetype)init
 {
@@ -81,6 +118,12 @@ const CGFloat HLStackLayoutManagerEpsilon = 0.001f;
   return self;
 }
 
+- (void)dealloc
+{
+  free(_incrementalFitLengths);
+  free(_incrementalCellOffsets);
+}
+
 - (void)encodeWithCoder:(NSCoder *)aCoder
 {
   [aCoder encodeInteger:_stackDirection forKey:@"stackDirection"];
@@ -119,42 +162,344 @@ const CGFloat HLStackLayoutManagerEpsilon = 0.001f;
 
 - (void)layout:(NSArray *)nodes
 {
-  [self GL_layout:nodes getCellLengths:nil];
+  [self GL_layout:nodes getCellLengths:nil state:nil];
 }
 
 - (void)layout:(NSArray *)nodes getCellLengths:(NSArray * __autoreleasing *)cellLengths
 {
-  [self GL_layout:nodes getCellLengths:cellLengths];
+  [self GL_layout:nodes getCellLengths:cellLengths state:nil];
+}
+
+- (void)layout:(NSArray *)nodes getState:(HLLayoutState * __autoreleasing *)state
+{
+  [self GL_layout:nodes getCellLengths:nil state:state];
+}
+
+- (void)layoutSizes:(const CGSize *)sizes count:(NSUInteger)count getPositions:(CGPoint *)positions
+{
+  [self GL_layoutSizes:sizes count:count getPositions:positions cellLengths:NULL state:nil];
 }
 
-- (void)GL_layout:(NSArray *)nodes getCellLengths:(NSArray * __autoreleasing *)returnCellLengths
+- (void)layoutSizes:(const CGSize *)sizes
+              count:(NSUInteger)count
+       getPositions:(CGPoint *)positions
+              state:(HLLayoutState * __autoreleasing *)returnState
+{
+  HLLayoutState *state = (returnState ? [self GL_newState] : nil);
+  [self GL_layoutSizes:sizes count:count getPositions:positions cellLengths:NULL state:state];
+  if (returnState) {
+    *returnState = state;
+  }
+}
+
+- (CGFloat)labelOffsetYForNodeAtIndex:(NSUInteger)nodeIndex
+{
+  return _cellLabelOffsetY;
+}
+
+- (void)layoutIncrementally:(NSArray *)nodes
 {
   NSUInteger nodesCount = (nodes ? [nodes count] : 0);
   if (nodesCount == 0) {
+    [self invalidateIncrementalLayout];
     return;
   }
   NSUInteger cellLengthsCount = (_cellLengths ? [_cellLengths count] : 0);
   NSUInteger cellAnchorPointsCount = (_cellAnchorPoints ? [_cellAnchorPoints count] : 0);
 
-  CGFloat (*cellLengthFitFunction)(id);
+  // note: Configuration changes since the last incremental layout determine how much must
+  // be redone.  Changes to cell lengths or stack direction require remeasuring every
+  // node; changes to anything else require only repositioning.
+  BOOL needsMeasureAll = (!_incrementalIsValid
+                          || _incrementalCount != nodesCount
+                          || _incrementalStackDirection != _stackDirection
+                          || !(_incrementalCellLengths == _cellLengths || [_incrementalCellLengths isEqualToArray:_cellLengths]));
+  BOOL needsPositionAll = (needsMeasureAll
+                           || !(_incrementalCellAnchorPoints == _cellAnchorPoints || [_incrementalCellAnchorPoints isEqualToArray:_cellAnchorPoints])
+                           || _incrementalCellSeparator != _cellSeparator
+                           || _incrementalCellLabelOffsetY != _cellLabelOffsetY);
+
+  if (needsMeasureAll) {
+    // note: Fill cells depend on the length of the whole stack, so they cannot be laid out
+    // incrementally.
+    for (NSUInteger c = 0; c < cellLengthsCount; ++c) {
+      if ([_cellLengths[c] doubleValue] < -HLStackLayoutManagerEpsilon) {
+        [self invalidateIncrementalLayout];
+        [self GL_layout:nodes getCellLengths:nil state:nil];
+        return;
+      }
+    }
+    [self GL_reserveIncrementalCapacity:nodesCount];
+    _incrementalCount = nodesCount;
+    if (!_incrementalUnmeasuredIndexes) {
+      _incrementalUnmeasuredIndexes = [NSMutableIndexSet indexSet];
+    }
+    [_incrementalUnmeasuredIndexes removeAllIndexes];
+    [_incrementalUnmeasuredIndexes addIndexesInRange:NSMakeRange(0, nodesCount)];
+    _incrementalDirtyIndex = 0;
+  } else if (_incrementalCellSeparator != _cellSeparator) {
+    _incrementalDirtyIndex = 0;
+  }
+
+  BOOL stackIsHorizontal = (_stackDirection == HLStackLayoutManagerStackRight
+                            || _stackDirection == HLStackLayoutManagerStackLeft);
+
+  // note: Measure only new and resized nodes.
+  CGFloat *fitLengths = _incrementalFitLengths;
+  [_incrementalUnmeasuredIndexes enumerateRangesUsingBlock:^(NSRange range, BOOL *stop){
+    for (NSUInteger nodeIndex = range.location; nodeIndex < NSMaxRange(range); ++nodeIndex) {
+      CGSize size = HLLayoutManagerGetNodeSize(nodes[nodeIndex]);
+      fitLengths[nodeIndex] = (stackIsHorizontal ? size.width : size.height);
+    }
+  }];
+  [_incrementalUnmeasuredIndexes removeAllIndexes];
+
+  // note: Offsets before the first changed cell are still correct.
+  for (NSUInteger nodeIndex = _incrementalDirtyIndex; nodeIndex < nodesCount; ++nodeIndex) {
+    if (nodeIndex == 0) {
+      _incrementalCellOffsets[0] = 0.0f;
+    } else {
+      CGFloat previousCellLength = [self GL_incrementalCellLengthAtIndex:(nodeIndex - 1) cellLengthsCount:cellLengthsCount];
+      _incrementalCellOffsets[nodeIndex] = _incrementalCellOffsets[nodeIndex - 1] + previousCellLength + _cellSeparator;
+    }
+  }
+  CGFloat lastCellLength = [self GL_incrementalCellLengthAtIndex:(nodesCount - 1) cellLengthsCount:cellLengthsCount];
+  _length = _incrementalCellOffsets[nodesCount - 1] + lastCellLength + _stackBorder * 2.0f;
+
+  // note: See GL_layoutSizes:count:getPositions:cellLengths:state: for s.  If it moves (for
+  // instance, because the length changed and the stack is centered), then every node
+  // moves; likewise if the stack position moves perpendicular to the stack, which doesn't
+  // affect s.
+  CGFloat s;
   switch (_stackDirection) {
     case HLStackLayoutManagerStackRight:
+      s = _stackPosition.x - _length * _anchorPoint + _stackBorder;
+      break;
     case HLStackLayoutManagerStackLeft:
-      cellLengthFitFunction = &HLLayoutManagerGetNodeWidth;
+      s = _stackPosition.x + _length * (1.0f - _anchorPoint) - _stackBorder;
       break;
     case HLStackLayoutManagerStackUp:
+      s = _stackPosition.y - _length * _anchorPoint + _stackBorder;
+      break;
     case HLStackLayoutManagerStackDown:
-      cellLengthFitFunction = &HLLayoutManagerGetNodeHeight;
+      s = _stackPosition.y + _length * (1.0f - _anchorPoint) - _stackBorder;
+      break;
+  }
+  if (s != _incrementalStart
+      || _stackPosition.x != _incrementalStackPosition.x
+      || _stackPosition.y != _incrementalStackPosition.y) {
+    needsPositionAll = YES;
+  }
+
+  for (NSUInteger nodeIndex = (needsPositionAll ? 0 : _incrementalDirtyIndex); nodeIndex < nodesCount; ++nodeIndex) {
+    id node = nodes[nodeIndex];
+    if (![node isKindOfClass:[SKNode class]]) {
+      continue;
+    }
+    CGFloat cellLength = [self GL_incrementalCellLengthAtIndex:nodeIndex cellLengthsCount:cellLengthsCount];
+    CGFloat cellAnchorPoint = HLStackLayoutManagerCellValue(_cellAnchorPoints, cellAnchorPointsCount, nodeIndex, 0.5f);
+    CGFloat cellOffset = _incrementalCellOffsets[nodeIndex];
+    CGPoint position;
+    switch (_stackDirection) {
+      case HLStackLayoutManagerStackRight:
+        position = CGPointMake(s + cellOffset + cellLength * cellAnchorPoint, _stackPosition.y);
+        break;
+      case HLStackLayoutManagerStackLeft:
+        position = CGPointMake(s - cellOffset - cellLength * (1.0f - cellAnchorPoint), _stackPosition.y);
+        break;
+      case HLStackLayoutManagerStackUp:
+        position = CGPointMake(_stackPosition.x, s + cellOffset + cellLength * cellAnchorPoint);
+        break;
+      case HLStackLayoutManagerStackDown:
+        position = CGPointMake(_stackPosition.x, s - cellOffset - cellLength * (1.0f - cellAnchorPoint));
+        break;
+    }
+    if ([node isKindOfClass:[SKLabelNode class]]) {
+      position.y += _cellLabelOffsetY;
+    }
+    [(SKNode *)node setPosition:position];
+  }
+
+  _incrementalIsValid = YES;
+  _incrementalDirtyIndex = nodesCount;
+  _incrementalStackDirection = _stackDirection;
+  _incrementalCellLengths = [_cellLengths copy];
+  _incrementalCellAnchorPoints = [_cellAnchorPoints copy];
+  _incrementalCellSeparator = _cellSeparator;
+  _incrementalCellLabelOffsetY = _cellLabelOffsetY;
+  _incrementalStackPosition = _stackPosition;
+  _incrementalStart = s;
+}
+
+- (void)noteNodesInsertedInRange:(NSRange)range
+{
+  if (!_incrementalIsValid || range.length == 0) {
+    return;
+  }
+  if (range.location > _incrementalCount) {
+    [NSException raise:NSRangeException format:@"Inserted range %@ beyond bounds %lu.", NSStringFromRange(range), (unsigned long)_incrementalCount];
+  }
+  [self GL_reserveIncrementalCapacity:(_incrementalCount + range.length)];
+  NSUInteger movedCount = _incrementalCount - range.location;
+  memmove(_incrementalFitLengths + NSMaxRange(range), _incrementalFitLengths + range.location, movedCount * sizeof(CGFloat));
+  memmove(_incrementalCellOffsets + NSMaxRange(range), _incrementalCellOffsets + range.location, movedCount * sizeof(CGFloat));
+  _incrementalCount += range.length;
+  [_incrementalUnmeasuredIndexes shiftIndexesStartingAtIndex:range.location by:(NSInteger)range.length];
+  [_incrementalUnmeasuredIndexes addIndexesInRange:range];
+  _incrementalDirtyIndex = MIN(_incrementalDirtyIndex, range.location);
+}
+
+- (void)noteNodesRemovedInRange:(NSRange)range
+{
+  if (!_incrementalIsValid || range.length == 0) {
+    return;
+  }
+  if (NSMaxRange(range) > _incrementalCount) {
+    [NSException raise:NSRangeException format:@"Removed range %@ beyond bounds %lu.", NSStringFromRange(range), (unsigned long)_incrementalCount];
+  }
+  NSUInteger movedCount = _incrementalCount - NSMaxRange(range);
+  memmove(_incrementalFitLengths + range.location, _incrementalFitLengths + NSMaxRange(range), movedCount * sizeof(CGFloat));
+  memmove(_incrementalCellOffsets + range.location, _incrementalCellOffsets + NSMaxRange(range), movedCount * sizeof(CGFloat));
+  _incrementalCount -= range.length;
+  [_incrementalUnmeasuredIndexes removeIndexesInRange:range];
+  [_incrementalUnmeasuredIndexes shiftIndexesStartingAtIndex:NSMaxRange(range) by:-(NSInteger)range.length];
+  _incrementalDirtyIndex = MIN(_incrementalDirtyIndex, range.location);
+}
+
+- (void)noteNodesResizedInRange:(NSRange)range
+{
+  if (!_incrementalIsValid || range.length == 0) {
+    return;
+  }
+  if (NSMaxRange(range) > _incrementalCount) {
+    [NSException raise:NSRangeException format:@"Resized range %@ beyond bounds %lu.", NSStringFromRange(range), (unsigned long)_incrementalCount];
+  }
+  [_incrementalUnmeasuredIndexes addIndexesInRange:range];
+  _incrementalDirtyIndex = MIN(_incrementalDirtyIndex, range.location);
+}
+
+- (void)invalidateIncrementalLayout
+{
+  _incrementalIsValid = NO;
+  _incrementalCount = 0;
+  _incrementalCellLengths = nil;
+  _incrementalCellAnchorPoints = nil;
+}
+
+- (CGFloat)GL_incrementalCellLengthAtIndex:(NSUInteger)nodeIndex cellLengthsCount:(NSUInteger)cellLengthsCount
+{
+  CGFloat cellLength = HLStackLayoutManagerCellValue(_cellLengths, cellLengthsCount, nodeIndex, 0.0f);
+  if (cellLength > HLStackLayoutManagerEpsilon) {
+    return cellLength;
+  }
+  return _incrementalFitLengths[nodeIndex];
+}
+
+- (void)GL_reserveIncrementalCapacity:(NSUInteger)capacity
+{
+  if (capacity <= _incrementalCapacity) {
+    return;
+  }
+  NSUInteger newCapacity = MAX(capacity, _incrementalCapacity * 2);
+  CGFloat *fitLengths = realloc(_incrementalFitLengths, newCapacity * sizeof(CGFloat));
+  if (fitLengths) {
+    _incrementalFitLengths = fitLengths;
+  }
+  CGFloat *cellOffsets = realloc(_incrementalCellOffsets, newCapacity * sizeof(CGFloat));
+  if (cellOffsets) {
+    _incrementalCellOffsets = cellOffsets;
+  }
+  if (!fitLengths || !cellOffsets) {
+    [NSException raise:NSMallocException format:@"HLStackLayoutManager could not allocate incremental layout state for %lu nodes.", (unsigned long)newCapacity];
+  }
+  _incrementalCapacity = newCapacity;
+}
+
+- (HLLayoutState *)GL_newState
+{
+  // note: The stack is a single unbounded line; cells are along the stacking dimension.
+  BOOL stackIsHorizontal = (_stackDirection == HLStackLayoutManagerStackRight
+                            || _stackDirection == HLStackLayoutManagerStackLeft);
+  HLLayoutState *state = [[HLLayoutState alloc] initWithLineAxis:(stackIsHorizontal ? HLLayoutStateAxisY : HLLayoutStateAxisX)];
+  [state addLineFrom:-CGFLOAT_MAX to:CGFLOAT_MAX];
+  return state;
+}
+
+- (void)GL_layout:(NSArray *)nodes
+   getCellLengths:(NSArray * __autoreleasing *)returnCellLengths
+            state:(HLLayoutState * __autoreleasing *)returnState
+{
+  NSUInteger nodesCount = (nodes ? [nodes count] : 0);
+  HLLayoutState *state = (returnState ? [self GL_newState] : nil);
+  if (returnState) {
+    *returnState = state;
+  }
+  if (nodesCount == 0) {
+    return;
+  }
+
+  CGSize *sizes = (CGSize *)malloc(nodesCount * sizeof(CGSize));
+  CGPoint *positions = (CGPoint *)malloc(nodesCount * sizeof(CGPoint));
+  CGFloat *finalCellLengths = (returnCellLengths ? (CGFloat *)malloc(nodesCount * sizeof(CGFloat)) : NULL);
+  HLLayoutManagerGetNodeSizes(nodes, sizes);
+  [self GL_layoutSizes:sizes count:nodesCount getPositions:positions cellLengths:finalCellLengths state:state];
+
+  if (returnCellLengths) {
+    NSMutableArray *rcl = [NSMutableArray array];
+    for (NSUInteger nodeIndex = 0; nodeIndex < nodesCount; ++nodeIndex) {
+      [rcl addObject:[NSNumber numberWithDouble:finalCellLengths[nodeIndex]]];
+    }
+    *returnCellLengths = rcl;
+  }
+
+  for (NSUInteger nodeIndex = 0; nodeIndex < nodesCount; ++nodeIndex) {
+    id node = nodes[nodeIndex];
+    if (![node isKindOfClass:[SKNode class]]) {
+      continue;
+    }
+    CGPoint position = positions[nodeIndex];
+    if ([node isKindOfClass:[SKLabelNode class]]) {
+      position.y += _cellLabelOffsetY;
+    }
+    [(SKNode *)node setPosition:position];
+  }
+
+  free(sizes);
+  free(positions);
+  free(finalCellLengths);
+}
+
+- (void)GL_layoutSizes:(const CGSize *)sizes
+                 count:(NSUInteger)count
+          getPositions:(CGPoint *)positions
+           cellLengths:(CGFloat *)returnCellLengths
+                 state:(HLLayoutState *)state
+{
+  if (count == 0) {
+    return;
+  }
+  NSUInteger cellLengthsCount = (_cellLengths ? [_cellLengths count] : 0);
+  NSUInteger cellAnchorPointsCount = (_cellAnchorPoints ? [_cellAnchorPoints count] : 0);
+
+  BOOL stackIsHorizontal;
+  switch (_stackDirection) {
+    case HLStackLayoutManagerStackRight:
+    case HLStackLayoutManagerStackLeft:
+      stackIsHorizontal = YES;
+      break;
+    case HLStackLayoutManagerStackUp:
+    case HLStackLayoutManagerStackDown:
+      stackIsHorizontal = NO;
       break;
   }
 
   // First pass: Calculate fixed-size lengths, and sum fill-length ratios.
-  CGFloat *finalCellLengths = (CGFloat *)malloc(nodesCount * sizeof(CGFloat));
+  CGFloat *finalCellLengths = (CGFloat *)malloc(count * sizeof(CGFloat));
   CGFloat lengthTotalFixed = 0.0f;
   CGFloat lengthFillRatioSum = 0.0f;
   {
     CGFloat cellLength = 0.0f;
-    for (NSUInteger nodeIndex = 0; nodeIndex < nodesCount; ++nodeIndex) {
+    for (NSUInteger nodeIndex = 0; nodeIndex < count; ++nodeIndex) {
       if (nodeIndex < cellLengthsCount) {
         NSNumber *cellLengthNumber = _cellLengths[nodeIndex];
         cellLength = (CGFloat)[cellLengthNumber doubleValue];
@@ -168,24 +513,20 @@ const CGFloat HLStackLayoutManagerEpsilon = 0.001f;
       } else {
         // note: Leave cellLength zero so subsequent nodes reusing this cellLength
         // get recalculated.
-        CGFloat cellLengthFit = cellLengthFitFunction(nodes[nodeIndex]);
+        CGFloat cellLengthFit = (stackIsHorizontal ? sizes[nodeIndex].width : sizes[nodeIndex].height);
         lengthTotalFixed += cellLengthFit;
         finalCellLengths[nodeIndex] = cellLengthFit;
       }
     }
   }
-  CGFloat lengthTotalConstant = _cellSeparator * (nodesCount - 1) + _stackBorder * 2.0f;
+  CGFloat lengthTotalConstant = _cellSeparator * (count - 1) + _stackBorder * 2.0f;
   CGFloat lengthTotalFill = 0.0f;
   if (lengthFillRatioSum < 0.0 && _constrainedLength > (lengthTotalFixed + lengthTotalConstant)) {
     lengthTotalFill = _constrainedLength - lengthTotalFixed - lengthTotalConstant;
   }
   _length = lengthTotalFixed + lengthTotalFill + lengthTotalConstant;
   if (returnCellLengths) {
-    NSMutableArray *rcl = [NSMutableArray array];
-    for (NSUInteger nodeIndex = 0; nodeIndex < nodesCount; ++nodeIndex) {
-      [rcl addObject:[NSNumber numberWithDouble:finalCellLengths[nodeIndex]]];
-    }
-    *returnCellLengths = rcl;
+    memcpy(returnCellLengths, finalCellLengths, count * sizeof(CGFloat));
   }
 
   // note: s is the absolute position of the edge of the cell closest to the stack start,
@@ -208,8 +549,7 @@ const CGFloat HLStackLayoutManagerEpsilon = 0.001f;
   }
   CGFloat cellAnchorPoint = 0.5f;
 
-  for (NSUInteger nodeIndex = 0; nodeIndex < nodesCount; ++nodeIndex) {
-    id node = nodes[nodeIndex];
+  for (NSUInteger nodeIndex = 0; nodeIndex < count; ++nodeIndex) {
 
     CGFloat cellLength = finalCellLengths[nodeIndex];
     if (cellLength < -HLStackLayoutManagerEpsilon) {
@@ -221,38 +561,25 @@ const CGFloat HLStackLayoutManagerEpsilon = 0.001f;
       cellAnchorPoint = (CGFloat)[cellAnchorPointValue doubleValue];
     }
 
-    CGFloat cellOffsetY = 0.0f;
-    if ([node isKindOfClass:[SKLabelNode class]]) {
-      cellOffsetY = _cellLabelOffsetY;
-    }
-
     switch (_stackDirection) {
       case HLStackLayoutManagerStackRight:
-        if ([node isKindOfClass:[SKNode class]]) {
-          [(SKNode *)node setPosition:CGPointMake(s + cellLength * cellAnchorPoint,
-                                                  _stackPosition.y + cellOffsetY)];
-        }
+        positions[nodeIndex] = CGPointMake(s + cellLength * cellAnchorPoint, _stackPosition.y);
+        [state addCellFrom:s to:(s + cellLength)];
         s = s + cellLength + _cellSeparator;
         break;
       case HLStackLayoutManagerStackLeft:
-        if ([node isKindOfClass:[SKNode class]]) {
-          [(SKNode *)node setPosition:CGPointMake(s - cellLength * (1.0f - cellAnchorPoint),
-                                                  _stackPosition.y + cellOffsetY)];
-        }
+        positions[nodeIndex] = CGPointMake(s - cellLength * (1.0f - cellAnchorPoint), _stackPosition.y);
+        [state addCellFrom:(s - cellLength) to:s];
         s = s - cellLength - _cellSeparator;
         break;
       case HLStackLayoutManagerStackUp:
-        if ([node isKindOfClass:[SKNode class]]) {
-          [(SKNode *)node setPosition:CGPointMake(_stackPosition.x,
-                                                  s + cellLength * cellAnchorPoint + cellOffsetY)];
-        }
+        positions[nodeIndex] = CGPointMake(_stackPosition.x, s + cellLength * cellAnchorPoint);
+        [state addCellFrom:s to:(s + cellLength)];
         s = s + cellLength + _cellSeparator;
         break;
       case HLStackLayoutManagerStackDown:
-        if ([node isKindOfClass:[SKNode class]]) {
-          [(SKNode *)node setPosition:CGPointMake(_stackPosition.x,
-                                                  s - cellLength * (1.0f - cellAnchorPoint) + cellOffsetY)];
-        }
+        positions[nodeIndex] = CGPointMake(_stackPosition.x, s - cellLength * (1.0f - cellAnchorPoint));
+        [state addCellFrom:(s - cellLength) to:s];
         s = s - cellLength - _cellSeparator;
         break;
     }
@@ -276,73 +603,33 @@ HLStackLayoutManagerCellContainingPoint(NSArray *nodes,
   NSUInteger cellLengthsCount = (cellLengths ? [cellLengths count] : 0);
   NSUInteger cellAnchorPointsCount = (cellAnchorPoints ? [cellAnchorPoints count] : 0);
 
-  SKNode *pointNode = [SKNode node];
-  pointNode.position = CGPointMake(point, point);
-
   // note: Could do the binary search by copying position data from the nodes into an
   // array, but that would introduce an order-N operation, so in principle it seems
-  // wrongheaded.
-
-  // note: NSArray considers "ascending" direction to be from the first element of the
-  // sorted array to the last element of the sorted array, so for left and down, the
-  // descending numerical position is considered "ascending".
-  NSComparisonResult (^comparator)(SKNode *node1, SKNode *node2) = nil;
-  switch (stackDirection) {
-    case HLStackLayoutManagerStackRight:
-      comparator = ^NSComparisonResult(SKNode *node1, SKNode *node2){
-        if (node1.position.x < node2.position.x) {
-          return NSOrderedAscending;
-        } else if (node1.position.x > node2.position.x) {
-          return NSOrderedDescending;
-        } else {
-          return NSOrderedSame;
-        }
-      };
-      break;
-    case HLStackLayoutManagerStackLeft:
-      comparator = ^NSComparisonResult(SKNode *node1, SKNode *node2){
-        if (node1.position.x > node2.position.x) {
-          return NSOrderedAscending;
-        } else if (node1.position.x < node2.position.x) {
-          return NSOrderedDescending;
-        } else {
-          return NSOrderedSame;
-        }
-      };
-      break;
-    case HLStackLayoutManagerStackUp:
-      comparator = ^NSComparisonResult(SKNode *node1, SKNode *node2){
-        if (node1.position.y < node2.position.y) {
-          return NSOrderedAscending;
-        } else if (node1.position.y > node2.position.y) {
-          return NSOrderedDescending;
-        } else {
-          return NSOrderedSame;
-        }
-      };
-      break;
-    case HLStackLayoutManagerStackDown:
-      comparator = ^NSComparisonResult(SKNode *node1, SKNode *node2){
-        if (node1.position.y > node2.position.y) {
-          return NSOrderedAscending;
-        } else if (node1.position.y < node2.position.y) {
-          return NSOrderedDescending;
-        } else {
-          return NSOrderedSame;
-        }
-      };
-      break;
+  // wrongheaded.  (For that, and without node access, see HLLayoutState.)
+
+  // note: Find the first node whose position is beyond the point in the stacking
+  // direction: for right and up, greater than the point, and for left and down, smaller.
+  BOOL stackIsHorizontal = (stackDirection == HLStackLayoutManagerStackRight
+                            || stackDirection == HLStackLayoutManagerStackLeft);
+  BOOL stackIsDecreasing = (stackDirection == HLStackLayoutManagerStackLeft
+                            || stackDirection == HLStackLayoutManagerStackDown);
+  NSUInteger low = 0;
+  NSUInteger high = nodesCount;
+  while (low < high) {
+    NSUInteger middle = low + (high - low) / 2;
+    CGPoint middlePosition = [(SKNode *)nodes[middle] position];
+    CGFloat middleCoordinate = (stackIsHorizontal ? middlePosition.x : middlePosition.y);
+    BOOL isBeyond = (stackIsDecreasing ? middleCoordinate < point : middleCoordinate > point);
+    if (isBeyond) {
+      high = middle;
+    } else {
+      low = middle + 1;
+    }
   }
+  NSUInteger nextNodeIndex = low;
 
-  NSUInteger nextNodeIndex = [nodes indexOfObject:pointNode
-                                    inSortedRange:NSMakeRange(0, nodesCount)
-                                          options:NSBinarySearchingInsertionIndex
-                                  usingComparator:comparator];
-
-  // note: nextNodeIndex is the node with array position greater than pointNode; for right
-  // and up, the next-node position will be greater, and for left and down the next-node
-  // position will be smaller.  The node that contains the point is either that node or
-  // the previous one (in the array).  Using [begin, end) range terminology.
+  // note: The node that contains the point is either the next node or the previous one
+  // (in the array).  Using [begin, end) range terminology.
   NSUInteger checkNodeIndexBegin = (nextNodeIndex > 0 ? nextNodeIndex - 1 : nextNodeIndex);
   NSUInteger checkNodeIndexEnd = (nextNodeIndex < nodesCount ? nextNodeIndex + 1 : nextNodeIndex);
   for (NSUInteger nodeIndex = checkNodeIndexBegin; nodeIndex < checkNodeIndexEnd; ++nodeIndex) {
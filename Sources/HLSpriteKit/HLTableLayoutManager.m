@@ -10,6 +10,8 @@
 
 #import <TargetConditionals.h>
 
+#import "HLLayoutState.h"
+
 const CGFloat HLTableLayoutManagerEpsilon = 0.001f;
 
 @implementation HLTableLayoutManager
@@ -138,17 +140,96 @@ const CGFloat HLTableLayoutManagerEpsilon = 0.001f;
 
 - (void)layout:(NSArray *)nodes
 {
-  [self GL_layout:nodes getColumnWidths:nil rowHeights:nil];
+  [self GL_layout:nodes getColumnWidths:nil rowHeights:nil state:nil];
 }
 
 - (void)layout:(NSArray *)nodes getColumnWidths:(NSArray * __autoreleasing *)columnWidths rowHeights:(NSArray * __autoreleasing *)rowHeights
 {
-  [self GL_layout:nodes getColumnWidths:columnWidths rowHeights:rowHeights];
+  [self GL_layout:nodes getColumnWidths:columnWidths rowHeights:rowHeights state:nil];
 }
 
-- (void)GL_layout:(NSArray *)nodes getColumnWidths:(NSArray * __autoreleasing *)returnColumnWidths rowHeights:(NSArray * __autoreleasing *)returnRowHeights
+- (void)layout:(NSArray *)nodes getState:(HLLayoutState * __autoreleasing *)state
+{
+  [self GL_layout:nodes getColumnWidths:nil rowHeights:nil state:state];
+}
+
+- (void)layoutSizes:(const CGSize *)sizes count:(NSUInteger)count getPositions:(CGPoint *)positions
+{
+  [self GL_layoutSizes:sizes count:count getPositions:positions columnWidths:nil rowHeights:nil state:nil];
+}
+
+- (void)layoutSizes:(const CGSize *)sizes
+              count:(NSUInteger)count
+       getPositions:(CGPoint *)positions
+              state:(HLLayoutState * __autoreleasing *)returnState
+{
+  HLLayoutState *state = (returnState ? [[HLLayoutState alloc] initWithLineAxis:HLLayoutStateAxisY] : nil);
+  [self GL_layoutSizes:sizes count:count getPositions:positions columnWidths:nil rowHeights:nil state:state];
+  if (returnState) {
+    *returnState = state;
+  }
+}
+
+- (CGFloat)labelOffsetYForNodeAtIndex:(NSUInteger)nodeIndex
+{
+  NSUInteger rowLabelOffsetYsCount = [_rowLabelOffsetYs count];
+  if (rowLabelOffsetYsCount == 0) {
+    return 0.0f;
+  }
+  // note: With no column count, all nodes are in the first row.
+  NSUInteger row = (_columnCount > 0 ? nodeIndex / _columnCount : 0);
+  NSNumber *labelOffsetYNumber = _rowLabelOffsetYs[MIN(row, rowLabelOffsetYsCount - 1)];
+  return (CGFloat)[labelOffsetYNumber doubleValue];
+}
+
+- (void)GL_layout:(NSArray *)nodes
+  getColumnWidths:(NSArray * __autoreleasing *)returnColumnWidths
+       rowHeights:(NSArray * __autoreleasing *)returnRowHeights
+            state:(HLLayoutState * __autoreleasing *)returnState
 {
   NSUInteger nodesCount = [nodes count];
+  // note: Rows are lines, and the columns of each row are its cells.
+  HLLayoutState *state = (returnState ? [[HLLayoutState alloc] initWithLineAxis:HLLayoutStateAxisY] : nil);
+  if (returnState) {
+    *returnState = state;
+  }
+  if (nodesCount == 0) {
+    return;
+  }
+
+  CGSize *sizes = (CGSize *)malloc(nodesCount * sizeof(CGSize));
+  CGPoint *positions = (CGPoint *)malloc(nodesCount * sizeof(CGPoint));
+  HLLayoutManagerGetNodeSizes(nodes, sizes);
+  [self GL_layoutSizes:sizes
+                 count:nodesCount
+          getPositions:positions
+          columnWidths:returnColumnWidths
+            rowHeights:returnRowHeights
+                 state:state];
+
+  for (NSUInteger nodeIndex = 0; nodeIndex < nodesCount; ++nodeIndex) {
+    id node = nodes[nodeIndex];
+    if (![node isKindOfClass:[SKNode class]]) {
+      continue;
+    }
+    CGPoint position = positions[nodeIndex];
+    if ([node isKindOfClass:[SKLabelNode class]]) {
+      position.y += [self labelOffsetYForNodeAtIndex:nodeIndex];
+    }
+    [(SKNode *)node setPosition:position];
+  }
+
+  free(sizes);
+  free(positions);
+}
+
+- (void)GL_layoutSizes:(const CGSize *)sizes
+                 count:(NSUInteger)nodesCount
+          getPositions:(CGPoint *)positions
+          columnWidths:(NSArray * __autoreleasing *)returnColumnWidths
+            rowHeights:(NSArray * __autoreleasing *)returnRowHeights
+                 state:(HLLayoutState *)state
+{
   if (nodesCount == 0) {
     return;
   }
@@ -159,7 +240,6 @@ const CGFloat HLTableLayoutManagerEpsilon = 0.001f;
   NSUInteger columnWidthsCount = [_columnWidths count];
   NSUInteger columnAnchorPointsCount = [_columnAnchorPoints count];
   NSUInteger rowHeightsCount = [_rowHeights count];
-  NSUInteger rowLabelOffsetYsCount = [_rowLabelOffsetYs count];
 
   _rowCount = (nodesCount - 1) / columnCount + 1;
   // note: Analytically this is always false.  But the check is here for the sake of the
@@ -192,8 +272,7 @@ const CGFloat HLTableLayoutManagerEpsilon = 0.001f;
           if (nodeIndex >= nodesCount) {
             break;
           }
-          id node = nodes[nodeIndex];
-          CGFloat nodeWidth = HLLayoutManagerGetNodeWidth(node);
+          CGFloat nodeWidth = sizes[nodeIndex].width;
           if (nodeWidth > cellWidthMax) {
             cellWidthMax = nodeWidth;
           }
@@ -241,8 +320,7 @@ const CGFloat HLTableLayoutManagerEpsilon = 0.001f;
           if (nodeIndex >= nodesCount) {
             break;
           }
-          id node = nodes[nodeIndex];
-          CGFloat nodeHeight = HLLayoutManagerGetNodeHeight(node);
+          CGFloat nodeHeight = sizes[nodeIndex].height;
           if (nodeHeight > cellHeightMax) {
             cellHeightMax = nodeHeight;
           }
@@ -285,26 +363,19 @@ const CGFloat HLTableLayoutManagerEpsilon = 0.001f;
   }
 
   // note: x and y track the upper left corner of each cell.
-  NSEnumerator *nodesEnumerator = [nodes objectEnumerator];
   CGFloat cellY = _size.height * (1.0f - _anchorPoint.y) - _tableBorder + _tablePosition.y;
   CGFloat startCellX = _size.width * -1.0f * _anchorPoint.x + _tableBorder + _tablePosition.x;
-  CGFloat labelOffsetY = 0.0f;
-  id node = nil;
+  NSUInteger nodeIndex = 0;
   for (NSUInteger row = 0; row < _rowCount; ++row) {
 
     CGFloat cellHeight = rowHeights[row];
-
-    if (row < rowLabelOffsetYsCount) {
-      NSNumber *labelOffsetYNumber = _rowLabelOffsetYs[row];
-      labelOffsetY = (CGFloat)[labelOffsetYNumber doubleValue];
-    }
+    [state addLineFrom:cellY to:(cellY - cellHeight)];
 
     CGFloat cellX = startCellX;
     CGPoint cellAnchorPoint = CGPointMake(0.5f, 0.5f);
     for (NSUInteger column = 0; column < columnCount; ++column) {
 
-      node = [nodesEnumerator nextObject];
-      if (!node) {
+      if (nodeIndex >= nodesCount) {
         break;
       }
 
@@ -319,22 +390,14 @@ const CGFloat HLTableLayoutManagerEpsilon = 0.001f;
 #endif
       }
 
-      if ([node isKindOfClass:[SKNode class]]) {
-        if ([node isKindOfClass:[SKLabelNode class]]) {
-          [(SKNode *)node setPosition:CGPointMake(cellX + cellWidth * cellAnchorPoint.x,
-                                                  cellY - cellHeight * (1.0f - cellAnchorPoint.y) + labelOffsetY)];
-        } else {
-          [(SKNode *)node setPosition:CGPointMake(cellX + cellWidth * cellAnchorPoint.x,
-                                                  cellY - cellHeight * (1.0f - cellAnchorPoint.y))];
-        }
-      }
+      positions[nodeIndex] = CGPointMake(cellX + cellWidth * cellAnchorPoint.x,
+                                         cellY - cellHeight * (1.0f - cellAnchorPoint.y));
+      [state addCellFrom:cellX to:(cellX + cellWidth)];
+      ++nodeIndex;
 
       cellX = cellX + cellWidth + _columnSeparator;
     }
 
-    if (!node) {
-      break;
-    }
     cellY = cellY - cellHeight - _rowSeparator;
   }
 
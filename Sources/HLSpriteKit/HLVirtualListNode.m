@@ -0,0 +1,359 @@
+//
+//  HLVirtualListNode.m
+//  HLSpriteKit
+//
+//  Created by Karl Voskuil on 10/16/26.
+//  Copyright © 2026 Hilo Games. All rights reserved.
+//
+
+#import "HLVirtualListNode.h"
+
+#import "HLLayoutState.h"
+#import "HLScrollNode.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+enum {
+  HLVirtualListNodeZPositionLayerItems = 0,
+  HLVirtualListNodeZPositionLayerCount
+};
+
+@implementation HLVirtualListNode
+{
+  BOOL _layoutManagerReturnsState;
+  BOOL _layoutManagerOffsetsLabels;
+  CGSize *_itemSizes;
+  CGPoint *_itemPositions;
+  CGPoint *_itemAnchorPoints;
+  NSUInteger _itemCapacity;
+  HLLayoutState *_layoutState;
+  NSMutableIndexSet *_visibleItemIndexes;
+  NSMutableDictionary *_visibleNodes;
+  NSMutableArray *_reusableNodes;
+}
+
+- (instancetype)init
+{
+  return [self initWithLayoutManager:nil];
+}
+
+- (instancetype)initWithLayoutManager:(id <HLLayoutManager>)layoutManager
+{
+  self = [super init];
+  if (self) {
+    [self HL_initCommon];
+    self.layoutManager = layoutManager;
+  }
+  return self;
+}
+
+- (instancetype)initWithCoder:(NSCoder *)aDecoder
+{
+  self = [super initWithCoder:aDecoder];
+  if (self) {
+    [self HL_initCommon];
+    _dataSource = [aDecoder decodeObjectForKey:@"dataSource"];
+    self.layoutManager = [aDecoder decodeObjectForKey:@"layoutManager"];
+    _prefetchMargin = (CGFloat)[aDecoder decodeDoubleForKey:@"prefetchMargin"];
+    // note: Item nodes belong to the data source, and are recreated by reloadData.
+    [self removeAllChildren];
+  }
+  return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{
+  [super encodeWithCoder:aCoder];
+  [aCoder encodeConditionalObject:_dataSource forKey:@"dataSource"];
+  [aCoder encodeObject:_layoutManager forKey:@"layoutManager"];
+  [aCoder encodeDouble:_prefetchMargin forKey:@"prefetchMargin"];
+}
+
+- (instancetype)copyWithZone:(NSZone *)zone
+{
+  [NSException raise:@"HLCopyingNotImplemented" format:@"Copying not implemented for this descendant of an NSCopying parent."];
+  return nil;
+}
+
+- (void)dealloc
+{
+  free(_itemSizes);
+  free(_itemPositions);
+  free(_itemAnchorPoints);
+}
+
+- (void)setZPositionScale:(CGFloat)zPositionScale
+{
+  [super setZPositionScale:zPositionScale];
+  for (SKNode *node in [_visibleNodes objectEnumerator]) {
+    [self HL_layoutZForNode:node];
+  }
+}
+
+#pragma mark -
+#pragma mark Providing Items
+
+- (void)reloadData
+{
+  [self HL_recycleItemsAtIndexes:[_visibleItemIndexes copy]];
+
+  id <HLVirtualListNodeDataSource> dataSource = _dataSource;
+  NSUInteger itemCount = (dataSource ? [dataSource numberOfItemsInVirtualListNode:self] : 0);
+  [self HL_reserveItemCapacity:itemCount];
+  _itemCount = itemCount;
+  for (NSUInteger i = 0; i < itemCount; ++i) {
+    _itemSizes[i] = [dataSource virtualListNode:self sizeForItemAtIndex:i];
+  }
+  BOOL dataSourceReturnsAnchorPoints = [dataSource respondsToSelector:@selector(virtualListNode:anchorPointForItemAtIndex:)];
+  for (NSUInteger i = 0; i < itemCount; ++i) {
+    _itemAnchorPoints[i] = (dataSourceReturnsAnchorPoints ? [dataSource virtualListNode:self anchorPointForItemAtIndex:i] : CGPointMake(0.5f, 0.5f));
+  }
+  // note: Layout managers leave positions of items they do not lay out unchanged.
+  if (itemCount > 0) {
+    memset(_itemPositions, 0, itemCount * sizeof(CGPoint));
+  }
+
+  _layoutState = nil;
+  if (_layoutManager && itemCount > 0) {
+    if (_layoutManagerReturnsState) {
+      HLLayoutState *layoutState = nil;
+      [_layoutManager layoutSizes:_itemSizes count:itemCount getPositions:_itemPositions state:&layoutState];
+      _layoutState = layoutState;
+    } else {
+      [_layoutManager layoutSizes:_itemSizes count:itemCount getPositions:_itemPositions];
+    }
+  }
+
+  [self HL_updateVisibleItems];
+}
+
+- (SKNode *)dequeueReusableNode
+{
+  SKNode *node = [_reusableNodes lastObject];
+  if (node) {
+    [_reusableNodes removeLastObject];
+  }
+  return node;
+}
+
+#pragma mark -
+#pragma mark Configuring Layout
+
+- (void)setLayoutManager:(id <HLLayoutManager>)layoutManager
+{
+  if (layoutManager && ![layoutManager respondsToSelector:@selector(layoutSizes:count:getPositions:)]) {
+    [NSException raise:@"HLVirtualListNodeLayoutManagerUnsupported"
+                format:@"Layout manager %@ does not implement layoutSizes:count:getPositions:.", layoutManager];
+  }
+  _layoutManager = layoutManager;
+  _layoutManagerReturnsState = [layoutManager respondsToSelector:@selector(layoutSizes:count:getPositions:state:)];
+  _layoutManagerOffsetsLabels = [layoutManager respondsToSelector:@selector(labelOffsetYForNodeAtIndex:)];
+}
+
+#pragma mark -
+#pragma mark Updating the Visible Area
+
+- (void)updateVisibleRect:(CGRect)rect
+{
+  if (CGRectEqualToRect(rect, _visibleRect)) {
+    return;
+  }
+  _visibleRect = rect;
+  [self HL_updateVisibleItems];
+}
+
+- (void)updateForScrollNode:(HLScrollNode *)scrollNode
+{
+  CGRect rect = [scrollNode visibleContentRect];
+  SKNode *contentNode = scrollNode.contentNode;
+  if (!CGRectIsNull(rect) && contentNode && contentNode != self) {
+    // note: Converts corners only, so rotation between the content node and this node is
+    // not supported.
+    CGPoint lowerLeft = [self convertPoint:rect.origin fromNode:contentNode];
+    CGPoint upperRight = [self convertPoint:CGPointMake(CGRectGetMaxX(rect), CGRectGetMaxY(rect)) fromNode:contentNode];
+    rect = CGRectStandardize(CGRectMake(lowerLeft.x, lowerLeft.y, upperRight.x - lowerLeft.x, upperRight.y - lowerLeft.y));
+  }
+  [self updateVisibleRect:rect];
+}
+
+#pragma mark -
+#pragma mark Accessing Items
+
+- (NSIndexSet *)visibleItemIndexes
+{
+  return [_visibleItemIndexes copy];
+}
+
+- (SKNode *)nodeForItemAtIndex:(NSUInteger)itemIndex
+{
+  return _visibleNodes[@(itemIndex)];
+}
+
+- (CGPoint)positionOfItemAtIndex:(NSUInteger)itemIndex
+{
+  if (itemIndex >= _itemCount) {
+    [NSException raise:NSRangeException format:@"Item index %lu beyond bounds %lu.", (unsigned long)itemIndex, (unsigned long)_itemCount];
+  }
+  return _itemPositions[itemIndex];
+}
+
+- (NSUInteger)itemContainingPoint:(CGPoint)location
+{
+  if (_layoutState) {
+    NSUInteger cellIndex = [_layoutState cellContainingPoint:location];
+    if (cellIndex >= _itemCount) {
+      return NSNotFound;
+    }
+    return cellIndex;
+  }
+  for (NSUInteger i = 0; i < _itemCount; ++i) {
+    if (CGRectContainsPoint([self HL_frameOfItemAtIndex:i], location)) {
+      return i;
+    }
+  }
+  return NSNotFound;
+}
+
+#pragma mark -
+#pragma mark Private
+
+- (void)HL_initCommon
+{
+  _visibleRect = CGRectNull;
+  _visibleItemIndexes = [NSMutableIndexSet indexSet];
+  _visibleNodes = [NSMutableDictionary dictionary];
+  _reusableNodes = [NSMutableArray array];
+}
+
+- (void)HL_reserveItemCapacity:(NSUInteger)itemCapacity
+{
+  if (itemCapacity <= _itemCapacity) {
+    return;
+  }
+  CGSize *itemSizes = realloc(_itemSizes, itemCapacity * sizeof(CGSize));
+  CGPoint *itemPositions = realloc(_itemPositions, itemCapacity * sizeof(CGPoint));
+  CGPoint *itemAnchorPoints = realloc(_itemAnchorPoints, itemCapacity * sizeof(CGPoint));
+  if (itemSizes) {
+    _itemSizes = itemSizes;
+  }
+  if (itemPositions) {
+    _itemPositions = itemPositions;
+  }
+  if (itemAnchorPoints) {
+    _itemAnchorPoints = itemAnchorPoints;
+  }
+  if (!itemSizes || !itemPositions || !itemAnchorPoints) {
+    [NSException raise:NSMallocException format:@"HLVirtualListNode could not allocate storage for %lu items.", (unsigned long)itemCapacity];
+  }
+  _itemCapacity = itemCapacity;
+}
+
+- (CGRect)HL_frameOfItemAtIndex:(NSUInteger)itemIndex
+{
+  // note: Label nodes are offset by the layout manager so that they are visually centered
+  // on their calculated positions, and so their data source should report the default
+  // anchor point of (0.5, 0.5).
+  CGSize size = _itemSizes[itemIndex];
+  CGPoint position = _itemPositions[itemIndex];
+  CGPoint anchorPoint = _itemAnchorPoints[itemIndex];
+  return CGRectMake(position.x - size.width * anchorPoint.x, position.y - size.height * anchorPoint.y, size.width, size.height);
+}
+
+- (NSIndexSet *)HL_itemIndexesIntersectingRect:(CGRect)rect
+{
+  if (CGRectIsNull(rect) || _itemCount == 0) {
+    return [NSIndexSet indexSet];
+  }
+  if (_layoutState) {
+    NSMutableIndexSet *itemIndexes = [[_layoutState cellIndexesIntersectingRect:rect] mutableCopy];
+    if (_layoutState.cellCount > _itemCount) {
+      [itemIndexes removeIndexesInRange:NSMakeRange(_itemCount, _layoutState.cellCount - _itemCount)];
+    }
+    return itemIndexes;
+  }
+  NSMutableIndexSet *itemIndexes = [NSMutableIndexSet indexSet];
+  for (NSUInteger i = 0; i < _itemCount; ++i) {
+    if (CGRectIntersectsRect([self HL_frameOfItemAtIndex:i], rect)) {
+      [itemIndexes addIndex:i];
+    }
+  }
+  return itemIndexes;
+}
+
+- (void)HL_updateVisibleItems
+{
+  CGRect materializedRect = _visibleRect;
+  if (!CGRectIsNull(materializedRect)) {
+    materializedRect = CGRectInset(materializedRect, -_prefetchMargin, -_prefetchMargin);
+  }
+  NSIndexSet *itemIndexes = [self HL_itemIndexesIntersectingRect:materializedRect];
+
+  // note: Recycle before materializing, so that nodes leaving the visible area can be
+  // reused for those entering it.
+  NSMutableIndexSet *leavingItemIndexes = [_visibleItemIndexes mutableCopy];
+  [leavingItemIndexes removeIndexes:itemIndexes];
+  [self HL_recycleItemsAtIndexes:leavingItemIndexes];
+
+  NSMutableIndexSet *enteringItemIndexes = [itemIndexes mutableCopy];
+  [enteringItemIndexes removeIndexes:_visibleItemIndexes];
+  if ([enteringItemIndexes count] == 0) {
+    return;
+  }
+  id <HLVirtualListNodeDataSource> dataSource = _dataSource;
+  if (!dataSource) {
+    return;
+  }
+  [enteringItemIndexes enumerateIndexesUsingBlock:^(NSUInteger itemIndex, BOOL *stop){
+    SKNode *node = [dataSource virtualListNode:self nodeForItemAtIndex:itemIndex];
+    if (!node) {
+      return;
+    }
+    CGPoint position = self->_itemPositions[itemIndex];
+    if (self->_layoutManagerOffsetsLabels && [node isKindOfClass:[SKLabelNode class]]) {
+      position.y += [self->_layoutManager labelOffsetYForNodeAtIndex:itemIndex];
+    }
+    node.position = position;
+    [self HL_layoutZForNode:node];
+    if (node.parent != self) {
+      [node removeFromParent];
+      [self addChild:node];
+    }
+    self->_visibleNodes[@(itemIndex)] = node;
+    [self->_visibleItemIndexes addIndex:itemIndex];
+  }];
+}
+
+- (void)HL_recycleItemsAtIndexes:(NSIndexSet *)itemIndexes
+{
+  if ([itemIndexes count] == 0) {
+    return;
+  }
+  id <HLVirtualListNodeDataSource> dataSource = _dataSource;
+  BOOL dataSourceRespondsToDidEndDisplaying = [dataSource respondsToSelector:@selector(virtualListNode:didEndDisplayingNode:forItemAtIndex:)];
+  [itemIndexes enumerateIndexesUsingBlock:^(NSUInteger itemIndex, BOOL *stop){
+    NSNumber *key = @(itemIndex);
+    SKNode *node = self->_visibleNodes[key];
+    [self->_visibleNodes removeObjectForKey:key];
+    [self->_visibleItemIndexes removeIndex:itemIndex];
+    if (!node) {
+      return;
+    }
+    [node removeFromParent];
+    if (dataSourceRespondsToDidEndDisplaying) {
+      [dataSource virtualListNode:self didEndDisplayingNode:node forItemAtIndex:itemIndex];
+    }
+    [self->_reusableNodes addObject:node];
+  }];
+}
+
+- (void)HL_layoutZForNode:(SKNode *)node
+{
+  CGFloat zPositionLayerIncrement = self.zPositionScale / HLVirtualListNodeZPositionLayerCount;
+  node.zPosition = HLVirtualListNodeZPositionLayerItems * zPositionLayerIncrement;
+  if ([node isKindOfClass:[HLComponentNode class]]) {
+    [(HLComponentNode *)node setZPositionScale:zPositionLayerIncrement];
+  }
+}
+
+@end
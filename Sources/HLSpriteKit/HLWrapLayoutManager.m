@@ -10,6 +10,8 @@
 
 #import <TargetConditionals.h>
 
+#import "HLLayoutState.h"
+
 const CGFloat HLWrapLayoutManagerEpsilon = 0.001f;
 
 @implementation HLWrapLayoutManager
@@ -99,12 +101,85 @@ const CGFloat HLWrapLayoutManagerEpsilon = 0.001f;
 }
 
 - (void)layout:(NSArray *)nodes
+{
+  [self GL_layout:nodes state:nil];
+}
+
+- (void)layout:(NSArray *)nodes getState:(HLLayoutState * __autoreleasing *)state
+{
+  [self GL_layout:nodes state:state];
+}
+
+- (void)layoutSizes:(const CGSize *)sizes count:(NSUInteger)count getPositions:(CGPoint *)positions
+{
+  [self GL_layoutSizes:sizes count:count getPositions:positions state:nil];
+}
+
+- (void)layoutSizes:(const CGSize *)sizes
+              count:(NSUInteger)count
+       getPositions:(CGPoint *)positions
+              state:(HLLayoutState * __autoreleasing *)returnState
+{
+  HLLayoutState *state = (returnState ? [self GL_newState] : nil);
+  [self GL_layoutSizes:sizes count:count getPositions:positions state:state];
+  if (returnState) {
+    *returnState = state;
+  }
+}
+
+- (HLLayoutState *)GL_newState
+{
+  switch (_fillMode) {
+    case HLWrapLayoutManagerFillRightThenDown:
+    case HLWrapLayoutManagerFillRightThenUp:
+    case HLWrapLayoutManagerFillLeftThenDown:
+    case HLWrapLayoutManagerFillLeftThenUp:
+      return [[HLLayoutState alloc] initWithLineAxis:HLLayoutStateAxisY];
+    case HLWrapLayoutManagerFillDownThenRight:
+    case HLWrapLayoutManagerFillDownThenLeft:
+    case HLWrapLayoutManagerFillUpThenRight:
+    case HLWrapLayoutManagerFillUpThenLeft:
+      return [[HLLayoutState alloc] initWithLineAxis:HLLayoutStateAxisX];
+  }
+  return nil;
+}
+
+- (void)GL_layout:(NSArray *)nodes state:(HLLayoutState * __autoreleasing *)returnState
 {
   NSUInteger nodesCount = (nodes ? [nodes count] : 0);
+  HLLayoutState *state = (returnState ? [self GL_newState] : nil);
+  if (returnState) {
+    *returnState = state;
+  }
   if (nodesCount == 0) {
     return;
   }
 
+  CGSize *sizes = (CGSize *)malloc(nodesCount * sizeof(CGSize));
+  CGPoint *positions = (CGPoint *)malloc(nodesCount * sizeof(CGPoint));
+  HLLayoutManagerGetNodeSizes(nodes, sizes);
+  [self GL_layoutSizes:sizes count:nodesCount getPositions:positions state:state];
+
+  for (NSUInteger nodeIndex = 0; nodeIndex < nodesCount; ++nodeIndex) {
+    id node = nodes[nodeIndex];
+    if ([node isKindOfClass:[SKNode class]]) {
+      [(SKNode *)node setPosition:positions[nodeIndex]];
+    }
+  }
+
+  free(sizes);
+  free(positions);
+}
+
+- (void)GL_layoutSizes:(const CGSize *)sizes
+                 count:(NSUInteger)count
+          getPositions:(CGPoint *)positions
+                 state:(HLLayoutState *)state
+{
+  if (count == 0) {
+    return;
+  }
+
   CGFloat justificationFactor;
   switch (_justification) {
     case HLWrapLayoutManagerJustificationNear:
@@ -119,39 +194,42 @@ const CGFloat HLWrapLayoutManagerEpsilon = 0.001f;
   }
 
   // First pass: Calculate line lengths and overall size.
-  CGFloat (*cellLengthFitFunction)(id);
+  BOOL linesAreHorizontal;
   switch (_fillMode) {
     case HLWrapLayoutManagerFillRightThenDown:
     case HLWrapLayoutManagerFillRightThenUp:
     case HLWrapLayoutManagerFillLeftThenDown:
     case HLWrapLayoutManagerFillLeftThenUp:
-      cellLengthFitFunction = &HLLayoutManagerGetNodeWidth;
+      linesAreHorizontal = YES;
       break;
     case HLWrapLayoutManagerFillDownThenRight:
     case HLWrapLayoutManagerFillDownThenLeft:
     case HLWrapLayoutManagerFillUpThenRight:
     case HLWrapLayoutManagerFillUpThenLeft:
-      cellLengthFitFunction = &HLLayoutManagerGetNodeHeight;
+      linesAreHorizontal = NO;
       break;
   }
+  CGFloat *cellLengths = (CGFloat *)malloc(count * sizeof(CGFloat));
+  for (NSUInteger nodeIndex = 0; nodeIndex < count; ++nodeIndex) {
+    cellLengths[nodeIndex] = (linesAreHorizontal ? sizes[nodeIndex].width : sizes[nodeIndex].height);
+  }
   // note: Most possible number of lines is the number of nodes (one per line).
-  CGFloat *lineLengths = (CGFloat *)malloc(nodesCount * sizeof(CGFloat));
+  CGFloat *lineLengths = (CGFloat *)malloc(count * sizeof(CGFloat));
   CGFloat boundsLength = 0.0f;
   CGFloat boundsBreadth = 0.0f;
   // note: Start first line.
   NSUInteger lineIndex = 0;
   CGFloat lineLength = _wrapBorder;
   // note: Get first node information.
-  NSEnumerator *nodesEnumerator = [nodes objectEnumerator];
-  SKNode *node = [nodesEnumerator nextObject];
-  CGFloat cellLength = cellLengthFitFunction(node);
+  NSUInteger nodeIndex = 0;
+  CGFloat cellLength = cellLengths[nodeIndex];
   while (YES) {
     // note: Add node to line.  (A new line always gets at least one node, regardless of
     // length.)
     lineLength += cellLength;
     // note: Get next node information.
-    node = [nodesEnumerator nextObject];
-    if (!node) {
+    ++nodeIndex;
+    if (nodeIndex >= count) {
       lineLength += _wrapBorder;
       lineLengths[lineIndex] = lineLength;
       if (lineLength > boundsLength) {
@@ -159,7 +237,7 @@ const CGFloat HLWrapLayoutManagerEpsilon = 0.001f;
       }
       break;
     }
-    cellLength = cellLengthFitFunction(node);
+    cellLength = cellLengths[nodeIndex];
     // note: Continue in this line, or start new line.
     if (lineLength + _cellSeparator + cellLength + _wrapBorder <= _maximumLength) {
       lineLength += _cellSeparator;
@@ -190,6 +268,9 @@ const CGFloat HLWrapLayoutManagerEpsilon = 0.001f;
   }
 
   // Second pass: Position nodes.
+  // note: Lines have no breadth, so in the layout state each line extends halfway to its
+  // neighbors.
+  CGFloat halfLineSeparator = _lineSeparator / 2.0f;
   switch (_fillMode) {
     case HLWrapLayoutManagerFillRightThenDown: {
       CGFloat boundsLeft = _wrapPosition.x - _anchorPoint.x * boundsLength;
@@ -199,21 +280,22 @@ const CGFloat HLWrapLayoutManagerEpsilon = 0.001f;
       CGFloat lineLength = _wrapBorder;
       CGFloat lineX = boundsLeft + justificationFactor * (boundsLength - lineLengths[lineIndex]);
       CGFloat lineY = boundsTop;
+      [state addLineFrom:(lineY - halfLineSeparator) to:(lineY + halfLineSeparator)];
       // note: Get first node information.
-      NSEnumerator *nodesEnumerator = [nodes objectEnumerator];
-      SKNode *node = [nodesEnumerator nextObject];
-      CGFloat cellLength = HLLayoutManagerGetNodeWidth(node);
+      NSUInteger nodeIndex = 0;
+      CGFloat cellLength = cellLengths[nodeIndex];
       while (YES) {
         // note: Add node to line.  (A new line always gets at least one node, regardless
         // of length.)
-        node.position = CGPointMake(lineX + lineLength + _cellAnchorPoint * cellLength, lineY);
+        positions[nodeIndex] = CGPointMake(lineX + lineLength + _cellAnchorPoint * cellLength, lineY);
+        [state addCellFrom:(lineX + lineLength) to:(lineX + lineLength + cellLength)];
         lineLength += cellLength;
         // note: Get next node information.
-        node = [nodesEnumerator nextObject];
-        if (!node) {
+        ++nodeIndex;
+        if (nodeIndex >= count) {
           break;
         }
-        cellLength = HLLayoutManagerGetNodeWidth(node);
+        cellLength = cellLengths[nodeIndex];
         // note: Continue in this line, or start new line.
         if (lineLength + _cellSeparator + cellLength + _wrapBorder <= _maximumLength) {
           lineLength += _cellSeparator;
@@ -222,6 +304,7 @@ const CGFloat HLWrapLayoutManagerEpsilon = 0.001f;
           lineLength = _wrapBorder;
           lineX = boundsLeft + justificationFactor * (boundsLength - lineLengths[lineIndex]);
           lineY -= _lineSeparator;
+          [state addLineFrom:(lineY - halfLineSeparator) to:(lineY + halfLineSeparator)];
         }
       }
       break;
@@ -234,21 +317,22 @@ const CGFloat HLWrapLayoutManagerEpsilon = 0.001f;
       CGFloat lineLength = _wrapBorder;
       CGFloat lineX = boundsLeft + justificationFactor * (boundsLength - lineLengths[lineIndex]);
       CGFloat lineY = boundsBottom;
+      [state addLineFrom:(lineY - halfLineSeparator) to:(lineY + halfLineSeparator)];
       // note: Get first node information.
-      NSEnumerator *nodesEnumerator = [nodes objectEnumerator];
-      SKNode *node = [nodesEnumerator nextObject];
-      CGFloat cellLength = HLLayoutManagerGetNodeWidth(node);
+      NSUInteger nodeIndex = 0;
+      CGFloat cellLength = cellLengths[nodeIndex];
       while (YES) {
         // note: Add node to line.  (A new line always gets at least one node, regardless
         // of length.)
-        node.position = CGPointMake(lineX + lineLength + _cellAnchorPoint * cellLength, lineY);
+        positions[nodeIndex] = CGPointMake(lineX + lineLength + _cellAnchorPoint * cellLength, lineY);
+        [state addCellFrom:(lineX + lineLength) to:(lineX + lineLength + cellLength)];
         lineLength += cellLength;
         // note: Get next node information.
-        node = [nodesEnumerator nextObject];
-        if (!node) {
+        ++nodeIndex;
+        if (nodeIndex >= count) {
           break;
         }
-        cellLength = HLLayoutManagerGetNodeWidth(node);
+        cellLength = cellLengths[nodeIndex];
         // note: Continue in this line, or start new line.
         if (lineLength + _cellSeparator + cellLength + _wrapBorder <= _maximumLength) {
           lineLength += _cellSeparator;
@@ -257,6 +341,7 @@ const CGFloat HLWrapLayoutManagerEpsilon = 0.001f;
           lineLength = _wrapBorder;
           lineX = boundsLeft + justificationFactor * (boundsLength - lineLengths[lineIndex]);
           lineY += _lineSeparator;
+          [state addLineFrom:(lineY - halfLineSeparator) to:(lineY + halfLineSeparator)];
         }
       }
       break;
@@ -269,21 +354,22 @@ const CGFloat HLWrapLayoutManagerEpsilon = 0.001f;
       CGFloat lineLength = _wrapBorder;
       CGFloat lineX = boundsRight - justificationFactor * (boundsLength - lineLengths[lineIndex]);
       CGFloat lineY = boundsTop;
+      [state addLineFrom:(lineY - halfLineSeparator) to:(lineY + halfLineSeparator)];
       // note: Get first node information.
-      NSEnumerator *nodesEnumerator = [nodes objectEnumerator];
-      SKNode *node = [nodesEnumerator nextObject];
-      CGFloat cellLength = HLLayoutManagerGetNodeWidth(node);
+      NSUInteger nodeIndex = 0;
+      CGFloat cellLength = cellLengths[nodeIndex];
       while (YES) {
         // note: Add node to line.  (A new line always gets at least one node, regardless
         // of length.)
-        node.position = CGPointMake(lineX - lineLength - _cellAnchorPoint * cellLength, lineY);
+        positions[nodeIndex] = CGPointMake(lineX - lineLength - _cellAnchorPoint * cellLength, lineY);
+        [state addCellFrom:(lineX - lineLength) to:(lineX - lineLength - cellLength)];
         lineLength += cellLength;
         // note: Get next node information.
-        node = [nodesEnumerator nextObject];
-        if (!node) {
+        ++nodeIndex;
+        if (nodeIndex >= count) {
           break;
         }
-        cellLength = HLLayoutManagerGetNodeWidth(node);
+        cellLength = cellLengths[nodeIndex];
         // note: Continue in this line, or start new line.
         if (lineLength + _cellSeparator + cellLength + _wrapBorder <= _maximumLength) {
           lineLength += _cellSeparator;
@@ -292,6 +378,7 @@ const CGFloat HLWrapLayoutManagerEpsilon = 0.001f;
           lineLength = _wrapBorder;
           lineX = boundsRight - justificationFactor * (boundsLength - lineLengths[lineIndex]);
           lineY -= _lineSeparator;
+          [state addLineFrom:(lineY - halfLineSeparator) to:(lineY + halfLineSeparator)];
         }
       }
       break;
@@ -304,21 +391,22 @@ const CGFloat HLWrapLayoutManagerEpsilon = 0.001f;
       CGFloat lineLength = _wrapBorder;
       CGFloat lineX = boundsRight - justificationFactor * (boundsLength - lineLengths[lineIndex]);
       CGFloat lineY = boundsBottom;
+      [state addLineFrom:(lineY - halfLineSeparator) to:(lineY + halfLineSeparator)];
       // note: Get first node information.
-      NSEnumerator *nodesEnumerator = [nodes objectEnumerator];
-      SKNode *node = [nodesEnumerator nextObject];
-      CGFloat cellLength = HLLayoutManagerGetNodeWidth(node);
+      NSUInteger nodeIndex = 0;
+      CGFloat cellLength = cellLengths[nodeIndex];
       while (YES) {
         // note: Add node to line.  (A new line always gets at least one node, regardless
         // of length.)
-        node.position = CGPointMake(lineX - lineLength - _cellAnchorPoint * cellLength, lineY);
+        positions[nodeIndex] = CGPointMake(lineX - lineLength - _cellAnchorPoint * cellLength, lineY);
+        [state addCellFrom:(lineX - lineLength) to:(lineX - lineLength - cellLength)];
         lineLength += cellLength;
         // note: Get next node information.
-        node = [nodesEnumerator nextObject];
-        if (!node) {
+        ++nodeIndex;
+        if (nodeIndex >= count) {
           break;
         }
-        cellLength = HLLayoutManagerGetNodeWidth(node);
+        cellLength = cellLengths[nodeIndex];
         // note: Continue in this line, or start new line.
         if (lineLength + _cellSeparator + cellLength + _wrapBorder <= _maximumLength) {
           lineLength += _cellSeparator;
@@ -327,6 +415,7 @@ const CGFloat HLWrapLayoutManagerEpsilon = 0.001f;
           lineLength = _wrapBorder;
           lineX = boundsRight - justificationFactor * (boundsLength - lineLengths[lineIndex]);
           lineY += _lineSeparator;
+          [state addLineFrom:(lineY - halfLineSeparator) to:(lineY + halfLineSeparator)];
         }
       }
       break;
@@ -339,21 +428,22 @@ const CGFloat HLWrapLayoutManagerEpsilon = 0.001f;
       CGFloat lineLength = _wrapBorder;
       CGFloat lineX = boundsLeft;
       CGFloat lineY = boundsTop - justificationFactor * (boundsLength - lineLengths[lineIndex]);
+      [state addLineFrom:(lineX - halfLineSeparator) to:(lineX + halfLineSeparator)];
       // note: Get first node information.
-      NSEnumerator *nodesEnumerator = [nodes objectEnumerator];
-      SKNode *node = [nodesEnumerator nextObject];
-      CGFloat cellLength = HLLayoutManagerGetNodeHeight(node);
+      NSUInteger nodeIndex = 0;
+      CGFloat cellLength = cellLengths[nodeIndex];
       while (YES) {
         // note: Add node to line.  (A new line always gets at least one node, regardless
         // of length.)
-        node.position = CGPointMake(lineX, lineY - lineLength - _cellAnchorPoint * cellLength);
+        positions[nodeIndex] = CGPointMake(lineX, lineY - lineLength - _cellAnchorPoint * cellLength);
+        [state addCellFrom:(lineY - lineLength) to:(lineY - lineLength - cellLength)];
         lineLength += cellLength;
         // note: Get next node information.
-        node = [nodesEnumerator nextObject];
-        if (!node) {
+        ++nodeIndex;
+        if (nodeIndex >= count) {
           break;
         }
-        cellLength = HLLayoutManagerGetNodeHeight(node);
+        cellLength = cellLengths[nodeIndex];
         // note: Continue in this line, or start new line.
         if (lineLength + _cellSeparator + cellLength + _wrapBorder <= _maximumLength) {
           lineLength += _cellSeparator;
@@ -362,6 +452,7 @@ const CGFloat HLWrapLayoutManagerEpsilon = 0.001f;
           lineLength = _wrapBorder;
           lineX += _lineSeparator;
           lineY = boundsTop - justificationFactor * (boundsLength - lineLengths[lineIndex]);
+          [state addLineFrom:(lineX - halfLineSeparator) to:(lineX + halfLineSeparator)];
         }
       }
       break;
@@ -374,21 +465,22 @@ const CGFloat HLWrapLayoutManagerEpsilon = 0.001f;
       CGFloat lineLength = _wrapBorder;
       CGFloat lineX = boundsRight;
       CGFloat lineY = boundsTop - justificationFactor * (boundsLength - lineLengths[lineIndex]);
+      [state addLineFrom:(lineX - halfLineSeparator) to:(lineX + halfLineSeparator)];
       // note: Get first node information.
-      NSEnumerator *nodesEnumerator = [nodes objectEnumerator];
-      SKNode *node = [nodesEnumerator nextObject];
-      CGFloat cellLength = HLLayoutManagerGetNodeHeight(node);
+      NSUInteger nodeIndex = 0;
+      CGFloat cellLength = cellLengths[nodeIndex];
       while (YES) {
         // note: Add node to line.  (A new line always gets at least one node, regardless
         // of length.)
-        node.position = CGPointMake(lineX, lineY - lineLength - _cellAnchorPoint * cellLength);
+        positions[nodeIndex] = CGPointMake(lineX, lineY - lineLength - _cellAnchorPoint * cellLength);
+        [state addCellFrom:(lineY - lineLength) to:(lineY - lineLength - cellLength)];
         lineLength += cellLength;
         // note: Get next node information.
-        node = [nodesEnumerator nextObject];
-        if (!node) {
+        ++nodeIndex;
+        if (nodeIndex >= count) {
           break;
         }
-        cellLength = HLLayoutManagerGetNodeHeight(node);
+        cellLength = cellLengths[nodeIndex];
         // note: Continue in this line, or start new line.
         if (lineLength + _cellSeparator + cellLength + _wrapBorder <= _maximumLength) {
           lineLength += _cellSeparator;
@@ -397,6 +489,7 @@ const CGFloat HLWrapLayoutManagerEpsilon = 0.001f;
           lineLength = _wrapBorder;
           lineX -= _lineSeparator;
           lineY = boundsTop - justificationFactor * (boundsLength - lineLengths[lineIndex]);
+          [state addLineFrom:(lineX - halfLineSeparator) to:(lineX + halfLineSeparator)];
         }
       }
       break;
@@ -409,21 +502,22 @@ const CGFloat HLWrapLayoutManagerEpsilon = 0.001f;
       CGFloat lineLength = _wrapBorder;
       CGFloat lineX = boundsLeft;
       CGFloat lineY = boundsBottom + justificationFactor * (boundsLength - lineLengths[lineIndex]);
+      [state addLineFrom:(lineX - halfLineSeparator) to:(lineX + halfLineSeparator)];
       // note: Get first node information.
-      NSEnumerator *nodesEnumerator = [nodes objectEnumerator];
-      SKNode *node = [nodesEnumerator nextObject];
-      CGFloat cellLength = HLLayoutManagerGetNodeHeight(node);
+      NSUInteger nodeIndex = 0;
+      CGFloat cellLength = cellLengths[nodeIndex];
       while (YES) {
         // note: Add node to line.  (A new line always gets at least one node, regardless
         // of length.)
-        node.position = CGPointMake(lineX, lineY + lineLength + _cellAnchorPoint * cellLength);
+        positions[nodeIndex] = CGPointMake(lineX, lineY + lineLength + _cellAnchorPoint * cellLength);
+        [state addCellFrom:(lineY + lineLength) to:(lineY + lineLength + cellLength)];
         lineLength += cellLength;
         // note: Get next node information.
-        node = [nodesEnumerator nextObject];
-        if (!node) {
+        ++nodeIndex;
+        if (nodeIndex >= count) {
           break;
         }
-        cellLength = HLLayoutManagerGetNodeHeight(node);
+        cellLength = cellLengths[nodeIndex];
         // note: Continue in this line, or start new line.
         if (lineLength + _cellSeparator + cellLength + _wrapBorder <= _maximumLength) {
           lineLength += _cellSeparator;
@@ -432,6 +526,7 @@ const CGFloat HLWrapLayoutManagerEpsilon = 0.001f;
           lineLength = _wrapBorder;
           lineX += _lineSeparator;
           lineY = boundsBottom + justificationFactor * (boundsLength - lineLengths[lineIndex]);
+          [state addLineFrom:(lineX - halfLineSeparator) to:(lineX + halfLineSeparator)];
         }
       }
       break;
@@ -444,21 +539,22 @@ const CGFloat HLWrapLayoutManagerEpsilon = 0.001f;
       CGFloat lineLength = _wrapBorder;
       CGFloat lineX = boundsRight;
       CGFloat lineY = boundsBottom + justificationFactor * (boundsLength - lineLengths[lineIndex]);
+      [state addLineFrom:(lineX - halfLineSeparator) to:(lineX + halfLineSeparator)];
       // note: Get first node information.
-      NSEnumerator *nodesEnumerator = [nodes objectEnumerator];
-      SKNode *node = [nodesEnumerator nextObject];
-      CGFloat cellLength = HLLayoutManagerGetNodeHeight(node);
+      NSUInteger nodeIndex = 0;
+      CGFloat cellLength = cellLengths[nodeIndex];
       while (YES) {
         // note: Add node to line.  (A new line always gets at least one node, regardless
         // of length.)
-        node.position = CGPointMake(lineX, lineY + lineLength + _cellAnchorPoint * cellLength);
+        positions[nodeIndex] = CGPointMake(lineX, lineY + lineLength + _cellAnchorPoint * cellLength);
+        [state addCellFrom:(lineY + lineLength) to:(lineY + lineLength + cellLength)];
         lineLength += cellLength;
         // note: Get next node information.
-        node = [nodesEnumerator nextObject];
-        if (!node) {
+        ++nodeIndex;
+        if (nodeIndex >= count) {
           break;
         }
-        cellLength = HLLayoutManagerGetNodeHeight(node);
+        cellLength = cellLengths[nodeIndex];
         // note: Continue in this line, or start new line.
         if (lineLength + _cellSeparator + cellLength + _wrapBorder <= _maximumLength) {
           lineLength += _cellSeparator;
@@ -467,12 +563,14 @@ const CGFloat HLWrapLayoutManagerEpsilon = 0.001f;
           lineLength = _wrapBorder;
           lineX -= _lineSeparator;
           lineY = boundsBottom + justificationFactor * (boundsLength - lineLengths[lineIndex]);
+          [state addLineFrom:(lineX - halfLineSeparator) to:(lineX + halfLineSeparator)];
         }
       }
       break;
     }
   }
 
+  free(cellLengths);
   free(lineLengths);
 }
 
@@ -38,6 +38,17 @@ static NSString * const HLActionRunnerUserDataKey = @"HLActionRunner";
 
 - (void)hlSetActionRunner:(HLActionRunner *)actionRunner
 {
+  // note: A replaced action runner leaves its registry (if any), and the replacement joins
+  // it instead; otherwise the registry would go on updating the old runner with this node.
+  HLActionRunner *oldActionRunner = self.userData[HLActionRunnerUserDataKey];
+  HLActionRunnerRegistry *registry = nil;
+  if (oldActionRunner && oldActionRunner != actionRunner) {
+    registry = oldActionRunner.registry;
+    if (registry) {
+      [oldActionRunner setRegistry:nil node:nil];
+    }
+  }
+
   if (!actionRunner) {
     NSMutableDictionary *userData = self.userData;
     if (userData) {
@@ -48,6 +59,19 @@ static NSString * const HLActionRunnerUserDataKey = @"HLActionRunner";
       self.userData = [NSMutableDictionary dictionary];
     }
     self.userData[HLActionRunnerUserDataKey] = actionRunner;
+    if (registry && !actionRunner.registry) {
+      [actionRunner setRegistry:registry node:self];
+    }
+  }
+}
+
+- (void)hlSetActionRunnerRegistry:(HLActionRunnerRegistry *)registry
+{
+  if (!registry) {
+    HLActionRunner *actionRunner = self.userData[HLActionRunnerUserDataKey];
+    [actionRunner setRegistry:nil node:nil];
+  } else {
+    [self.hlActionRunner setRegistry:registry node:self];
   }
 }
 
@@ -68,7 +92,29 @@ static NSString * const HLActionRunnerUserDataKey = @"HLActionRunner";
 
 - (void)hlRunAction:(HLAction *)action withKey:(NSString *)key
 {
-  [self.hlActionRunner runAction:action withKey:key];
+  HLActionRunner *actionRunner = [self HL_actionRunnerForRunning];
+  [actionRunner runAction:action withKey:key];
+}
+
+- (void)hlRunActionDescriptor:(HLActionDescriptor *)descriptor withKey:(NSString *)key
+{
+  HLActionRunner *actionRunner = [self HL_actionRunnerForRunning];
+  [actionRunner runActionDescriptor:descriptor withKey:key];
+}
+
+- (HLActionRunner *)HL_actionRunnerForRunning
+{
+  HLActionRunner *actionRunner = self.hlActionRunner;
+  if (!actionRunner.registry) {
+    SKScene *scene = self.scene;
+    if ([scene conformsToProtocol:@protocol(HLActionRunnerRegistryOwner)]) {
+      HLActionRunnerRegistry *registry = [(id <HLActionRunnerRegistryOwner>)scene actionRunnerRegistry];
+      if (registry.enrollsRunnersAutomatically) {
+        [actionRunner setRegistry:registry node:self];
+      }
+    }
+  }
+  return actionRunner;
 }
 
 - (BOOL)hlHasActions
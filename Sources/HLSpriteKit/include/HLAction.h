@@ -8,6 +8,8 @@
 
 #import <SpriteKit/SpriteKit.h>
 
+#import "HLFunction.h"
+
 /**
  The timing mode for an action.
 
@@ -34,8 +36,110 @@ typedef NS_ENUM(NSInteger, HLActionTimingMode) {
    end, according to sine easing functions.
   */
   HLActionTimingEaseInEaseOut,
+  /**
+   Time starts out slow and accelerates to a quick end, according to the cubic Bezier
+   curve used by `SKActionTimingEaseIn`.
+  */
+  HLActionTimingEaseInBezier,
+  /**
+   Time starts out quick and decelerates to a slow end, according to the cubic Bezier curve
+   used by `SKActionTimingEaseOut`.
+  */
+  HLActionTimingEaseOutBezier,
+  /**
+   Time starts out slow, accelerates through the middle, and decelerates again to a slow
+   end, according to the cubic Bezier curve used by `SKActionTimingEaseInEaseOut`.
+  */
+  HLActionTimingEaseInEaseOutBezier,
 };
 
+/**
+ Applies a timing mode to a normal (linear) time, returning the normal time as experienced
+ by an action with that timing mode.
+
+ The normal time must be in the range `[0.0, 1.0]`.
+
+ By default, the sine timing modes are evaluated exactly using trigonometric functions, and
+ the Bezier timing modes are evaluated exactly as polynomials.  See
+ `HLActionSetUsesTimingTables()` for a faster alternative.
+*/
+FOUNDATION_EXPORT CGFloat HLActionApplyTiming(HLActionTimingMode timingMode, CGFloat normalTime);
+
+/**
+ The inverse of `HLActionApplyTiming()`: Returns the normal (linear) time corresponding to
+ a normal time as experienced by an action with the passed timing mode.
+
+ The normal time must be in the range `[0.0, 1.0]`.
+
+ By default, the sine timing modes are inverted exactly using inverse trigonometric
+ functions, and the Bezier timing modes are inverted by a few iterations of Newton's
+ method.  See `HLActionSetUsesTimingTables()` for a faster alternative.
+*/
+FOUNDATION_EXPORT CGFloat HLActionApplyTimingInverse(HLActionTimingMode timingMode, CGFloat normalTime);
+
+/**
+ Applies a timing mode to a normal time using a precomputed lookup table.
+
+ Tables sample each timing function at 1024 regular intervals of normal time, and are
+ linearly interpolated; lookup is constant time.  The absolute error compared to
+ `HLActionApplyTiming()` is bounded by `max|f''| / (8 * 1024^2)`: less than `3e-7` for
+ `HLActionTimingEaseIn` and `HLActionTimingEaseOut`, less than `6e-7` for
+ `HLActionTimingEaseInEaseOut`, and less than `8e-7` for the Bezier timing modes.  Results
+ at normal times `0.0` and `1.0` are exact.
+
+ Tables are built (once, for all timing modes) on first use.
+*/
+FOUNDATION_EXPORT CGFloat HLActionApplyTimingTable(HLActionTimingMode timingMode, CGFloat normalTime);
+
+/**
+ The inverse of `HLActionApplyTimingTable()`, using the same lookup table.
+
+ Lookup is a binary search over the table (ten steps).  The result is an exact inverse of
+ `HLActionApplyTimingTable()` (up to floating point rounding), which is important when
+ converting back and forth between time frames.  The absolute error compared to
+ `HLActionApplyTimingInverse()` is less than `2.5e-4` in normal time (a quarter of a table
+ interval), with the worst case near the flat ends of the easing curves where the exact
+ inverse is steepest.
+*/
+FOUNDATION_EXPORT CGFloat HLActionApplyTimingInverseTable(HLActionTimingMode timingMode, CGFloat normalTime);
+
+/**
+ Applies a timing mode to an array of normal times at once.
+
+ Sine timing modes are evaluated using the lookup tables of `HLActionApplyTimingTable()`
+ (with the same error bounds); Bezier timing modes are evaluated exactly.
+
+ @param timingMode The timing mode to apply.
+
+ @param normalTimes An array of `count` normal times, each in the range `[0.0, 1.0]`.
+
+ @param results An array with room for `count` results.  May be the same as `normalTimes`
+                for evaluation in place.
+
+ @param count The number of normal times.
+*/
+FOUNDATION_EXPORT void HLActionApplyTimingBatch(HLActionTimingMode timingMode, const CGFloat *normalTimes, CGFloat *results, NSUInteger count);
+
+/**
+ Configures `HLActionApplyTiming()` and `HLActionApplyTimingInverse()` (and therefore all
+ actions) to use the lookup tables of `HLActionApplyTimingTable()` and
+ `HLActionApplyTimingInverseTable()` rather than trigonometric functions (for sine timing
+ modes) or polynomials and iterative solutions (for Bezier timing modes).
+
+ Tables are used for all non-linear timing modes in both directions, so that the inverse
+ remains an exact inverse (up to floating point rounding) of the forward function.
+
+ Defaults to `NO`.  Intended to be set once, on startup, before any actions are running:
+ Switching in the middle of an action will introduce a small discontinuity (bounded by
+ the table error).
+*/
+FOUNDATION_EXPORT void HLActionSetUsesTimingTables(BOOL usesTimingTables);
+
+/**
+ Returns whether timing functions use lookup tables; see `HLActionSetUsesTimingTables()`.
+*/
+FOUNDATION_EXPORT BOOL HLActionUsesTimingTables(void);
+
 /**
  The `HLAction` system provides a stateful alternative to the `SKAction` system.
 
@@ -271,6 +375,9 @@ typedef NS_ENUM(NSInteger, HLActionTimingMode) {
  action-runners at the same time, for instance, would advance its elapsed time twice as
  fast as expected.
 
+ A completed `HLAction` can, however, be returned to its initial state with `rewind` and
+ then run again.
+
  ## Possibilities
 
  ### Modification of Action State
@@ -337,6 +444,77 @@ typedef NS_ENUM(NSInteger, HLActionTimingMode) {
 */
 - (BOOL)update:(NSTimeInterval)incrementalTime node:(SKNode *)node;
 
+/**
+ Moves the action (and the node) directly to the state at an elapsed time.
+
+ The result is the same as if the action had been updated from its start for a total of
+ `elapsedTime`, but computed directly rather than by simulating the intervening updates:
+ Simple durational actions (like move, scale, rotate, and fade) evaluate their state in
+ closed form, independent of the size of the seek.
+
+ Collections are not as cheap.  Actions (or iterations of a repeat) which are passed over
+ on the way to the target are each completed in turn, so that their effects on the node
+ are applied (and so that perform-selector actions are performed); the cost of seeking a
+ sequence or repeat is therefore linear in the number of actions or iterations passed
+ over, though each is sought directly to completion rather than simulated frame by frame.
+
+ Seeking may be forward or backward from the current state.  Seeking backward undoes the
+ effects of durational actions on the node, but cannot undo zero-duration actions like
+ `HLPerformSelector*Action` or `HLRemoveFromParentAction`; those will be run again when
+ seeking or updating forward past them.  Some actions cannot seek backward at all: chase
+ actions, custom subclasses of `HLAction` (which are updated forward), `HLRepeatAction`
+ when seeking to an earlier iteration, and sequences when seeking back past an action
+ which cannot be rewound.  If any action in the tree cannot seek to the requested time,
+ an exception is thrown before any action (or the node) is changed.
+
+ Seeking evaluates the action as if the speeds and timing modes of it and its sub-actions
+ had always been what they are at the time of the seek.
+
+ @param elapsedTime The time since the start of the action, in the time frame of the
+                    caller (that is, like the `incrementalTime` passed to `update:node:`,
+                    before this action's `speed` and `timingMode` are applied).  Negative
+                    values are considered the same as zero.
+
+ @param node The node to be updated by the action, or `nil` for none.
+
+ @return A boolean indicating if this node should continue being updated in the future
+         (that is, ongoing or "not yet completed").
+*/
+- (BOOL)seekToElapsedTime:(NSTimeInterval)elapsedTime node:(SKNode *)node;
+
+/// @name Rewinding the Action
+
+/**
+ Resets the action to its initial state, so that it can be run again.
+
+ Rewinding is an alternative to copying an unstarted action: It reuses the action's
+ storage rather than allocating a new one.  `HLRepeatAction` rewinds its repeated action
+ on each iteration when possible.
+
+ Elapsed time is reset to zero.  Collections like `HLGroupAction` and
+ `HLSequenceAction` rewind all their actions.  Values which were captured from the node
+ on the first update (for instance, the origin of an `HLMoveToAction` initialized
+ without one) are forgotten, and will be captured again on the next first update;
+ values passed during initialization are kept.
+
+ Only actions for which `canRewind` is `YES` may be rewound.  Subclasses which keep
+ state beyond that of `HLAction` should override this method, calling super, and should
+ override `canRewind` to return `YES`.
+*/
+- (void)rewind;
+
+/**
+ Whether or not the action can be rewound.
+
+ The base class returns `NO`; each action class which supports rewinding overrides this
+ explicitly.  Collections return `YES` only when all of their actions can be rewound.
+
+ Most actions can be rewound.  Currently the exceptions are chase actions, whose
+ position and destination are freely modified while running, and `HLCustomAction`, whose
+ user data might be modified while running.
+*/
+@property (nonatomic, readonly) BOOL canRewind;
+
 /// @name Controlling Durational Actions
 
 /**
@@ -405,6 +583,14 @@ When complete, `elapsedTime` won't necessarily match the action's `duration`:
 
 @end
 
+@class HLActionCommandQueue;
+@class HLActionRunnerRegistry;
+
+/**
+ A plain-data action allocated from an `HLActionArena`; see `HLActionDescriptor.h`.
+*/
+typedef struct HLActionDescriptor HLActionDescriptor;
+
 /**
  A runner and manager of `HLAction` actions.
 
@@ -413,7 +599,8 @@ When complete, `elapsedTime` won't necessarily match the action's `duration`:
 
  Usually an action runner is associated with an individual node which is passed to all
  running actions.  The node is not stored on the action runner, though, but is passed in
- as needed.
+ as needed.  (The exception is when the action runner is added to an
+ `HLActionRunnerRegistry`; see `setRegistry:node:`.)
 */
 @interface HLActionRunner : NSObject <NSCoding, NSCopying>
 
@@ -479,6 +666,144 @@ When complete, `elapsedTime` won't necessarily match the action's `duration`:
 */
 - (void)update:(NSTimeInterval)incrementalTime node:(SKNode *)node speed:(CGFloat)speed;
 
+/// @name Stepping With a Fixed Time Step
+
+/**
+ The fixed time step for updating actions, or zero (the default) to update actions with
+ whatever incremental time is passed to the update.
+
+ When set, the action runner accumulates incremental time (after modification by speed)
+ passed to `update:node:` or `update:node:speed:`, and then updates its actions in steps of
+ exactly this length for as long as the accumulated time allows.  Leftover time remains
+ accumulated for the next update.
+
+ Because the actions see the same sequence of incremental times regardless of frame rate,
+ their results are bit-identical across runs and devices, making them suitable for replays
+ or lockstep multiplayer.  (Of course, anything else which affects the node between updates
+ must also be deterministic.)
+
+ Changing the fixed time step does not reset the accumulated time; see `accumulatedTime`.
+ Negative values are considered the same as zero.
+*/
+@property (nonatomic, assign) NSTimeInterval fixedTimeStep;
+
+/**
+ The maximum number of fixed time steps performed in a single update, or zero for no
+ limit.  Default value is `5`.
+
+ If the device cannot keep up with the simulation (or after a long pause), a single update
+ might otherwise run many steps to catch up, which only makes the problem worse.  When the
+ limit is reached, the extra accumulated time is dropped, except for any fraction of a
+ step.  (Dropping time means the actions fall behind wall-clock time, but every step is
+ still exactly `fixedTimeStep` long, so results remain deterministic.)
+
+ Only relevant when `fixedTimeStep` is set.
+*/
+@property (nonatomic, assign) NSUInteger maximumStepCount;
+
+/**
+ The time accumulated by updates but not yet used for a fixed time step.
+
+ Always less than `fixedTimeStep` after an update.  Set to zero to discard accumulated time
+ (for instance, when synchronizing with another simulation).
+*/
+@property (nonatomic, assign) NSTimeInterval accumulatedTime;
+
+/**
+ Whether or not the action runner interpolates node properties between fixed time steps.
+ Default value is `NO`.
+
+ When the fixed time step is longer than the frame interval, actions appear to stutter,
+ since the node is only changed on frames that run a step.  When interpolation is on, the
+ action runner renders the node between its state at the previous step and its state at the
+ latest step, in proportion to the accumulated time: specifically, the node's `position`,
+ `zRotation`, `xScale`, `yScale`, and `alpha`.  (Note this means rendering lags the
+ simulation by up to one step.)
+
+ The simulated node state is restored at the start of the next update, before any steps
+ are run, and so interpolation does not affect the results of actions.  Changes made to the
+ interpolated properties by other code between updates are preserved, though they are not
+ themselves interpolated.
+
+ Only relevant when `fixedTimeStep` is set and the update is passed a node.  Interpolation
+ state is not encoded or copied.
+*/
+@property (nonatomic, assign) BOOL interpolatesNode;
+
+/// @name Deferring Idle Updates
+
+/**
+ Whether or not the action runner skips updating its actions while they are all idle.
+ Default value is `NO`.
+
+ An action is idle when updating it has no effect other than advancing its elapsed time:
+ An `HLWaitAction` is idle until it completes, and a group, sequence, or repeat is idle
+ while its currently-running actions are all idle.  A long sequence that mostly waits
+ (say, a wait followed by a fade, repeated forever) is therefore idle most of the time.
+
+ When set, after each update the action runner computes the time until the first of its
+ actions stops being idle.  Until then, it only accumulates incremental time.  Once the
+ accumulated time reaches the idle time, the actions are updated with all of it at once,
+ and so the extra time carries into the following actions exactly as it would if they had
+ been updated every frame.
+
+ When the action runner is a member of an `HLActionRunnerRegistry`, the registry goes
+ further: It removes an idle action runner from its per-update loop entirely, and parks it
+ on a timer wheel to be woken (and updated) at its deadline, so that the per-update cost
+ of a waiting action runner is zero.  A parked action runner uses the node speed at the
+ time it was parked; if the node speed changes while parked, the change applies only after
+ it wakes (or immediately, if the owner calls `update:node:` with zero time).
+
+ The actions are brought up to date whenever they are accessed through the action runner
+ (for example, by `actionForKey:`), or the action runner is encoded or copied.  However,
+ changes made to an idle action through some other reference (for instance, to its
+ `speed`) while updates are deferred will not take effect until the deferred time is
+ delivered.
+*/
+@property (nonatomic, assign) BOOL defersIdleUpdates;
+
+/// @name Throttling Offscreen Updates
+
+/**
+ Whether or not the action runner's node is offscreen, so that its actions may be updated
+ less often.  Default value is `NO`.
+
+ A node scrolled far outside the visible area (for instance, content in an `HLScrollNode`)
+ gains nothing from full-rate updates.  While this property is set, the action runner
+ accumulates incremental time (after modification by speed) rather than updating its
+ actions, except that once the accumulated time reaches `offscreenUpdateInterval`, the
+ actions are updated with all of it at once.  When the property is cleared, the next update
+ catches up: The actions are updated with the accumulated time plus the incremental time in
+ a single large update.
+
+ Because actions carry extra time from one to the next, one large update gives the same
+ results as many small ones for most actions.  (Exceptions are actions whose results
+ depend on the node as changed by other code between updates, like `HLChaseWeakTargetAction`,
+ and the frames skipped by texture animations, which are not displayed.)  When a fixed time
+ step is set, the catch-up is run in steps, and is still limited by `maximumStepCount`.
+
+ Unlike deferred idle time, accumulated offscreen time is not delivered when the actions
+ are accessed through the action runner (for example, by `actionForKey:`), since the node
+ is not available then; accessed actions reflect the last update.
+*/
+@property (nonatomic, assign) BOOL offscreen;
+
+/**
+ The minimum time between updates of the actions while the action runner is `offscreen`,
+ or zero (the default) to not update the actions at all while offscreen.
+
+ Negative values are considered the same as zero.
+*/
+@property (nonatomic, assign) NSTimeInterval offscreenUpdateInterval;
+
+/**
+ The time accumulated by updates while `offscreen`, but not yet delivered to the actions.
+
+ Set to zero to discard the accumulated time (so that the actions resume where they left
+ off rather than catching up).
+*/
+@property (nonatomic, assign) NSTimeInterval offscreenTime;
+
 /// @name Adding and Removing Actions
 
 /**
@@ -488,6 +813,21 @@ When complete, `elapsedTime` won't necessarily match the action's `duration`:
 */
 - (void)runAction:(HLAction *)action withKey:(NSString *)key;
 
+/**
+ Adds an action descriptor to the action runner.
+
+ The descriptor is updated like an action, but without creating any objects.  It is
+ converted to an `HLAction` (see `HLActionDescriptorCreateAction()`) only if needed: when
+ accessed by `actionForKey:`.  When the action runner is encoded or copied, an equivalent
+ action is encoded or copied in its place, and the descriptor keeps running in the
+ receiver.  Descriptors are never considered idle (see `defersIdleUpdates`).
+
+ A descriptor may only be run once, and must not be a member of a sequence or group
+ descriptor.  It is considered running by its arena (and so is not reclaimed by
+ `[HLActionArena recycle]`) until it completes or is removed.
+*/
+- (void)runActionDescriptor:(HLActionDescriptor *)descriptor withKey:(NSString *)key;
+
 /**
  Returns `YES` if this action runner is running any actions.
 */
@@ -510,6 +850,275 @@ When complete, `elapsedTime` won't necessarily match the action's `duration`:
 */
 - (void)removeAllActions;
 
+/// @name Registering With an Action Runner Registry
+
+/**
+ The registry, if any, with which this action runner is registered.
+
+ See `setRegistry:node:`.
+*/
+@property (nonatomic, readonly, weak) HLActionRunnerRegistry *registry;
+
+/**
+ Associates the action runner with a registry and a node.
+
+ While associated, the action runner is a member of the registry whenever it has actions:
+ It joins the registry when it gains its first action, and leaves when its last action
+ completes or is removed.  The registry updates all its members at once; see
+ `[HLActionRunnerRegistry updateAllRunners:]`.
+
+ The node is retained weakly, and is passed to the action runner's update (along with its
+ `speed`) by the registry.  If the node is deallocated, the action runner is dropped from
+ the registry at the next update.  If the node is in a scene when associated, then the
+ action runner is also disassociated from the registry at its next update after the node
+ leaves the scene, so that the registry does not keep it (and its actions) alive.
+
+ The registry and node are not encoded or copied.
+
+ @param registry The registry, or `nil` to disassociate the action runner from its current
+                 registry (if any).
+
+ @param node The node to be passed to the action runner's update by the registry, or `nil`
+             for none.
+*/
+- (void)setRegistry:(HLActionRunnerRegistry *)registry node:(SKNode *)node;
+
+@end
+
+/**
+ A collection of action runners that currently have actions, so that they can all be
+ updated at once.
+
+ The typical use of `HLAction` requires the caller to update each action runner (or node,
+ via `SKNode+HLAction`) every frame, even if the action runner has no actions.  For a
+ scene with many nodes, most of which are idle, that per-frame cost can be significant.
+ Instead, action runners may be associated with a registry, which they join only when they
+ have actions and leave as soon as they don't; then a single call to `updateAllRunners:`
+ updates only the animated action runners.
+
+     [_orcNode hlSetActionRunnerRegistry:_actionRunnerRegistry];
+     [_orcNode hlRunAction:[HLAction fadeOutWithDuration:3.0] withKey:@"fade"];
+     ...
+     - (void)update:(NSTimeInterval)currentTime
+     {
+       ...
+       [_actionRunnerRegistry updateAllRunners:incrementalTime];
+     }
+
+ `HLScene` owns a registry (see `HLActionRunnerRegistryOwner`), which nodes in the scene
+ may also join automatically; see `enrollsRunnersAutomatically`.
+
+ Action runners may join or leave the registry during `updateAllRunners:` (because their
+ actions run or remove other actions).  Action runners that join during the update are not
+ updated until the next update; action runners that leave are not updated again.
+
+ Action runners are updated one at a time, on the calling thread.  (For evaluating large
+ numbers of simple animations across cores, see `HLActionWorld`.)
+*/
+@interface HLActionRunnerRegistry : NSObject
+
+/// @name Creating a Registry
+
+/**
+ Returns an initialized registry.
+*/
+- (instancetype)init;
+
+/// @name Updating the Action Runners
+
+/**
+ Updates all action runners currently in the registry, passing each its associated node
+ and node speed.
+
+ First drains the registry's `commandQueue`, so that commands added since the last update
+ take effect in this update.
+
+ @param incrementalTime The elapsed time since the last update call.  Negative values are
+                        considered the same as zero.
+*/
+- (void)updateAllRunners:(NSTimeInterval)incrementalTime;
+
+/// @name Enrolling Action Runners
+
+/**
+ Whether or not nodes in a scene owning this registry join it automatically when running
+ actions.
+
+ When set, a node in a scene conforming to `HLActionRunnerRegistryOwner` which runs an
+ action with `[SKNode hlRunAction:withKey:]` associates its action runner with the
+ scene's registry (if not already associated with one).  Such nodes must not also be
+ updated with `[SKNode hlActionRunnerUpdate:]`, or their actions will be updated twice.
+ Action runners leave the registry when their nodes leave the scene; see
+ `[HLActionRunner setRegistry:node:]`.
+
+ Default value is `NO`.
+*/
+@property (nonatomic, assign) BOOL enrollsRunnersAutomatically;
+
+/// @name Deferring Callbacks
+
+/**
+ Whether or not callbacks made by actions during `updateAllRunners:` are deferred until all
+ runners have been updated.
+
+ Perform-selector actions (like `HLPerformSelectorWeakAction`) and custom actions (like
+ `HLCustomAction`) call their targets in the middle of an update, where the callbacks
+ might see some nodes updated for the current frame and others not, and where their changes
+ (for instance, running or removing actions) affect runners still to be updated.  When
+ this property is set, the callbacks are instead queued, with their arguments, in a buffer
+ owned by the registry, and made after all runners have been updated, in the order they
+ would otherwise have been made.
+
+ Only callbacks made during `updateAllRunners:` are deferred; updates of runners outside
+ the registry make their callbacks immediately.  Callbacks made by the deferred callbacks
+ themselves are not deferred.  Targets and arguments are retained until their callbacks
+ are made, even for weak-target actions.  If a deferred callback raises an exception, the
+ callbacks deferred after it are released without being made, and the exception is
+ propagated out of `updateAllRunners:`.  If an action runner raises an exception during
+ the update, callbacks already deferred are kept, and made at the end of the next update.
+
+ Callbacks are deferred only on the thread calling `updateAllRunners:`; runners updated on
+ other threads at the same time make their callbacks immediately.
+
+ Default value is `NO`.
+*/
+@property (nonatomic, assign) BOOL defersCallbacks;
+
+/// @name Running Actions from Other Threads
+
+/**
+ A queue of commands to run and remove actions, which may be added from any thread.
+
+ The queue is drained at the start of every `updateAllRunners:`.  See
+ `HLActionCommandQueue`.
+*/
+@property (nonatomic, readonly) HLActionCommandQueue *commandQueue;
+
+/// @name Getting Registry Information
+
+/**
+ The number of action runners currently in the registry (that is, those with actions).
+*/
+@property (nonatomic, readonly) NSUInteger runnerCount;
+
+@end
+
+/**
+ A protocol for objects (typically scenes) which own an `HLActionRunnerRegistry`.
+
+ When running an action on a node using `[SKNode hlRunAction:withKey:]`, the node's action
+ runner will be associated with its scene's registry (if the scene conforms to this
+ protocol, if the registry `enrollsRunnersAutomatically`, and if the action runner isn't
+ already associated with a registry).
+*/
+@protocol HLActionRunnerRegistryOwner <NSObject>
+
+/**
+ The registry owned by this object.
+*/
+- (HLActionRunnerRegistry *)actionRunnerRegistry;
+
+@end
+
+/**
+ Statistics recorded by `HLActionInstrumentation` for a kind of action or for an action
+ runner key.
+*/
+@interface HLActionStatistics : NSObject
+
+/**
+ The number of updates.
+*/
+@property (nonatomic, readonly) NSUInteger updateCount;
+
+/**
+ The number of updates which completed the action.
+*/
+@property (nonatomic, readonly) NSUInteger completionCount;
+
+/**
+ The number of allocations made on behalf of the actions while running.
+
+ For an action class, this counts copies of actions of that class made by `HLRepeatAction`
+ (when the repeated action cannot be rewound, or the first time it is run).  For an action
+ runner key, this counts growth of the action runner's storage when an action is run with
+ that key.
+*/
+@property (nonatomic, readonly) NSUInteger allocationCount;
+
+/**
+ The total time spent in updates, in seconds.
+*/
+@property (nonatomic, readonly) NSTimeInterval updateTime;
+
+@end
+
+/**
+ Opt-in instrumentation of the `HLAction` system, for finding out which actions dominate
+ frame time.
+
+ When enabled, every action update is counted and timed, and the results are accumulated
+ by action class (for all actions, including those nested in groups, sequences, and
+ repeats) and by action runner key (for actions run directly by an `HLActionRunner`).
+ Update times are inclusive: The time recorded for a sequence, for instance, includes the
+ time recorded for the actions in the sequence.
+
+ When disabled (the default), the only overhead is a check of a global flag on each
+ action update.
+
+ Instrumentation is not thread-safe, and is expected to be used on the same thread as the
+ actions.
+*/
+@interface HLActionInstrumentation : NSObject
+
+/// @name Enabling Instrumentation
+
+/**
+ Enables or disables instrumentation.
+
+ Disabling instrumentation does not reset the statistics recorded so far.
+*/
++ (void)setEnabled:(BOOL)enabled;
+
+/**
+ Returns whether instrumentation is enabled.
+*/
++ (BOOL)isEnabled;
+
+/**
+ Discards all recorded statistics.
+*/
++ (void)reset;
+
+/// @name Getting Statistics
+
+/**
+ Returns a snapshot of the recorded statistics by action class, as a dictionary mapping
+ class names to `HLActionStatistics`.
+*/
++ (NSDictionary *)statisticsByActionClass;
+
+/**
+ Returns a snapshot of the recorded statistics by action runner key, as a dictionary
+ mapping keys to `HLActionStatistics`.
+*/
++ (NSDictionary *)statisticsByKey;
+
+/**
+ Returns the recorded statistics formatted as a human-readable table, one row per action
+ class and per key, sorted by descending update time.
+*/
++ (NSString *)tableDescription;
+
+/**
+ Returns the recorded statistics encoded as JSON.
+
+ The JSON object has members `actionClasses` and `keys`, each an object mapping names to
+ objects with members `updateCount`, `completionCount`, `allocationCount`, and
+ `updateTime`.
+*/
++ (NSData *)JSONData;
+
 @end
 
 /**
@@ -531,7 +1140,7 @@ When complete, `elapsedTime` won't necessarily match the action's `duration`:
 /// @name Accessing Action State
 
 /**
- The `HLAction` members of this group action.
+ The non-completed `HLAction` members of this group action.
 
  This property is readonly; actions should not be added or removed to the group after
  initialization.
@@ -578,16 +1187,16 @@ When complete, `elapsedTime` won't necessarily match the action's `duration`:
 /**
  Creates an action that repeats another action forever.
 
- The action to be repeated is retained strongly, and copied on each iteration immediately
- before it is run.
+ The action to be repeated is retained strongly, and copied immediately before it is run.
+ See `[HLRepeatAction prototypeAction]` for details.
 */
 - (instancetype)initWithAction:(HLAction *)prototypeAction;
 
 /**
  Creates an action that repeats another action the passed number of times.
 
- The action to be repeated is retained strongly, and copied on each iteration immediately
- before it is run.
+ The action to be repeated is retained strongly, and copied immediately before it is run.
+ See `[HLRepeatAction prototypeAction]` for details.
 
  If count is passed 0, the action will be repeated forever.
 */
@@ -598,12 +1207,18 @@ When complete, `elapsedTime` won't necessarily match the action's `duration`:
 /**
  The prototype action to be repeated.
 
- This prototype will be copied on each iteration.
+ The prototype itself is never run.  If the prototype can be rewound (see `[HLAction
+ canRewind]`), then it is copied for the first two iterations, and those two copies are
+ then alternately rewound and reused for later iterations, so that a long-running repeat
+ does not allocate.  Otherwise, it is copied on each iteration.
 */
 @property (nonatomic, readonly) HLAction *prototypeAction;
 
 /**
  The copy of the prototype action currently being run, or `nil` if none.
+
+ Because copies are reused, the same object may be returned for different iterations
+ (though never for two consecutive iterations).
 */
 @property (nonatomic, readonly) HLAction *copiedAction;
 
@@ -619,6 +1234,75 @@ When complete, `elapsedTime` won't necessarily match the action's `duration`:
 
 @end
 
+/**
+ An action that plays back a tree of groups, sequences, and repeats, flattened into a
+ single timeline.
+
+ Each level of a nested tree of collection actions translates time for its members
+ (accounting for its own speed and timing mode) and tracks their extra time on
+ completion.  When the collections in the tree all have a speed of `1.0` and a linear
+ timing mode, that work is redundant: The start time of every non-collection ("leaf")
+ action in the tree can be computed in advance.  A timeline action does so once, on
+ creation, and then each update walks a cursor through the leaves sorted by start time,
+ updating those which have started and not yet completed.
+
+ Flattening rules:
+
+  * Members of a group start at the start time of the group.
+
+  * Members of a sequence start at the completion time of the previous member.
+
+  * Repeats with a finite count are unrolled, with a copy of the prototype action for each
+    iteration.  However, if unrolling a repeat would bring the timeline to more than 4096
+    leaves, the repeat is instead kept whole as a single leaf.
+
+  * Any other action is a leaf.  Leaves keep their own speed and timing mode, and are
+    updated normally.
+
+ A tree can be flattened only if every collection has speed `1.0` and a linear timing
+ mode, every repeat has a finite count, every action in the tree has not yet been run, and
+ every leaf has a finite completion time (for instance, not a zero speed).  See
+ `canFlattenAction:` and `[HLAction flattenedAction:]`.
+
+ Results differ from the original tree in only one way: When multiple leaves are updated
+ in the same update, they are updated in order of start time (with ties in tree order),
+ rather than in tree order.  This matters only to leaves which have side effects on each
+ other, like perform-selector actions.
+
+ The timeline action itself may be given a speed or timing mode, like any action.
+*/
+@interface HLTimelineAction : HLAction <NSCoding, NSCopying>
+
+/// @name Creating the Action
+
+/**
+ Returns `YES` if the action (and all actions in it) can be flattened into a timeline.
+
+ See class discussion for details.
+*/
++ (BOOL)canFlattenAction:(HLAction *)action;
+
+/**
+ Creates a timeline action by flattening a tree of actions.
+
+ The tree is copied, and the copy is flattened; the passed action is not modified.
+
+ Raises an exception if the action cannot be flattened; see `canFlattenAction:`.
+*/
+- (instancetype)initWithAction:(HLAction *)action;
+
+/// @name Accessing Action State
+
+/**
+ The leaf actions of the timeline, in order of start time.
+
+ This property is readonly; actions should not be added or removed to the timeline after
+ initialization.
+*/
+@property (nonatomic, readonly) NSArray *actions;
+
+@end
+
 /**
  An action that idles for a duration.
 */
@@ -798,6 +1482,65 @@ When complete, `elapsedTime` won't necessarily match the action's `duration`:
 
 @end
 
+/**
+ An action that moves along a path at constant speed over a duration.
+
+ A node moved along a cubic Bezier by `t` (see `[HLCubicBezier pointForT:]`) moves at
+ uneven speed, faster where the curve's control points are far apart.  A follow-path
+ action instead moves by distance along the path, using the arc length tables of the
+ `HLCubicBezierPath` and its curves; each update finds its position by binary search.  The
+ tables belong to the path, and so are shared by all actions following the same path
+ (including copies).
+
+ The path is in the coordinate space of the node's parent; the original position of the
+ node is ignored.  The timing mode of the action applies to distance along the path: For
+ instance, with an ease-in timing mode, the node starts slowly and accelerates.
+*/
+@interface HLFollowPathAction : HLAction <NSCoding, NSCopying>
+
+/// @name Creating the Action
+
+/**
+ Creates a follow-path action.
+*/
+- (instancetype)initWithPath:(HLCubicBezierPath *)path duration:(NSTimeInterval)duration;
+
+/// @name Configuring the Action
+
+/**
+ The path passed to the initializer.
+*/
+@property (nonatomic, readonly) HLCubicBezierPath *path;
+
+/**
+ Whether or not the action sets the node's rotation to the direction of travel along the
+ path.
+
+ Where the direction is undefined (for instance, along a degenerate curve), the node's
+ rotation is left unchanged.  Default value is `NO`.
+*/
+@property (nonatomic, assign) BOOL orientsToTangent;
+
+/// @name Accessing Action State
+
+/**
+ The current position of the follow-path action.
+
+ If a node was passed to the update method, it was updated with this position.
+*/
+@property (nonatomic, readonly) CGPoint position;
+
+/**
+ The current direction of travel of the follow-path action, as a rotation angle in
+ radians, or `0` if undefined.
+
+ If a node was passed to the update method and `orientsToTangent` is set, the node was
+ updated with this rotation.
+*/
+@property (nonatomic, readonly) CGFloat zRotation;
+
+@end
+
 /**
  An action that tracks a relative change in z-position over a duration.
 */
@@ -1108,9 +1851,145 @@ When complete, `elapsedTime` won't necessarily match the action's `duration`:
 
 @end
 
+/**
+ The node properties animated by an `HLKeyframeAction`.
+*/
+typedef NS_OPTIONS(NSUInteger, HLKeyframeActionChannels) {
+  /**
+   The node's position.
+  */
+  HLKeyframeActionChannelPosition = 1 << 0,
+  /**
+   The node's x and y scale.
+  */
+  HLKeyframeActionChannelScale = 1 << 1,
+  /**
+   The node's alpha.
+  */
+  HLKeyframeActionChannelAlpha = 1 << 2,
+  /**
+   The node's z-rotation.
+  */
+  HLKeyframeActionChannelRotation = 1 << 3,
+};
+
+/**
+ A keyframe of an `HLKeyframeAction`: a time and the values of each channel at that time.
+
+ The timing mode applies to the segment beginning at this keyframe and ending at the next;
+ it is ignored for the last keyframe.
+*/
+typedef struct {
+  NSTimeInterval time;
+  CGPoint position;
+  CGFloat xScale;
+  CGFloat yScale;
+  CGFloat alpha;
+  CGFloat zRotation;
+  HLActionTimingMode timingMode;
+} HLKeyframe;
+
+/**
+ An action that animates node properties through a series of keyframes.
+
+ Complex motion can be approximated by a sequence of to-actions (for instance, a number of
+ `HLMoveToAction`s in an `HLSequenceAction`), but that costs an action object and an update
+ for each segment.  A keyframe action instead holds the times and values of all keyframes
+ in flat arrays, and at each update interpolates every animated channel of the active
+ segment in one pass.
+
+ Only the channels passed to the initializer are animated; the values of other channels
+ in the keyframes are ignored.  Each segment between keyframes is interpolated linearly in
+ the segment's own timing mode (see `HLKeyframe`).  Rotation is interpolated numerically,
+ without normalization, so that keyframes may describe rotation of any number of turns.
+
+ The duration of the action is the time of the last keyframe.  Before the first keyframe,
+ channels have the values of the first keyframe.  (The timing mode and speed of the action
+ itself apply to the keyframe timeline as a whole.)
+
+ The active segment is found by binary search, using the previous segment as a hint, so
+ that actions with many keyframes remain cheap to update.  The keyframe arrays are
+ immutable and shared between copies of the action.
+*/
+@interface HLKeyframeAction : HLAction <NSCoding, NSCopying>
+
+/// @name Creating the Action
+
+/**
+ Creates a keyframe action.
+
+ The keyframes are copied.  There must be at least one keyframe, and keyframe times must
+ be non-negative and strictly increasing.
+*/
+- (instancetype)initWithKeyframes:(const HLKeyframe *)keyframes count:(NSUInteger)keyframeCount channels:(HLKeyframeActionChannels)channels;
+
+/// @name Accessing Keyframes
+
+/**
+ The channels animated by the action.
+*/
+@property (nonatomic, readonly) HLKeyframeActionChannels channels;
+
+/**
+ The number of keyframes.
+*/
+@property (nonatomic, readonly) NSUInteger keyframeCount;
+
+/**
+ Returns the keyframe at the passed index.
+
+ Values of channels not animated by the action are not stored, and are returned as zero.
+*/
+- (HLKeyframe)keyframeAtIndex:(NSUInteger)index;
+
+/// @name Sampling the Action
+
+/**
+ The current values of the keyframe action, as a keyframe.
+
+ If a node was passed to the update method, its animated channels were updated with these
+ values.  The time of the returned keyframe is the current elapsed time; the timing mode is
+ that of the active segment.
+*/
+@property (nonatomic, readonly) HLKeyframe currentKeyframe;
+
+/**
+ Returns the interpolated values of the keyframe action at a time, as a keyframe.
+
+ The time is measured on the keyframe timeline, from `0` to `duration`, without regard to
+ the timing mode and speed of the action.  Sampling does not change the state of the
+ action.
+*/
+- (HLKeyframe)keyframeForTime:(NSTimeInterval)time;
+
+/**
+ Samples the interpolated values of the keyframe action at a number of times.
+
+ Equivalent to calling `keyframeForTime:` for each time, but faster, especially when the
+ times are in increasing order: Each search for the active segment is hinted by the last.
+
+ @param times An array of `count` times, measured on the keyframe timeline.
+
+ @param keyframes An array of at least `count` keyframes, set by this method to the
+                  sampled values.
+
+ @param count The number of times to sample.
+*/
+- (void)getKeyframes:(HLKeyframe *)keyframes forTimes:(const NSTimeInterval *)times count:(NSUInteger)count;
+
+@end
+
 /**
  An action that blends color and changes color blend factor (for a spite node) from one
  set of values to another.
+
+ The components of the colors are read once, and interpolated without creating color
+ objects.  A new color object is created (and set on the sprite node) only when the
+ interpolated components change by a visible amount (half of an 8-bit channel step), so
+ slow color transitions do not allocate a color every update.  To read the exact
+ interpolated components, use `getColorRed:green:blue:alpha:colorBlendFactor:`.
+
+ Colors must be convertible to RGB components (see `getRed:green:blue:alpha:`).
 */
 @interface HLColorizeAction : HLAction <NSCoding, NSCopying>
 
@@ -1182,6 +2061,18 @@ When complete, `elapsedTime` won't necessarily match the action's `duration`:
 */
 - (void)getColor:(SKColor * __autoreleasing *)color colorBlendFactor:(CGFloat *)colorBlendFactor;
 
+/**
+ The current color components and color blend factor of the colorize action.
+
+ The components are exact, and no color object is created.  If the action does not animate
+ color, all color components are zero.
+*/
+- (void)getColorRed:(CGFloat *)red
+              green:(CGFloat *)green
+               blue:(CGFloat *)blue
+              alpha:(CGFloat *)alpha
+   colorBlendFactor:(CGFloat *)colorBlendFactor;
+
 @end
 
 /**
@@ -1745,21 +2636,31 @@ When complete, `elapsedTime` won't necessarily match the action's `duration`:
 /**
  Creates an action that repeats another action forever.
 
- The action to be repeated is retained strongly, and copied on each iteration immediately
- before it is run.
+ The action to be repeated is retained strongly, and copied immediately before it is run.
+ See `[HLRepeatAction prototypeAction]` for details.
 */
 + (HLRepeatAction *)repeatAction:(HLAction *)action count:(NSUInteger)count;
 
 /**
  Creates an action that repeats another action the passed number of times.
 
- The action to be repeated is retained strongly, and copied on each iteration immediately
- before it is run.
+ The action to be repeated is retained strongly, and copied immediately before it is run.
+ See `[HLRepeatAction prototypeAction]` for details.
 
  If count is passed 0, the action will be repeated forever.
 */
 + (HLRepeatAction *)repeatActionForever:(HLAction *)action;
 
+/**
+ Returns a flattened timeline of the passed action, if possible, or else the action
+ itself.
+
+ If the action can be flattened (see `[HLTimelineAction canFlattenAction:]`), returns a new
+ `HLTimelineAction` which plays back a copy of the action, and the passed action remains
+ unmodified.  Otherwise, returns the passed action.
+*/
++ (HLAction *)flattenedAction:(HLAction *)action;
+
 /**
  Creates an action that idles for a duration.
 */
@@ -1818,6 +2719,11 @@ When complete, `elapsedTime` won't necessarily match the action's `duration`:
 */
 + (HLChaseWeakTargetAction *)chaseFrom:(CGPoint)origin toWeakTarget:(id)destinationWeakTarget selector:(SEL)destinationSelector duration:(NSTimeInterval)duration;
 
+/**
+ Creates an action that moves along a path at constant speed over a duration.
+*/
++ (HLFollowPathAction *)followPath:(HLCubicBezierPath *)path duration:(NSTimeInterval)duration;
+
 /**
  Creates an action that tracks a relative change in z-position over a duration.
 */
@@ -2017,6 +2923,13 @@ When complete, `elapsedTime` won't necessarily match the action's `duration`:
 */
 + (HLFadeAlphaToAction *)fadeAlphaFrom:(CGFloat)alphaFrom to:(CGFloat)alphaTo duration:(NSTimeInterval)duration;
 
+/**
+ Creates an action that animates node properties through a series of keyframes.
+
+ See `HLKeyframeAction` for details.
+*/
++ (HLKeyframeAction *)keyframes:(const HLKeyframe *)keyframes count:(NSUInteger)keyframeCount channels:(HLKeyframeActionChannels)channels;
+
 /**
  Creates an action that blends color and changes color blend factor (for a spite node)
  from one set of values to another.
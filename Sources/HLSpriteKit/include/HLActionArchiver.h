@@ -0,0 +1,128 @@
+//
+//  HLActionArchiver.h
+//  HLSpriteKit
+//
+//  Created by Karl Voskuil on 10/16/26.
+//  Copyright © 2026 Hilo Games. All rights reserved.
+//
+
+#import <Foundation/Foundation.h>
+
+/**
+ The error domain for errors reported by `HLActionUnarchiver`.
+*/
+FOUNDATION_EXPORT NSString * const HLActionArchiverErrorDomain;
+
+/**
+ The current version of the binary format written by `HLActionArchiver`.
+*/
+FOUNDATION_EXPORT const NSUInteger HLActionArchiverFormatVersion;
+
+/**
+ A keyed coder that writes a compact binary archive, intended for `HLAction` trees and
+ `HLActionRunner` state.
+
+ `HLAction` and `HLActionRunner` (like most objects) encode themselves with keyed coding,
+ and so can be archived with `NSKeyedArchiver`.  But keyed archives are large, and slow to
+ write and read, mostly because every key of every object is stored (and looked up) as a
+ string.  Since the action classes already implement `NSCoding`, this archiver implements
+ the same keyed coding interface with a binary format instead:
+
+  * Every string used as a key, class name, or string value is written once, the first
+    time it is used; after that, it is referred to by an index into a table shared by the
+    whole archive.
+
+  * Integers are written as variable-length integers, and floating point values as fixed
+    width little-endian values.  Each value is preceded by a one-byte tag giving its type.
+
+  * Arrays, dictionaries, strings, numbers, and data are written directly, without
+    intermediate objects.  Other objects are written as a class name followed by their
+    keyed fields, and objects encoded more than once are written once and thereafter
+    referred to by index.
+
+ The archive is a sequence of root objects, appended one at a time with
+ `encodeRootObject:`, and read back one at a time by `HLActionUnarchiver`.
+
+ Any object conforming to `NSCoding` that uses only keyed coding may be archived.
+ Conditional objects (see `encodeConditionalObject:forKey:`) are written only if the same
+ object has already been written unconditionally earlier in the archive; otherwise they are
+ written as `nil`.
+*/
+@interface HLActionArchiver : NSCoder
+
+/// @name Creating an Archiver
+
+/**
+ Returns an initialized archiver with an empty archive.
+*/
+- (instancetype)init;
+
+/**
+ Returns an archive containing a single root object.
+*/
++ (NSData *)archivedDataWithRootObject:(id)rootObject;
+
+/// @name Encoding Root Objects
+
+/**
+ Appends a root object to the archive.
+
+ The root object may be `nil`.
+*/
+- (void)encodeRootObject:(id)rootObject;
+
+/**
+ The archive encoded so far.
+*/
+@property (nonatomic, readonly) NSData *encodedData;
+
+@end
+
+/**
+ A keyed decoder that reads archives written by `HLActionArchiver`.
+
+ Root objects are decoded one at a time, in the order they were written.  Each is decoded
+ directly from the archive data, without first building an intermediate representation of
+ the whole archive.
+
+ As with `NSKeyedUnarchiver`, `decodeObjectOfClass:forKey:` and
+ `decodeObjectOfClasses:forKey:` only decode values which are instances of the passed
+ classes (or their subclasses), and check the class of an object before instantiating it.
+ Objects referred to during their own decoding (that is, in a reference cycle) are
+ returned allocated but not yet initialized.  Values and objects may be nested at most
+ 256 deep.
+
+ On malformed input, a disallowed class, or nesting too deep, decoding raises
+ `NSInvalidUnarchiveOperationException`.
+*/
+@interface HLActionUnarchiver : NSCoder
+
+/// @name Creating an Unarchiver
+
+/**
+ Returns an unarchiver reading from the passed archive data, or `nil` (with an error) if
+ the data is not an archive written by a compatible version of `HLActionArchiver`.
+*/
+- (instancetype)initForReadingFromData:(NSData *)data error:(NSError * __autoreleasing *)error;
+
+/**
+ Returns the first root object of the passed archive data, or `nil` (with an error) if the
+ data is not a valid archive or the object cannot be decoded.
+*/
++ (id)unarchivedObjectFromData:(NSData *)data error:(NSError * __autoreleasing *)error;
+
+/// @name Decoding Root Objects
+
+/**
+ Whether or not there are more root objects to decode.
+*/
+@property (nonatomic, readonly) BOOL hasMoreRootObjects;
+
+/**
+ Decodes and returns the next root object from the archive.
+
+ Raises an exception if there are no more root objects.
+*/
+- (id)decodeRootObject;
+
+@end
@@ -0,0 +1,117 @@
+//
+//  HLActionCommandQueue.h
+//  HLSpriteKit
+//
+//  Created by Karl Voskuil on 10/16/26.
+//  Copyright © 2026 Hilo Games. All rights reserved.
+//
+
+#import <SpriteKit/SpriteKit.h>
+
+#import "HLAction.h"
+
+/**
+ A queue of commands to run and remove actions, which may be added from any thread, and
+ which are applied on the thread updating the actions.
+
+ Actions must be run and removed on the thread that updates them (usually the main
+ thread).  Code running on background queues (AI, pathfinding) would otherwise have to
+ dispatch to the main thread for every change.  Instead, it can add commands to a command
+ queue, and the commands are applied in a batch when the queue is drained:
+
+     dispatch_async(_aiQueue, ^{
+       ...
+       [commandQueue runAction:[HLAction moveTo:target duration:1.0] withKey:@"move" onNode:orcNode];
+     });
+
+ Adding a command takes no locks: Commands are pushed onto a lock-free stack with a single
+ atomic compare-and-swap, and the draining thread takes the whole stack with a single
+ atomic exchange.  Commands are applied in the order they were added (for commands added
+ by any one thread, in the order that thread added them).
+
+ Every `HLActionRunnerRegistry` owns a command queue, which it drains at the start of
+ `[HLActionRunnerRegistry updateAllRunners:]`; for nodes in an `HLScene`, use the queue of
+ the scene's registry.
+
+ The actions, keys, and targets of commands are retained until the commands are applied.
+ (An action added to a command queue must not be otherwise used, as usual.)
+*/
+@interface HLActionCommandQueue : NSObject
+
+/// @name Creating a Command Queue
+
+/**
+ Returns an initialized command queue.
+*/
+- (instancetype)init;
+
+/// @name Adding Commands
+
+/**
+ Adds a command to run an action on a node, as if by `[SKNode hlRunAction:withKey:]`.
+
+ May be called from any thread.  Passing `nil` for the action removes the action for the
+ key, as for `[HLActionRunner runAction:withKey:]`.
+*/
+- (void)runAction:(HLAction *)action withKey:(NSString *)key onNode:(SKNode *)node;
+
+/**
+ Adds a command to remove an action from a node, as if by `[SKNode hlRemoveActionForKey:]`.
+
+ May be called from any thread.
+*/
+- (void)removeActionForKey:(NSString *)key onNode:(SKNode *)node;
+
+/**
+ Adds a command to remove all actions from a node, as if by `[SKNode hlRemoveAllActions]`.
+
+ May be called from any thread.
+*/
+- (void)removeAllActionsOnNode:(SKNode *)node;
+
+/**
+ Adds a command to run an action on an action runner, as if by `[HLActionRunner
+ runAction:withKey:]`.
+
+ May be called from any thread.
+*/
+- (void)runAction:(HLAction *)action withKey:(NSString *)key onActionRunner:(HLActionRunner *)actionRunner;
+
+/**
+ Adds a command to remove an action from an action runner, as if by `[HLActionRunner
+ removeActionForKey:]`.
+
+ May be called from any thread.
+*/
+- (void)removeActionForKey:(NSString *)key onActionRunner:(HLActionRunner *)actionRunner;
+
+/**
+ Adds a command to remove all actions from an action runner, as if by `[HLActionRunner
+ removeAllActions]`.
+
+ May be called from any thread.
+*/
+- (void)removeAllActionsOnActionRunner:(HLActionRunner *)actionRunner;
+
+/// @name Applying Commands
+
+/**
+ Applies all commands added so far, in order, and returns the number applied.
+
+ Must be called on the thread updating the actions.  Commands added while draining (by
+ other threads, or by the commands' own effects) are left for the next drain.
+
+ If applying a command raises an exception, the commands after it in this drain are
+ discarded without being applied, and the exception is propagated.
+*/
+- (NSUInteger)drain;
+
+/**
+ Returns `YES` if there are commands waiting to be applied.
+
+ May be called from any thread, though the answer may be out of date by the time it is
+ returned.
+*/
+- (BOOL)hasCommands;
+
+@end
@@ -0,0 +1,195 @@
+//
+//  HLActionDescriptor.h
+//  HLSpriteKit
+//
+//  Created by Karl Voskuil on 10/16/26.
+//  Copyright © 2026 Hilo Games. All rights reserved.
+//
+
+#import <SpriteKit/SpriteKit.h>
+
+#import "HLAction.h"
+
+/**
+ A region of memory from which `HLActionDescriptor` structures are allocated.
+
+ Transient effects (a hit spark, say, which moves, scales, and fades a handful of nodes for
+ a fraction of a second) create many small `HLAction` objects which are discarded almost
+ immediately.  Action descriptors are plain C structures describing the same simple
+ actions, allocated by bumping a pointer in a chunk of arena memory, and run by
+ `HLActionRunner` without creating any objects.
+
+ Memory is reclaimed in whole chunks by `recycle`: Every chunk which contains no running
+ descriptors is emptied and reused for later allocations.  A descriptor is running from
+ when it is passed to `[HLActionRunner runActionDescriptor:withKey:]` until it completes
+ or is removed.  A typical owner (for instance, a scene) recycles its arena once per frame,
+ before creating any new descriptors:
+
+     - (void)update:(NSTimeInterval)currentTime
+     {
+       [_effectArena recycle];
+       ...
+     }
+
+ The arena is retained by action runners running its descriptors.  Like the rest of the
+ action system, the arena is not thread-safe.
+*/
+@interface HLActionArena : NSObject
+
+/// @name Creating an Arena
+
+/**
+ Returns an initialized arena with a default chunk size.
+*/
+- (instancetype)init;
+
+/**
+ Returns an initialized arena which allocates memory in chunks of (at least) the passed
+ size, in bytes.
+*/
+- (instancetype)initWithChunkSize:(NSUInteger)chunkSize NS_DESIGNATED_INITIALIZER;
+
+/// @name Reclaiming Memory
+
+/**
+ Reclaims the memory of all chunks containing no running descriptors.
+
+ Descriptors which have been created but not yet run are invalid after this call, as are
+ descriptors which have completed.
+*/
+- (void)recycle;
+
+/// @name Getting Arena Information
+
+/**
+ The total number of bytes in chunks allocated by the arena (whether in use or not).
+*/
+@property (nonatomic, readonly) NSUInteger chunkBytes;
+
+/**
+ The number of descriptors, including descriptors in sequences and groups, currently
+ running.
+*/
+@property (nonatomic, readonly) NSUInteger runningCount;
+
+@end
+
+/// @name Creating Action Descriptors
+
+/**
+ Returns a descriptor for an action like `HLWaitAction`.
+*/
+FOUNDATION_EXPORT HLActionDescriptor *HLActionDescriptorWait(HLActionArena *arena, NSTimeInterval duration);
+
+/**
+ Returns a descriptor for an action like `HLMoveByAction`.
+*/
+FOUNDATION_EXPORT HLActionDescriptor *HLActionDescriptorMoveBy(HLActionArena *arena, CGFloat deltaX, CGFloat deltaY, NSTimeInterval duration);
+
+/**
+ Returns a descriptor for an action like `HLMoveToAction`.  The origin is the node's
+ position at the first update.
+*/
+FOUNDATION_EXPORT HLActionDescriptor *HLActionDescriptorMoveTo(HLActionArena *arena, CGPoint destination, NSTimeInterval duration);
+
+/**
+ Returns a descriptor for an action like `HLScaleXYByAction`.
+*/
+FOUNDATION_EXPORT HLActionDescriptor *HLActionDescriptorScaleBy(HLActionArena *arena, CGFloat scaleDeltaX, CGFloat scaleDeltaY, NSTimeInterval duration);
+
+/**
+ Returns a descriptor for an action like `HLScaleToAction`.  The starting scales are the
+ node's scales at the first update.
+*/
+FOUNDATION_EXPORT HLActionDescriptor *HLActionDescriptorScaleTo(HLActionArena *arena, CGFloat scaleXTo, CGFloat scaleYTo, NSTimeInterval duration);
+
+/**
+ Returns a descriptor for an action like `HLRotateByAction`.
+*/
+FOUNDATION_EXPORT HLActionDescriptor *HLActionDescriptorRotateBy(HLActionArena *arena, CGFloat angleDelta, NSTimeInterval duration);
+
+/**
+ Returns a descriptor for an action like `HLRotateToAction` (without shortest-unit-arc).
+ The starting angle is the node's rotation at the first update.
+*/
+FOUNDATION_EXPORT HLActionDescriptor *HLActionDescriptorRotateTo(HLActionArena *arena, CGFloat angleTo, NSTimeInterval duration);
+
+/**
+ Returns a descriptor for an action like `HLFadeAlphaByAction`.
+*/
+FOUNDATION_EXPORT HLActionDescriptor *HLActionDescriptorFadeAlphaBy(HLActionArena *arena, CGFloat alphaDelta, NSTimeInterval duration);
+
+/**
+ Returns a descriptor for an action like `HLFadeAlphaToAction`.  The starting alpha is the
+ node's alpha at the first update.
+*/
+FOUNDATION_EXPORT HLActionDescriptor *HLActionDescriptorFadeAlphaTo(HLActionArena *arena, CGFloat alphaTo, NSTimeInterval duration);
+
+/**
+ Returns a descriptor for an action like `HLRemoveFromParentAction`.
+*/
+FOUNDATION_EXPORT HLActionDescriptor *HLActionDescriptorRemoveFromParent(HLActionArena *arena);
+
+/**
+ Returns a descriptor for an action like `HLSequenceAction`.
+
+ The descriptors must be non-empty, allocated from the same arena, and not otherwise used.
+ The array itself is copied into the arena.
+*/
+FOUNDATION_EXPORT HLActionDescriptor *HLActionDescriptorSequence(HLActionArena *arena, HLActionDescriptor * const *descriptors, NSUInteger count);
+
+/**
+ Returns a descriptor for an action like `HLGroupAction`.
+
+ The descriptors must be non-empty, allocated from the same arena, and not otherwise used.
+ The array itself is copied into the arena.
+*/
+FOUNDATION_EXPORT HLActionDescriptor *HLActionDescriptorGroup(HLActionArena *arena, HLActionDescriptor * const *descriptors, NSUInteger count);
+
+/// @name Configuring Action Descriptors
+
+/**
+ Sets the timing mode of the descriptor, as for `[HLAction timingMode]`.
+*/
+FOUNDATION_EXPORT void HLActionDescriptorSetTimingMode(HLActionDescriptor *descriptor, HLActionTimingMode timingMode);
+
+/**
+ Sets the speed of the descriptor, as for `[HLAction speed]`.  Negative values are
+ considered the same as zero.
+*/
+FOUNDATION_EXPORT void HLActionDescriptorSetSpeed(HLActionDescriptor *descriptor, CGFloat speed);
+
+/**
+ Returns the duration of the descriptor, as for `[HLAction duration]`.
+*/
+FOUNDATION_EXPORT NSTimeInterval HLActionDescriptorDuration(const HLActionDescriptor *descriptor);
+
+/**
+ Returns the arena from which the descriptor was allocated.
+*/
+FOUNDATION_EXPORT HLActionArena *HLActionDescriptorArena(const HLActionDescriptor *descriptor);
+
+/// @name Running Action Descriptors
+
+/**
+ Updates the descriptor, as for `[HLAction update:node:]`, and returns `NO` when it has
+ completed.
+
+ Usually descriptors are run by `[HLActionRunner runActionDescriptor:withKey:]` rather than
+ updated directly.  A descriptor updated directly is not considered running by its arena,
+ and so the caller must not recycle the arena until it is done with the descriptor.
+*/
+FOUNDATION_EXPORT BOOL HLActionDescriptorUpdate(HLActionDescriptor *descriptor, NSTimeInterval incrementalTime, SKNode *node);
+
+/// @name Converting Action Descriptors
+
+/**
+ Returns a new action equivalent to the descriptor, and in the same state.
+
+ Used by `HLActionRunner` when an action running as a descriptor is accessed through the
+ object API (for instance, by `actionForKey:`), or when the action runner is encoded or
+ copied.  The action is brought to the descriptor's state by seeking (see
+ `[HLAction seekToElapsedTime:node:]`) to the total time it has been updated, and so the
+ speeds of its descriptors are assumed not to have changed while running.
+*/
+FOUNDATION_EXPORT HLAction *HLActionDescriptorCreateAction(const HLActionDescriptor *descriptor);
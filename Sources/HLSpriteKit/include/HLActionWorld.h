@@ -0,0 +1,253 @@
+//
+//  HLActionWorld.h
+//  HLSpriteKit
+//
+//  Created by Karl Voskuil on 10/16/26.
+//  Copyright © 2026 Hilo Games. All rights reserved.
+//
+
+#import <SpriteKit/SpriteKit.h>
+
+#import "HLAction.h"
+
+/**
+ The kind of node property animated by an `HLActionWorld` track, and whether it is
+ animated by a delta ("by") or to a destination ("to").
+
+ Each track type corresponds to a simple durational `HLAction`, and animates the node
+ exactly as that action would.
+*/
+typedef NS_ENUM(NSInteger, HLActionWorldTrackType) {
+  /**
+   Like `HLMoveByAction`: Moves the node's `position` by a delta (`valueX`, `valueY`).
+  */
+  HLActionWorldTrackMoveBy,
+  /**
+   Like `HLMoveToAction`: Moves the node's `position` to a destination (`valueX`,
+   `valueY`).  The origin is the node's position at the first update of the track.
+  */
+  HLActionWorldTrackMoveTo,
+  /**
+   Like `HLScaleXYByAction`: Changes the node's `xScale` and `yScale` by deltas (`valueX`,
+   `valueY`).
+  */
+  HLActionWorldTrackScaleBy,
+  /**
+   Like `HLScaleToAction`: Changes the node's `xScale` and `yScale` to final values
+   (`valueX`, `valueY`).  The starting scales are read from the node at the first update
+   of the track.
+  */
+  HLActionWorldTrackScaleTo,
+  /**
+   Like `HLRotateByAction`: Changes the node's `zRotation` by a delta (`valueX`).
+  */
+  HLActionWorldTrackRotateBy,
+  /**
+   Like `HLRotateToAction` (without shortest-unit-arc): Changes the node's `zRotation` to
+   a final value (`valueX`).
+  */
+  HLActionWorldTrackRotateTo,
+  /**
+   Like `HLFadeAlphaByAction`: Changes the node's `alpha` by a delta (`valueX`).
+  */
+  HLActionWorldTrackFadeAlphaBy,
+  /**
+   Like `HLFadeAlphaToAction`: Changes the node's `alpha` to a final value (`valueX`).
+  */
+  HLActionWorldTrackFadeAlphaTo,
+  /**
+   Like `HLChangeZPositionByAction`: Changes the node's `zPosition` by a delta (`valueX`).
+  */
+  HLActionWorldTrackChangeZPositionBy,
+  /**
+   Like `HLChangeZPositionToAction`: Changes the node's `zPosition` to a final value
+   (`valueX`).
+  */
+  HLActionWorldTrackChangeZPositionTo,
+};
+
+/**
+ A track identifier returned by `HLActionWorld` when no track is indicated.
+*/
+FOUNDATION_EXPORT const NSUInteger HLActionWorldTrackNotFound;
+
+/**
+ A batch runner for large numbers of simple durational animations.
+
+ An `HLActionRunner` running thousands of small actions (each moving, scaling, rotating,
+ or fading a single node) spends most of its time on per-action overhead: dictionary
+ lookups, message sends, and pointer chasing through scattered action objects.  An
+ `HLActionWorld` instead stores each animation as a "track" in a set of contiguous
+ per-field arrays (a struct-of-arrays layout), advances the time of all tracks in a single
+ tight loop, and then writes the results back to the nodes.
+
+ Tracks follow `HLAction` semantics exactly:
+
+  * Elapsed time is advanced by the incremental time multiplied by the track's speed.
+
+  * The track's timing mode is applied to normal time before interpolation.
+
+  * "By" tracks apply instantaneous deltas to the node (so that they compose with other
+    animations of the same property), compensating for floating point drift so that the
+    final cumulative delta is exact.
+
+  * "To" tracks remember the node's starting value at their first update, and snap to the
+    destination value on completion.
+
+  * A track added with `addTrackWithType:node:valueX:valueY:duration:timingMode:speed:afterTrack:`
+    starts when the previous track completes, and receives the previous track's extra
+    time in its first update, just as in an `HLSequenceAction`.
+
+ The update runs in two phases.  The first phase advances time and computes new property
+ values for each track into a side buffer, without touching any nodes; for large worlds it
+ can be split across cores (see `concurrentTrackThreshold`).  The second phase writes the
+ values to the nodes, always on the calling thread.
+
+ Two-phase concurrent evaluation is available only here, and not for `HLActionRunner` or
+ `HLActionRunnerRegistry`.  Actions run by action runners write to their nodes as they are
+ updated, and perform-selector and custom actions call out to arbitrary code, so action
+ runners are always updated serially on the calling thread.  Tracks have no callbacks, and
+ so the second phase has nothing to do but write node properties.
+
+ Completed tracks are discarded, and their identifiers are recycled for later tracks.
+
+ The world retains the nodes of its tracks until the tracks complete or are removed.
+
+ `HLActionWorld` is not a replacement for `HLActionRunner`: it does not support encoding,
+ keys, or any kind of action other than those listed in `HLActionWorldTrackType`.
+*/
+@interface HLActionWorld : NSObject
+
+/// @name Creating an Action World
+
+/**
+ Returns an initialized action world.
+*/
+- (instancetype)init;
+
+/**
+ Returns an initialized action world with storage preallocated for a number of tracks.
+
+ The world grows its storage as needed; the capacity is only a hint.
+*/
+- (instancetype)initWithCapacity:(NSUInteger)capacity NS_DESIGNATED_INITIALIZER;
+
+/// @name Adding and Removing Tracks
+
+/**
+ Adds a track to the world, to begin on the next update.
+
+ @param type The type of track, determining the node property animated.
+
+ @param node The node to animate.  Must not be `nil`.
+
+ @param valueX The delta or destination value for the track; for track types with a
+               single value, the only value.
+
+ @param valueY The y delta or destination value for track types with two values;
+               otherwise ignored.
+
+ @param duration The duration of the track, in seconds.
+
+ @param timingMode The timing mode of the track.
+
+ @param speed The speed of the track.  Negative values are considered the same as zero.
+
+ @return The identifier of the added track.
+*/
+- (NSUInteger)addTrackWithType:(HLActionWorldTrackType)type
+                          node:(SKNode *)node
+                        valueX:(CGFloat)valueX
+                        valueY:(CGFloat)valueY
+                      duration:(NSTimeInterval)duration
+                    timingMode:(HLActionTimingMode)timingMode
+                         speed:(CGFloat)speed;
+
+/**
+ Adds a track to the world, to begin when another track completes.
+
+ If the previous track already has a following track, the new track is added after the
+ last track in the chain.  If the previous track is not found (or is
+ `HLActionWorldTrackNotFound`), the new track begins on the next update.
+
+ Parameters as for `addTrackWithType:node:valueX:valueY:duration:timingMode:speed:`.
+
+ @param previousTrack The identifier of the track to follow.
+
+ @return The identifier of the added track.
+*/
+- (NSUInteger)addTrackWithType:(HLActionWorldTrackType)type
+                          node:(SKNode *)node
+                        valueX:(CGFloat)valueX
+                        valueY:(CGFloat)valueY
+                      duration:(NSTimeInterval)duration
+                    timingMode:(HLActionTimingMode)timingMode
+                         speed:(CGFloat)speed
+                    afterTrack:(NSUInteger)previousTrack;
+
+/**
+ Returns `YES` if the track identifier refers to a running or waiting track.
+
+ Note that identifiers are recycled: After a track completes, its identifier may be
+ returned again for a newly-added track.
+*/
+- (BOOL)hasTrack:(NSUInteger)track;
+
+/**
+ Removes a track, along with any tracks waiting to follow it.
+
+ Does nothing if the track is not found.
+*/
+- (void)removeTrack:(NSUInteger)track;
+
+/**
+ Removes all tracks animating the passed node.
+*/
+- (void)removeTracksForNode:(SKNode *)node;
+
+/**
+ Removes all tracks.
+*/
+- (void)removeAllTracks;
+
+/**
+ The number of running or waiting tracks.
+*/
+@property (nonatomic, readonly) NSUInteger trackCount;
+
+/// @name Updating the Tracks
+
+/**
+ The number of tracks at or above which the first phase of each update (advancing time and
+ computing new values) is split across a pool of worker threads, or zero (the default) to
+ always evaluate on the calling thread.
+
+ Each worker handles a contiguous range of tracks; the caller blocks until all are done,
+ and then writes the results to the nodes itself.  Results are identical to evaluation on
+ the calling thread.  Since there is overhead in dispatching the work, small worlds are
+ always evaluated on the calling thread regardless of this setting; a threshold of a few
+ thousand tracks is a reasonable starting point.
+*/
+@property (nonatomic, assign) NSUInteger concurrentTrackThreshold;
+
+/**
+ Advances all running tracks and writes the results to their nodes.
+
+ @param incrementalTime The elapsed time since the last update call.  Negative values are
+                        considered the same as zero.
+*/
+- (void)update:(NSTimeInterval)incrementalTime;
+
+/**
+ Advances all running tracks and writes the results to their nodes, modified by a speed.
+
+ See `[HLActionRunner update:node:speed:]` for discussion.
+
+ @param incrementalTime The elapsed time since the last update call.  Negative values are
+                        considered the same as zero.
+
+ @param speed A speed which will be used to modify the `incrementalTime`.
+*/
+- (void)update:(NSTimeInterval)incrementalTime speed:(CGFloat)speed;
+
+@end
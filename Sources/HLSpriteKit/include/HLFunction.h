@@ -11,8 +11,13 @@
 
 /**
  A model of a cubic Bezier function.
+
+ For motion along the curve at constant speed, the curve can be parameterized by arc
+ length rather than by `t` (see `arcLength` and `tForArcLength:`).  The arc length table is
+ calculated the first time it is needed, and is then kept with the curve, so that all users
+ of the same curve object share it.
 */
-@interface HLCubicBezier : NSObject
+@interface HLCubicBezier : NSObject <NSCoding>
 
 /**
  Returns an initialized cubic Bezier curve.
@@ -32,11 +37,94 @@
 */
 @property (nonatomic, readonly) CGPoint p0;
 
+/**
+ Returns the `p1` passed to the initializer.
+*/
+@property (nonatomic, readonly) CGPoint p1;
+
+/**
+ Returns the `p2` passed to the initializer.
+*/
+@property (nonatomic, readonly) CGPoint p2;
+
+/**
+ Returns the `p3` passed to the initializer.
+*/
+@property (nonatomic, readonly) CGPoint p3;
+
 /**
  Returns a point on the cubic Bezier curve given a `t` value between `0` and `1`.
 */
 - (CGPoint)pointForT:(CGFloat)t;
 
+/**
+ Returns the tangent (the derivative with respect to `t`) of the cubic Bezier curve given
+ a `t` value between `0` and `1`.
+*/
+- (CGPoint)tangentForT:(CGFloat)t;
+
+/**
+ The length of the curve.
+
+ The length is approximated by a table of chords sampled at regular `t` intervals.
+*/
+@property (nonatomic, readonly) CGFloat arcLength;
+
+/**
+ Returns the `t` value of the point on the curve at a distance along the curve from `p0`.
+
+ The distance is clamped to the range from `0` to `arcLength`.  The `t` value is found by
+ binary search of the arc length table.
+*/
+- (CGFloat)tForArcLength:(CGFloat)arcLength;
+
+@end
+
+/**
+ A path made of a series of cubic Bezier curves, parameterized by arc length.
+
+ The path keeps a table of the cumulative arc length at the start of each curve, so that
+ the curve containing any distance along the path can be found by binary search.  The path
+ is immutable, and may be shared by any number of owners (for instance, by a number of
+ `HLFollowPathAction`s following the same path).
+*/
+@interface HLCubicBezierPath : NSObject <NSCoding>
+
+/**
+ Returns an initialized path made of the passed curves.
+
+ @param beziers An array of `HLCubicBezier` curves, in order.  Typically each curve starts
+                where the previous curve ends, but this is not required.  There must be at
+                least one curve.
+*/
+- (instancetype)initWithBeziers:(NSArray *)beziers;
+
+/**
+ The curves of the path.
+*/
+@property (nonatomic, readonly) NSArray *beziers;
+
+/**
+ The total arc length of the path.
+*/
+@property (nonatomic, readonly) CGFloat arcLength;
+
+/**
+ Returns the point at a distance along the path.
+
+ The distance is clamped to the range from `0` to `arcLength`.
+*/
+- (CGPoint)pointForArcLength:(CGFloat)arcLength;
+
+/**
+ Returns the point and tangent at a distance along the path.
+
+ The distance is clamped to the range from `0` to `arcLength`.  The tangent is in the
+ direction of travel, but it is not normalized, and it may be zero (for instance, at a
+ cusp, or along a degenerate curve).  Either pointer may be `NULL`.
+*/
+- (void)getPoint:(CGPoint *)point tangent:(CGPoint *)tangent forArcLength:(CGFloat)arcLength;
+
 @end
 
 /**
@@ -78,6 +166,11 @@
 */
 @property (nonatomic, readonly) CGPoint startLocation;
 
+/**
+ The cubic Bezier of the trajectory, in the owner's coordinate space.
+*/
+@property (nonatomic, readonly) HLCubicBezier *bezier;
+
 /**
  Returns a point on the trajectory given a `t` value between `0` and `1`.
 */
@@ -85,6 +178,23 @@
 
 @end
 
+/**
+ Returns the index of the segment of a piecewise linear function containing a given X.
+
+ The segment `k` is the one between knots `k` and `k + 1`, and contains X values from
+ `knotXValues[k]` (inclusive) to `knotXValues[k + 1]` (exclusive).  X values before the
+ first knot are considered part of the first segment, and X values at or after the last
+ knot are considered part of the last segment.  The knot X values must be monotonically
+ increasing, and there must be at least two knots.
+
+ Searches are commonly made for nearby X values in succession (for instance, while
+ evaluating a function over increasing time).  For that reason, the caller passes the
+ result of a previous search as a hint; the hinted segment and its successor are checked
+ before falling back to a binary search.  Any hint is allowed, and `0` may be passed if
+ there is no previous search.
+*/
+FOUNDATION_EXPORT NSUInteger HLPiecewiseLinearSegmentIndex(const CGFloat *knotXValues, NSUInteger knotCount, CGFloat x, NSUInteger hint);
+
 /**
  A model of a piecewise linear function.
 */
@@ -104,6 +214,8 @@
 
 /**
  Solves Y in the the piecewise linear function for a given X.
+
+ May be called from multiple threads at once.
 */
 - (CGFloat)yForX:(CGFloat)x;
 
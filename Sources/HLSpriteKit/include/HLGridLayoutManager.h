@@ -112,6 +112,15 @@ typedef NS_ENUM(NSInteger, HLGridLayoutManagerFillMode) {
 */
 - (void)layout:(NSArray *)nodes;
 
+/**
+ Layout and (optionally) return the cell geometry of the layout.
+
+ Lines of the state are the rows or columns of the grid in the order filled (for instance,
+ rows for `HLGridLayoutManagerFillRightThenDown`), and cells are the squares of each line,
+ indexed as the nodes laid out.  See `[HLLayoutManager layout:getState:]`.
+*/
+- (void)layout:(NSArray *)nodes getState:(HLLayoutState * __autoreleasing *)state;
+
 /**
  Sets the positions of the passed nodes according to the layout-affecting parameters.
 
@@ -141,6 +150,26 @@ typedef NS_ENUM(NSInteger, HLGridLayoutManagerFillMode) {
 */
 - (void)layoutWith2DArray:(NSArray *)nodeArrays;
 
+/**
+ Calculates the positions of the passed number of nodes, without accessing any nodes.
+
+ See `[HLLayoutManager layoutSizes:count:getPositions:]` and `layout:`.  Square size does
+ not depend on node size, so `sizes` is ignored and may be `NULL`.  Updates `size` (and
+ `columnCount` or `rowCount`).
+*/
+- (void)layoutSizes:(const CGSize *)sizes count:(NSUInteger)count getPositions:(CGPoint *)positions;
+
+/**
+ Calculates the positions of the passed number of nodes, and (optionally) returns the cell
+ geometry of the layout.
+
+ See `layoutSizes:count:getPositions:` and `layout:getState:`.
+*/
+- (void)layoutSizes:(const CGSize *)sizes
+              count:(NSUInteger)count
+       getPositions:(CGPoint *)positions
+              state:(HLLayoutState * __autoreleasing *)state;
+
 /// @name Getting and Setting Grid Geometry
 
 /**
@@ -265,7 +294,8 @@ typedef NS_ENUM(NSInteger, HLGridLayoutManagerFillMode) {
  the grid border or a square separator.
 
  The returned index might not refer to a real node if not enough nodes were passed to the
- layout method to fill the grid.
+ layout method to fill the grid.  (The `HLLayoutState` returned by `layout:getState:` only
+ finds real nodes.)
 */
 - (NSUInteger)nodeContainingPoint:(CGPoint)location;
 
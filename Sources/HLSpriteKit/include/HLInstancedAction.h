@@ -0,0 +1,170 @@
+//
+//  HLInstancedAction.h
+//  HLSpriteKit
+//
+//  Created by Karl Voskuil on 10/16/26.
+//  Copyright © 2026 Hilo Games. All rights reserved.
+//
+
+#import <SpriteKit/SpriteKit.h>
+
+#import "HLAction.h"
+
+/**
+ How the changes made by an `HLInstancedAction` are broadcast to its subscribed nodes.
+*/
+typedef NS_ENUM(NSInteger, HLInstancedActionBroadcastMode) {
+  /**
+   Each update, the change in each broadcast property of the evaluation node is added to
+   the corresponding property of each subscribed node.  Subscribed nodes keep their own
+   starting values, and so (for instance) a field of coins can bob in place, each around
+   its own position.
+  */
+  HLInstancedActionBroadcastDeltas,
+  /**
+   Each update, each broadcast property of the evaluation node which changed is copied to
+   the corresponding property of each subscribed node.  All subscribed nodes (in the same
+   phase) end up with identical values.
+  */
+  HLInstancedActionBroadcastValues,
+};
+
+/**
+ An action evaluated once per update and broadcast to any number of subscribed nodes.
+
+ When many nodes run identical actions (say, hundreds of coins bobbing with the same
+ `repeatActionForever:`), an `HLActionRunner` for each node evaluates the same action tree
+ over and over.  An `HLInstancedAction` instead evaluates a single copy of the action on a
+ private evaluation node, and then applies the resulting changes to every subscribed node,
+ so that the per-update cost is proportional to the size of the action tree plus the number
+ of nodes, rather than their product.
+
+ The broadcast properties are `position`, `zRotation`, `xScale`, `yScale`, `alpha`, and
+ `zPosition`.  Anything else the action does (colorizing, changing textures, performing
+ selectors, and so on) happens only once, to the evaluation node.
+
+ Each node subscribes with a time offset, which is how far its timeline lags behind the
+ shared timeline: A node with a time offset of `0.5` sees the action as it was half a
+ second earlier.  Nodes with the same time offset share an evaluation (a "phase"), so the
+ cost grows with the number of distinct time offsets.  Use a small number of distinct
+ offsets (for instance, a handful of evenly-spaced values) to stagger many nodes cheaply.
+
+ The shared timeline starts at the first update.  Nodes subscribed later join their phase
+ in progress, and see only the changes made from then on.  A phase created after the
+ shared timeline has passed its time offset is first advanced silently (without
+ broadcasting) to catch up.
+
+ When the action completes for a phase, the phase's nodes are unsubscribed.
+
+ The instanced action retains its subscribed nodes until they are unsubscribed.  It is
+ updated by its owner, like `HLActionWorld`, and is not encoded or copied.
+*/
+@interface HLInstancedAction : NSObject
+
+/// @name Creating an Instanced Action
+
+/**
+ Returns an initialized instanced action which broadcasts deltas.
+
+ The action is copied, and the copy is copied again for each phase.
+*/
+- (instancetype)initWithAction:(HLAction *)action;
+
+/**
+ Returns an initialized instanced action.
+
+ @param action The action to evaluate.  It is copied, and the copy is copied again for each
+               phase.
+
+ @param broadcastMode How changes are broadcast to subscribed nodes.
+*/
+- (instancetype)initWithAction:(HLAction *)action broadcastMode:(HLInstancedActionBroadcastMode)broadcastMode;
+
+/// @name Accessing the Instanced Action
+
+/**
+ The action evaluated for each phase.
+*/
+@property (nonatomic, readonly) HLAction *action;
+
+/**
+ How changes are broadcast to subscribed nodes.
+*/
+@property (nonatomic, readonly) HLInstancedActionBroadcastMode broadcastMode;
+
+/**
+ A node whose broadcast properties are the starting values of the evaluation node for
+ each new phase.
+
+ By default the template has the properties of a new `SKNode`.  This only matters for
+ actions whose changes depend on the starting values (like `HLMoveToAction`); set the
+ template's properties before subscribing nodes.
+*/
+@property (nonatomic, readonly) SKNode *templateNode;
+
+/// @name Subscribing Nodes
+
+/**
+ Subscribes a node with no time offset.
+*/
+- (void)addNode:(SKNode *)node;
+
+/**
+ Subscribes a node with a time offset.
+
+ Does nothing if the node is already subscribed.
+
+ @param node The node to subscribe.  Must not be `nil`.
+
+ @param timeOffset How far the node's timeline lags behind the shared timeline, in
+                   seconds.  Negative values are considered the same as zero.
+*/
+- (void)addNode:(SKNode *)node timeOffset:(NSTimeInterval)timeOffset;
+
+/**
+ Unsubscribes a node.
+
+ Does nothing if the node is not subscribed.
+*/
+- (void)removeNode:(SKNode *)node;
+
+/**
+ Unsubscribes all nodes.
+*/
+- (void)removeAllNodes;
+
+/**
+ The number of subscribed nodes.
+*/
+@property (nonatomic, readonly) NSUInteger nodeCount;
+
+/**
+ The number of phases (that is, of distinct time offsets among subscribed nodes), each of
+ which is evaluated separately.
+*/
+@property (nonatomic, readonly) NSUInteger phaseCount;
+
+/// @name Updating the Instanced Action
+
+/**
+ Advances the shared timeline, and broadcasts the changes to all subscribed nodes.
+
+ @param incrementalTime The elapsed time since the last update call.  Negative values are
+                        considered the same as zero.
+*/
+- (void)update:(NSTimeInterval)incrementalTime;
+
+/**
+ Advances the shared timeline modified by a speed, and broadcasts the changes to all
+ subscribed nodes.
+
+ See `[HLActionRunner update:node:speed:]` for discussion.
+
+ @param incrementalTime The elapsed time since the last update call.  Negative values are
+                        considered the same as zero.
+
+ @param speed A speed which will be used to modify the `incrementalTime`.
+*/
+- (void)update:(NSTimeInterval)incrementalTime speed:(CGFloat)speed;
+
+@end
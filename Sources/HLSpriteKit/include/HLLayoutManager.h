@@ -6,6 +6,8 @@
 //  Copyright (c) 2014 Hilo Games. All rights reserved.
 //
 
+@class HLLayoutState;
+
 /**
  An `HLLayoutManager` lays out nodes (typically the children nodes of a parent) by
  setting their positions.
@@ -54,6 +56,62 @@
 */
 - (void)layout:(NSArray *)nodes;
 
+/// @name Performing a Geometry-Only Layout
+
+@optional
+
+/**
+ Calculates a layout from plain data, without accessing any nodes.
+
+ The layout is calculated as for `layout:`, but from the passed node sizes (as returned by
+ `HLLayoutManagerGetNodeSize()`) rather than from nodes, and the calculated positions are
+ written into the passed buffer rather than set on nodes.  Because no nodes are accessed,
+ a layout can be calculated away from the node tree: for instance, on a background queue
+ (using a copy of the layout manager), or several times to compare candidate
+ configurations.
+
+ Notes for adopters:
+
+ - `layout:` should be implemented as measure (`HLLayoutManagerGetNodeSizes()`), compute
+   (this method), and apply (set node positions), so that the two always agree.
+
+ - Adjustments which depend on the kind of node (for instance, label Y offsets) are not
+   included in the calculated positions, and are left to `layout:`.  Document them, and
+   report label Y offsets through `labelOffsetYForNodeAtIndex:`.
+
+ - Last-layout state (for instance, the overall size of the layout) is updated as for
+   `layout:`.  The layout manager is not otherwise modified.
+
+ - Positions of items the manager would not lay out (for instance, those beyond its
+   configured count) are left unchanged in the buffer.
+
+ @param sizes The sizes of the nodes to be laid out, in node order.  Layout managers
+              which do not consider node sizes accept `NULL`.
+
+ @param count The number of nodes to be laid out.
+
+ @param positions A buffer of at least `count` positions, into which the calculated
+                  position of each node is written.
+*/
+- (void)layoutSizes:(const CGSize *)sizes count:(NSUInteger)count getPositions:(CGPoint *)positions;
+
+/**
+ Returns the Y offset which `layout:` adds to the calculated position of the node at the
+ passed index, if that node is a label node.
+
+ Callers of `layoutSizes:count:getPositions:` which later position label nodes themselves
+ can add the offset so that the nodes end up where `layout:` would have put them.  The
+ offset is determined by the current configuration of the layout manager.
+
+ Notes for adopters:
+
+ - Implement if `layout:` offsets label nodes.  The offset must not depend on the sizes of
+   the nodes.
+*/
+- (CGFloat)labelOffsetYForNodeAtIndex:(NSUInteger)nodeIndex;
+
+@required
+
 /// @name Accessing Last-Layout State
 
 /**
@@ -137,7 +195,52 @@
    positions of the laid-out nodes.  In that case, we don't want extra state objects
    flying around; we want reusable code which knows how to do useful calculations
    on the already-extant last-layout state information.  So: global helper function.
+
+ In the end, hit testing (the most common use of last-layout state) was unified with a
+ single plain-old-data state object, `HLLayoutState`, returned optionally by
+ `layout:getState:`.  It is not polymorphic: every layout is described as lines of cells,
+ with boundaries kept in C arrays, so that finding the cell containing a point is a binary
+ search without allocation or node access.  The older helpers remain for compatibility.
+*/
+
+@optional
+
+/**
+ Lays out the passed nodes, as with `layout:`, and optionally returns the cell geometry
+ of the layout.
+
+ Cells of the returned state are indexed as the nodes laid out.  Layout managers which do
+ not arrange nodes in cells (for instance, `HLRingLayoutManager`) do not implement this
+ method.
+
+ @param nodes The nodes to lay out.
+
+ @param state If not `NULL`, returns the cell geometry of the layout.
+*/
+- (void)layout:(NSArray *)nodes getState:(HLLayoutState * __autoreleasing *)state;
+
+/**
+ Calculates a layout from plain data, as with `layoutSizes:count:getPositions:`, and
+ optionally returns the cell geometry of the layout, as with `layout:getState:`.
+*/
+- (void)layoutSizes:(const CGSize *)sizes
+              count:(NSUInteger)count
+       getPositions:(CGPoint *)positions
+              state:(HLLayoutState * __autoreleasing *)state;
+
+@end
+
+/**
+ An optional protocol for nodes which report their own size for layout purposes.
+
+ See `HLLayoutManagerGetNodeSize()`.
 */
+@protocol HLLayoutSizing <NSObject>
+
+/**
+ The size of the node for layout purposes.
+*/
+- (CGSize)layoutSize;
 
 @end
 
@@ -148,11 +251,34 @@
  In particular, some managers allow layout geometry to be specified as "automatic" based
  on the nodes laid out, but there is no one way to calculate the size of a node.  This is
  a standard, simplified way (rather than using, say, `calculateAccumulatedFrame`): If the
- node responds to `size`, then that property is used; if the node is an SKLabelNode, then
- the frame size is returned; otherwise, the size is considered to be zero.
+ node conforms to `HLLayoutSizing`, then its `layoutSize` is used; if the node is an
+ SKLabelNode, then the frame size is returned; if the node responds to `size` (returning
+ `CGSize`), then that property is used; otherwise, the size is considered to be zero.
+
+ Which of these applies is determined once per class and cached, so methods added to (or
+ replaced in) a class at runtime after its nodes have been measured are not noticed until
+ `HLLayoutManagerInvalidateNodeSizeCache()` is called.
 */
 CGSize HLLayoutManagerGetNodeSize(id node);
 
+/**
+ Discards the per-class resolutions cached by `HLLayoutManagerGetNodeSize()` and related
+ functions, so that each class is resolved again when its nodes are next measured.
+
+ Call after adding, replacing, or swizzling `layoutSize` or `size` methods (or adding
+ `HLLayoutSizing` conformance) at runtime for classes which have already been measured,
+ and after disposing of a runtime-created class (since its address might be reused for
+ another class).  Safe to call from any thread; measurements already in progress on other
+ threads might still use the old resolutions.
+*/
+void HLLayoutManagerInvalidateNodeSizeCache(void);
+
+/**
+ Convenience method (for layout managers) which gets the sizes of all passed nodes, as
+ with `HLLayoutManagerGetNodeSize()`, into a buffer of at least `[nodes count]` sizes.
+*/
+void HLLayoutManagerGetNodeSizes(NSArray *nodes, CGSize *sizes);
+
 /**
  Convenience method (for layout managers) providing a standard way to calculate the required
  width of a node for layout purposes.
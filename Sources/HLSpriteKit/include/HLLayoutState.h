@@ -0,0 +1,127 @@
+//
+//  HLLayoutState.h
+//  HLSpriteKit
+//
+//  Created by Karl Voskuil on 10/16/26.
+//  Copyright © 2026 Hilo Games. All rights reserved.
+//
+
+#import <SpriteKit/SpriteKit.h>
+
+/**
+ The axis along which the lines of an `HLLayoutState` are arranged.
+*/
+typedef NS_ENUM(NSInteger, HLLayoutStateAxis) {
+  /**
+   Lines are arranged horizontally (as columns), and the cells within each line
+   vertically.
+  */
+  HLLayoutStateAxisX,
+  /**
+   Lines are arranged vertically (as rows), and the cells within each line horizontally.
+  */
+  HLLayoutStateAxisY,
+};
+
+/**
+ The cell geometry of a layout, kept as plain data for fast queries after layout.
+
+ Layout managers lay out nodes in cells, and owners often need to know which cell
+ contains a point (for instance, which menu item was tapped).  Rather than deriving cells
+ from the positions of the laid-out nodes, a layout manager can return (see
+ `[HLLayoutManager layout:getState:]`) the cell boundaries it calculated.
+
+ The state is a list of lines, each containing a list of cells.  Lines are intervals
+ along the line axis; cells are intervals along the other axis, within their line.  Cells
+ are numbered consecutively through all lines, in the order added, which (for the layout
+ managers in this library) is the order of the laid-out nodes.  For example, the rows of
+ an `HLTableLayoutManager` are lines along the Y axis, and its cells are the columns of
+ each row.  Some layouts are one-dimensional: An `HLStackLayoutManager` has a single
+ unbounded line.
+
+ Boundaries are stored in C arrays (cumulative, like prefix sums: the absolute start and
+ end of each line and cell, plus the index of the first cell of each line), so queries are
+ binary searches, with no allocation and no access to nodes.  Lines and cells may be added
+ in increasing or decreasing coordinate order, but must be consistent within a list.
+ Spaces between cells (for instance, separators) are not part of any cell.
+
+ A state is not updated by later layouts; it describes only the layout that returned it.
+*/
+@interface HLLayoutState : NSObject
+
+/// @name Creating a Layout State
+
+/**
+ Returns an initialized, empty layout state with lines along the Y axis.
+*/
+- (instancetype)init;
+
+/**
+ Returns an initialized, empty layout state with lines along the passed axis.
+*/
+- (instancetype)initWithLineAxis:(HLLayoutStateAxis)lineAxis NS_DESIGNATED_INITIALIZER;
+
+/// @name Building a Layout State
+
+/**
+ Adds a line spanning the passed coordinates along the line axis.
+
+ The coordinates may be passed in either order.  Pass `-CGFLOAT_MAX` and `CGFLOAT_MAX` for
+ a line without bounds.  Subsequent cells are added to this line.
+*/
+- (void)addLineFrom:(CGFloat)start to:(CGFloat)end;
+
+/**
+ Adds a cell spanning the passed coordinates along the cell axis to the last line added.
+
+ The coordinates may be passed in either order.  A line must have been added.
+*/
+- (void)addCellFrom:(CGFloat)start to:(CGFloat)end;
+
+/// @name Querying a Layout State
+
+/**
+ The axis along which lines are arranged.
+*/
+@property (nonatomic, readonly) HLLayoutStateAxis lineAxis;
+
+/**
+ The number of lines in the layout.
+*/
+@property (nonatomic, readonly) NSUInteger lineCount;
+
+/**
+ The number of cells in the layout.
+*/
+@property (nonatomic, readonly) NSUInteger cellCount;
+
+/**
+ Returns the index of the cell containing the passed point, or `NSNotFound` if there is
+ none.
+
+ Cell boundaries are inclusive, so a point exactly on the border between adjacent cells
+ may be found in either.  Runs in O(log n) time.
+*/
+- (NSUInteger)cellContainingPoint:(CGPoint)point;
+
+/**
+ Returns the index of the line containing the passed point, or `NSNotFound` if there is
+ none.
+*/
+- (NSUInteger)lineContainingPoint:(CGPoint)point;
+
+/**
+ Returns the indexes of the cells intersecting the passed rectangle.
+
+ Boundaries are inclusive, as for `cellContainingPoint:`.  Lines and cells are assumed not
+ to overlap their neighbors.  Runs in O(k log n) time, where k is the number of lines
+ intersecting the rectangle.
+*/
+- (NSIndexSet *)cellIndexesIntersectingRect:(CGRect)rect;
+
+/**
+ Returns the range of cell indexes in the passed line.
+*/
+- (NSRange)cellRangeOfLineAtIndex:(NSUInteger)lineIndex;
+
+@end
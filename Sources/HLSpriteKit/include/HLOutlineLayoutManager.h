@@ -133,6 +133,42 @@ FOUNDATION_EXPORT const CGFloat HLOutlineLayoutManagerEpsilon;
 */
 - (void)layout:(NSArray *)nodes animatedDuration:(NSTimeInterval)duration delay:(NSTimeInterval)delay;
 
+/**
+ Layout and (optionally) return the cell geometry of the layout.
+
+ Each laid-out node is a line of the state (not including separators), with a single cell
+ unbounded in X.  See `[HLLayoutManager layout:getState:]`.
+*/
+- (void)layout:(NSArray *)nodes getState:(HLLayoutState * __autoreleasing *)state;
+
+/**
+ Calculates the positions of nodes with the passed sizes, without accessing any nodes.
+
+ See `[HLLayoutManager layoutSizes:count:getPositions:]`.  As with `layout:`, only as many
+ positions are calculated as there are `nodeLevels`.  The positions do not include
+ `levelLabelOffsetYs`, which `layout:` adds for label nodes.  Updates `height`.
+*/
+- (void)layoutSizes:(const CGSize *)sizes count:(NSUInteger)count getPositions:(CGPoint *)positions;
+
+/**
+ Calculates the positions of nodes with the passed sizes, and (optionally) returns the cell
+ geometry of the layout.
+
+ See `layoutSizes:count:getPositions:` and `layout:getState:`.
+*/
+- (void)layoutSizes:(const CGSize *)sizes
+              count:(NSUInteger)count
+       getPositions:(CGPoint *)positions
+              state:(HLLayoutState * __autoreleasing *)state;
+
+/**
+ Returns the Y offset which `layout:` adds to the position of the label node at the passed
+ index, from `levelLabelOffsetYs`.
+
+ See `[HLLayoutManager labelOffsetYForNodeAtIndex:]`.
+*/
+- (CGFloat)labelOffsetYForNodeAtIndex:(NSUInteger)nodeIndex;
+
 /// @name Getting and Setting Outline Geometry
 
 /**
@@ -369,7 +405,8 @@ FOUNDATION_EXPORT const CGFloat HLOutlineLayoutManagerEpsilon;
  `HLOutlineLayoutManager` (which involves a few array lookups and `NSValue` conversions).
  X position is not considered.  Separators (both "before" and "after") are not considered
  to be part of the node's line; they do not need to be passed because they are inferred
- from current node position.
+ from current node position.  For repeated queries, prefer the `HLLayoutState` returned by
+ `layout:getState:`, which does not access the nodes.
 */
 NSUInteger HLOutlineLayoutManagerLineContainingPointY(NSArray *nodes,
                                                       CGFloat pointY,
@@ -115,6 +115,14 @@ FOUNDATION_EXPORT const CGFloat HLParallaxLayoutManagerEpsilon;
 */
 - (void)layout:(NSArray *)nodes;
 
+/**
+ Calculates the positions of the passed number of nodes, without accessing any nodes.
+
+ See `[HLLayoutManager layoutSizes:count:getPositions:]`.  Parallax does not consider node
+ size, so `sizes` is ignored and may be `NULL`.
+*/
+- (void)layoutSizes:(const CGSize *)sizes count:(NSUInteger)count getPositions:(CGPoint *)positions;
+
 /// @name Getting and Setting Parallax Geometry
 
 /**
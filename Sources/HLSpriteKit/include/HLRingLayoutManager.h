@@ -33,10 +33,12 @@ FOUNDATION_EXPORT const CGFloat HLRingLayoutManagerEpsilon;
  For layout to have an effect: `radii` must have at least one element, and one of the
  `setThetas*` methods must have been called with non-empty parameters.
 
- The order of the passed nodes determines position in the ring.  A ring position is
- skipped if the corresponding element in the array is not a kind of `SKNode` class.  (It
- is suggested to pass `[NSNull null]` or `[SKNode node]` to intentionally leave positions
- empty.)
+ The order of the passed nodes determines position in the ring.  Elements in the array
+ which are not a kind of `SKNode` class are skipped: They are not positioned, and (unless
+ thetas are assigned with `setThetas:`) they do not advance the theta for the next node.
+ To intentionally leave a ring position empty, pass `[SKNode node]`.  (Thetas spread by
+ `setThetasWithInitialTheta:` are divided among all elements of the array, though,
+ including skipped ones.)
 
  Some configurations of a ring layout manager only make sense for a fixed number of
  nodes (see, for example, `setThetas:`).  In that case, only as many nodes will be laid
@@ -58,6 +60,15 @@ FOUNDATION_EXPORT const CGFloat HLRingLayoutManagerEpsilon;
 */
 - (void)layout:(NSArray *)nodes getThetas:(NSArray * __autoreleasing *)thetas;
 
+/**
+ Calculates the positions of the passed number of nodes, without accessing any nodes.
+
+ See `[HLLayoutManager layoutSizes:count:getPositions:]`.  The ring does not consider node
+ size, so `sizes` is ignored and may be `NULL`.  Every position is calculated, as if all
+ nodes passed to `layout:` were kinds of `SKNode`.
+*/
+- (void)layoutSizes:(const CGSize *)sizes count:(NSUInteger)count getPositions:(CGPoint *)positions;
+
 /// @name Getting and Setting Ring Geometry
 
 /**
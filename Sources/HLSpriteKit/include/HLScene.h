@@ -8,6 +8,7 @@
 
 #import <SpriteKit/SpriteKit.h>
 
+#import "HLAction.h"
 #import "HLGestureTarget.h"
 
 /**
@@ -125,6 +126,9 @@ FOUNDATION_EXPORT NSString * const HLSceneChildResizeWithScene;
 
    - modal presentation of a node above the scene
 
+   - a registry of `HLAction` action runners, so that only animated nodes need be updated
+     each frame
+
  ## Shared Gesture Recognition System
 
  `HLScene` includes a gesture recognition system that can forward `UIGestureRecognizer`
@@ -154,9 +158,9 @@ FOUNDATION_EXPORT NSString * const HLSceneChildResizeWithScene;
    forward gestures.
 */
 #if TARGET_OS_IPHONE
-@interface HLScene : SKScene <NSCoding, UIGestureRecognizerDelegate>
+@interface HLScene : SKScene <NSCoding, UIGestureRecognizerDelegate, HLActionRunnerRegistryOwner>
 #else
-@interface HLScene : SKScene <NSCoding, NSGestureRecognizerDelegate>
+@interface HLScene : SKScene <NSCoding, NSGestureRecognizerDelegate, HLActionRunnerRegistryOwner>
 #endif
 
 /// @name Loading Scene Assets
@@ -290,6 +294,29 @@ FOUNDATION_EXPORT NSString * const HLSceneChildResizeWithScene;
 */
 - (void)removeAllSharedGestureRecognizers;
 
+/// @name Updating Action Runners
+
+/**
+ A registry of action runners for nodes in this scene.
+
+ Nodes join this registry explicitly using `[SKNode hlSetActionRunnerRegistry:]`.  If the
+ registry's `enrollsRunnersAutomatically` is set, then nodes in the scene which run actions
+ using `[SKNode hlRunAction:withKey:]` join it automatically; they leave it when their
+ actions complete, or when they leave the scene.  If set when the scene is encoded, then
+ after decoding, nodes in the scene with actions are rejoined to the registry.
+
+ Created lazily on first access.
+*/
+- (HLActionRunnerRegistry *)actionRunnerRegistry;
+
+/**
+ Updates all action runners in the scene's `actionRunnerRegistry`.
+
+ This is intended to be called by the subclass once per frame, typically from `update:`,
+ in place of calling `[SKNode hlActionRunnerUpdate:]` on each node.
+*/
+- (void)updateAllRunners:(NSTimeInterval)incrementalTime;
+
 /// @name Presenting a Modal Node
 
 /**
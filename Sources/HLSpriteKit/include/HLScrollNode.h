@@ -295,6 +295,16 @@ typedef NS_ENUM(NSInteger, HLScrollNodeContentScaleMinimumMode)
 */
 - (void)setContentOffset:(CGPoint)contentOffset contentScale:(CGFloat)contentScale;
 
+/**
+ Returns the area of the content visible in the `HLScrollNode`, in the content coordinate
+ system.
+
+ The area is calculated from `size`, `anchorPoint`, `contentOffset`, and `contentScale`;
+ it does not account for any clipping or scaling above the `HLScrollNode`.  Returns
+ `CGRectNull` if the content scale is not positive.
+*/
+- (CGRect)visibleContentRect;
+
 /**
  Returns an action that will animate a change to the content offset.
 
@@ -7,6 +7,10 @@
 //
 
 #import "HLAction.h"
+#import "HLActionArchiver.h"
+#import "HLActionCommandQueue.h"
+#import "HLActionDescriptor.h"
+#import "HLActionWorld.h"
 #import "HLComponentNode.h"
 #import "HLEmitterStore.h"
 #import "HLFunction.h"
@@ -15,11 +19,13 @@
 #import "HLGridNode.h"
 #import "HLHacktion.h"
 #import "HLIconNode.h"
+#import "HLInstancedAction.h"
 #import "HLItemContentNode.h"
 #import "HLItemNode.h"
 #import "HLItemsNode.h"
 #import "HLLabelButtonNode.h"
 #import "HLLayoutManager.h"
+#import "HLLayoutState.h"
 #import "HLLog.h"
 #import "HLMath.h"
 #import "HLMenuNode.h"
@@ -36,6 +42,7 @@
 #import "HLTiledNode.h"
 #import "HLToolbarNode.h"
 #import "HLUglyShuffler.h"
+#import "HLVirtualListNode.h"
 #import "HLWrapLayoutManager.h"
 #import "NSGestureRecognizer+MultipleActions.h"
 #import "SKLabelNode+HLLabelNodeAdditions.h"
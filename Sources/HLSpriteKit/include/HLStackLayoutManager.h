@@ -295,6 +295,106 @@ typedef NS_ENUM(NSInteger, HLStackLayoutManagerStackDirection) {
 */
 - (void)layout:(NSArray *)nodes getCellLengths:(NSArray * __autoreleasing *)cellLengths;
 
+/**
+ Layout and (optionally) return the cell geometry of the layout.
+
+ The state has a single unbounded line; cells are along the stacking dimension, and do
+ not include `cellSeparator`.  See `[HLLayoutManager layout:getState:]`.
+*/
+- (void)layout:(NSArray *)nodes getState:(HLLayoutState * __autoreleasing *)state;
+
+/**
+ Calculates the positions of nodes with the passed sizes, without accessing any nodes.
+
+ See `[HLLayoutManager layoutSizes:count:getPositions:]`.  The positions do not include
+ `cellLabelOffsetY`, which `layout:` adds for label nodes.  Updates `length`.
+*/
+- (void)layoutSizes:(const CGSize *)sizes count:(NSUInteger)count getPositions:(CGPoint *)positions;
+
+/**
+ Calculates the positions of nodes with the passed sizes, and (optionally) returns the cell
+ geometry of the layout.
+
+ See `layoutSizes:count:getPositions:` and `layout:getState:`.
+*/
+- (void)layoutSizes:(const CGSize *)sizes
+              count:(NSUInteger)count
+       getPositions:(CGPoint *)positions
+              state:(HLLayoutState * __autoreleasing *)state;
+
+/**
+ Returns the Y offset which `layout:` adds to the position of the label node at the passed
+ index, from `cellLabelOffsetY`.
+
+ See `[HLLayoutManager labelOffsetYForNodeAtIndex:]`.
+*/
+- (CGFloat)labelOffsetYForNodeAtIndex:(NSUInteger)nodeIndex;
+
+/// @name Performing an Incremental Layout
+
+/**
+ Set the positions of all passed nodes, as with `layout:`, but reusing work from the last
+ incremental layout where possible.
+
+ The stack remembers the measured length of each node and the offset of each cell.  After
+ the first incremental layout, the owner reports changes to the list of nodes (using
+ `noteNodesInsertedInRange:`, `noteNodesRemovedInRange:`, and `noteNodesResizedInRange:`),
+ and the next incremental layout measures only the new and resized nodes, and recalculates
+ and repositions only from the first changed cell onwards.  For instance, appending a line
+ to a long downwards stack of labels with `anchorPoint` `1.0` measures and positions only
+ the new label.
+
+ Unchanged nodes before the first changed cell are not repositioned, so their positions
+ must not be changed by the owner in the meantime.
+
+ Some changes require more work:
+
+ - If the start of the stack moves (for instance, because the stack length changed and
+   the stack is anchored at its center), all nodes are repositioned, though none are
+   remeasured.
+
+ - If `stackDirection` or `cellLengths` changes, or if the number of nodes does not match
+   the reported changes, all nodes are remeasured.  (Changes to other layout-affecting
+   properties are noticed, too.)
+
+ - If any cells are fill cells (see `cellLengths`), every incremental layout is a full
+   layout.
+
+ Incremental state is not encoded or copied.
+*/
+- (void)layoutIncrementally:(NSArray *)nodes;
+
+/**
+ Reports that nodes were inserted in the passed range of the array of nodes since the
+ last incremental layout.
+
+ See `layoutIncrementally:`.  Ranges refer to the array as it is after any previously
+ reported changes.  Has no effect if there has been no incremental layout.
+*/
+- (void)noteNodesInsertedInRange:(NSRange)range;
+
+/**
+ Reports that nodes were removed from the passed range of the array of nodes since the
+ last incremental layout.
+
+ See `noteNodesInsertedInRange:`.
+*/
+- (void)noteNodesRemovedInRange:(NSRange)range;
+
+/**
+ Reports that nodes in the passed range of the array of nodes have changed size since the
+ last incremental layout.
+
+ See `noteNodesInsertedInRange:`.
+*/
+- (void)noteNodesResizedInRange:(NSRange)range;
+
+/**
+ Discards incremental layout state, so that the next incremental layout measures and
+ positions every node.
+*/
+- (void)invalidateIncrementalLayout;
+
 /// @name Getting and Setting Stack Geometry
 
 /**
@@ -467,6 +567,8 @@ typedef NS_ENUM(NSInteger, HLStackLayoutManagerStackDirection) {
  The algorithm uses binary search in the nodes list (assuming it is ordered by position in
  the stacking dimension), and calculates cell length in the same way it is calculated in
  `HLStackLayoutManager` (which involves a few array lookups and `NSValue` conversions).
+ For repeated queries, prefer the `HLLayoutState` returned by `layout:getState:`, which
+ does not access the nodes.
  The non-stacking dimension is not considered.  The stacking direction could be inferred,
  but the stacking dimension cannot.  The cell separator is not considered to be part of
  the node's cell; it is inferred from the current node position.
@@ -154,6 +154,41 @@ FOUNDATION_EXPORT const CGFloat HLTableLayoutManagerEpsilon;
 */
 - (void)layout:(NSArray *)nodes getColumnWidths:(NSArray * __autoreleasing *)columnWidths rowHeights:(NSArray * __autoreleasing *)rowHeights;
 
+/**
+ Layout and (optionally) return the cell geometry of the layout.
+
+ Rows are the lines of the state, and columns the cells of each row; separators and the
+ table border are not part of any cell.  See `[HLLayoutManager layout:getState:]`.
+*/
+- (void)layout:(NSArray *)nodes getState:(HLLayoutState * __autoreleasing *)state;
+
+/**
+ Calculates the positions of nodes with the passed sizes, without accessing any nodes.
+
+ See `[HLLayoutManager layoutSizes:count:getPositions:]`.  The positions do not include
+ `rowLabelOffsetYs`, which `layout:` adds for label nodes.  Updates `rowCount` and `size`.
+*/
+- (void)layoutSizes:(const CGSize *)sizes count:(NSUInteger)count getPositions:(CGPoint *)positions;
+
+/**
+ Calculates the positions of nodes with the passed sizes, and (optionally) returns the cell
+ geometry of the layout.
+
+ See `layoutSizes:count:getPositions:` and `layout:getState:`.
+*/
+- (void)layoutSizes:(const CGSize *)sizes
+              count:(NSUInteger)count
+       getPositions:(CGPoint *)positions
+              state:(HLLayoutState * __autoreleasing *)state;
+
+/**
+ Returns the Y offset which `layout:` adds to the position of the label node at the passed
+ index, from `rowLabelOffsetYs`.
+
+ See `[HLLayoutManager labelOffsetYForNodeAtIndex:]`.
+*/
+- (CGFloat)labelOffsetYForNodeAtIndex:(NSUInteger)nodeIndex;
+
 /// @name Getting and Setting Table Geometry
 
 /**
@@ -0,0 +1,227 @@
+//
+//  HLVirtualListNode.h
+//  HLSpriteKit
+//
+//  Created by Karl Voskuil on 10/16/26.
+//  Copyright © 2026 Hilo Games. All rights reserved.
+//
+
+#import <SpriteKit/SpriteKit.h>
+
+#import "HLComponentNode.h"
+#import "HLLayoutManager.h"
+
+@class HLScrollNode;
+@protocol HLVirtualListNodeDataSource;
+
+/**
+ `HLVirtualListNode` presents a large number of items, laid out by a layout manager, while
+ creating nodes only for the items currently visible.
+
+ Item geometry is calculated from item sizes alone (provided by the `dataSource`), using
+ the layout manager's geometry-only layout (see `[HLLayoutManager
+ layoutSizes:count:getPositions:]`).  Then, as the visible area changes, nodes are
+ requested from the data source for items coming into view, and the nodes of items going
+ out of view are removed and kept for reuse (see `dequeueReusableNode`).  The number of
+ nodes in the tree, then, depends on the size of the visible area rather than on the
+ number of items.
+
+ The virtual list node is typically the content node of an `HLScrollNode` (or a
+ descendant of it), with the owner calling `updateForScrollNode:` every frame:
+
+     - (void)update:(NSTimeInterval)currentTime
+     {
+       [_listNode updateForScrollNode:_scrollNode];
+     }
+
+ The call is cheap when the visible area has not changed.  (The scroll node's delegate is
+ not sufficient for this purpose: the content moves without notification, for instance,
+ during animated scrolling.)
+
+ Nodes are positioned as by `[HLLayoutManager layout:]`: at the calculated positions,
+ plus the label Y offset for label nodes (see `[HLLayoutManager
+ labelOffsetYForNodeAtIndex:]`).  Items which do not yet have nodes are tested for
+ visibility and containment using their sizes and anchor points, as reported by the data
+ source.
+*/
+@interface HLVirtualListNode : HLComponentNode <NSCoding>
+
+/// @name Creating a Virtual List Node
+
+/**
+ Initializes a virtual list node with a layout manager.
+
+ See `layoutManager`.
+*/
+- (instancetype)initWithLayoutManager:(id <HLLayoutManager>)layoutManager;
+
+/// @name Providing Items
+
+/**
+ The data source which provides the item count, item sizes, and item nodes.
+
+ Changes in the data source are not noticed until `reloadData`.
+*/
+@property (nonatomic, weak) id <HLVirtualListNodeDataSource> dataSource;
+
+/**
+ Discards all item geometry and nodes, and reloads them from the data source.
+
+ Must be called after the data source (or its data) changes, after the layout manager is
+ changed or configured, and after decoding.  Item sizes are requested for all items, and
+ item nodes only for items within the last visible area.
+*/
+- (void)reloadData;
+
+/**
+ Returns a node previously removed from the list, for reuse by the data source, or `nil`
+ if none is available.
+
+ Nodes are kept for reuse when their items go out of view.  Since all items share a single
+ collection of reusable nodes, lists with different kinds of item nodes must check (and
+ reconfigure) the kind of the node returned.
+*/
+- (SKNode *)dequeueReusableNode;
+
+/// @name Configuring Layout
+
+/**
+ The layout manager which calculates item positions.
+
+ The layout manager must implement `[HLLayoutManager layoutSizes:count:getPositions:]`.
+ If it also implements `[HLLayoutManager layoutSizes:count:getPositions:state:]`, then the
+ returned cell geometry is used to find visible items in logarithmic time; otherwise, all
+ items are tested, assuming that item nodes are centered on their positions.
+
+ Changes to the layout manager (or its configuration) are not noticed until `reloadData`.
+*/
+@property (nonatomic, strong) id <HLLayoutManager> layoutManager;
+
+/**
+ The distance beyond the visible area, in all directions, within which items are also
+ given nodes.
+
+ A margin creates nodes for items shortly before they come into view, and keeps nodes for
+ items shortly after they go out of view, so that small movements back and forth do not
+ recreate nodes.
+
+ Default value `0.0`.
+*/
+@property (nonatomic, assign) CGFloat prefetchMargin;
+
+/// @name Updating the Visible Area
+
+/**
+ Sets the visible area, in the coordinate system of this node, and creates or removes item
+ nodes accordingly.
+
+ Returns immediately if the area has not changed since the last update.  Pass `CGRectNull`
+ to remove all item nodes.
+*/
+- (void)updateVisibleRect:(CGRect)rect;
+
+/**
+ Sets the visible area to the visible content of the passed scroll node, as with
+ `updateVisibleRect:`.
+
+ This node must be the scroll node's content node, or a descendant of it.  See
+ `[HLScrollNode visibleContentRect]`.
+*/
+- (void)updateForScrollNode:(HLScrollNode *)scrollNode;
+
+/**
+ The visible area last set.
+
+ Default value `CGRectNull`.
+*/
+@property (nonatomic, readonly) CGRect visibleRect;
+
+/// @name Accessing Items
+
+/**
+ The number of items, as last loaded from the data source.
+*/
+@property (nonatomic, readonly) NSUInteger itemCount;
+
+/**
+ The indexes of the items which currently have nodes.
+*/
+@property (nonatomic, readonly) NSIndexSet *visibleItemIndexes;
+
+/**
+ Returns the node of the item at the passed index, or `nil` if the item does not currently
+ have a node.
+*/
+- (SKNode *)nodeForItemAtIndex:(NSUInteger)itemIndex;
+
+/**
+ Returns the calculated position of the item at the passed index, in the coordinate system
+ of this node.
+
+ The position does not include any label Y offset applied to the item's node.
+*/
+- (CGPoint)positionOfItemAtIndex:(NSUInteger)itemIndex;
+
+/**
+ Returns the index of the item containing the passed point, or `NSNotFound` if there is
+ none.
+
+ Items need not have nodes to be found.  If the layout manager returns cell geometry, the
+ point is tested against cells; otherwise, against item sizes and anchor points.
+
+ @param location The location, in the coordinate system of this node.
+*/
+- (NSUInteger)itemContainingPoint:(CGPoint)location;
+
+@end
+
+/**
+ A data source for `HLVirtualListNode`.
+*/
+@protocol HLVirtualListNodeDataSource <NSObject>
+
+/// @name Providing Items
+
+/**
+ Returns the number of items in the list.
+*/
+- (NSUInteger)numberOfItemsInVirtualListNode:(HLVirtualListNode *)virtualListNode;
+
+/**
+ Returns the size of the item at the passed index, for layout purposes.
+
+ The size should match the size of the node later returned for the item, as measured by
+ `HLLayoutManagerGetNodeSize()`.
+*/
+- (CGSize)virtualListNode:(HLVirtualListNode *)virtualListNode sizeForItemAtIndex:(NSUInteger)itemIndex;
+
+/**
+ Returns a node for the item at the passed index, which is coming into view.
+
+ Typically the data source reuses a node from `[HLVirtualListNode dequeueReusableNode]`,
+ if available, and configures it for the item.  The returned node is positioned and added
+ as a child of the virtual list node.
+*/
+- (SKNode *)virtualListNode:(HLVirtualListNode *)virtualListNode nodeForItemAtIndex:(NSUInteger)itemIndex;
+
+@optional
+
+/**
+ Returns the anchor point of the node for the item at the passed index.
+
+ Used, with the item size, to find the frames of items which do not yet have nodes.  If
+ not implemented, all items are considered to have an anchor point of `(0.5, 0.5)`.  Label
+ nodes are visually centered on their positions by the layout manager's label Y offsets,
+ so return `(0.5, 0.5)` for them.
+*/
+- (CGPoint)virtualListNode:(HLVirtualListNode *)virtualListNode anchorPointForItemAtIndex:(NSUInteger)itemIndex;
+
+/**
+ Called after the node of the item at the passed index has been removed, because the item
+ went out of view or the list was reloaded.
+
+ The node is made available for reuse after this call.
+*/
+- (void)virtualListNode:(HLVirtualListNode *)virtualListNode didEndDisplayingNode:(SKNode *)node forItemAtIndex:(NSUInteger)itemIndex;
+
+@end
@@ -106,6 +106,33 @@ typedef NS_ENUM(NSInteger, HLWrapLayoutManagerJustification) {
 */
 - (void)layout:(NSArray *)nodes;
 
+/**
+ Layout and (optionally) return the cell geometry of the layout.
+
+ Lines of the state are the lines of the wrap; since lines have no breadth, each extends
+ halfway to its neighbors (by `lineSeparator`).  Cells are along the length of each line,
+ and do not include `cellSeparator`.  See `[HLLayoutManager layout:getState:]`.
+*/
+- (void)layout:(NSArray *)nodes getState:(HLLayoutState * __autoreleasing *)state;
+
+/**
+ Calculates the positions of nodes with the passed sizes, without accessing any nodes.
+
+ See `[HLLayoutManager layoutSizes:count:getPositions:]`.  Updates `size`.
+*/
+- (void)layoutSizes:(const CGSize *)sizes count:(NSUInteger)count getPositions:(CGPoint *)positions;
+
+/**
+ Calculates the positions of nodes with the passed sizes, and (optionally) returns the cell
+ geometry of the layout.
+
+ See `layoutSizes:count:getPositions:` and `layout:getState:`.
+*/
+- (void)layoutSizes:(const CGSize *)sizes
+              count:(NSUInteger)count
+       getPositions:(CGPoint *)positions
+              state:(HLLayoutState * __autoreleasing *)state;
+
 /// @name Getting and Setting Wrap Geometry
 
 /**
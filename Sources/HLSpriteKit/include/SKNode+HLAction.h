@@ -41,13 +41,40 @@
 */
 - (void)hlActionRunnerUpdate:(NSTimeInterval)incrementalTime;
 
+/**
+ Associates the attached action runner (creating one if necessary) with a registry, so
+ that it is updated (with this node) by `[HLActionRunnerRegistry updateAllRunners:]`
+ whenever it has actions.
+
+ Pass `nil` to disassociate the attached action runner from its registry.
+
+ Nodes in a scene conforming to `HLActionRunnerRegistryOwner` (like `HLScene`) do not need
+ to call this explicitly if the registry `enrollsRunnersAutomatically` and they run
+ actions using `hlRunAction:withKey:` while in the scene.  See `[HLActionRunner
+ setRegistry:node:]` for details.
+*/
+- (void)hlSetActionRunnerRegistry:(HLActionRunnerRegistry *)registry;
+
 /// @name Managing Actions
 
 /**
- Adds an action to the attached action runner, if any.
+ Adds an action to the attached action runner, creating an action runner if necessary.
+
+ If the node is in a scene which conforms to `HLActionRunnerRegistryOwner`, the scene's
+ registry `enrollsRunnersAutomatically`, and the action runner is not already associated
+ with a registry, then the action runner is associated with the scene's registry.
 */
 - (void)hlRunAction:(HLAction *)action withKey:(NSString *)key;
 
+/**
+ Adds an action descriptor to the attached action runner, creating an action runner if
+ necessary.
+
+ The action runner is associated with the scene's registry as for `hlRunAction:withKey:`.
+ See `[HLActionRunner runActionDescriptor:withKey:]` for details.
+*/
+- (void)hlRunActionDescriptor:(HLActionDescriptor *)descriptor withKey:(NSString *)key;
+
 /**
  Returns `YES` if this node has an attached action runner with actions.
 */
@@ -0,0 +1,196 @@
+//
+//  HLActionArchiverTests.m
+//  HLSpriteKit
+//
+//  Created by Karl Voskuil on 10/16/26.
+//  Copyright © 2026 Hilo Games. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "HLAction.h"
+#import "HLActionArchiver.h"
+
+@interface HLActionArchiverTestsLink : NSObject <NSCoding>
+
+@property (nonatomic, strong) id action;
+
+@property (nonatomic, strong) id next;
+
+@end
+
+@implementation HLActionArchiverTestsLink
+
+- (instancetype)initWithCoder:(NSCoder *)aDecoder
+{
+  self = [super init];
+  if (self) {
+    _action = [aDecoder decodeObjectOfClass:[HLAction class] forKey:@"action"];
+    _next = [aDecoder decodeObjectForKey:@"next"];
+  }
+  return self;
+}
+
+- (void)encodeWithCoder:(NSCoder *)aCoder
+{
+  [aCoder encodeObject:_action forKey:@"action"];
+  [aCoder encodeObject:_next forKey:@"next"];
+}
+
+@end
+
+@interface HLActionArchiverTests : XCTestCase
+
+@end
+
+@implementation HLActionArchiverTests
+
+- (HLActionRunner *)HL_actionRunner
+{
+  HLActionRunner *actionRunner = [[HLActionRunner alloc] init];
+  HLMoveByAction *moveAction = [HLAction moveByX:30.0f y:-12.0f duration:1.5];
+  moveAction.timingMode = HLActionTimingEaseInEaseOut;
+  [actionRunner runAction:[HLAction sequence:@[ [HLAction group:@[ moveAction,
+                                                                  [HLAction rotateByAngle:2.0f duration:0.75] ]],
+                                                [HLAction waitForDuration:0.5],
+                                                [HLAction repeatAction:[HLAction fadeAlphaBy:-0.1f duration:0.2] count:3] ]]
+                  withKey:@"sequence"];
+  HLScaleToAction *scaleAction = [HLAction scaleTo:2.0f duration:2.0];
+  scaleAction.speed = 0.75f;
+  [actionRunner runAction:scaleAction withKey:@"scale"];
+  [actionRunner runAction:[HLAction moveTo:CGPointMake(-5.0f, 7.0f) duration:3.0] withKey:@"moveTo"];
+  actionRunner.fixedTimeStep = 0.05;
+  return actionRunner;
+}
+
+- (void)testRoundTrip
+{
+  HLActionRunner *originalRunner = [self HL_actionRunner];
+  SKNode *originalNode = [SKNode node];
+  [originalRunner update:0.9 node:originalNode];
+
+  NSData *binaryData = [HLActionArchiver archivedDataWithRootObject:originalRunner];
+  NSData *keyedData = [NSKeyedArchiver archivedDataWithRootObject:originalRunner requiringSecureCoding:NO error:NULL];
+  XCTAssertNotNil(binaryData);
+  XCTAssertLessThan([binaryData length], [keyedData length]);
+
+  NSError *error = nil;
+  HLActionRunner *binaryRunner = [HLActionUnarchiver unarchivedObjectFromData:binaryData error:&error];
+  XCTAssertNil(error);
+  XCTAssertTrue([binaryRunner isKindOfClass:[HLActionRunner class]]);
+  NSKeyedUnarchiver *keyedUnarchiver = [[NSKeyedUnarchiver alloc] initForReadingFromData:keyedData error:NULL];
+  keyedUnarchiver.requiresSecureCoding = NO;
+  HLActionRunner *keyedRunner = [keyedUnarchiver decodeObjectForKey:NSKeyedArchiveRootObjectKey];
+  XCTAssertEqualWithAccuracy(binaryRunner.accumulatedTime, keyedRunner.accumulatedTime, 0.0);
+
+  // note: Decoded runners continue identically.
+  SKNode *binaryNode = [originalNode copy];
+  SKNode *keyedNode = [originalNode copy];
+  for (int u = 0; u < 30; ++u) {
+    [binaryRunner update:0.1 node:binaryNode];
+    [keyedRunner update:0.1 node:keyedNode];
+    XCTAssertEqual(binaryNode.position.x, keyedNode.position.x);
+    XCTAssertEqual(binaryNode.position.y, keyedNode.position.y);
+    XCTAssertEqual(binaryNode.zRotation, keyedNode.zRotation);
+    XCTAssertEqual(binaryNode.xScale, keyedNode.xScale);
+    XCTAssertEqual(binaryNode.alpha, keyedNode.alpha);
+  }
+  XCTAssertFalse([binaryRunner hasActions]);
+}
+
+- (void)testRootObjects
+{
+  HLWaitAction *sharedAction = [HLAction waitForDuration:2.0];
+  HLActionArchiver *archiver = [[HLActionArchiver alloc] init];
+  [archiver encodeRootObject:@[ sharedAction, sharedAction ]];
+  [archiver encodeRootObject:nil];
+  [archiver encodeRootObject:@{ @"name" : @"name", @"count" : @3, @"flag" : @YES, @"ratio" : @0.5 }];
+  [archiver encodeRootObject:sharedAction];
+
+  HLActionUnarchiver *unarchiver = [[HLActionUnarchiver alloc] initForReadingFromData:archiver.encodedData error:NULL];
+  XCTAssertNotNil(unarchiver);
+  NSArray *actions = [unarchiver decodeRootObject];
+  XCTAssertEqual([actions count], 2);
+  XCTAssertTrue(actions[0] == actions[1]);
+  XCTAssertEqualWithAccuracy(((HLWaitAction *)actions[0]).duration, 2.0, 0.0);
+  XCTAssertNil([unarchiver decodeRootObject]);
+  NSDictionary *dictionary = [unarchiver decodeRootObject];
+  XCTAssertEqualObjects(dictionary, (@{ @"name" : @"name", @"count" : @3, @"flag" : @YES, @"ratio" : @0.5 }));
+  // note: References may span root objects.
+  XCTAssertTrue([unarchiver decodeRootObject] == actions[0]);
+  XCTAssertFalse(unarchiver.hasMoreRootObjects);
+}
+
+- (void)testInvalidData
+{
+  NSError *error = nil;
+  id object = [HLActionUnarchiver unarchivedObjectFromData:[@"not an archive" dataUsingEncoding:NSUTF8StringEncoding] error:&error];
+  XCTAssertNil(object);
+  XCTAssertEqualObjects(error.domain, HLActionArchiverErrorDomain);
+
+  NSMutableData *truncatedData = [[HLActionArchiver archivedDataWithRootObject:[self HL_actionRunner]] mutableCopy];
+  [truncatedData setLength:([truncatedData length] / 2)];
+  HLActionUnarchiver *unarchiver = [[HLActionUnarchiver alloc] initForReadingFromData:truncatedData error:NULL];
+  XCTAssertThrowsSpecificNamed([unarchiver decodeRootObject], NSException, NSInvalidUnarchiveOperationException);
+}
+
+- (void)testAllowedClasses
+{
+  HLActionArchiverTestsLink *link = [[HLActionArchiverTestsLink alloc] init];
+  link.action = [HLAction waitForDuration:1.0];
+  NSError *error = nil;
+  HLActionArchiverTestsLink *decodedLink = [HLActionUnarchiver unarchivedObjectFromData:[HLActionArchiver archivedDataWithRootObject:link] error:&error];
+  XCTAssertNil(error);
+  XCTAssertTrue([decodedLink.action isKindOfClass:[HLWaitAction class]]);
+
+  // note: Neither plain values nor objects of other classes are allowed.
+  for (id disallowedValue in @[ @"string", @[ [HLAction waitForDuration:1.0] ], [[HLActionArchiverTestsLink alloc] init] ]) {
+    link.action = disallowedValue;
+    NSData *data = [HLActionArchiver archivedDataWithRootObject:link];
+    HLActionUnarchiver *unarchiver = [[HLActionUnarchiver alloc] initForReadingFromData:data error:NULL];
+    XCTAssertThrowsSpecificNamed([unarchiver decodeRootObject], NSException, NSInvalidUnarchiveOperationException);
+    error = nil;
+    XCTAssertNil([HLActionUnarchiver unarchivedObjectFromData:data error:&error]);
+    XCTAssertEqualObjects(error.domain, HLActionArchiverErrorDomain);
+  }
+}
+
+- (void)testReferenceCycles
+{
+  HLActionArchiverTestsLink *firstLink = [[HLActionArchiverTestsLink alloc] init];
+  HLActionArchiverTestsLink *secondLink = [[HLActionArchiverTestsLink alloc] init];
+  firstLink.next = secondLink;
+  secondLink.next = firstLink;
+  NSError *error = nil;
+  HLActionArchiverTestsLink *decodedLink = [HLActionUnarchiver unarchivedObjectFromData:[HLActionArchiver archivedDataWithRootObject:firstLink] error:&error];
+  XCTAssertNil(error);
+  XCTAssertTrue([decodedLink.next isKindOfClass:[HLActionArchiverTestsLink class]]);
+  XCTAssertTrue(((HLActionArchiverTestsLink *)decodedLink.next).next == decodedLink);
+  // note: Break the cycles.
+  secondLink.next = nil;
+  decodedLink.next = nil;
+}
+
+- (void)testNestingTooDeep
+{
+  HLActionArchiverTestsLink *link = nil;
+  for (NSUInteger l = 0; l < 1000; ++l) {
+    HLActionArchiverTestsLink *previousLink = link;
+    link = [[HLActionArchiverTestsLink alloc] init];
+    link.next = previousLink;
+  }
+  NSError *error = nil;
+  XCTAssertNil([HLActionUnarchiver unarchivedObjectFromData:[HLActionArchiver archivedDataWithRootObject:link] error:&error]);
+  XCTAssertEqualObjects(error.domain, HLActionArchiverErrorDomain);
+
+  // note: Decoded values are nested too, even without objects.
+  NSArray *array = @[];
+  for (NSUInteger a = 0; a < 1000; ++a) {
+    array = @[ array ];
+  }
+  error = nil;
+  XCTAssertNil([HLActionUnarchiver unarchivedObjectFromData:[HLActionArchiver archivedDataWithRootObject:array] error:&error]);
+  XCTAssertNotNil(error);
+}
+
+@end
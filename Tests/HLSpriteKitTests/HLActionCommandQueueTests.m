@@ -0,0 +1,121 @@
+//
+//  HLActionCommandQueueTests.m
+//  HLSpriteKit
+//
+//  Created by Karl Voskuil on 10/16/26.
+//  Copyright © 2026 Hilo Games. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "HLActionCommandQueue.h"
+#import "SKNode+HLAction.h"
+
+@interface HLActionCommandQueueTestsThrowingRunner : HLActionRunner
+
+@end
+
+@implementation HLActionCommandQueueTestsThrowingRunner
+
+- (void)runAction:(HLAction *)action withKey:(NSString *)key
+{
+  [NSException raise:@"HLActionCommandQueueTestsException" format:@"Raised by test runner."];
+}
+
+@end
+
+@interface HLActionCommandQueueTests : XCTestCase
+
+@end
+
+@implementation HLActionCommandQueueTests
+
+- (void)testConcurrentCommands
+{
+  HLActionCommandQueue *commandQueue = [[HLActionCommandQueue alloc] init];
+  HLActionRunner *actionRunner = [[HLActionRunner alloc] init];
+  XCTAssertFalse([commandQueue hasCommands]);
+  XCTAssertEqual([commandQueue drain], 0);
+
+  const size_t commandCount = 1000;
+  dispatch_apply(commandCount, dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^(size_t c){
+    [commandQueue runAction:[HLAction waitForDuration:1.0]
+                    withKey:[NSString stringWithFormat:@"wait%zu", c]
+             onActionRunner:actionRunner];
+  });
+  XCTAssertTrue([commandQueue hasCommands]);
+  XCTAssertFalse([actionRunner hasActions]);
+
+  XCTAssertEqual([commandQueue drain], commandCount);
+  XCTAssertFalse([commandQueue hasCommands]);
+  for (size_t c = 0; c < commandCount; ++c) {
+    XCTAssertNotNil([actionRunner actionForKey:[NSString stringWithFormat:@"wait%zu", c]]);
+  }
+}
+
+- (void)testCommandOrder
+{
+  HLActionCommandQueue *commandQueue = [[HLActionCommandQueue alloc] init];
+  SKNode *node = [SKNode node];
+  [commandQueue runAction:[HLAction waitForDuration:1.0] withKey:@"a" onNode:node];
+  [commandQueue runAction:[HLAction waitForDuration:1.0] withKey:@"b" onNode:node];
+  [commandQueue removeActionForKey:@"a" onNode:node];
+  [commandQueue runAction:[HLAction waitForDuration:2.0] withKey:@"b" onNode:node];
+  XCTAssertEqual([commandQueue drain], 4);
+  XCTAssertNil([node hlActionForKey:@"a"]);
+  XCTAssertEqualWithAccuracy([node hlActionForKey:@"b"].duration, 2.0, 0.0001);
+
+  [commandQueue removeAllActionsOnNode:node];
+  [commandQueue drain];
+  XCTAssertFalse([node hlHasActions]);
+
+  HLActionRunner *actionRunner = [[HLActionRunner alloc] init];
+  [commandQueue runAction:[HLAction waitForDuration:1.0] withKey:@"a" onActionRunner:actionRunner];
+  [commandQueue runAction:[HLAction waitForDuration:1.0] withKey:@"b" onActionRunner:actionRunner];
+  [commandQueue removeAllActionsOnActionRunner:actionRunner];
+  [commandQueue runAction:[HLAction waitForDuration:1.0] withKey:@"c" onActionRunner:actionRunner];
+  XCTAssertEqual([commandQueue drain], 4);
+  XCTAssertNil([actionRunner actionForKey:@"a"]);
+  XCTAssertNil([actionRunner actionForKey:@"b"]);
+  XCTAssertNotNil([actionRunner actionForKey:@"c"]);
+}
+
+- (void)testDrainDiscardsCommandsAfterException
+{
+  HLActionCommandQueue *commandQueue = [[HLActionCommandQueue alloc] init];
+  HLActionRunner *actionRunner = [[HLActionRunner alloc] init];
+  HLActionRunner *throwingRunner = [[HLActionCommandQueueTestsThrowingRunner alloc] init];
+  __weak HLAction *weakDiscardedAction = nil;
+  @autoreleasepool {
+    HLAction *discardedAction = [HLAction waitForDuration:1.0];
+    weakDiscardedAction = discardedAction;
+    [commandQueue runAction:[HLAction waitForDuration:1.0] withKey:@"a" onActionRunner:actionRunner];
+    [commandQueue runAction:[HLAction waitForDuration:1.0] withKey:@"b" onActionRunner:throwingRunner];
+    [commandQueue runAction:discardedAction withKey:@"c" onActionRunner:actionRunner];
+  }
+  XCTAssertThrowsSpecificNamed([commandQueue drain], NSException, @"HLActionCommandQueueTestsException");
+  XCTAssertNil(weakDiscardedAction);
+  XCTAssertNotNil([actionRunner actionForKey:@"a"]);
+  XCTAssertNil([actionRunner actionForKey:@"c"]);
+  XCTAssertFalse([commandQueue hasCommands]);
+}
+
+- (void)testRegistryDrainsOnUpdate
+{
+  HLActionRunnerRegistry *registry = [[HLActionRunnerRegistry alloc] init];
+  SKNode *node = [SKNode node];
+  [node hlSetActionRunnerRegistry:registry];
+
+  dispatch_sync(dispatch_get_global_queue(QOS_CLASS_DEFAULT, 0), ^{
+    [registry.commandQueue runAction:[HLAction moveByX:10.0f y:0.0f duration:1.0] withKey:@"move" onNode:node];
+  });
+  XCTAssertEqual(registry.runnerCount, 0);
+
+  // note: The command is applied at the start of the update, and so the action is updated
+  // by it, too.
+  [registry updateAllRunners:0.5];
+  XCTAssertEqual(registry.runnerCount, 1);
+  XCTAssertEqualWithAccuracy(node.position.x, 5.0f, 0.0001f);
+}
+
+@end
@@ -0,0 +1,143 @@
+//
+//  HLActionDescriptorTests.m
+//  HLSpriteKit
+//
+//  Created by Karl Voskuil on 10/16/26.
+//  Copyright © 2026 Hilo Games. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "HLActionDescriptor.h"
+#import "SKNode+HLAction.h"
+
+@interface HLActionDescriptorTests : XCTestCase
+
+@end
+
+@implementation HLActionDescriptorTests
+
+- (HLActionDescriptor *)HL_sparkDescriptorWithArena:(HLActionArena *)arena
+{
+  HLActionDescriptor *moveDescriptor = HLActionDescriptorMoveBy(arena, 20.0f, 10.0f, 0.3);
+  HLActionDescriptorSetTimingMode(moveDescriptor, HLActionTimingEaseOut);
+  HLActionDescriptor *groupDescriptors[] = {
+    moveDescriptor,
+    HLActionDescriptorScaleTo(arena, 2.0f, 0.5f, 0.2),
+    HLActionDescriptorFadeAlphaTo(arena, 0.0f, 0.3),
+  };
+  HLActionDescriptor *sequenceDescriptors[] = {
+    HLActionDescriptorWait(arena, 0.05),
+    HLActionDescriptorGroup(arena, groupDescriptors, 3),
+    HLActionDescriptorRotateBy(arena, 1.0f, 0.1),
+  };
+  return HLActionDescriptorSequence(arena, sequenceDescriptors, 3);
+}
+
+- (HLAction *)HL_sparkAction
+{
+  HLMoveByAction *moveAction = [HLAction moveByX:20.0f y:10.0f duration:0.3];
+  moveAction.timingMode = HLActionTimingEaseOut;
+  return [HLAction sequence:@[ [HLAction waitForDuration:0.05],
+                               [HLAction group:@[ moveAction,
+                                                  [HLAction scaleXTo:2.0f y:0.5f duration:0.2],
+                                                  [HLAction fadeAlphaTo:0.0f duration:0.3] ]],
+                               [HLAction rotateByAngle:1.0f duration:0.1] ]];
+}
+
+- (void)testDescriptorMatchesAction
+{
+  HLActionArena *arena = [[HLActionArena alloc] init];
+  SKNode *descriptorNode = [SKNode node];
+  SKNode *actionNode = [SKNode node];
+  [descriptorNode hlRunActionDescriptor:[self HL_sparkDescriptorWithArena:arena] withKey:@"spark"];
+  [actionNode hlRunAction:[self HL_sparkAction] withKey:@"spark"];
+  XCTAssertEqual(arena.runningCount, 7);
+
+  NSTimeInterval frameTimes[] = { 0.016, 0.03, 0.1, 0.017, 0.08, 0.2, 0.05 };
+  for (size_t f = 0; f < sizeof(frameTimes) / sizeof(frameTimes[0]); ++f) {
+    [descriptorNode hlActionRunnerUpdate:frameTimes[f]];
+    [actionNode hlActionRunnerUpdate:frameTimes[f]];
+    XCTAssertEqualWithAccuracy(descriptorNode.position.x, actionNode.position.x, 0.0001);
+    XCTAssertEqualWithAccuracy(descriptorNode.position.y, actionNode.position.y, 0.0001);
+    XCTAssertEqualWithAccuracy(descriptorNode.xScale, actionNode.xScale, 0.0001);
+    XCTAssertEqualWithAccuracy(descriptorNode.alpha, actionNode.alpha, 0.0001);
+    XCTAssertEqualWithAccuracy(descriptorNode.zRotation, actionNode.zRotation, 0.0001);
+  }
+  XCTAssertFalse([descriptorNode hlHasActions]);
+  XCTAssertFalse([actionNode hlHasActions]);
+  XCTAssertEqual(arena.runningCount, 0);
+}
+
+- (void)testConvertToAction
+{
+  HLActionArena *arena = [[HLActionArena alloc] init];
+  SKNode *descriptorNode = [SKNode node];
+  SKNode *actionNode = [SKNode node];
+  [descriptorNode hlRunActionDescriptor:[self HL_sparkDescriptorWithArena:arena] withKey:@"spark"];
+  [actionNode hlRunAction:[self HL_sparkAction] withKey:@"spark"];
+  [descriptorNode hlActionRunnerUpdate:0.15];
+  [actionNode hlActionRunnerUpdate:0.15];
+
+  // note: Accessing the action converts the descriptor, which stops running.
+  HLAction *convertedAction = [descriptorNode hlActionForKey:@"spark"];
+  XCTAssertTrue([convertedAction isKindOfClass:[HLSequenceAction class]]);
+  XCTAssertEqualWithAccuracy(convertedAction.elapsedTime, [actionNode hlActionForKey:@"spark"].elapsedTime, 0.0001);
+  XCTAssertEqual(arena.runningCount, 0);
+
+  [descriptorNode hlActionRunnerUpdate:0.1];
+  [actionNode hlActionRunnerUpdate:0.1];
+  XCTAssertEqualWithAccuracy(descriptorNode.position.x, actionNode.position.x, 0.0001);
+  XCTAssertEqualWithAccuracy(descriptorNode.xScale, actionNode.xScale, 0.0001);
+  XCTAssertEqualWithAccuracy(descriptorNode.alpha, actionNode.alpha, 0.0001);
+}
+
+- (void)testCopyAndEncodeLeaveDescriptorsRunning
+{
+  HLActionArena *arena = [[HLActionArena alloc] init];
+  HLActionRunner *actionRunner = [[HLActionRunner alloc] init];
+  SKNode *node = [SKNode node];
+  [actionRunner runActionDescriptor:[self HL_sparkDescriptorWithArena:arena] withKey:@"spark"];
+  [actionRunner update:0.15 node:node];
+  XCTAssertEqual(arena.runningCount, 7);
+
+  // note: The copy and the archive get equivalent actions; the receiver keeps running its
+  // descriptor.
+  HLActionRunner *copiedRunner = [actionRunner copy];
+  NSData *archiveData = [NSKeyedArchiver archivedDataWithRootObject:actionRunner requiringSecureCoding:NO error:NULL];
+  NSKeyedUnarchiver *unarchiver = [[NSKeyedUnarchiver alloc] initForReadingFromData:archiveData error:NULL];
+  unarchiver.requiresSecureCoding = NO;
+  HLActionRunner *decodedRunner = [unarchiver decodeObjectForKey:NSKeyedArchiveRootObjectKey];
+  XCTAssertEqual(arena.runningCount, 7);
+  for (HLActionRunner *otherRunner in @[ copiedRunner, decodedRunner ]) {
+    HLAction *otherAction = [otherRunner actionForKey:@"spark"];
+    XCTAssertTrue([otherAction isKindOfClass:[HLSequenceAction class]]);
+    XCTAssertEqualWithAccuracy(otherAction.elapsedTime, 0.15, 0.0001);
+  }
+
+  SKNode *copiedNode = [node copy];
+  [actionRunner update:0.1 node:node];
+  [copiedRunner update:0.1 node:copiedNode];
+  XCTAssertEqualWithAccuracy(node.position.x, copiedNode.position.x, 0.0001);
+  XCTAssertEqualWithAccuracy(node.xScale, copiedNode.xScale, 0.0001);
+  XCTAssertEqualWithAccuracy(node.alpha, copiedNode.alpha, 0.0001);
+}
+
+- (void)testArenaRecycling
+{
+  HLActionArena *arena = [[HLActionArena alloc] initWithChunkSize:1024];
+  HLActionRunner *actionRunner = [[HLActionRunner alloc] init];
+  SKNode *node = [SKNode node];
+  for (int f = 0; f < 100; ++f) {
+    [arena recycle];
+    [actionRunner runActionDescriptor:HLActionDescriptorMoveBy(arena, 1.0f, 0.0f, 0.05)
+                              withKey:[NSString stringWithFormat:@"spark%d", f]];
+    [actionRunner update:0.02 node:node];
+  }
+  // note: Each spark runs for three frames, so only a few are running at once, and the
+  // arena stops growing.
+  XCTAssertLessThanOrEqual(arena.runningCount, 3);
+  XCTAssertLessThanOrEqual(arena.chunkBytes, 4096);
+}
+
+@end
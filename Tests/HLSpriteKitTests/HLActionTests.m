@@ -9,6 +9,21 @@
 #import <XCTest/XCTest.h>
 
 #import "HLAction.h"
+#import "HLScene.h"
+#import "SKNode+HLAction.h"
+
+@interface HLActionTestsThrowingRunner : HLActionRunner
+
+@end
+
+@implementation HLActionTestsThrowingRunner
+
+- (void)update:(NSTimeInterval)incrementalTime node:(SKNode *)node
+{
+  [NSException raise:@"HLActionTestsException" format:@"Raised by test runner."];
+}
+
+@end
 
 @interface HLActionTests : XCTestCase
 
@@ -17,6 +32,7 @@
 @implementation HLActionTests
 {
   NSUInteger _counter;
+  NSMutableArray *_recordedPositions;
 }
 
 - (void)HL_incrementCounter
@@ -24,6 +40,41 @@
   ++_counter;
 }
 
+- (void)HL_incrementCounterWithNode:(SKNode *)node elapsedTime:(CGFloat)elapsedTime duration:(NSTimeInterval)duration userData:(id)userData
+{
+  ++_counter;
+}
+
+- (void)HL_recordPositionOfNode:(SKNode *)node
+{
+  [_recordedPositions addObject:@(node.position.x)];
+}
+
+- (void)HL_raiseException
+{
+  [NSException raise:@"HLActionTestsException" format:@"Raised by test callback."];
+}
+
+- (void)HL_measureActionRunnerUpdateWithActionCount:(NSUInteger)actionCount
+{
+  const NSUInteger runnerCount = 1000;
+  NSMutableArray *nodes = [NSMutableArray arrayWithCapacity:runnerCount];
+  for (NSUInteger n = 0; n < runnerCount; ++n) {
+    SKNode *node = [SKNode node];
+    for (NSUInteger a = 0; a < actionCount; ++a) {
+      [node hlRunAction:[HLAction moveByX:1.0f y:1.0f duration:1.0e9] withKey:[NSString stringWithFormat:@"move-%lu", (unsigned long)a]];
+    }
+    [nodes addObject:node];
+  }
+  [self measureBlock:^{
+    for (NSUInteger u = 0; u < 60; ++u) {
+      for (SKNode *node in nodes) {
+        [node hlActionRunnerUpdate:(1.0 / 60.0)];
+      }
+    }
+  }];
+}
+
 - (void)testAction
 {
   // Completion
@@ -77,6 +128,74 @@
   }
 }
 
+- (void)testTimingFunctions
+{
+  HLActionTimingMode timingModes[] = {
+    HLActionTimingEaseIn,
+    HLActionTimingEaseOut,
+    HLActionTimingEaseInEaseOut,
+    HLActionTimingEaseInBezier,
+    HLActionTimingEaseOutBezier,
+    HLActionTimingEaseInEaseOutBezier,
+  };
+  const NSUInteger sampleCount = 101;
+  CGFloat normalTimes[sampleCount];
+  for (NSUInteger i = 0; i < sampleCount; ++i) {
+    normalTimes[i] = (CGFloat)i / (sampleCount - 1) * 0.999f + 0.0003f;
+  }
+
+  for (size_t m = 0; m < sizeof(timingModes) / sizeof(timingModes[0]); ++m) {
+    HLActionTimingMode timingMode = timingModes[m];
+    XCTAssertEqual(HLActionApplyTiming(timingMode, 0.0f), 0.0f);
+    XCTAssertEqualWithAccuracy(HLActionApplyTiming(timingMode, 1.0f), 1.0f, 0.000001);
+    XCTAssertEqual(HLActionApplyTimingTable(timingMode, 0.0f), 0.0f);
+    XCTAssertEqual(HLActionApplyTimingTable(timingMode, 1.0f), 1.0f);
+
+    CGFloat results[sampleCount];
+    HLActionApplyTimingBatch(timingMode, normalTimes, results, sampleCount);
+    for (NSUInteger i = 0; i < sampleCount; ++i) {
+      CGFloat normalTime = normalTimes[i];
+      CGFloat exact = HLActionApplyTiming(timingMode, normalTime);
+      // Table error bounds.
+      XCTAssertEqualWithAccuracy(HLActionApplyTimingTable(timingMode, normalTime), exact, 0.000001);
+      XCTAssertEqualWithAccuracy(results[i], exact, 0.000001);
+      // Inverses.
+      XCTAssertEqualWithAccuracy(HLActionApplyTimingInverse(timingMode, exact), normalTime, 0.00001);
+      XCTAssertEqualWithAccuracy(HLActionApplyTimingInverseTable(timingMode, exact), normalTime, 0.00025);
+      // Table inverse is an inverse of the table.
+      CGFloat table = HLActionApplyTimingTable(timingMode, normalTime);
+      XCTAssertEqualWithAccuracy(HLActionApplyTimingInverseTable(timingMode, table), normalTime, 0.000001);
+    }
+  }
+
+  // SKAction ease-out curve, at the midpoint: control points (1/3, 1/3) and (2/3, 1).
+  XCTAssertEqualWithAccuracy(HLActionApplyTiming(HLActionTimingEaseOutBezier, 0.5f), 0.625f, 0.000001);
+
+  // Actions using tables.
+  HLActionSetUsesTimingTables(YES);
+  for (size_t m = 0; m < sizeof(timingModes) / sizeof(timingModes[0]); ++m) {
+    // Round trips are exact (up to rounding) in both directions.
+    HLActionTimingMode timingMode = timingModes[m];
+    for (NSUInteger i = 0; i < sampleCount; ++i) {
+      CGFloat normalTime = normalTimes[i];
+      XCTAssertEqualWithAccuracy(HLActionApplyTimingInverse(timingMode, HLActionApplyTiming(timingMode, normalTime)), normalTime, 0.000001);
+      XCTAssertEqualWithAccuracy(HLActionApplyTiming(timingMode, HLActionApplyTimingInverse(timingMode, normalTime)), normalTime, 0.000001);
+    }
+  }
+  {
+    HLAction *action = [HLAction waitForDuration:1.0];
+    action.timingMode = HLActionTimingEaseInEaseOut;
+    XCTAssertTrue([action update:0.5 node:nil]);
+    XCTAssertEqualWithAccuracy(action.elapsedTime, 0.5, 0.000001);
+    HLSequenceAction *sequenceAction = [HLAction sequence:@[ [HLAction waitForDuration:1.0] ]];
+    sequenceAction.timingMode = HLActionTimingEaseOut;
+    XCTAssertTrue([sequenceAction update:0.9 node:nil]);
+    XCTAssertFalse([sequenceAction update:0.2 node:nil]);
+  }
+  HLActionSetUsesTimingTables(NO);
+  XCTAssertFalse(HLActionUsesTimingTables());
+}
+
 - (void)testGroupAction
 {
   // Group updates
@@ -390,4 +509,864 @@
   }
 }
 
+- (void)testTimelineAction
+{
+  // Flattened tree matches the original tree.
+  {
+    _counter = 0;
+    HLMoveByAction *easedMoveAction = [HLAction moveByX:5.0f y:0.0f duration:0.4];
+    easedMoveAction.timingMode = HLActionTimingEaseOut;
+    HLAction *treeAction = [HLAction sequence:@[ [HLAction group:@[ [HLAction moveByX:10.0f y:20.0f duration:1.0],
+                                                                    [HLAction sequence:@[ easedMoveAction,
+                                                                                          [HLAction performSelector:@selector(HL_incrementCounter) onWeakTarget:self],
+                                                                                          [HLAction rotateByAngle:1.0f duration:0.3] ]] ]],
+                                                 [HLAction repeatAction:[HLAction moveByX:0.0f y:-3.0f duration:0.25] count:3] ]];
+    XCTAssertTrue([HLTimelineAction canFlattenAction:treeAction]);
+    HLAction *timelineAction = [HLAction flattenedAction:treeAction];
+    XCTAssertTrue([timelineAction isKindOfClass:[HLTimelineAction class]]);
+    XCTAssertEqual([((HLTimelineAction *)timelineAction).actions count], 7);
+    XCTAssertEqualWithAccuracy(timelineAction.duration, 1.75, 0.0001);
+
+    SKNode *treeNode = [SKNode node];
+    SKNode *timelineNode = [SKNode node];
+    NSTimeInterval incrementalTimes[] = { 0.1, 0.35, 0.2, 0.01, 0.5, 0.3, 0.4 };
+    BOOL treeNotYetCompleted = YES;
+    BOOL timelineNotYetCompleted = YES;
+    for (size_t u = 0; u < sizeof(incrementalTimes) / sizeof(incrementalTimes[0]); ++u) {
+      treeNotYetCompleted = [treeAction update:incrementalTimes[u] node:treeNode];
+      timelineNotYetCompleted = [timelineAction update:incrementalTimes[u] node:timelineNode];
+      XCTAssertEqual(treeNotYetCompleted, timelineNotYetCompleted);
+      XCTAssertEqualWithAccuracy(treeNode.position.x, timelineNode.position.x, 0.0001);
+      XCTAssertEqualWithAccuracy(treeNode.position.y, timelineNode.position.y, 0.0001);
+      XCTAssertEqualWithAccuracy(treeNode.zRotation, timelineNode.zRotation, 0.0001);
+      if (!treeNotYetCompleted) {
+        break;
+      }
+    }
+    XCTAssertFalse(timelineNotYetCompleted);
+    XCTAssertEqual(_counter, 2);
+    XCTAssertEqualWithAccuracy(timelineNode.position.y, 11.0f, 0.0001);
+  }
+
+  // Repeats too large to unroll are kept whole as leaves.
+  {
+    HLAction *treeAction = [HLAction sequence:@[ [HLAction repeatAction:[HLAction moveByX:1.0f y:0.0f duration:0.5] count:4],
+                                                 [HLAction repeatAction:[HLAction group:@[ [HLAction moveByX:0.0f y:1.0f duration:0.001],
+                                                                                           [HLAction waitForDuration:0.001] ]]
+                                                                 count:1000000] ]];
+    HLAction *timelineAction = [HLAction flattenedAction:treeAction];
+    XCTAssertTrue([timelineAction isKindOfClass:[HLTimelineAction class]]);
+    NSArray *leaves = ((HLTimelineAction *)timelineAction).actions;
+    XCTAssertEqual([leaves count], 5);
+    XCTAssertTrue([[leaves lastObject] isKindOfClass:[HLRepeatAction class]]);
+    XCTAssertEqualWithAccuracy(timelineAction.duration, 1002.0, 0.0001);
+
+    SKNode *node = [SKNode node];
+    XCTAssertTrue([timelineAction update:2.0105 node:node]);
+    XCTAssertEqualWithAccuracy(node.position.x, 4.0f, 0.0001);
+    XCTAssertEqualWithAccuracy(node.position.y, 10.5f, 0.0001);
+  }
+
+  // Trees with non-unit speed, non-linear timing, or infinite repeats are not flattened.
+  {
+    HLSequenceAction *fastAction = [HLAction sequence:@[ [HLAction waitForDuration:1.0] ]];
+    fastAction.speed = 2.0f;
+    XCTAssertFalse([HLTimelineAction canFlattenAction:fastAction]);
+    XCTAssertEqual([HLAction flattenedAction:fastAction], fastAction);
+    HLGroupAction *easedAction = [HLAction group:@[ [HLAction waitForDuration:1.0] ]];
+    easedAction.timingMode = HLActionTimingEaseIn;
+    XCTAssertFalse([HLTimelineAction canFlattenAction:easedAction]);
+    XCTAssertFalse([HLTimelineAction canFlattenAction:[HLAction repeatActionForever:[HLAction waitForDuration:1.0]]]);
+  }
+}
+
+- (void)testKeyframeAction
+{
+  HLKeyframe keyframes[4] = {
+    { .time = 0.0, .position = { 0.0f, 0.0f }, .alpha = 1.0f, .timingMode = HLActionTimingLinear },
+    { .time = 1.0, .position = { 10.0f, 0.0f }, .alpha = 0.5f, .timingMode = HLActionTimingEaseIn },
+    { .time = 2.0, .position = { 10.0f, 20.0f }, .alpha = 0.5f, .timingMode = HLActionTimingLinear },
+    { .time = 4.0, .position = { 0.0f, 0.0f }, .alpha = 0.0f, .timingMode = HLActionTimingLinear },
+  };
+  HLKeyframeAction *keyframeAction = [HLAction keyframes:keyframes
+                                                   count:4
+                                                channels:(HLKeyframeActionChannelPosition | HLKeyframeActionChannelAlpha)];
+  XCTAssertEqualWithAccuracy(keyframeAction.duration, 4.0, 0.0);
+
+  SKNode *node = [SKNode node];
+  node.zRotation = 1.0f;
+  [keyframeAction update:0.5 node:node];
+  XCTAssertEqualWithAccuracy(node.position.x, 5.0f, 0.0001);
+  XCTAssertEqualWithAccuracy(node.alpha, 0.75f, 0.0001);
+  // note: Channels not animated are left alone.
+  XCTAssertEqual(node.zRotation, 1.0f);
+
+  // note: Each segment has its own timing mode.
+  [keyframeAction update:1.0 node:node];
+  XCTAssertEqualWithAccuracy(node.position.x, 10.0f, 0.0001);
+  XCTAssertEqualWithAccuracy(node.position.y, HLActionApplyTiming(HLActionTimingEaseIn, 0.5f) * 20.0f, 0.0001);
+
+  // note: Sampling is independent of the action's state, and of the order of the times.
+  NSTimeInterval times[5] = { 3.0, 0.0, 4.5, 1.0, 0.25 };
+  HLKeyframe samples[5];
+  [keyframeAction getKeyframes:samples forTimes:times count:5];
+  XCTAssertEqualWithAccuracy(samples[0].position.x, 5.0f, 0.0001);
+  XCTAssertEqualWithAccuracy(samples[0].alpha, 0.25f, 0.0001);
+  XCTAssertEqualWithAccuracy(samples[1].alpha, 1.0f, 0.0001);
+  XCTAssertEqualWithAccuracy(samples[2].alpha, 0.0f, 0.0001);
+  XCTAssertEqualWithAccuracy(samples[3].position.x, 10.0f, 0.0001);
+  XCTAssertEqualWithAccuracy(samples[4].position.x, 2.5f, 0.0001);
+  XCTAssertEqual(samples[4].zRotation, 0.0f);
+  XCTAssertEqualWithAccuracy(keyframeAction.currentKeyframe.time, 1.5, 0.0001);
+
+  // note: Copies share keyframes but not state.
+  HLKeyframeAction *copiedAction = [keyframeAction copy];
+  [copiedAction rewind];
+  XCTAssertEqual(copiedAction.keyframeCount, 4);
+  XCTAssertEqualWithAccuracy([copiedAction keyframeAtIndex:2].position.y, 20.0f, 0.0);
+
+  XCTAssertTrue([keyframeAction update:2.0 node:node]);
+  XCTAssertFalse([keyframeAction update:1.0 node:node]);
+  XCTAssertEqualWithAccuracy(node.position.x, 0.0f, 0.0001);
+  XCTAssertEqualWithAccuracy(node.alpha, 0.0f, 0.0001);
+
+  [copiedAction update:3.0 node:node];
+  XCTAssertEqualWithAccuracy(node.position.x, 5.0f, 0.0001);
+  XCTAssertEqualWithAccuracy(node.position.y, 10.0f, 0.0001);
+
+  HLKeyframe invalidKeyframes[2] = { { .time = 1.0 }, { .time = 1.0 } };
+  XCTAssertThrows([HLAction keyframes:invalidKeyframes count:2 channels:HLKeyframeActionChannelPosition]);
+}
+
+- (void)testFollowPathAction
+{
+  HLCubicBezier *horizontalBezier = [[HLCubicBezier alloc] initWithP0:CGPointMake(0.0f, 0.0f)
+                                                                   p1:CGPointMake(90.0f, 0.0f)
+                                                                   p2:CGPointMake(95.0f, 0.0f)
+                                                                   p3:CGPointMake(100.0f, 0.0f)];
+  HLCubicBezier *verticalBezier = [[HLCubicBezier alloc] initWithP0:CGPointMake(100.0f, 0.0f)
+                                                                 p1:CGPointMake(100.0f, 10.0f)
+                                                                 p2:CGPointMake(100.0f, 20.0f)
+                                                                 p3:CGPointMake(100.0f, 50.0f)];
+  HLCubicBezierPath *path = [[HLCubicBezierPath alloc] initWithBeziers:@[ horizontalBezier, verticalBezier ]];
+  HLFollowPathAction *followPathAction = [HLAction followPath:path duration:1.5];
+  followPathAction.orientsToTangent = YES;
+
+  // note: Motion is at constant speed, even though the curve is not uniform in t.
+  SKNode *node = [SKNode node];
+  [followPathAction update:0.5 node:node];
+  XCTAssertEqualWithAccuracy(node.position.x, 50.0f, 0.5);
+  XCTAssertEqualWithAccuracy(node.position.y, 0.0f, 0.0001);
+  XCTAssertEqualWithAccuracy(node.zRotation, 0.0f, 0.0001);
+
+  HLFollowPathAction *copiedAction = [followPathAction copy];
+  XCTAssertTrue(copiedAction.path == path);
+
+  [followPathAction update:0.7 node:node];
+  XCTAssertEqualWithAccuracy(node.position.x, 100.0f, 0.0001);
+  XCTAssertEqualWithAccuracy(node.position.y, 20.0f, 0.5);
+  XCTAssertEqualWithAccuracy(node.zRotation, (CGFloat)M_PI_2, 0.0001);
+
+  XCTAssertFalse([followPathAction update:0.5 node:node]);
+  XCTAssertEqualWithAccuracy(node.position.x, 100.0f, 0.0001);
+  XCTAssertEqualWithAccuracy(node.position.y, 50.0f, 0.0001);
+
+  // note: Without orientation, rotation is left alone.
+  SKNode *copiedNode = [SKNode node];
+  copiedAction.orientsToTangent = NO;
+  [copiedAction update:1.0 node:copiedNode];
+  XCTAssertEqualWithAccuracy(copiedNode.position.y, 50.0f, 0.5);
+  XCTAssertEqual(copiedNode.zRotation, 0.0f);
+}
+
+- (void)testColorizeAction
+{
+  SKColor *colorFrom = [SKColor colorWithRed:1.0f green:0.0f blue:0.0f alpha:1.0f];
+  SKColor *colorTo = [SKColor colorWithRed:0.0f green:0.0f blue:1.0f alpha:1.0f];
+  SKSpriteNode *node = [SKSpriteNode spriteNodeWithColor:colorFrom size:CGSizeMake(10.0f, 10.0f)];
+  node.colorBlendFactor = 0.0f;
+  HLColorizeAction *colorizeAction = [HLAction colorizeWithColor:colorTo colorBlendFactor:1.0f duration:1.0];
+
+  [colorizeAction update:0.5 node:node];
+  CGFloat red, green, blue, alpha, colorBlendFactor;
+  [colorizeAction getColorRed:&red green:&green blue:&blue alpha:&alpha colorBlendFactor:&colorBlendFactor];
+  XCTAssertEqualWithAccuracy(red, 0.5f, 0.0001);
+  XCTAssertEqualWithAccuracy(blue, 0.5f, 0.0001);
+  XCTAssertEqualWithAccuracy(colorBlendFactor, 0.5f, 0.0001);
+  SKColor *color = colorizeAction.color;
+
+  // note: Invisible changes don't produce a new color.
+  [colorizeAction update:0.0001 node:node];
+  XCTAssertTrue(colorizeAction.color == color);
+  [colorizeAction getColorRed:&red green:&green blue:&blue alpha:&alpha colorBlendFactor:&colorBlendFactor];
+  XCTAssertEqualWithAccuracy(red, 0.4999f, 0.00001);
+  [colorizeAction update:0.1 node:node];
+  XCTAssertFalse(colorizeAction.color == color);
+
+  [colorizeAction update:0.4 node:node];
+  XCTAssertTrue(colorizeAction.color == colorTo);
+  XCTAssertEqualWithAccuracy(node.colorBlendFactor, 1.0f, 0.0001);
+
+  // note: Reading the color between updates doesn't stop the next update from setting it,
+  // and a color set on the node by someone else is reasserted.
+  {
+    SKSpriteNode *node = [SKSpriteNode spriteNodeWithColor:colorFrom size:CGSizeMake(10.0f, 10.0f)];
+    HLColorizeAction *colorizeAction = [HLAction colorizeWithColor:colorTo colorBlendFactor:1.0f duration:1.0];
+    [colorizeAction update:0.25 node:node];
+    [colorizeAction update:0.25 node:nil];
+    XCTAssertNotNil(colorizeAction.color);
+    [colorizeAction update:0.0001 node:node];
+    CGFloat nodeRed, nodeGreen, nodeBlue, nodeAlpha;
+    [node.color getRed:&nodeRed green:&nodeGreen blue:&nodeBlue alpha:&nodeAlpha];
+    XCTAssertEqualWithAccuracy(nodeRed, 0.5f, 0.0001);
+    XCTAssertEqualWithAccuracy(nodeBlue, 0.5f, 0.0001);
+    node.color = [SKColor greenColor];
+    [colorizeAction update:0.0001 node:node];
+    [node.color getRed:&nodeRed green:&nodeGreen blue:&nodeBlue alpha:&nodeAlpha];
+    XCTAssertEqualWithAccuracy(nodeGreen, 0.0f, 0.0001);
+    XCTAssertEqualWithAccuracy(nodeBlue, 0.5f, 0.001);
+  }
+}
+
+- (void)testRewind
+{
+  // Rewindability
+  {
+    XCTAssertTrue([[HLAction waitForDuration:1.0] canRewind]);
+    XCTAssertTrue([[HLAction moveTo:CGPointZero duration:1.0] canRewind]);
+    XCTAssertTrue([[HLAction removeFromParent] canRewind]);
+    XCTAssertTrue([[HLAction repeatAction:[HLAction rotateByAngle:1.0f duration:1.0] count:2] canRewind]);
+    XCTAssertFalse([[[HLChaseAction alloc] initWithDestination:CGPointZero duration:1.0] canRewind]);
+    HLAction *customAction = [HLAction customActionWithDuration:1.0 selector:@selector(HL_incrementCounterWithNode:elapsedTime:duration:userData:) weakTarget:self userData:nil];
+    XCTAssertFalse([customAction canRewind]);
+    XCTAssertFalse([[HLAction sequence:@[ [HLAction waitForDuration:1.0], [HLAction group:@[ customAction ]] ]] canRewind]);
+  }
+
+  // Rewound actions forget state captured from the node, but not state passed at initialization
+  {
+    SKNode *node = [SKNode node];
+    HLMoveToAction *moveToAction = [HLAction moveTo:CGPointMake(10.0f, 0.0f) duration:1.0];
+    XCTAssertFalse([moveToAction update:1.0 node:node]);
+    XCTAssertEqual(node.position.x, 10.0f);
+    [moveToAction rewind];
+    XCTAssertEqual(moveToAction.elapsedTime, 0.0);
+    node.position = CGPointMake(20.0f, 0.0f);
+    XCTAssertTrue([moveToAction update:0.5 node:node]);
+    XCTAssertEqualWithAccuracy(node.position.x, 15.0f, 0.0001);
+
+    HLFadeAlphaToAction *fadeAction = [HLAction fadeAlphaFrom:0.0f to:1.0f duration:1.0];
+    XCTAssertFalse([fadeAction update:1.0 node:nil]);
+    [fadeAction rewind];
+    XCTAssertTrue([fadeAction update:0.25 node:nil]);
+    XCTAssertEqualWithAccuracy(fadeAction.alpha, 0.25f, 0.0001);
+  }
+
+  // Rewound collections restart all their actions
+  {
+    SKNode *node = [SKNode node];
+    HLSequenceAction *sequenceAction = [HLAction sequence:@[ [HLAction moveByX:10.0f y:0.0f duration:1.0],
+                                                             [HLAction group:@[ [HLAction moveByX:0.0f y:10.0f duration:1.0],
+                                                                                [HLAction waitForDuration:2.0] ]] ]];
+    XCTAssertFalse([sequenceAction update:3.5 node:node]);
+    XCTAssertEqual([sequenceAction.actions count], 0);
+    [sequenceAction rewind];
+    XCTAssertEqual([sequenceAction.actions count], 2);
+    HLGroupAction *groupAction = sequenceAction.actions[1];
+    XCTAssertEqual([groupAction.actions count], 2);
+    XCTAssertFalse([sequenceAction update:3.5 node:node]);
+    XCTAssertEqual(node.position.x, 20.0f);
+    XCTAssertEqual(node.position.y, 20.0f);
+  }
+
+  // Repeat reuses rewound copies after the first two iterations, with the same results as copying
+  {
+    _counter = 0;
+    SKNode *node = [SKNode node];
+    HLAction *templateAction = [HLAction sequence:@[ [HLAction moveByX:1.0f y:0.0f duration:0.5],
+                                                     [HLAction group:@[ [HLAction moveByX:0.0f y:2.0f duration:0.25],
+                                                                        [HLAction fadeAlphaBy:-0.1f duration:0.5] ]],
+                                                     [HLAction performSelector:@selector(HL_incrementCounter) onWeakTarget:self] ]];
+    HLRepeatAction *repeatAction = [HLAction repeatAction:templateAction count:6];
+    XCTAssertTrue([repeatAction update:0.1 node:node]);
+    HLAction *firstIterationAction = repeatAction.copiedAction;
+    XCTAssertTrue([repeatAction update:1.0 node:node]);
+    HLAction *secondIterationAction = repeatAction.copiedAction;
+    XCTAssertNotEqual(firstIterationAction, secondIterationAction);
+    XCTAssertTrue([repeatAction update:1.0 node:node]);
+    XCTAssertEqual(repeatAction.copiedAction, firstIterationAction);
+    XCTAssertTrue([repeatAction update:1.0 node:node]);
+    XCTAssertEqual(repeatAction.copiedAction, secondIterationAction);
+    XCTAssertFalse([repeatAction update:3.0 node:node]);
+    XCTAssertEqual(_counter, 6);
+    XCTAssertEqualWithAccuracy(node.position.x, 6.0f, 0.0001);
+    XCTAssertEqualWithAccuracy(node.position.y, 12.0f, 0.0001);
+    XCTAssertEqualWithAccuracy(node.alpha, 0.4f, 0.0001);
+  }
+
+  // Nested repeats rewind along with their parents
+  {
+    _counter = 0;
+    HLAction *innerAction = [HLAction sequence:@[ [HLAction waitForDuration:1.0],
+                                                  [HLAction performSelector:@selector(HL_incrementCounter) onWeakTarget:self] ]];
+    HLRepeatAction *repeatAction = [HLAction repeatAction:[HLAction repeatAction:innerAction count:3] count:4];
+    XCTAssertFalse([repeatAction update:12.5 node:nil]);
+    XCTAssertEqual(_counter, 12);
+  }
+}
+
+- (void)testSeek
+{
+  // Simple actions seek in closed form, forward and backward
+  {
+    SKNode *seekNode = [SKNode node];
+    HLMoveToAction *seekAction = [HLAction moveTo:CGPointMake(10.0f, 20.0f) duration:1.0];
+    seekAction.timingMode = HLActionTimingEaseInEaseOut;
+    for (NSNumber *time in @[ @0.3, @0.1, @0.8 ]) {
+      XCTAssertTrue([seekAction seekToElapsedTime:[time doubleValue] node:seekNode]);
+      SKNode *updateNode = [SKNode node];
+      HLMoveToAction *updateAction = [HLAction moveTo:CGPointMake(10.0f, 20.0f) duration:1.0];
+      updateAction.timingMode = HLActionTimingEaseInEaseOut;
+      [updateAction update:[time doubleValue] node:updateNode];
+      XCTAssertEqualWithAccuracy(seekNode.position.x, updateNode.position.x, 0.0001);
+      XCTAssertEqualWithAccuracy(seekNode.position.y, updateNode.position.y, 0.0001);
+    }
+    XCTAssertFalse([seekAction seekToElapsedTime:1.5 node:seekNode]);
+    XCTAssertEqual(seekNode.position.x, 10.0f);
+  }
+
+  // Sequences seek forward and backward, applying and undoing the effects of their actions
+  {
+    SKNode *node = [SKNode node];
+    HLSequenceAction *sequenceAction = [HLAction sequence:@[ [HLAction moveByX:10.0f y:0.0f duration:1.0],
+                                                             [HLAction waitForDuration:0.5],
+                                                             [HLAction moveByX:0.0f y:10.0f duration:1.0] ]];
+    XCTAssertTrue([sequenceAction seekToElapsedTime:2.0 node:node]);
+    XCTAssertEqualWithAccuracy(node.position.x, 10.0f, 0.0001);
+    XCTAssertEqualWithAccuracy(node.position.y, 5.0f, 0.0001);
+    XCTAssertEqual([sequenceAction.actions count], 1);
+    XCTAssertTrue([sequenceAction seekToElapsedTime:0.5 node:node]);
+    XCTAssertEqualWithAccuracy(node.position.x, 5.0f, 0.0001);
+    XCTAssertEqualWithAccuracy(node.position.y, 0.0f, 0.0001);
+    XCTAssertEqual([sequenceAction.actions count], 3);
+    XCTAssertFalse([sequenceAction seekToElapsedTime:3.0 node:node]);
+    XCTAssertEqualWithAccuracy(node.position.x, 10.0f, 0.0001);
+    XCTAssertEqualWithAccuracy(node.position.y, 10.0f, 0.0001);
+  }
+
+  // Zero-duration actions passed over are run, and run again after seeking backward past them
+  {
+    _counter = 0;
+    HLSequenceAction *sequenceAction = [HLAction sequence:@[ [HLAction waitForDuration:1.0],
+                                                             [HLAction performSelector:@selector(HL_incrementCounter) onWeakTarget:self],
+                                                             [HLAction waitForDuration:1.0] ]];
+    XCTAssertTrue([sequenceAction seekToElapsedTime:1.5 node:nil]);
+    XCTAssertEqual(_counter, 1);
+    XCTAssertTrue([sequenceAction seekToElapsedTime:0.5 node:nil]);
+    XCTAssertEqual(_counter, 1);
+    XCTAssertTrue([sequenceAction seekToElapsedTime:1.5 node:nil]);
+    XCTAssertEqual(_counter, 2);
+  }
+
+  // Groups seek all their actions
+  {
+    SKNode *node = [SKNode node];
+    HLGroupAction *groupAction = [HLAction group:@[ [HLAction moveByX:10.0f y:0.0f duration:1.0],
+                                                    [HLAction moveByX:0.0f y:10.0f duration:2.0] ]];
+    XCTAssertTrue([groupAction seekToElapsedTime:1.5 node:node]);
+    XCTAssertEqual([groupAction.actions count], 1);
+    XCTAssertEqualWithAccuracy(node.position.x, 10.0f, 0.0001);
+    XCTAssertEqualWithAccuracy(node.position.y, 7.5f, 0.0001);
+    XCTAssertTrue([groupAction seekToElapsedTime:0.5 node:node]);
+    XCTAssertEqual([groupAction.actions count], 2);
+    XCTAssertEqualWithAccuracy(node.position.x, 5.0f, 0.0001);
+    XCTAssertEqualWithAccuracy(node.position.y, 2.5f, 0.0001);
+  }
+
+  // Repeats seek forward through iterations, but backward only within an iteration
+  {
+    SKNode *node = [SKNode node];
+    HLRepeatAction *repeatAction = [HLAction repeatAction:[HLAction moveByX:1.0f y:0.0f duration:1.0] count:10];
+    XCTAssertTrue([repeatAction seekToElapsedTime:5.5 node:node]);
+    XCTAssertEqual(repeatAction.index, 5);
+    XCTAssertEqualWithAccuracy(node.position.x, 5.5f, 0.0001);
+    XCTAssertTrue([repeatAction seekToElapsedTime:5.25 node:node]);
+    XCTAssertEqualWithAccuracy(node.position.x, 5.25f, 0.0001);
+    XCTAssertThrows([repeatAction seekToElapsedTime:2.0 node:node]);
+    XCTAssertEqualWithAccuracy(node.position.x, 5.25f, 0.0001);
+  }
+
+  // A tree which can't seek backward throws before changing any action or the node
+  {
+    SKNode *node = [SKNode node];
+    HLMoveByAction *moveByAction = [HLAction moveByX:10.0f y:0.0f duration:1.0];
+    HLCustomAction *customAction = [HLAction customActionWithDuration:1.0 selector:@selector(HL_incrementCounterWithNode:elapsedTime:duration:userData:) weakTarget:self userData:nil];
+    HLSequenceAction *sequenceAction = [HLAction sequence:@[ moveByAction, customAction ]];
+    XCTAssertTrue([sequenceAction seekToElapsedTime:1.5 node:node]);
+    XCTAssertThrowsSpecificNamed([sequenceAction seekToElapsedTime:0.5 node:node], NSException, @"HLActionInvalid");
+    XCTAssertEqualWithAccuracy(node.position.x, 10.0f, 0.0001);
+    XCTAssertEqualWithAccuracy(customAction.elapsedTime, 0.5, 0.0001);
+    XCTAssertEqual([sequenceAction.actions count], 1);
+  }
+
+  // Start times follow changes to the speeds of sequenced actions
+  {
+    SKNode *node = [SKNode node];
+    HLWaitAction *waitAction = [HLAction waitForDuration:1.0];
+    HLSequenceAction *sequenceAction = [HLAction sequence:@[ waitAction,
+                                                             [HLAction moveByX:10.0f y:0.0f duration:1.0] ]];
+    XCTAssertTrue([sequenceAction seekToElapsedTime:0.5 node:node]);
+    waitAction.speed = 2.0f;
+    XCTAssertTrue([sequenceAction seekToElapsedTime:1.0 node:node]);
+    XCTAssertEqualWithAccuracy(node.position.x, 5.0f, 0.0001);
+  }
+}
+
+- (void)testActionRunner
+{
+  // Completion removes action
+  {
+    HLActionRunner *actionRunner = [[HLActionRunner alloc] init];
+    [actionRunner runAction:[HLAction waitForDuration:1.0] withKey:@"a"];
+    [actionRunner runAction:[HLAction waitForDuration:2.0] withKey:@"b"];
+    XCTAssertTrue([actionRunner hasActions]);
+    [actionRunner update:1.5 node:nil];
+    XCTAssertNil([actionRunner actionForKey:@"a"]);
+    XCTAssertNotNil([actionRunner actionForKey:@"b"]);
+    [actionRunner update:1.0 node:nil];
+    XCTAssertFalse([actionRunner hasActions]);
+  }
+
+  // Keys compared by value as well as by pointer
+  {
+    HLActionRunner *actionRunner = [[HLActionRunner alloc] init];
+    NSMutableString *key = [NSMutableString stringWithString:@"wait"];
+    HLAction *action = [HLAction waitForDuration:1.0];
+    [actionRunner runAction:action withKey:key];
+    [key appendString:@"-changed"];
+    XCTAssertEqual([actionRunner actionForKey:@"wait"], action);
+    [actionRunner removeActionForKey:[NSString stringWithFormat:@"w%@", @"ait"]];
+    XCTAssertFalse([actionRunner hasActions]);
+  }
+
+  // Grows beyond inline storage
+  {
+    HLActionRunner *actionRunner = [[HLActionRunner alloc] init];
+    for (NSUInteger a = 0; a < 20; ++a) {
+      [actionRunner runAction:[HLAction waitForDuration:(1.0 + a)] withKey:[NSString stringWithFormat:@"%lu", (unsigned long)a]];
+    }
+    [actionRunner update:10.5 node:nil];
+    XCTAssertNil([actionRunner actionForKey:@"9"]);
+    XCTAssertNotNil([actionRunner actionForKey:@"10"]);
+    HLActionRunner *copiedActionRunner = [actionRunner copy];
+    [actionRunner removeAllActions];
+    XCTAssertFalse([actionRunner hasActions]);
+    XCTAssertNotNil([copiedActionRunner actionForKey:@"19"]);
+  }
+
+  // Mutation during update: removed actions are not updated; new keys are not updated
+  // until the next update; an action completing after replacing itself keeps the
+  // replacement.
+  {
+    _counter = 0;
+    HLActionRunner *actionRunner = [[HLActionRunner alloc] init];
+    HLCustomAction *removeAction = [HLAction customActionWithDuration:0.0
+                                                             selector:@selector(HL_removeActionsWithNode:elapsedTime:duration:userData:)
+                                                           weakTarget:self
+                                                             userData:actionRunner];
+    [actionRunner runAction:removeAction withKey:@"remove"];
+    [actionRunner runAction:[HLAction performSelector:@selector(HL_incrementCounter) onWeakTarget:self] withKey:@"removed"];
+    [actionRunner update:0.1 node:nil];
+    XCTAssertEqual(_counter, 0);
+    XCTAssertNotNil([actionRunner actionForKey:@"replaced"]);
+    XCTAssertTrue([[actionRunner actionForKey:@"remove"] isKindOfClass:[HLWaitAction class]]);
+    [actionRunner update:0.1 node:nil];
+    XCTAssertEqual(_counter, 1);
+    XCTAssertNil([actionRunner actionForKey:@"replaced"]);
+    [actionRunner update:1.0 node:nil];
+    XCTAssertFalse([actionRunner hasActions]);
+  }
+}
+
+- (void)testActionRunnerFixedTimeStep
+{
+  // Results are identical regardless of how time is split across updates.
+  {
+    // note: Frame times are multiples of 1/64 so that both sum exactly to 0.875, which is
+    // 52.5 steps: 52 steps run, and half a step accumulates.
+    NSTimeInterval frameTimesA[] = { 0.015625, 0.015625, 0.015625, 0.015625, 0.5, 0.015625, 0.296875 };
+    NSTimeInterval frameTimesB[] = { 0.046875, 0.09375, 0.03125, 0.203125, 0.078125, 0.421875 };
+    SKNode *nodeA = [SKNode node];
+    SKNode *nodeB = [SKNode node];
+    HLActionRunner *actionRunnerA = [[HLActionRunner alloc] init];
+    HLActionRunner *actionRunnerB = [[HLActionRunner alloc] init];
+    for (HLActionRunner *actionRunner in @[ actionRunnerA, actionRunnerB ]) {
+      actionRunner.fixedTimeStep = 1.0 / 60.0;
+      actionRunner.maximumStepCount = 0;
+      HLMoveByAction *moveAction = [HLAction moveByX:100.0f y:-37.0f duration:0.7];
+      moveAction.timingMode = HLActionTimingEaseInEaseOut;
+      [actionRunner runAction:moveAction withKey:@"move"];
+      [actionRunner runAction:[HLAction rotateByAngle:3.0f duration:1.3] withKey:@"rotate"];
+      [actionRunner runAction:[HLAction waitForDuration:10.0] withKey:@"wait"];
+    }
+    for (size_t f = 0; f < sizeof(frameTimesA) / sizeof(frameTimesA[0]); ++f) {
+      [actionRunnerA update:frameTimesA[f] node:nodeA];
+    }
+    for (size_t f = 0; f < sizeof(frameTimesB) / sizeof(frameTimesB[0]); ++f) {
+      [actionRunnerB update:frameTimesB[f] node:nodeB];
+    }
+    // note: The wait action's elapsed time counts the steps.
+    XCTAssertEqualWithAccuracy([actionRunnerA actionForKey:@"wait"].elapsedTime, 52.0 / 60.0, 0.000001);
+    XCTAssertEqualWithAccuracy([actionRunnerB actionForKey:@"wait"].elapsedTime, 52.0 / 60.0, 0.000001);
+    XCTAssertEqualWithAccuracy(actionRunnerA.accumulatedTime, 0.875 - 52.0 / 60.0, 0.000001);
+    XCTAssertEqualWithAccuracy(actionRunnerB.accumulatedTime, 0.875 - 52.0 / 60.0, 0.000001);
+    XCTAssertEqual(nodeA.position.x, nodeB.position.x);
+    XCTAssertEqual(nodeA.position.y, nodeB.position.y);
+    XCTAssertEqual(nodeA.zRotation, nodeB.zRotation);
+  }
+
+  // Maximum step count drops extra time.
+  {
+    HLActionRunner *actionRunner = [[HLActionRunner alloc] init];
+    actionRunner.fixedTimeStep = 0.1;
+    actionRunner.maximumStepCount = 3;
+    [actionRunner runAction:[HLAction waitForDuration:0.5] withKey:@"wait"];
+    [actionRunner update:1.05 node:nil];
+    XCTAssertNotNil([actionRunner actionForKey:@"wait"]);
+    XCTAssertEqualWithAccuracy(actionRunner.accumulatedTime, 0.05, 0.000001);
+    [actionRunner update:0.2 node:nil];
+    XCTAssertFalse([actionRunner hasActions]);
+  }
+
+  // Interpolation renders between steps without affecting the simulation.
+  {
+    SKNode *node = [SKNode node];
+    HLActionRunner *actionRunner = [[HLActionRunner alloc] init];
+    actionRunner.fixedTimeStep = 0.25;
+    actionRunner.interpolatesNode = YES;
+    [actionRunner runAction:[HLAction moveByX:4.0f y:0.0f duration:1.0] withKey:@"move"];
+    // note: Rendering lags the simulation by a step.
+    [actionRunner update:0.25 node:node];
+    XCTAssertEqualWithAccuracy(node.position.x, 0.0f, 0.0001);
+    [actionRunner update:0.125 node:node];
+    XCTAssertEqualWithAccuracy(node.position.x, 0.5f, 0.0001);
+    [actionRunner update:0.125 node:node];
+    XCTAssertEqualWithAccuracy(node.position.x, 1.0f, 0.0001);
+    [actionRunner update:0.125 node:node];
+    XCTAssertEqualWithAccuracy(node.position.x, 1.5f, 0.0001);
+    // note: Outside changes are preserved; the node is left as simulated once the actions
+    // complete.
+    node.position = CGPointMake(node.position.x + 10.0f, 0.0f);
+    [actionRunner update:0.375 node:node];
+    XCTAssertEqualWithAccuracy(node.position.x, 14.0f, 0.0001);
+    XCTAssertFalse([actionRunner hasActions]);
+  }
+}
+
+- (void)testActionRunnerRegistry
+{
+  HLActionRunnerRegistry *registry = [[HLActionRunnerRegistry alloc] init];
+  SKNode *idleNode = [SKNode node];
+  [idleNode hlSetActionRunnerRegistry:registry];
+  SKNode *movingNode = [SKNode node];
+  [movingNode hlSetActionRunnerRegistry:registry];
+  XCTAssertEqual(registry.runnerCount, 0);
+
+  // Runners join when they gain actions.
+  [movingNode hlRunAction:[HLAction moveByX:10.0f y:0.0f duration:1.0] withKey:@"move"];
+  [movingNode hlRunAction:[HLAction waitForDuration:0.5] withKey:@"wait"];
+  XCTAssertEqual(registry.runnerCount, 1);
+
+  // Runners are updated with their node and node speed.
+  movingNode.speed = 2.0f;
+  [registry updateAllRunners:0.25];
+  XCTAssertEqualWithAccuracy(movingNode.position.x, 5.0f, 0.0001);
+  XCTAssertEqual(registry.runnerCount, 1);
+
+  // Runners leave when their last action completes.
+  [registry updateAllRunners:0.25];
+  XCTAssertEqualWithAccuracy(movingNode.position.x, 10.0f, 0.0001);
+  XCTAssertEqual(registry.runnerCount, 0);
+  XCTAssertFalse([movingNode hlHasActions]);
+
+  // Runners leave when actions are removed, and rejoin when added again.
+  [idleNode hlRunAction:[HLAction waitForDuration:1.0] withKey:@"wait"];
+  XCTAssertEqual(registry.runnerCount, 1);
+  [idleNode hlRemoveAllActions];
+  XCTAssertEqual(registry.runnerCount, 0);
+  [idleNode hlRunAction:[HLAction waitForDuration:1.0] withKey:@"wait"];
+  XCTAssertEqual(registry.runnerCount, 1);
+  [idleNode hlSetActionRunnerRegistry:nil];
+  XCTAssertEqual(registry.runnerCount, 0);
+}
+
+- (void)testActionRunnerRegistryEnrollment
+{
+  HLScene *scene = [HLScene sceneWithSize:CGSizeMake(100.0f, 100.0f)];
+  HLActionRunnerRegistry *registry = scene.actionRunnerRegistry;
+
+  // Nodes do not join the scene's registry unless it enrolls them.
+  SKNode *manualNode = [SKNode node];
+  [scene addChild:manualNode];
+  [manualNode hlRunAction:[HLAction moveByX:10.0f y:0.0f duration:1.0] withKey:@"move"];
+  XCTAssertEqual(registry.runnerCount, 0);
+  XCTAssertNil(manualNode.hlActionRunner.registry);
+
+  // Enrolled runners leave when their nodes leave the scene, and so are not kept alive.
+  registry.enrollsRunnersAutomatically = YES;
+  __weak SKNode *weakNode = nil;
+  __weak HLActionRunner *weakActionRunner = nil;
+  @autoreleasepool {
+    SKNode *node = [SKNode node];
+    [scene addChild:node];
+    [node hlRunAction:[HLAction moveByX:10.0f y:0.0f duration:10.0] withKey:@"move"];
+    XCTAssertEqual(registry.runnerCount, 1);
+    weakNode = node;
+    weakActionRunner = node.hlActionRunner;
+    [scene updateAllRunners:0.1];
+    XCTAssertEqualWithAccuracy(node.position.x, 0.1f, 0.0001);
+    [node removeFromParent];
+    [scene updateAllRunners:0.1];
+    XCTAssertEqual(registry.runnerCount, 0);
+    XCTAssertNil(node.hlActionRunner.registry);
+    XCTAssertEqualWithAccuracy(node.position.x, 0.1f, 0.0001);
+    XCTAssertTrue([node hlHasActions]);
+  }
+  XCTAssertNil(weakNode);
+  XCTAssertNil(weakActionRunner);
+}
+
+- (void)testActionRunnerRegistryDefersCallbacks
+{
+  HLActionRunnerRegistry *registry = [[HLActionRunnerRegistry alloc] init];
+  registry.defersCallbacks = YES;
+  SKNode *callingNode = [SKNode node];
+  [callingNode hlSetActionRunnerRegistry:registry];
+  SKNode *movingNode = [SKNode node];
+  [movingNode hlSetActionRunnerRegistry:registry];
+  _recordedPositions = [NSMutableArray array];
+
+  // note: The calling runner is updated first, but its callbacks see the moving node
+  // already updated for the frame.
+  [callingNode hlRunAction:[HLAction sequence:@[ [HLAction performSelector:@selector(HL_recordPositionOfNode:) onWeakTarget:self withArgument:movingNode],
+                                                 [HLAction waitForDuration:0.75],
+                                                 [HLAction performSelector:@selector(HL_recordPositionOfNode:) onWeakTarget:self withArgument:movingNode] ]]
+                   withKey:@"record"];
+  [movingNode hlRunAction:[HLAction moveByX:10.0f y:0.0f duration:1.0] withKey:@"move"];
+  [registry updateAllRunners:0.25];
+  XCTAssertEqual([_recordedPositions count], 1);
+  XCTAssertEqualWithAccuracy([_recordedPositions[0] doubleValue], 2.5, 0.0001);
+
+  // note: Custom actions are deferred too, with their arguments as of the update.
+  HLCustomAction *customAction = [HLAction customActionWithDuration:1.0 selector:@selector(HL_incrementCounterWithNode:elapsedTime:duration:userData:) weakTarget:self userData:nil];
+  [callingNode hlRunAction:customAction withKey:@"custom"];
+  _counter = 0;
+  [registry updateAllRunners:0.25];
+  XCTAssertEqual(_counter, 1);
+  XCTAssertEqual([_recordedPositions count], 1);
+  [registry updateAllRunners:0.25];
+  XCTAssertEqual(_counter, 2);
+  XCTAssertEqual([_recordedPositions count], 2);
+  XCTAssertEqualWithAccuracy([_recordedPositions[1] doubleValue], 7.5, 0.0001);
+
+  // note: Without deferral, the callback sees the node as it was before the frame.
+  registry.defersCallbacks = NO;
+  [callingNode hlRunAction:[HLAction performSelector:@selector(HL_recordPositionOfNode:) onWeakTarget:self withArgument:movingNode] withKey:@"record"];
+  [registry updateAllRunners:0.125];
+  XCTAssertEqual([_recordedPositions count], 3);
+  XCTAssertEqualWithAccuracy([_recordedPositions[2] doubleValue], 7.5, 0.0001);
+  XCTAssertEqualWithAccuracy(movingNode.position.x, 8.75, 0.0001);
+
+  // note: A callback that throws drops the callbacks after it, and later updates defer and
+  // make callbacks again.
+  registry.defersCallbacks = YES;
+  _counter = 0;
+  [callingNode hlRunAction:[HLAction group:@[ [HLAction performSelector:@selector(HL_raiseException) onWeakTarget:self],
+                                              [HLAction performSelector:@selector(HL_incrementCounter) onWeakTarget:self] ]]
+                   withKey:@"raise"];
+  XCTAssertThrowsSpecificNamed([registry updateAllRunners:0.125], NSException, @"HLActionTestsException");
+  XCTAssertEqual(_counter, 0);
+  [callingNode hlRunAction:[HLAction performSelector:@selector(HL_incrementCounter) onWeakTarget:self] withKey:@"increment"];
+  [registry updateAllRunners:0.125];
+  XCTAssertEqual(_counter, 1);
+
+  // note: A runner that throws leaves the registry no longer deferring, and callbacks
+  // already deferred are made after the next update.
+  HLActionRunner *deferredRunner = [[HLActionRunner alloc] init];
+  [deferredRunner setRegistry:registry node:nil];
+  [deferredRunner runAction:[HLAction performSelector:@selector(HL_incrementCounter) onWeakTarget:self] withKey:@"increment"];
+  HLActionRunner *throwingRunner = [[HLActionTestsThrowingRunner alloc] init];
+  [throwingRunner setRegistry:registry node:nil];
+  [throwingRunner runAction:[HLAction waitForDuration:1.0] withKey:@"wait"];
+  _counter = 0;
+  XCTAssertThrowsSpecificNamed([registry updateAllRunners:0.125], NSException, @"HLActionTestsException");
+  XCTAssertEqual(_counter, 0);
+  HLActionRunner *immediateRunner = [[HLActionRunner alloc] init];
+  [immediateRunner runAction:[HLAction performSelector:@selector(HL_incrementCounter) onWeakTarget:self] withKey:@"increment"];
+  [immediateRunner update:0.125 node:nil];
+  XCTAssertEqual(_counter, 1);
+  [throwingRunner removeAllActions];
+  [registry updateAllRunners:0.125];
+  XCTAssertEqual(_counter, 2);
+  XCTAssertEqual(registry.runnerCount, 0);
+}
+
+- (void)testActionRunnerDefersIdleUpdates
+{
+  // Deferred updates match regular updates, including extra time carried out of waits.
+  {
+    NSTimeInterval frameTimes[] = { 0.1, 0.3, 0.05, 0.2, 0.017, 0.5, 0.033, 0.25, 0.4 };
+    SKNode *regularNode = [SKNode node];
+    SKNode *deferredNode = [SKNode node];
+    HLActionRunner *regularRunner = [[HLActionRunner alloc] init];
+    HLActionRunner *deferredRunner = [[HLActionRunner alloc] init];
+    deferredRunner.defersIdleUpdates = YES;
+    for (HLActionRunner *actionRunner in @[ regularRunner, deferredRunner ]) {
+      HLAction *action = [HLAction sequence:@[ [HLAction waitForDuration:0.6],
+                                               [HLAction moveByX:10.0f y:0.0f duration:0.5],
+                                               [HLAction waitForDuration:0.45],
+                                               [HLAction moveByX:0.0f y:10.0f duration:0.5] ]];
+      [actionRunner runAction:[HLAction repeatActionForever:action] withKey:@"repeat"];
+    }
+    for (size_t f = 0; f < sizeof(frameTimes) / sizeof(frameTimes[0]); ++f) {
+      [regularRunner update:frameTimes[f] node:regularNode];
+      [deferredRunner update:frameTimes[f] node:deferredNode];
+      XCTAssertEqualWithAccuracy(deferredNode.position.x, regularNode.position.x, 0.0001);
+      XCTAssertEqualWithAccuracy(deferredNode.position.y, regularNode.position.y, 0.0001);
+    }
+    // note: Accessing an action brings it up to date.
+    XCTAssertEqualWithAccuracy([deferredRunner actionForKey:@"repeat"].elapsedTime,
+                               [regularRunner actionForKey:@"repeat"].elapsedTime, 0.0001);
+  }
+
+  // Registry parks waiting runners and wakes them at their deadline.
+  {
+    HLActionRunnerRegistry *registry = [[HLActionRunnerRegistry alloc] init];
+    SKNode *node = [SKNode node];
+    [node hlSetActionRunnerRegistry:registry];
+    [node hlActionRunner].defersIdleUpdates = YES;
+    [node hlRunAction:[HLAction sequence:@[ [HLAction waitForDuration:1.0],
+                                            [HLAction moveByX:10.0f y:0.0f duration:1.0] ]]
+              withKey:@"sequence"];
+    for (int u = 0; u < 10; ++u) {
+      [registry updateAllRunners:0.1];
+      XCTAssertEqual(registry.runnerCount, 1);
+      XCTAssertEqualWithAccuracy(node.position.x, 0.0f, 0.0001);
+    }
+    for (int u = 0; u < 5; ++u) {
+      [registry updateAllRunners:0.1];
+    }
+    XCTAssertEqualWithAccuracy(node.position.x, 5.0f, 0.0001);
+    for (int u = 0; u < 5; ++u) {
+      [registry updateAllRunners:0.1];
+    }
+    XCTAssertEqualWithAccuracy(node.position.x, 10.0f, 0.0001);
+    XCTAssertEqual(registry.runnerCount, 0);
+    XCTAssertFalse([node hlHasActions]);
+  }
+}
+
+- (void)testActionRunnerOffscreen
+{
+  // Offscreen runners skip updates, and catch up in one update when back on screen.
+  {
+    SKNode *regularNode = [SKNode node];
+    SKNode *offscreenNode = [SKNode node];
+    HLActionRunner *regularRunner = [[HLActionRunner alloc] init];
+    HLActionRunner *offscreenRunner = [[HLActionRunner alloc] init];
+    for (HLActionRunner *actionRunner in @[ regularRunner, offscreenRunner ]) {
+      HLAction *action = [HLAction sequence:@[ [HLAction moveByX:10.0f y:0.0f duration:0.5],
+                                               [HLAction waitForDuration:0.3],
+                                               [HLAction moveByX:0.0f y:10.0f duration:0.5] ]];
+      [actionRunner runAction:[HLAction repeatActionForever:action] withKey:@"repeat"];
+    }
+    [regularRunner update:0.1 node:regularNode];
+    [offscreenRunner update:0.1 node:offscreenNode];
+    offscreenRunner.offscreen = YES;
+    for (int u = 0; u < 20; ++u) {
+      [regularRunner update:0.1 node:regularNode];
+      [offscreenRunner update:0.1 node:offscreenNode];
+    }
+    XCTAssertEqualWithAccuracy(offscreenNode.position.x, 2.0f, 0.0001);
+    XCTAssertEqualWithAccuracy(offscreenRunner.offscreenTime, 2.0, 0.000001);
+    offscreenRunner.offscreen = NO;
+    [regularRunner update:0.1 node:regularNode];
+    [offscreenRunner update:0.1 node:offscreenNode];
+    XCTAssertEqualWithAccuracy(offscreenNode.position.x, regularNode.position.x, 0.0001);
+    XCTAssertEqualWithAccuracy(offscreenNode.position.y, regularNode.position.y, 0.0001);
+    XCTAssertEqualWithAccuracy(offscreenRunner.offscreenTime, 0.0, 0.000001);
+  }
+
+  // Offscreen runners with an update interval update at a reduced rate.
+  {
+    SKNode *node = [SKNode node];
+    HLActionRunner *actionRunner = [[HLActionRunner alloc] init];
+    actionRunner.offscreen = YES;
+    actionRunner.offscreenUpdateInterval = 0.25;
+    [actionRunner runAction:[HLAction moveByX:10.0f y:0.0f duration:1.0] withKey:@"move"];
+    [actionRunner update:0.1 node:node];
+    [actionRunner update:0.1 node:node];
+    XCTAssertEqualWithAccuracy(node.position.x, 0.0f, 0.0001);
+    [actionRunner update:0.1 node:node];
+    XCTAssertEqualWithAccuracy(node.position.x, 3.0f, 0.0001);
+    XCTAssertEqualWithAccuracy(actionRunner.offscreenTime, 0.0, 0.000001);
+  }
+}
+
+- (void)HL_removeActionsWithNode:(SKNode *)node elapsedTime:(CGFloat)elapsedTime duration:(NSTimeInterval)duration userData:(HLActionRunner *)actionRunner
+{
+  [actionRunner removeActionForKey:@"removed"];
+  [actionRunner runAction:[HLAction performSelector:@selector(HL_incrementCounter) onWeakTarget:self] withKey:@"replaced"];
+  [actionRunner runAction:[HLAction waitForDuration:1.0] withKey:@"remove"];
+}
+
+- (void)testActionInstrumentation
+{
+  [HLActionInstrumentation reset];
+  [HLActionInstrumentation setEnabled:YES];
+  HLActionRunner *actionRunner = [[HLActionRunner alloc] init];
+  [actionRunner runAction:[HLAction repeatAction:[HLAction waitForDuration:1.0] count:3] withKey:@"repeat"];
+  [actionRunner update:1.5 node:nil];
+  [actionRunner update:2.0 node:nil];
+  [HLActionInstrumentation setEnabled:NO];
+  [actionRunner runAction:[HLAction waitForDuration:1.0] withKey:@"ignored"];
+  [actionRunner update:1.0 node:nil];
+
+  NSDictionary *statisticsByActionClass = [HLActionInstrumentation statisticsByActionClass];
+  HLActionStatistics *repeatStatistics = statisticsByActionClass[@"HLRepeatAction"];
+  XCTAssertEqual(repeatStatistics.updateCount, 2);
+  XCTAssertEqual(repeatStatistics.completionCount, 1);
+  HLActionStatistics *waitStatistics = statisticsByActionClass[@"HLWaitAction"];
+  XCTAssertEqual(waitStatistics.updateCount, 4);
+  XCTAssertEqual(waitStatistics.completionCount, 3);
+  // note: The third iteration reuses the action from the first.
+  XCTAssertEqual(waitStatistics.allocationCount, 2);
+  XCTAssertGreaterThanOrEqual(repeatStatistics.updateTime, waitStatistics.updateTime);
+
+  NSDictionary *statisticsByKey = [HLActionInstrumentation statisticsByKey];
+  XCTAssertEqual([statisticsByKey count], 1);
+  XCTAssertEqual(((HLActionStatistics *)statisticsByKey[@"repeat"]).updateCount, 2);
+
+  NSDictionary *json = [NSJSONSerialization JSONObjectWithData:[HLActionInstrumentation JSONData] options:0 error:NULL];
+  XCTAssertEqualObjects(json[@"actionClasses"][@"HLWaitAction"][@"completionCount"], @3);
+  XCTAssertTrue([[HLActionInstrumentation tableDescription] containsString:@"HLRepeatAction"]);
+
+  [HLActionInstrumentation reset];
+  XCTAssertEqual([[HLActionInstrumentation statisticsByActionClass] count], 0);
+}
+
+- (void)testActionRunnerUpdatePerformance1
+{
+  [self HL_measureActionRunnerUpdateWithActionCount:1];
+}
+
+- (void)testActionRunnerUpdatePerformance4
+{
+  [self HL_measureActionRunnerUpdateWithActionCount:4];
+}
+
+- (void)testActionRunnerUpdatePerformance16
+{
+  [self HL_measureActionRunnerUpdateWithActionCount:16];
+}
+
 @end
@@ -0,0 +1,137 @@
+//
+//  HLActionWorldTests.m
+//  HLSpriteKit
+//
+//  Created by Karl Voskuil on 10/16/26.
+//  Copyright © 2026 Hilo Games. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "HLActionWorld.h"
+
+@interface HLActionWorldTests : XCTestCase
+
+@end
+
+@implementation HLActionWorldTests
+
+- (void)testMatchesActions
+{
+  // By, with timing mode and speed.
+  {
+    SKNode *actionNode = [SKNode node];
+    SKNode *worldNode = [SKNode node];
+    HLMoveByAction *moveAction = [HLAction moveByX:10.0f y:-20.0f duration:1.0];
+    moveAction.timingMode = HLActionTimingEaseInEaseOut;
+    moveAction.speed = 1.5f;
+    HLActionWorld *world = [[HLActionWorld alloc] init];
+    NSUInteger track = [world addTrackWithType:HLActionWorldTrackMoveBy
+                                          node:worldNode
+                                        valueX:10.0f
+                                        valueY:-20.0f
+                                      duration:1.0
+                                    timingMode:HLActionTimingEaseInEaseOut
+                                         speed:1.5f];
+    for (int u = 0; u < 5; ++u) {
+      [moveAction update:0.1 node:actionNode];
+      [world update:0.1];
+      XCTAssertEqualWithAccuracy(worldNode.position.x, actionNode.position.x, 0.0001);
+      XCTAssertEqualWithAccuracy(worldNode.position.y, actionNode.position.y, 0.0001);
+    }
+    XCTAssertTrue([world hasTrack:track]);
+    [world update:0.5];
+    XCTAssertFalse([world hasTrack:track]);
+    XCTAssertEqual(world.trackCount, 0);
+    XCTAssertEqual(worldNode.position.x, 10.0f);
+    XCTAssertEqual(worldNode.position.y, -20.0f);
+  }
+
+  // To, with origin remembered at first update.
+  {
+    SKNode *actionNode = [SKNode node];
+    actionNode.alpha = 0.5f;
+    SKNode *worldNode = [SKNode node];
+    worldNode.alpha = 0.5f;
+    HLFadeAlphaToAction *fadeAction = [HLAction fadeAlphaTo:0.0f duration:2.0];
+    fadeAction.timingMode = HLActionTimingEaseIn;
+    HLActionWorld *world = [[HLActionWorld alloc] init];
+    [world addTrackWithType:HLActionWorldTrackFadeAlphaTo
+                       node:worldNode
+                     valueX:0.0f
+                     valueY:0.0f
+                   duration:2.0
+                 timingMode:HLActionTimingEaseIn
+                      speed:1.0f];
+    for (int u = 0; u < 4; ++u) {
+      [fadeAction update:0.3 node:actionNode];
+      [world update:0.3];
+      XCTAssertEqualWithAccuracy(worldNode.alpha, actionNode.alpha, 0.0001);
+    }
+  }
+}
+
+- (void)testExtraTime
+{
+  SKNode *actionNode = [SKNode node];
+  SKNode *worldNode = [SKNode node];
+  HLSequenceAction *sequenceAction = [HLAction sequence:@[ [HLAction moveTo:CGPointMake(10.0f, 0.0f) duration:0.25],
+                                                           [HLAction rotateByAngle:1.0f duration:0.5],
+                                                           [HLAction moveTo:CGPointMake(0.0f, 10.0f) duration:1.0] ]];
+  HLActionWorld *world = [[HLActionWorld alloc] init];
+  NSUInteger track = [world addTrackWithType:HLActionWorldTrackMoveTo node:worldNode valueX:10.0f valueY:0.0f duration:0.25 timingMode:HLActionTimingLinear speed:1.0f];
+  track = [world addTrackWithType:HLActionWorldTrackRotateBy node:worldNode valueX:1.0f valueY:0.0f duration:0.5 timingMode:HLActionTimingLinear speed:1.0f afterTrack:track];
+  [world addTrackWithType:HLActionWorldTrackMoveTo node:worldNode valueX:0.0f valueY:10.0f duration:1.0 timingMode:HLActionTimingLinear speed:1.0f afterTrack:track];
+  XCTAssertEqual(world.trackCount, 3);
+
+  // note: The first update completes the first track and carries extra time into the
+  // second; the second update completes the second track and carries into the third.
+  [sequenceAction update:0.4 node:actionNode];
+  [world update:0.4];
+  XCTAssertEqual(world.trackCount, 2);
+  XCTAssertEqualWithAccuracy(worldNode.zRotation, actionNode.zRotation, 0.0001);
+  [sequenceAction update:0.6 node:actionNode];
+  [world update:0.6];
+  XCTAssertEqual(world.trackCount, 1);
+  XCTAssertEqualWithAccuracy(worldNode.zRotation, 1.0f, 0.0001);
+  XCTAssertEqualWithAccuracy(worldNode.position.x, actionNode.position.x, 0.0001);
+  XCTAssertEqualWithAccuracy(worldNode.position.y, actionNode.position.y, 0.0001);
+
+  [world removeTracksForNode:worldNode];
+  XCTAssertEqual(world.trackCount, 0);
+}
+
+- (void)testConcurrentEvaluation
+{
+  const NSUInteger trackCount = 3000;
+  HLActionWorld *serialWorld = [[HLActionWorld alloc] initWithCapacity:trackCount];
+  HLActionWorld *concurrentWorld = [[HLActionWorld alloc] initWithCapacity:trackCount];
+  concurrentWorld.concurrentTrackThreshold = 1;
+  NSMutableArray *serialNodes = [NSMutableArray array];
+  NSMutableArray *concurrentNodes = [NSMutableArray array];
+  for (NSUInteger t = 0; t < trackCount; ++t) {
+    HLActionWorldTrackType type = (t % 2 == 0 ? HLActionWorldTrackMoveBy : HLActionWorldTrackMoveTo);
+    HLActionTimingMode timingMode = (HLActionTimingMode)(t % 4);
+    NSTimeInterval duration = 0.5 + (t % 7) * 0.25;
+    SKNode *serialNode = [SKNode node];
+    SKNode *concurrentNode = [SKNode node];
+    [serialNodes addObject:serialNode];
+    [concurrentNodes addObject:concurrentNode];
+    [serialWorld addTrackWithType:type node:serialNode valueX:(CGFloat)t valueY:-(CGFloat)t duration:duration timingMode:timingMode speed:1.0f];
+    [concurrentWorld addTrackWithType:type node:concurrentNode valueX:(CGFloat)t valueY:-(CGFloat)t duration:duration timingMode:timingMode speed:1.0f];
+  }
+
+  for (int u = 0; u < 12; ++u) {
+    [serialWorld update:0.2];
+    [concurrentWorld update:0.2];
+    XCTAssertEqual(serialWorld.trackCount, concurrentWorld.trackCount);
+  }
+  for (NSUInteger t = 0; t < trackCount; ++t) {
+    SKNode *serialNode = serialNodes[t];
+    SKNode *concurrentNode = concurrentNodes[t];
+    XCTAssertEqual(serialNode.position.x, concurrentNode.position.x);
+    XCTAssertEqual(serialNode.position.y, concurrentNode.position.y);
+  }
+}
+
+@end
@@ -16,6 +16,32 @@
 
 @implementation HLFunctionTests
 
+- (void)testCubicBezierArcLength
+{
+  HLCubicBezier *bezier = [[HLCubicBezier alloc] initWithP0:CGPointMake(0.0f, 0.0f)
+                                                         p1:CGPointMake(0.0f, 0.0f)
+                                                         p2:CGPointMake(10.0f, 0.0f)
+                                                         p3:CGPointMake(10.0f, 0.0f)];
+  XCTAssertEqualWithAccuracy(bezier.arcLength, 10.0f, 0.0001);
+  XCTAssertEqual([bezier tForArcLength:-1.0f], 0.0f);
+  XCTAssertEqual([bezier tForArcLength:11.0f], 1.0f);
+  // note: The curve is symmetric, so the middle of the curve is at t = 0.5.
+  XCTAssertEqualWithAccuracy([bezier tForArcLength:5.0f], 0.5f, 0.0001);
+  CGFloat t = [bezier tForArcLength:2.5f];
+  XCTAssertEqualWithAccuracy([bezier pointForT:t].x, 2.5f, 0.01);
+  XCTAssertEqualWithAccuracy([bezier tangentForT:0.5f].x, 15.0f, 0.0001);
+
+  HLCubicBezier *circleBezier = [[HLCubicBezier alloc] initWithP0:CGPointMake(1.0f, 0.0f)
+                                                               p1:CGPointMake(1.0f, 0.5523f)
+                                                               p2:CGPointMake(0.5523f, 1.0f)
+                                                               p3:CGPointMake(0.0f, 1.0f)];
+  HLCubicBezierPath *path = [[HLCubicBezierPath alloc] initWithBeziers:@[ bezier, circleBezier ]];
+  XCTAssertEqualWithAccuracy(path.arcLength, 10.0f + M_PI_2, 0.001);
+  CGPoint point = [path pointForArcLength:(10.0f + M_PI_4)];
+  XCTAssertEqualWithAccuracy(point.x, M_SQRT1_2, 0.001);
+  XCTAssertEqualWithAccuracy(point.y, M_SQRT1_2, 0.001);
+}
+
 - (void)testPiecewiseLinearFunction
 {
   HLPiecewiseLinearFunction *plf = [[HLPiecewiseLinearFunction alloc] initWithKnotXValues:@[ @(0.0f), @(0.5f), @(1.0f)]
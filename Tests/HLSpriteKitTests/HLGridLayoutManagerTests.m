@@ -120,4 +120,34 @@
   }
 }
 
+- (void)testLayoutSizes
+{
+  const CGFloat epsilon = 0.0001f;
+
+  HLGridLayoutManager *layoutManager = [[HLGridLayoutManager alloc] initWithColumnCount:3 squareSize:CGSizeMake(13.0f, 13.0f)];
+  layoutManager.gridBorder = 11.0f;
+  layoutManager.squareSeparator = 7.0f;
+
+  // note: Sizes are ignored; every entry is positioned, and the size is updated.
+  CGPoint positions[5];
+  [layoutManager layoutSizes:NULL count:5 getPositions:positions];
+  XCTAssertEqual(layoutManager.rowCount, 2);
+  XCTAssertEqualWithAccuracy(layoutManager.size.width, 75.0f, epsilon);
+  XCTAssertEqualWithAccuracy(layoutManager.size.height, 55.0f, epsilon);
+  XCTAssertEqualWithAccuracy(positions[1].x - positions[0].x, 20.0f, epsilon);
+  XCTAssertEqualWithAccuracy(positions[3].x, positions[0].x, epsilon);
+  XCTAssertEqualWithAccuracy(positions[0].y - positions[3].y, 20.0f, epsilon);
+
+  // note: Matches layout of the same number of nodes.
+  NSMutableArray *layoutNodes = [NSMutableArray array];
+  for (NSInteger i = 0; i < 5; ++i) {
+    [layoutNodes addObject:[SKNode node]];
+  }
+  [layoutManager layout:layoutNodes];
+  for (NSUInteger n = 0; n < 5; ++n) {
+    XCTAssertEqualWithAccuracy(((SKNode *)layoutNodes[n]).position.x, positions[n].x, epsilon);
+    XCTAssertEqualWithAccuracy(((SKNode *)layoutNodes[n]).position.y, positions[n].y, epsilon);
+  }
+}
+
 @end
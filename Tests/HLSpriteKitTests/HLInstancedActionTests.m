@@ -0,0 +1,116 @@
+//
+//  HLInstancedActionTests.m
+//  HLSpriteKit
+//
+//  Created by Karl Voskuil on 10/16/26.
+//  Copyright © 2026 Hilo Games. All rights reserved.
+//
+
+#import <XCTest/XCTest.h>
+
+#import "HLInstancedAction.h"
+#import "SKNode+HLAction.h"
+
+@interface HLInstancedActionTests : XCTestCase
+
+@end
+
+@implementation HLInstancedActionTests
+
+- (void)testBroadcastDeltas
+{
+  HLAction *bobAction = [HLAction repeatAction:[HLAction sequence:@[ [HLAction moveByX:0.0f y:10.0f duration:0.5],
+                                                                     [HLAction moveByX:0.0f y:-10.0f duration:0.5] ]]
+                                         count:2];
+  HLInstancedAction *instancedAction = [[HLInstancedAction alloc] initWithAction:bobAction];
+  NSMutableArray *instancedNodes = [NSMutableArray array];
+  NSMutableArray *runnerNodes = [NSMutableArray array];
+  for (int n = 0; n < 3; ++n) {
+    SKNode *instancedNode = [SKNode node];
+    instancedNode.position = CGPointMake(n * 100.0f, n * 50.0f);
+    [instancedAction addNode:instancedNode];
+    [instancedNodes addObject:instancedNode];
+    SKNode *runnerNode = [SKNode node];
+    runnerNode.position = instancedNode.position;
+    [runnerNode hlRunAction:[bobAction copy] withKey:@"bob"];
+    [runnerNodes addObject:runnerNode];
+  }
+  XCTAssertEqual(instancedAction.nodeCount, 3);
+  XCTAssertEqual(instancedAction.phaseCount, 1);
+
+  for (int u = 0; u < 12; ++u) {
+    [instancedAction update:0.15];
+    for (int n = 0; n < 3; ++n) {
+      SKNode *instancedNode = instancedNodes[n];
+      SKNode *runnerNode = runnerNodes[n];
+      [runnerNode hlActionRunnerUpdate:0.15];
+      XCTAssertEqualWithAccuracy(instancedNode.position.x, runnerNode.position.x, 0.0001);
+      XCTAssertEqualWithAccuracy(instancedNode.position.y, runnerNode.position.y, 0.0001);
+    }
+  }
+
+  // note: Completion unsubscribes the nodes.
+  [instancedAction update:1.0];
+  XCTAssertEqual(instancedAction.nodeCount, 0);
+  XCTAssertEqual(instancedAction.phaseCount, 0);
+  XCTAssertEqualWithAccuracy(((SKNode *)instancedNodes[2]).position.y, 100.0f, 0.0001);
+}
+
+- (void)testTimeOffsets
+{
+  HLInstancedAction *instancedAction = [[HLInstancedAction alloc] initWithAction:[HLAction moveByX:8.0f y:0.0f duration:1.0]];
+  SKNode *leadingNode = [SKNode node];
+  SKNode *laggingNode = [SKNode node];
+  SKNode *otherLaggingNode = [SKNode node];
+  [instancedAction addNode:leadingNode];
+  [instancedAction addNode:laggingNode timeOffset:0.25];
+  [instancedAction addNode:otherLaggingNode timeOffset:0.25];
+  [instancedAction addNode:otherLaggingNode timeOffset:0.5];
+  XCTAssertEqual(instancedAction.nodeCount, 3);
+  XCTAssertEqual(instancedAction.phaseCount, 2);
+
+  [instancedAction update:0.1];
+  XCTAssertEqualWithAccuracy(leadingNode.position.x, 0.8f, 0.0001);
+  XCTAssertEqualWithAccuracy(laggingNode.position.x, 0.0f, 0.0001);
+  [instancedAction update:0.4];
+  XCTAssertEqualWithAccuracy(leadingNode.position.x, 4.0f, 0.0001);
+  XCTAssertEqualWithAccuracy(laggingNode.position.x, 2.0f, 0.0001);
+  XCTAssertEqualWithAccuracy(otherLaggingNode.position.x, 2.0f, 0.0001);
+
+  // note: A node joining a phase in progress sees only later changes; a new phase catches
+  // up silently.
+  SKNode *joiningNode = [SKNode node];
+  [instancedAction addNode:joiningNode timeOffset:0.25];
+  SKNode *newPhaseNode = [SKNode node];
+  [instancedAction addNode:newPhaseNode timeOffset:0.375];
+  XCTAssertEqual(instancedAction.phaseCount, 3);
+  [instancedAction removeNode:otherLaggingNode];
+  [instancedAction update:0.5];
+  XCTAssertEqualWithAccuracy(leadingNode.position.x, 8.0f, 0.0001);
+  XCTAssertEqualWithAccuracy(laggingNode.position.x, 6.0f, 0.0001);
+  XCTAssertEqualWithAccuracy(otherLaggingNode.position.x, 2.0f, 0.0001);
+  XCTAssertEqualWithAccuracy(joiningNode.position.x, 4.0f, 0.0001);
+  XCTAssertEqualWithAccuracy(newPhaseNode.position.x, 4.0f, 0.0001);
+  XCTAssertEqual(instancedAction.phaseCount, 2);
+  XCTAssertEqual(instancedAction.nodeCount, 3);
+}
+
+- (void)testBroadcastValues
+{
+  HLInstancedAction *instancedAction = [[HLInstancedAction alloc] initWithAction:[HLAction fadeAlphaTo:0.0f duration:1.0]
+                                                                   broadcastMode:HLInstancedActionBroadcastValues];
+  instancedAction.templateNode.alpha = 0.5f;
+  SKNode *node = [SKNode node];
+  node.position = CGPointMake(3.0f, 4.0f);
+  [instancedAction addNode:node];
+  [instancedAction update:0.5];
+  XCTAssertEqualWithAccuracy(node.alpha, 0.25f, 0.0001);
+  // note: Unchanged properties are left alone.
+  XCTAssertEqual(node.position.x, 3.0f);
+  XCTAssertEqual(node.position.y, 4.0f);
+  [instancedAction update:0.5];
+  XCTAssertEqual(node.alpha, 0.0f);
+  XCTAssertEqual(instancedAction.nodeCount, 0);
+}
+
+@end
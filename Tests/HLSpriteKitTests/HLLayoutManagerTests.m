@@ -11,6 +11,8 @@
 
 #import "HLLayoutManager.h"
 
+#include <objc/runtime.h>
+
 @interface HLLayoutManagerTests : XCTestCase
 @end
 
@@ -44,6 +46,26 @@
 }
 @end
 
+@interface HLLayoutSizingThing : SKLabelNode <HLLayoutSizing>
+@end
+@implementation HLLayoutSizingThing
+- (CGSize)layoutSize
+{
+  return CGSizeMake(3.0f, 4.0f);
+}
+@end
+
+@interface HLLaterSizedNode : SKNode
+@end
+@implementation HLLaterSizedNode
+@end
+
+static CGSize
+HLLaterSizedNodeSize(id self, SEL _cmd)
+{
+  return CGSizeMake(11.0f, 12.0f);
+}
+
 @implementation HLLayoutManagerTests
 
 - (void)testGetNodeSize
@@ -73,6 +95,25 @@
     XCTAssertTrue(CGSizeEqualToSize(size, spriteNodeSize));
   }
 
+  {
+    // note: Measured repeatedly, so that the cached resolution is used, too.
+    HLSizedThing *sizedThing = [[HLSizedThing alloc] initWithSize:CGSizeMake(5.0f, 6.0f)];
+    for (int i = 0; i < 2; ++i) {
+      XCTAssertTrue(CGSizeEqualToSize(HLLayoutManagerGetNodeSize(sizedThing), CGSizeMake(5.0f, 6.0f)));
+      XCTAssertEqual(HLLayoutManagerGetNodeWidth(sizedThing), 5.0f);
+      XCTAssertEqual(HLLayoutManagerGetNodeHeight(sizedThing), 6.0f);
+    }
+    sizedThing.size = CGSizeMake(7.0f, 8.0f);
+    XCTAssertTrue(CGSizeEqualToSize(HLLayoutManagerGetNodeSize(sizedThing), CGSizeMake(7.0f, 8.0f)));
+  }
+
+  {
+    // note: Conforming to HLLayoutSizing takes precedence over being a label node.
+    HLLayoutSizingThing *layoutSizingThing = [HLLayoutSizingThing labelNodeWithText:@"hello"];
+    CGSize size = HLLayoutManagerGetNodeSize(layoutSizingThing);
+    XCTAssertTrue(CGSizeEqualToSize(size, CGSizeMake(3.0f, 4.0f)));
+  }
+
   {
     HLWrongTypeSizedThing *wrongTypeSizedThing = [[HLWrongTypeSizedThing alloc] initWithSize:3];
     CGSize size;
@@ -88,4 +129,27 @@
   }
 }
 
+- (void)testInvalidateNodeSizeCache
+{
+  HLLaterSizedNode *laterSizedNode = [HLLaterSizedNode node];
+  XCTAssertTrue(CGSizeEqualToSize(HLLayoutManagerGetNodeSize(laterSizedNode), CGSizeZero));
+
+  // note: Added after the class has been resolved, so not used until the cache is
+  // invalidated.
+  NSString *types = [NSString stringWithFormat:@"%s@:", @encode(CGSize)];
+  BOOL added = class_addMethod([HLLaterSizedNode class], @selector(size), (IMP)HLLaterSizedNodeSize, [types UTF8String]);
+  XCTAssertTrue(added);
+
+  HLLayoutManagerInvalidateNodeSizeCache();
+  XCTAssertTrue(CGSizeEqualToSize(HLLayoutManagerGetNodeSize(laterSizedNode), CGSizeMake(11.0f, 12.0f)));
+  CGSize sizes[2];
+  HLLayoutManagerGetNodeSizes(@[ laterSizedNode, [SKNode node] ], sizes);
+  XCTAssertTrue(CGSizeEqualToSize(sizes[0], CGSizeMake(11.0f, 12.0f)));
+  XCTAssertTrue(CGSizeEqualToSize(sizes[1], CGSizeZero));
+
+  // note: Other classes are resolved again, too.
+  SKSpriteNode *spriteNode = [SKSpriteNode spriteNodeWithColor:[SKColor blackColor] size:CGSizeMake(10.0f, 10.0f)];
+  XCTAssertTrue(CGSizeEqualToSize(HLLayoutManagerGetNodeSize(spriteNode), CGSizeMake(10.0f, 10.0f)));
+}
+
 @end
@@ -0,0 +1,110 @@
+//
+//  HLLayoutStateTests.m
+//  HLSpriteKit
+//
+//  Created by Karl Voskuil on 10/16/26.
+//  Copyright © 2026 Hilo Games. All rights reserved.
+//
+
+#import <SpriteKit/SpriteKit.h>
+#import <XCTest/XCTest.h>
+
+#import "HLLayoutState.h"
+#import "HLStackLayoutManager.h"
+#import "HLTableLayoutManager.h"
+
+@interface HLLayoutStateTests : XCTestCase
+
+@end
+
+@implementation HLLayoutStateTests
+
+- (void)testBasic
+{
+  HLLayoutState *state = [[HLLayoutState alloc] initWithLineAxis:HLLayoutStateAxisY];
+  XCTAssertEqual([state cellContainingPoint:CGPointZero], NSNotFound);
+
+  // note: Lines and cells added in decreasing order, with gaps.
+  [state addLineFrom:10.0f to:0.0f];
+  [state addCellFrom:-10.0f to:-20.0f];
+  [state addCellFrom:-25.0f to:-30.0f];
+  [state addLineFrom:-5.0f to:-15.0f];
+  [state addCellFrom:0.0f to:5.0f];
+  XCTAssertEqual(state.lineCount, 2);
+  XCTAssertEqual(state.cellCount, 3);
+  XCTAssertEqual([state cellRangeOfLineAtIndex:0].location, 0);
+  XCTAssertEqual([state cellRangeOfLineAtIndex:0].length, 2);
+  XCTAssertEqual([state cellRangeOfLineAtIndex:1].location, 2);
+  XCTAssertEqual([state cellRangeOfLineAtIndex:1].length, 1);
+
+  XCTAssertEqual([state lineContainingPoint:CGPointMake(0.0f, 5.0f)], 0);
+  XCTAssertEqual([state lineContainingPoint:CGPointMake(0.0f, -10.0f)], 1);
+  XCTAssertEqual([state lineContainingPoint:CGPointMake(0.0f, -2.0f)], NSNotFound);
+  XCTAssertEqual([state cellContainingPoint:CGPointMake(-15.0f, 5.0f)], 0);
+  XCTAssertEqual([state cellContainingPoint:CGPointMake(-27.0f, 5.0f)], 1);
+  XCTAssertEqual([state cellContainingPoint:CGPointMake(-22.0f, 5.0f)], NSNotFound);
+  XCTAssertEqual([state cellContainingPoint:CGPointMake(-35.0f, 5.0f)], NSNotFound);
+  XCTAssertEqual([state cellContainingPoint:CGPointMake(3.0f, -10.0f)], 2);
+  XCTAssertEqual([state cellContainingPoint:CGPointMake(-15.0f, -10.0f)], NSNotFound);
+
+  NSMutableIndexSet *expectedIndexes = [NSMutableIndexSet indexSetWithIndexesInRange:NSMakeRange(0, 2)];
+  XCTAssertEqualObjects([state cellIndexesIntersectingRect:CGRectMake(-28.0f, 2.0f, 16.0f, 1.0f)], expectedIndexes);
+  [expectedIndexes removeIndex:1];
+  [expectedIndexes addIndex:2];
+  XCTAssertEqualObjects([state cellIndexesIntersectingRect:CGRectMake(-15.0f, -10.0f, 18.0f, 15.0f)], expectedIndexes);
+  XCTAssertEqual([[state cellIndexesIntersectingRect:CGRectMake(-100.0f, -3.0f, 200.0f, 2.0f)] count], 0);
+  XCTAssertEqual([[state cellIndexesIntersectingRect:CGRectNull] count], 0);
+}
+
+- (void)testStack
+{
+  SKSpriteNode *mediumNode = [SKSpriteNode spriteNodeWithColor:[SKColor whiteColor] size:CGSizeMake(20.0f, 20.0f)];
+  SKSpriteNode *bigNode = [SKSpriteNode spriteNodeWithColor:[SKColor whiteColor] size:CGSizeMake(30.0f, 30.0f)];
+  SKSpriteNode *smallNode = [SKSpriteNode spriteNodeWithColor:[SKColor whiteColor] size:CGSizeMake(10.0f, 10.0f)];
+  NSArray *nodes = @[ mediumNode, bigNode, smallNode ];
+
+  // note: Cells are [-35, -15], [-10, 20], and [25, 35].
+  HLStackLayoutManager *layoutManager = [[HLStackLayoutManager alloc] initWithStackDirection:HLStackLayoutManagerStackRight];
+  layoutManager.cellSeparator = 5.0f;
+  HLLayoutState *state = nil;
+  [layoutManager layout:nodes getState:&state];
+  XCTAssertEqual(state.lineCount, 1);
+  XCTAssertEqual(state.cellCount, 3);
+  XCTAssertEqual([state cellContainingPoint:CGPointMake(-35.0f, 100.0f)], 0);
+  XCTAssertEqual([state cellContainingPoint:CGPointMake(-12.0f, 0.0f)], NSNotFound);
+  XCTAssertEqual([state cellContainingPoint:CGPointMake(0.0f, 0.0f)], 1);
+  XCTAssertEqual([state cellContainingPoint:CGPointMake(30.0f, 0.0f)], 2);
+  XCTAssertEqual([state cellContainingPoint:CGPointMake(40.0f, 0.0f)], NSNotFound);
+
+  // note: Cells are [15, 35], [-20, 10], and [-35, -25].
+  layoutManager.stackDirection = HLStackLayoutManagerStackDown;
+  [layoutManager layout:nodes getState:&state];
+  XCTAssertEqual([state cellContainingPoint:CGPointMake(100.0f, 20.0f)], 0);
+  XCTAssertEqual([state cellContainingPoint:CGPointMake(0.0f, 12.0f)], NSNotFound);
+  XCTAssertEqual([state cellContainingPoint:CGPointMake(0.0f, 0.0f)], 1);
+  XCTAssertEqual([state cellContainingPoint:CGPointMake(0.0f, -30.0f)], 2);
+}
+
+- (void)testTable
+{
+  HLTableLayoutManager *layoutManager = [[HLTableLayoutManager alloc] init];
+  layoutManager.anchorPoint = CGPointMake(0.0f, 1.0f);
+  layoutManager.columnCount = 2;
+  layoutManager.columnWidths = @[ @10.0f, @20.0f ];
+  layoutManager.rowHeights = @[ @5.0f ];
+
+  // note: Rows are [0, -5] and [-5, -10]; columns are [0, 10] and [10, 30].
+  CGSize sizes[3] = { CGSizeZero, CGSizeZero, CGSizeZero };
+  CGPoint positions[3];
+  HLLayoutState *state = nil;
+  [layoutManager layoutSizes:sizes count:3 getPositions:positions state:&state];
+  XCTAssertEqual(state.lineCount, 2);
+  XCTAssertEqual(state.cellCount, 3);
+  XCTAssertEqual([state cellContainingPoint:CGPointMake(5.0f, -2.0f)], 0);
+  XCTAssertEqual([state cellContainingPoint:CGPointMake(15.0f, -2.0f)], 1);
+  XCTAssertEqual([state cellContainingPoint:CGPointMake(5.0f, -7.0f)], 2);
+  XCTAssertEqual([state cellContainingPoint:CGPointMake(15.0f, -7.0f)], NSNotFound);
+  XCTAssertEqual([state cellContainingPoint:CGPointMake(5.0f, 1.0f)], NSNotFound);
+}
+
+@end
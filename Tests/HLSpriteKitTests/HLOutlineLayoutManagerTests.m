@@ -284,4 +284,39 @@
   }
 }
 
+- (void)testLayoutSizes
+{
+  const CGFloat HLEpsilon = 0.0001f;
+
+  NSArray *nodeLevels = @[ @0, @1, @1, @0 ];
+  HLOutlineLayoutManager *layoutManager = [[HLOutlineLayoutManager alloc] initWithNodeLevels:nodeLevels levelIndents:@[ @10.0f ]];
+  layoutManager.anchorPointY = 1.0f;
+  layoutManager.levelLineHeights = @[ @24.0f, @16.0f ];
+  layoutManager.levelAnchorPointYs = @[ @0.0f ];
+  layoutManager.outlinePosition = CGPointMake(3.0f, -100.0f);
+
+  // note: Only as many positions are calculated as there are node levels.
+  CGSize sizes[5] = { CGSizeMake(20.0f, 10.0f), CGSizeMake(8.0f, 8.0f), CGSizeMake(8.0f, 8.0f), CGSizeMake(20.0f, 10.0f), CGSizeMake(5.0f, 5.0f) };
+  CGPoint positions[5];
+  positions[4] = CGPointMake(-1.0f, -1.0f);
+  [layoutManager layoutSizes:sizes count:5 getPositions:positions];
+  XCTAssertEqualWithAccuracy(layoutManager.height, 80.0f, HLEpsilon);
+  XCTAssertEqualWithAccuracy(positions[0].y, -124.0f, HLEpsilon);
+  XCTAssertEqualWithAccuracy(positions[1].y, -140.0f, HLEpsilon);
+  XCTAssertEqualWithAccuracy(positions[3].y, -180.0f, HLEpsilon);
+  XCTAssertEqualWithAccuracy(positions[1].x - positions[0].x, 10.0f, HLEpsilon);
+  XCTAssertEqualWithAccuracy(positions[4].x, -1.0f, HLEpsilon);
+
+  // note: Matches layout of non-label nodes with the same sizes.
+  NSMutableArray *nodes = [NSMutableArray array];
+  for (NSUInteger n = 0; n < 4; ++n) {
+    [nodes addObject:[SKSpriteNode spriteNodeWithColor:[SKColor whiteColor] size:sizes[n]]];
+  }
+  [layoutManager layout:nodes];
+  for (NSUInteger n = 0; n < 4; ++n) {
+    XCTAssertEqualWithAccuracy(((SKNode *)nodes[n]).position.x, positions[n].x, HLEpsilon);
+    XCTAssertEqualWithAccuracy(((SKNode *)nodes[n]).position.y, positions[n].y, HLEpsilon);
+  }
+}
+
 @end
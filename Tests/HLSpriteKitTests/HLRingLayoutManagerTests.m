@@ -0,0 +1,70 @@
+//
+//  HLRingLayoutManagerTests.m
+//  HLSpriteKit
+//
+//  Created by Karl Voskuil on 10/16/26.
+//  Copyright © 2026 Hilo Games. All rights reserved.
+//
+
+#import <SpriteKit/SpriteKit.h>
+#import <XCTest/XCTest.h>
+
+#import "HLRingLayoutManager.h"
+
+@interface HLRingLayoutManagerTests : XCTestCase
+
+@end
+
+@implementation HLRingLayoutManagerTests
+
+- (void)testSkipsNonNodes
+{
+  const CGFloat epsilon = 0.0001f;
+
+  SKNode *firstNode = [SKNode node];
+  SKNode *secondNode = [SKNode node];
+  NSArray *nodes = @[ firstNode, [NSNull null], secondNode ];
+
+  HLRingLayoutManager *layoutManager = [[HLRingLayoutManager alloc] init];
+  layoutManager.radii = @[ @10.0f ];
+  [layoutManager setThetasWithInitialTheta:0.0f thetaIncrement:(CGFloat)M_PI_2];
+
+  // note: The null is not laid out, and does not advance theta.
+  NSArray *thetas = nil;
+  [layoutManager layout:nodes getThetas:&thetas];
+  XCTAssertEqual([thetas count], 2);
+  XCTAssertEqualWithAccuracy(firstNode.position.x, 10.0f, epsilon);
+  XCTAssertEqualWithAccuracy(firstNode.position.y, 0.0f, epsilon);
+  XCTAssertEqualWithAccuracy(secondNode.position.x, 0.0f, epsilon);
+  XCTAssertEqualWithAccuracy(secondNode.position.y, 10.0f, epsilon);
+}
+
+- (void)testLayoutSizes
+{
+  const CGFloat epsilon = 0.0001f;
+
+  HLRingLayoutManager *layoutManager = [[HLRingLayoutManager alloc] init];
+  layoutManager.ringPosition = CGPointMake(5.0f, 0.0f);
+  layoutManager.radii = @[ @10.0f, @20.0f ];
+  [layoutManager setThetasWithInitialTheta:0.0f thetaIncrement:(CGFloat)M_PI_2];
+
+  // note: Sizes are ignored; every entry is positioned.
+  CGPoint positions[3];
+  [layoutManager layoutSizes:NULL count:3 getPositions:positions];
+  XCTAssertEqualWithAccuracy(positions[0].x, 15.0f, epsilon);
+  XCTAssertEqualWithAccuracy(positions[0].y, 0.0f, epsilon);
+  XCTAssertEqualWithAccuracy(positions[1].x, 5.0f, epsilon);
+  XCTAssertEqualWithAccuracy(positions[1].y, 20.0f, epsilon);
+  XCTAssertEqualWithAccuracy(positions[2].x, -15.0f, epsilon);
+  XCTAssertEqualWithAccuracy(positions[2].y, 0.0f, epsilon);
+
+  // note: Matches layout of the same number of nodes.
+  NSArray *nodes = @[ [SKNode node], [SKNode node], [SKNode node] ];
+  [layoutManager layout:nodes];
+  for (NSUInteger n = 0; n < 3; ++n) {
+    XCTAssertEqualWithAccuracy(((SKNode *)nodes[n]).position.x, positions[n].x, epsilon);
+    XCTAssertEqualWithAccuracy(((SKNode *)nodes[n]).position.y, positions[n].y, epsilon);
+  }
+}
+
+@end
@@ -83,6 +83,106 @@
   }
 }
 
+- (void)testLayoutSizes
+{
+  const CGFloat HLEpsilon = 0.0001f;
+
+  SKSpriteNode *spriteNode = [SKSpriteNode spriteNodeWithColor:[SKColor whiteColor] size:CGSizeMake(20.0f, 10.0f)];
+  SKLabelNode *labelNode = [SKLabelNode labelNodeWithText:@"Label Node"];
+  NSArray *nodes = @[ spriteNode, labelNode, [NSNull null] ];
+
+  HLStackLayoutManager *layoutManager = [[HLStackLayoutManager alloc] initWithStackDirection:HLStackLayoutManagerStackDown];
+  layoutManager.cellLengths = @[ @0.0, @0.0, @15.0 ];
+  layoutManager.cellSeparator = 2.0f;
+  layoutManager.cellLabelOffsetY = -3.0f;
+
+  // note: Geometry-only layout gives the same positions as layout, except for the label
+  // offset, and touches no nodes.
+  CGSize sizes[3] = { spriteNode.size, labelNode.frame.size, CGSizeZero };
+  CGPoint positions[3];
+  [layoutManager layoutSizes:sizes count:3 getPositions:positions];
+  CGFloat dryRunLength = layoutManager.length;
+  XCTAssertEqualWithAccuracy(spriteNode.position.y, 0.0f, HLEpsilon);
+
+  [layoutManager layout:nodes];
+  XCTAssertEqualWithAccuracy(layoutManager.length, dryRunLength, HLEpsilon);
+  XCTAssertEqualWithAccuracy(spriteNode.position.x, positions[0].x, HLEpsilon);
+  XCTAssertEqualWithAccuracy(spriteNode.position.y, positions[0].y, HLEpsilon);
+  XCTAssertEqualWithAccuracy(labelNode.position.y, positions[1].y - 3.0f, HLEpsilon);
+  XCTAssertEqualWithAccuracy(positions[0].y - positions[2].y,
+                             5.0f + 2.0f + labelNode.frame.size.height + 2.0f + 7.5f,
+                             HLEpsilon);
+}
+
+- (void)testLayoutIncrementally
+{
+  const CGFloat HLEpsilon = 0.0001f;
+
+  NSMutableArray *nodes = [NSMutableArray array];
+  for (NSUInteger n = 0; n < 5; ++n) {
+    [nodes addObject:[SKSpriteNode spriteNodeWithColor:[SKColor whiteColor] size:CGSizeMake(10.0f, 10.0f + n)]];
+  }
+  HLStackLayoutManager *layoutManager = [[HLStackLayoutManager alloc] initWithStackDirection:HLStackLayoutManagerStackDown];
+  layoutManager.anchorPoint = 1.0f;
+  layoutManager.cellSeparator = 2.0f;
+  [layoutManager layoutIncrementally:nodes];
+
+  // note: With the top of the stack fixed, appending a node does not reposition the
+  // nodes before it.
+  SKSpriteNode *firstNode = nodes[0];
+  CGPoint firstPosition = firstNode.position;
+  firstNode.position = CGPointMake(100.0f, 100.0f);
+  [nodes addObject:[SKSpriteNode spriteNodeWithColor:[SKColor whiteColor] size:CGSizeMake(10.0f, 20.0f)]];
+  [layoutManager noteNodesInsertedInRange:NSMakeRange(5, 1)];
+  [layoutManager layoutIncrementally:nodes];
+  XCTAssertEqualWithAccuracy(firstNode.position.y, 100.0f, HLEpsilon);
+  firstNode.position = firstPosition;
+
+  // note: Every change gives the same result as a full layout.
+  void (^checkFullLayout)(void) = ^{
+    CGPoint positions[8];
+    for (NSUInteger n = 0; n < [nodes count]; ++n) {
+      positions[n] = [(SKNode *)nodes[n] position];
+    }
+    HLStackLayoutManager *fullLayoutManager = [layoutManager copy];
+    [fullLayoutManager layout:nodes];
+    for (NSUInteger n = 0; n < [nodes count]; ++n) {
+      XCTAssertEqualWithAccuracy([(SKNode *)nodes[n] position].x, positions[n].x, HLEpsilon);
+      XCTAssertEqualWithAccuracy([(SKNode *)nodes[n] position].y, positions[n].y, HLEpsilon);
+    }
+    XCTAssertEqualWithAccuracy(fullLayoutManager.length, layoutManager.length, HLEpsilon);
+  };
+  checkFullLayout();
+
+  [(SKSpriteNode *)nodes[2] setSize:CGSizeMake(10.0f, 40.0f)];
+  [nodes insertObject:[SKSpriteNode spriteNodeWithColor:[SKColor whiteColor] size:CGSizeMake(10.0f, 5.0f)] atIndex:1];
+  [layoutManager noteNodesResizedInRange:NSMakeRange(2, 1)];
+  [layoutManager noteNodesInsertedInRange:NSMakeRange(1, 1)];
+  [layoutManager layoutIncrementally:nodes];
+  checkFullLayout();
+
+  [nodes removeObjectsInRange:NSMakeRange(3, 2)];
+  [layoutManager noteNodesRemovedInRange:NSMakeRange(3, 2)];
+  [layoutManager layoutIncrementally:nodes];
+  checkFullLayout();
+
+  // note: Configuration changes are noticed.
+  layoutManager.anchorPoint = 0.5f;
+  layoutManager.cellLengths = @[ @0.0, @30.0, @0.0 ];
+  [layoutManager layoutIncrementally:nodes];
+  checkFullLayout();
+
+  // note: Moving the stack perpendicular to the stacking direction doesn't move the start
+  // of the stack, but still moves every node.
+  layoutManager.stackPosition = CGPointMake(25.0f, 0.0f);
+  [layoutManager layoutIncrementally:nodes];
+  XCTAssertEqualWithAccuracy([(SKNode *)nodes[0] position].x, 25.0f, HLEpsilon);
+  XCTAssertEqualWithAccuracy([(SKNode *)[nodes lastObject] position].x, 25.0f, HLEpsilon);
+  checkFullLayout();
+
+  XCTAssertThrows([layoutManager noteNodesRemovedInRange:NSMakeRange(3, 10)]);
+}
+
 - (void)testCellContainingPoint
 {
   SKSpriteNode *mediumNode = [SKSpriteNode spriteNodeWithColor:[SKColor whiteColor] size:CGSizeMake(20.0f, 20.0f)];
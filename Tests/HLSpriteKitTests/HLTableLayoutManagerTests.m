@@ -79,4 +79,27 @@
   }
 }
 
+- (void)testLayoutSizes
+{
+  const CGFloat epsilon = 0.0001f;
+
+  HLTableLayoutManager *layoutManager = [[HLTableLayoutManager alloc] init];
+  layoutManager.anchorPoint = CGPointZero;
+  layoutManager.columnCount = 2;
+  layoutManager.columnSeparator = 1.0f;
+
+  // note: Column widths and row heights fit the largest sizes in each.
+  CGSize sizes[3] = { CGSizeMake(10.0f, 4.0f), CGSizeMake(6.0f, 8.0f), CGSizeMake(2.0f, 2.0f) };
+  CGPoint positions[3];
+  [layoutManager layoutSizes:sizes count:3 getPositions:positions];
+  XCTAssertEqual(layoutManager.rowCount, 2);
+  XCTAssertEqualWithAccuracy(layoutManager.size.width, 17.0f, epsilon);
+  XCTAssertEqualWithAccuracy(layoutManager.size.height, 10.0f, epsilon);
+  XCTAssertEqualWithAccuracy(positions[0].x, 5.0f, epsilon);
+  XCTAssertEqualWithAccuracy(positions[1].x, 14.0f, epsilon);
+  XCTAssertEqualWithAccuracy(positions[2].x, 5.0f, epsilon);
+  XCTAssertEqualWithAccuracy(positions[0].y, 6.0f, epsilon);
+  XCTAssertEqualWithAccuracy(positions[2].y, 1.0f, epsilon);
+}
+
 @end
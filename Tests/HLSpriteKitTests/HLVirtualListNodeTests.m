@@ -0,0 +1,162 @@
+//
+//  HLVirtualListNodeTests.m
+//  HLSpriteKit
+//
+//  Created by Karl Voskuil on 10/16/26.
+//  Copyright © 2026 Hilo Games. All rights reserved.
+//
+
+#import <SpriteKit/SpriteKit.h>
+#import <XCTest/XCTest.h>
+
+#import "HLRingLayoutManager.h"
+#import "HLStackLayoutManager.h"
+#import "HLVirtualListNode.h"
+
+@interface HLVirtualListNodeTestsDataSource : NSObject <HLVirtualListNodeDataSource>
+@property (nonatomic, assign) NSUInteger itemCount;
+@property (nonatomic, assign) NSUInteger createdNodeCount;
+@property (nonatomic, assign) CGPoint anchorPoint;
+@property (nonatomic, assign) BOOL labelItems;
+@end
+
+@implementation HLVirtualListNodeTestsDataSource
+
+- (instancetype)init
+{
+  self = [super init];
+  if (self) {
+    _anchorPoint = CGPointMake(0.5f, 0.5f);
+  }
+  return self;
+}
+
+- (NSUInteger)numberOfItemsInVirtualListNode:(HLVirtualListNode *)virtualListNode
+{
+  return _itemCount;
+}
+
+- (CGSize)virtualListNode:(HLVirtualListNode *)virtualListNode sizeForItemAtIndex:(NSUInteger)itemIndex
+{
+  return CGSizeMake(100.0f, 10.0f);
+}
+
+- (CGPoint)virtualListNode:(HLVirtualListNode *)virtualListNode anchorPointForItemAtIndex:(NSUInteger)itemIndex
+{
+  return _anchorPoint;
+}
+
+- (SKNode *)virtualListNode:(HLVirtualListNode *)virtualListNode nodeForItemAtIndex:(NSUInteger)itemIndex
+{
+  SKNode *node = [virtualListNode dequeueReusableNode];
+  if (!node) {
+    if (_labelItems) {
+      node = [SKLabelNode labelNodeWithText:@"item"];
+    } else {
+      SKSpriteNode *spriteNode = [SKSpriteNode spriteNodeWithColor:[SKColor whiteColor] size:CGSizeMake(100.0f, 10.0f)];
+      spriteNode.anchorPoint = _anchorPoint;
+      node = spriteNode;
+    }
+    ++_createdNodeCount;
+  }
+  node.name = [NSString stringWithFormat:@"%lu", (unsigned long)itemIndex];
+  return node;
+}
+
+@end
+
+@interface HLVirtualListNodeTests : XCTestCase
+
+@end
+
+@implementation HLVirtualListNodeTests
+
+- (void)testRecycling
+{
+  HLVirtualListNodeTestsDataSource *dataSource = [[HLVirtualListNodeTestsDataSource alloc] init];
+  dataSource.itemCount = 100000;
+
+  HLStackLayoutManager *layoutManager = [[HLStackLayoutManager alloc] initWithStackDirection:HLStackLayoutManagerStackDown];
+  HLVirtualListNode *listNode = [[HLVirtualListNode alloc] initWithLayoutManager:layoutManager];
+  listNode.dataSource = dataSource;
+  [listNode reloadData];
+  XCTAssertEqual(listNode.itemCount, 100000);
+  XCTAssertEqual([listNode.children count], 0);
+
+  // note: Items are 10 high, stacked down without separators, so a rect 24 high centered
+  // on an item intersects it and its two neighbors.
+  CGPoint position = [listNode positionOfItemAtIndex:500];
+  [listNode updateVisibleRect:CGRectMake(-50.0f, position.y - 12.0f, 100.0f, 24.0f)];
+  XCTAssertEqualObjects(listNode.visibleItemIndexes, [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(499, 3)]);
+  XCTAssertEqual([listNode.children count], 3);
+  XCTAssertEqual(dataSource.createdNodeCount, 3);
+  SKNode *node = [listNode nodeForItemAtIndex:500];
+  XCTAssertEqualObjects(node.name, @"500");
+  XCTAssertEqualWithAccuracy(node.position.y, position.y, 0.001f);
+  XCTAssertEqual([listNode itemContainingPoint:position], 500);
+
+  // note: Scrolling down ten items reuses the nodes.
+  [listNode updateVisibleRect:CGRectMake(-50.0f, position.y - 112.0f, 100.0f, 24.0f)];
+  XCTAssertEqualObjects(listNode.visibleItemIndexes, [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(509, 3)]);
+  XCTAssertEqual([listNode.children count], 3);
+  XCTAssertEqual(dataSource.createdNodeCount, 3);
+  XCTAssertNil([listNode nodeForItemAtIndex:500]);
+  XCTAssertEqualObjects([listNode nodeForItemAtIndex:510].name, @"510");
+
+  // note: The prefetch margin adds one item on each side.
+  listNode.prefetchMargin = 10.0f;
+  [listNode reloadData];
+  XCTAssertEqualObjects(listNode.visibleItemIndexes, [NSIndexSet indexSetWithIndexesInRange:NSMakeRange(508, 5)]);
+  XCTAssertEqual(dataSource.createdNodeCount, 5);
+
+  [listNode updateVisibleRect:CGRectNull];
+  XCTAssertEqual([listNode.children count], 0);
+  XCTAssertEqual([listNode.visibleItemIndexes count], 0);
+}
+
+- (void)testItemGeometry
+{
+  {
+    // note: The ring layout manager returns no cell geometry, so items are found by their
+    // frames.  With an anchor point of (0, 0), the single item at (100, 0) extends up and
+    // to the right of its position.
+    HLVirtualListNodeTestsDataSource *dataSource = [[HLVirtualListNodeTestsDataSource alloc] init];
+    dataSource.itemCount = 1;
+    dataSource.anchorPoint = CGPointZero;
+    HLRingLayoutManager *layoutManager = [[HLRingLayoutManager alloc] init];
+    layoutManager.radii = @[ @100.0f ];
+    [layoutManager setThetas:@[ @0.0f ]];
+    HLVirtualListNode *listNode = [[HLVirtualListNode alloc] initWithLayoutManager:layoutManager];
+    listNode.dataSource = dataSource;
+    [listNode reloadData];
+    XCTAssertEqual([listNode itemContainingPoint:CGPointMake(190.0f, 8.0f)], 0);
+    XCTAssertEqual([listNode itemContainingPoint:CGPointMake(60.0f, -2.0f)], NSNotFound);
+    [listNode updateVisibleRect:CGRectMake(180.0f, 2.0f, 5.0f, 5.0f)];
+    XCTAssertEqualObjects(listNode.visibleItemIndexes, [NSIndexSet indexSetWithIndex:0]);
+    SKNode *node = [listNode nodeForItemAtIndex:0];
+    XCTAssertEqualWithAccuracy(node.position.x, 100.0f, 0.001f);
+    XCTAssertEqualWithAccuracy(node.position.y, 0.0f, 0.001f);
+    [listNode updateVisibleRect:CGRectMake(60.0f, -4.0f, 5.0f, 2.0f)];
+    XCTAssertEqual([listNode.visibleItemIndexes count], 0);
+  }
+
+  {
+    // note: Label nodes are offset as by the layout manager's layout:.
+    HLVirtualListNodeTestsDataSource *dataSource = [[HLVirtualListNodeTestsDataSource alloc] init];
+    dataSource.itemCount = 10;
+    dataSource.labelItems = YES;
+    HLStackLayoutManager *layoutManager = [[HLStackLayoutManager alloc] initWithStackDirection:HLStackLayoutManagerStackDown];
+    layoutManager.cellLabelOffsetY = -3.0f;
+    HLVirtualListNode *listNode = [[HLVirtualListNode alloc] initWithLayoutManager:layoutManager];
+    listNode.dataSource = dataSource;
+    [listNode reloadData];
+    CGPoint position = [listNode positionOfItemAtIndex:5];
+    [listNode updateVisibleRect:CGRectMake(-50.0f, position.y - 2.0f, 100.0f, 4.0f)];
+    SKNode *node = [listNode nodeForItemAtIndex:5];
+    XCTAssertTrue([node isKindOfClass:[SKLabelNode class]]);
+    XCTAssertEqualWithAccuracy(node.position.x, position.x, 0.001f);
+    XCTAssertEqualWithAccuracy(node.position.y, position.y - 3.0f, 0.001f);
+  }
+}
+
+@end